@@ -0,0 +1,41 @@
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <gobeyond/utility/arena.hpp>
+#include <gobeyond/utility/format.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  const char* volatile g_topic = "sensors/hall-3/temperature";
+  volatile int g_value = 2150;
+}
+
+BENCHMARK_CASE("arena/request scratch/heap") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::vector<std::string> parts;
+    parts.reserve(4);
+
+    for ( int j = 0; j < 4; ++j ) {
+      parts.push_back(std::string(g_topic) + "/" + std::to_string(g_value + j));
+    }
+
+    benchmark::doNotOptimize(parts);
+  }
+}
+
+BENCHMARK_CASE("arena/request scratch/thread frame") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    gobeyond::utility::FrameScope frame;
+    gobeyond::utility::ArenaResource resource{frame.arena()};
+    std::pmr::vector<std::string_view> parts{&resource};
+    parts.reserve(4);
+
+    for ( int j = 0; j < 4; ++j ) {
+      parts.push_back(gobeyond::utility::format_to(frame.arena(), GBE_FMT("%s/%d"), g_topic, g_value + j));
+    }
+
+    benchmark::doNotOptimize(parts);
+  }
+}
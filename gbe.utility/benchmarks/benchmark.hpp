@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+  /// Keeps the compiler from optimizing away the given value
+  template <typename T>
+  inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile T* sink = &value;
+    (void)sink;
+#endif
+  }
+
+  struct Case {
+    std::string name;
+    std::function<void(std::size_t)> run;
+  };
+
+  inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+  }
+
+  struct Register {
+    Register(const char* name, std::function<void(std::size_t)> run) {
+      registry().push_back({name, std::move(run)});
+    }
+  };
+
+  /// Runs all registered cases whose name contains the filter and prints ns/op
+  inline void runAll(const std::string& filter, std::size_t iterations) {
+    for ( const Case& c : registry() ) {
+      if ( !filter.empty() && c.name.find(filter) == std::string::npos ) {
+        continue;
+      }
+
+      c.run(iterations / 10);
+
+      const auto start = std::chrono::steady_clock::now();
+      c.run(iterations);
+      const auto stop = std::chrono::steady_clock::now();
+
+      const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+      std::printf("%-48s %10.2f ns/op\n", c.name.c_str(), ns / static_cast<double>(iterations));
+    }
+  }
+}
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Registers a benchmark body, the body runs `iterations` times
+#define BENCHMARK_CASE(name) \
+  static void BENCHMARK_CONCAT(benchmark_, __LINE__)(std::size_t iterations); \
+  static ::benchmark::Register BENCHMARK_CONCAT(benchmark_register_, __LINE__)(name, &BENCHMARK_CONCAT(benchmark_, __LINE__)); \
+  static void BENCHMARK_CONCAT(benchmark_, __LINE__)(std::size_t iterations)
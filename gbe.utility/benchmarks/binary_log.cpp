@@ -0,0 +1,57 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <gobeyond/utility/binary_log.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  enum class LogLocation : unsigned {
+    LOGFILE = 2
+  };
+
+  volatile int g_retries = 3;
+  volatile unsigned g_session = 40000u;
+  const char* volatile g_broker = "mqtt.local";
+
+  std::string temporaryBase(const char* name) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return (directory / "log").string();
+  }
+}
+
+BENCHMARK_CASE("binary_log/text line/fprintf") {
+  const std::string path = temporaryBase("gbe_benchmark_text") + ".txt";
+  std::FILE* file = std::fopen(path.c_str(), "w");
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::fprintf(file, "2026-10-16 12:00:00.000000 [LOGFILE] Connection to broker %s established after %d retries, session %u resumed\n", g_broker, g_retries, g_session);
+  }
+
+  std::fclose(file);
+  std::filesystem::remove_all(std::filesystem::path(path).parent_path());
+}
+
+BENCHMARK_CASE("binary_log/deferred/append") {
+  const std::string base = temporaryBase("gbe_benchmark_binary");
+
+  {
+    gobeyond::utility::BinaryLogWriter writer{base, 16 * 1024 * 1024, 2};
+    const gobeyond::utility::BitMask<LogLocation> route{LogLocation::LOGFILE};
+
+    for ( std::size_t i = 0; i < iterations; ++i ) {
+      gobeyond::utility::DeferredRecord<64> record;
+      record.capture(GBE_FMT("Connection to broker %s established after %d retries, session %u resumed"), g_broker, g_retries, g_session);
+      writer.append(route, record, i);
+    }
+  }
+
+  std::filesystem::remove_all(std::filesystem::path(base).parent_path());
+}
+
+#endif
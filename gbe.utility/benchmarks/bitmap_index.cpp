@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <gobeyond/utility/bitmap_index.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16
+  };
+
+  using mask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  constexpr std::size_t g_records = 1 << 22;
+
+  /// Rare MQTT records, mostly LOGFILE records and DEBUG in long stretches
+  std::vector<mask_type> masks() {
+    std::mt19937 random{1};
+    std::vector<mask_type> result;
+
+    for ( std::size_t i = 0; i < g_records; ++i ) {
+      mask_type mask;
+
+      if ( 0 == random() % 100 ) {
+        mask.enable(LogLocation::MQTT);
+      }
+
+      if ( 0 != random() % 8 ) {
+        mask.enable(LogLocation::LOGFILE);
+      }
+
+      if ( 0 == (i >> 16) % 2 ) {
+        mask.enable(LogLocation::DEBUG);
+      }
+
+      result.push_back(mask);
+    }
+
+    return result;
+  }
+
+  const std::vector<mask_type> g_masks = masks();
+
+  gobeyond::utility::BitmapIndex<LogLocation> index() {
+    gobeyond::utility::BitmapIndex<LogLocation> result;
+
+    for ( const mask_type& mask : g_masks ) {
+      result.append(mask);
+    }
+
+    result.optimize();
+    std::printf("bitmap_index: %zu bytes for %zu records, std::vector<BitMask> %zu bytes\n",
+                result.memory_usage(), g_masks.size(), g_masks.size() * sizeof(mask_type));
+    return result;
+  }
+
+  const gobeyond::utility::BitmapIndex<LogLocation> g_index = index();
+}
+
+BENCHMARK_CASE("bitmap_index/MQTT but not LOGFILE 4M records/std::vector<BitMask>") {
+  std::vector<std::uint32_t> selected;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    selected.clear();
+
+    for ( std::size_t record = 0; record < g_masks.size(); ++record ) {
+      if ( g_masks[record].isEnabled(LogLocation::MQTT) && g_masks[record].isDisabled(LogLocation::LOGFILE) ) {
+        selected.push_back(static_cast<std::uint32_t>(record));
+      }
+    }
+
+    benchmark::doNotOptimize(selected.data());
+  }
+}
+
+BENCHMARK_CASE("bitmap_index/MQTT but not LOGFILE 4M records/BitmapIndex") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const gobeyond::utility::RoaringBitmap selected = g_index.bitmap(LogLocation::MQTT).andNot(g_index.bitmap(LogLocation::LOGFILE));
+    benchmark::doNotOptimize(selected.cardinality());
+  }
+}
+
+BENCHMARK_CASE("bitmap_index/MQTT and DEBUG 4M records/std::vector<BitMask>") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t count = 0;
+
+    for ( const mask_type& mask : g_masks ) {
+      count += mask == mask_type::Enabled{LogLocation::MQTT | LogLocation::DEBUG} ? 1 : 0;
+    }
+
+    benchmark::doNotOptimize(count);
+  }
+}
+
+BENCHMARK_CASE("bitmap_index/MQTT and DEBUG 4M records/BitmapIndex") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const gobeyond::utility::RoaringBitmap selected = g_index.query(mask_type::Enabled{LogLocation::MQTT | LogLocation::DEBUG});
+    benchmark::doNotOptimize(selected.cardinality());
+  }
+}
@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gobeyond/utility/bitmask_array.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16
+  };
+
+  using mask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  constexpr std::size_t g_records = 1 << 22;
+
+  std::vector<mask_type> masks() {
+    std::mt19937 random{1};
+    std::vector<mask_type> result;
+
+    for ( std::size_t i = 0; i < g_records; ++i ) {
+      result.push_back(mask_type{static_cast<LogLocation>(random() % 32)});
+    }
+
+    return result;
+  }
+
+  const std::vector<mask_type> g_masks = masks();
+
+  gobeyond::utility::BitMaskArray<LogLocation> columns() {
+    gobeyond::utility::BitMaskArray<LogLocation> result;
+
+    for ( const mask_type& mask : g_masks ) {
+      result.push_back(mask);
+    }
+
+    return result;
+  }
+
+  const gobeyond::utility::BitMaskArray<LogLocation> g_columns = columns();
+}
+
+BENCHMARK_CASE("bitmask_array/count 4M records/std::vector<BitMask>") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t count = 0;
+
+    for ( const mask_type& mask : g_masks ) {
+      count += mask.isEnabled(LogLocation::MQTT) && mask.isEnabled(LogLocation::LOGFILE) ? 1 : 0;
+    }
+
+    benchmark::doNotOptimize(count);
+  }
+}
+
+BENCHMARK_CASE("bitmask_array/count 4M records/BitMaskArray") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const std::size_t count = g_columns.count(mask_type::Enabled{LogLocation::MQTT | LogLocation::LOGFILE});
+    benchmark::doNotOptimize(count);
+  }
+}
+
+BENCHMARK_CASE("bitmask_array/count 4M records/BitMaskArray parallel") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const std::size_t count = g_columns.parallel_count(mask_type::Enabled{LogLocation::MQTT | LogLocation::LOGFILE});
+    benchmark::doNotOptimize(count);
+  }
+}
+
+BENCHMARK_CASE("bitmask_array/select 4M records/std::vector<BitMask>") {
+  std::vector<std::size_t> selected;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    selected.clear();
+
+    for ( std::size_t k = 0; k < g_masks.size(); ++k ) {
+      if ( g_masks[k].isEnabled(LogLocation::PUSHNOTIFICATION) ) {
+        selected.push_back(k);
+      }
+    }
+
+    benchmark::doNotOptimize(selected);
+  }
+}
+
+BENCHMARK_CASE("bitmask_array/select 4M records/BitMaskArray") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const std::vector<std::size_t> selected = g_columns.select(mask_type::Enabled{LogLocation::PUSHNOTIFICATION});
+    benchmark::doNotOptimize(selected);
+  }
+}
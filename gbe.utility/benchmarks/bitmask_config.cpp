@@ -0,0 +1,118 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gobeyond/utility/bitmask_config.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16
+  };
+
+  using mask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  constexpr std::size_t g_modules = 512;
+
+  std::vector<mask_type> masks() {
+    std::vector<mask_type> result;
+
+    for ( std::size_t i = 0; i < g_modules; ++i ) {
+      result.push_back(mask_type{static_cast<LogLocation>(i % 32)});
+    }
+
+    return result;
+  }
+
+  /// Keeps other threads reading while the benchmark thread reads too
+  template <typename TRead>
+  class Contention
+  {
+    public:
+      explicit Contention(TRead read) {
+        for ( int t = 0; t < 3; ++t ) {
+          m_threads.emplace_back([this, read]() {
+            while ( !m_done.load(std::memory_order_relaxed) ) {
+              read();
+            }
+          });
+        }
+      }
+
+      ~Contention() {
+        m_done = true;
+
+        for ( std::thread& thread : m_threads ) {
+          thread.join();
+        }
+      }
+
+    private:
+      std::atomic<bool> m_done{false};
+      std::vector<std::thread> m_threads;
+  };
+}
+
+BENCHMARK_CASE("bitmask_config/read one module/std::mutex") {
+  std::mutex mutex;
+  const std::vector<mask_type> config = masks();
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::lock_guard<std::mutex> lock(mutex);
+    benchmark::doNotOptimize(config[i % g_modules].isEnabled(LogLocation::MQTT));
+  }
+}
+
+BENCHMARK_CASE("bitmask_config/read one module/BitMaskConfig") {
+  gobeyond::utility::BitMaskConfig<LogLocation> config{masks()};
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(config.get(i % g_modules).isEnabled(LogLocation::MQTT));
+  }
+}
+
+BENCHMARK_CASE("bitmask_config/read all modules/BitMaskConfig") {
+  gobeyond::utility::BitMaskConfig<LogLocation> config{masks()};
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const auto view = config.read();
+    std::size_t count = 0;
+
+    for ( const mask_type& mask : view->masks() ) {
+      count += mask.isEnabled(LogLocation::MQTT) ? 1 : 0;
+    }
+
+    benchmark::doNotOptimize(count);
+  }
+}
+
+BENCHMARK_CASE("bitmask_config/read one module, 3 other readers/std::mutex") {
+  std::mutex mutex;
+  const std::vector<mask_type> config = masks();
+  const auto read = [&mutex, &config](std::size_t module) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return config[module % g_modules].isEnabled(LogLocation::MQTT);
+  };
+  Contention contention([&read]() { benchmark::doNotOptimize(read(1)); });
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(read(i));
+  }
+}
+
+BENCHMARK_CASE("bitmask_config/read one module, 3 other readers/BitMaskConfig") {
+  gobeyond::utility::BitMaskConfig<LogLocation> config{masks()};
+  Contention contention([&config]() { benchmark::doNotOptimize(config.get(1).isEnabled(LogLocation::MQTT)); });
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(config.get(i % g_modules).isEnabled(LogLocation::MQTT));
+  }
+}
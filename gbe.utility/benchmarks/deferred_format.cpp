@@ -0,0 +1,32 @@
+#include <gobeyond/utility/deferred_format.hpp>
+
+#include "benchmark.hpp"
+
+using record_type = gobeyond::utility::DeferredRecord<128>;
+using buffer_type = gobeyond::utility::StringBuffer<256>;
+
+namespace {
+  volatile int g_value = 4711;
+  volatile double g_ratio = 0.73125;
+  volatile unsigned g_id = 0xC0FFEEu;
+  const char* volatile g_name = "sensor.temperature";
+}
+
+BENCHMARK_CASE("deferred/6 args/capture") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    record_type record;
+    record.capture(GBE_FMT("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%s"), g_name, g_value, g_ratio, g_id, g_id, "MQTT");
+    benchmark::doNotOptimize(record);
+  }
+}
+
+BENCHMARK_CASE("deferred/6 args/render") {
+  record_type record;
+  record.capture(GBE_FMT("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%s"), g_name, g_value, g_ratio, g_id, g_id, "MQTT");
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer_type buffer;
+    record.render(buffer);
+    benchmark::doNotOptimize(buffer);
+  }
+}
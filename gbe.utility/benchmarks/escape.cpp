@@ -0,0 +1,73 @@
+#include <string>
+#include <string_view>
+
+#include <gobeyond/utility/escape.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  /// A long payload with a few characters to escape, as typical for MQTT and BROWSER messages
+  std::string payload() {
+    std::string text;
+
+    while ( text.size() < 900 ) {
+      text += "sensors/hall-3/temperature value 21.5 above threshold 21.0 \"ALARM\"\n";
+    }
+
+    return text;
+  }
+
+  const std::string g_payload = payload();
+
+  /// How payloads were escaped before, one character at a time after formatting
+  template <std::size_t TBufferSize>
+  void naiveEscape(gobeyond::utility::StringBuffer<TBufferSize>& buffer, std::string_view text) {
+    for ( char c : text ) {
+      switch ( c ) {
+        case '"':
+          buffer.append("\\\"");
+          break;
+        case '\\':
+          buffer.append("\\\\");
+          break;
+        case '\n':
+          buffer.append("\\n");
+          break;
+        default:
+          buffer.append(c);
+          break;
+      }
+    }
+  }
+}
+
+BENCHMARK_CASE("escape/json/naive loop") {
+  gobeyond::utility::StringBuffer<2048> buffer;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer.clear();
+    naiveEscape(buffer, g_payload);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("escape/json/append_escaped") {
+  gobeyond::utility::StringBuffer<2048> buffer;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer.clear();
+    buffer.append_escaped(g_payload);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("escape/html/append_escaped") {
+  gobeyond::utility::StringBuffer<2048> buffer;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer.clear();
+    buffer.append_escaped(g_payload, gobeyond::utility::Escape::Html);
+    benchmark::doNotOptimize(buffer);
+  }
+}
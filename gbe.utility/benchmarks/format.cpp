@@ -0,0 +1,42 @@
+#include <cstdio>
+
+#include <gobeyond/utility/string_buffer.hpp>
+
+#include "benchmark.hpp"
+
+using buffer_type = gobeyond::utility::StringBuffer<256>;
+
+namespace {
+  volatile int g_value = 4711;
+  volatile double g_ratio = 0.73125;
+  volatile unsigned g_id = 0xC0FFEEu;
+  const char* volatile g_name = "sensor.temperature";
+}
+
+BENCHMARK_CASE("format/3 args/snprintf") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer_type buffer = buffer_type::format("%s: value=%d id=%u", g_name, g_value, g_id);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("format/3 args/compiled") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer_type buffer = buffer_type::format(GBE_FMT("%s: value=%d id=%u"), g_name, g_value, g_id);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("format/6 args/snprintf") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer_type buffer = buffer_type::format("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%s", g_name, g_value, g_ratio, g_id, g_id, "MQTT");
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("format/6 args/compiled") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer_type buffer = buffer_type::format(GBE_FMT("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%s"), g_name, g_value, g_ratio, g_id, g_id, "MQTT");
+    benchmark::doNotOptimize(buffer);
+  }
+}
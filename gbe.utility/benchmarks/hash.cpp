@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <gobeyond/utility/hash.hpp>
+#include <gobeyond/utility/intern_table.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  /// A typical alert, rate limiting hashes the whole text of every message
+  const std::string g_text = "2026-10-16 12:00:00.000000 [MQTT] sensors/hall-3/temperature: value 21.5 above threshold 21.0, notifying ALARM";
+
+  std::string alert(int n) {
+    return "sensors/hall-" + std::to_string(n) + "/temperature: value above threshold";
+  }
+}
+
+BENCHMARK_CASE("hash/std::hash") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t value = std::hash<std::string_view>()(g_text);
+    benchmark::doNotOptimize(value);
+  }
+}
+
+BENCHMARK_CASE("hash/hash_string") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::uint64_t value = gobeyond::utility::hash_string(g_text);
+    benchmark::doNotOptimize(value);
+  }
+}
+
+BENCHMARK_CASE("hash/lookup/unordered_map") {
+  std::unordered_map<std::string, std::uint32_t> map;
+
+  for ( int n = 0; n < 256; ++n ) {
+    map.emplace(alert(n), static_cast<std::uint32_t>(n));
+  }
+
+  const std::string key = alert(100);
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::uint32_t id = map.find(key)->second;
+    benchmark::doNotOptimize(id);
+  }
+}
+
+BENCHMARK_CASE("hash/lookup/InternTable") {
+  gobeyond::utility::InternTable table{256, 256 * 64};
+
+  for ( int n = 0; n < 256; ++n ) {
+    (void)table.intern(alert(n));
+  }
+
+  const std::string key = alert(100);
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::uint32_t id = table.find(key);
+    benchmark::doNotOptimize(id);
+  }
+}
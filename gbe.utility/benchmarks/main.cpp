@@ -0,0 +1,13 @@
+#include <cstdlib>
+#include <string>
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv) {
+  const std::string filter = argc > 1 ? argv[1] : "";
+  const std::size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+  benchmark::runAll(filter, iterations);
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+
+#include <gobeyond/utility/numeric.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  volatile std::uint32_t g_small = 4711;
+  volatile std::int64_t g_large = -1234567890123456ll;
+  volatile double g_real = 3.14159265358979;
+}
+
+BENCHMARK_CASE("numeric/int32/snprintf") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::snprintf(buffer, sizeof(buffer), "%u", static_cast<unsigned>(g_small));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/int32/to_chars") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::uint32_t>(g_small));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/int32/write_decimal") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    gobeyond::utility::write_decimal(buffer, static_cast<std::uint32_t>(g_small));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/int64/snprintf") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(g_large));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/int64/to_chars") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::int64_t>(g_large));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/int64/write_decimal") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    gobeyond::utility::write_decimal(buffer, static_cast<std::int64_t>(g_large));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/hex08/snprintf") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::snprintf(buffer, sizeof(buffer), "%08x", static_cast<unsigned>(g_small));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/hex08/write_hex") {
+  char buffer[32];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    gobeyond::utility::write_hex(buffer, g_small, false, 8);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/fixed3/snprintf") {
+  char buffer[64];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(g_real));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/fixed3/to_chars") {
+  char buffer[64];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(g_real), std::chars_format::fixed, 3);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/fixed3/write_fixed") {
+  char buffer[64];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    gobeyond::utility::write_fixed(buffer, buffer + sizeof(buffer), g_real, 3);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/shortest/snprintf %.17g") {
+  char buffer[64];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::snprintf(buffer, sizeof(buffer), "%.17g", static_cast<double>(g_real));
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("numeric/shortest/write_shortest") {
+  char buffer[64];
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    gobeyond::utility::write_shortest(buffer, buffer + sizeof(buffer), static_cast<double>(g_real));
+    benchmark::doNotOptimize(buffer);
+  }
+}
@@ -0,0 +1,55 @@
+#include <cstdint>
+
+#include <gobeyond/utility/route_filter.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4
+  };
+
+  using buffer_type = gobeyond::utility::StringBuffer<256>;
+  using filter_type = gobeyond::utility::RouteFilter<LogLocation>;
+
+  filter_type g_filter{gobeyond::utility::BitMask<LogLocation>{LogLocation::LOGFILE}};
+}
+
+BENCHMARK_CASE("route_filter/disabled/format then check") {
+  buffer_type buffer;
+  double value = 21.5;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(value);
+    buffer = buffer_type::format(GBE_FMT("sensor %s value %f limit %d"), "hall-3", value, 42);
+
+    if ( g_filter.accepts(LogLocation::MQTT) ) {
+      benchmark::doNotOptimize(buffer);
+    }
+  }
+}
+
+BENCHMARK_CASE("route_filter/disabled/GBE_FORMAT_IF") {
+  buffer_type buffer;
+  double value = 21.5;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(value);
+    GBE_FORMAT_IF(g_filter, LogLocation::MQTT, buffer, GBE_FMT("sensor %s value %f limit %d"), "hall-3", value, 42);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("route_filter/enabled/GBE_FORMAT_IF") {
+  buffer_type buffer;
+  double value = 21.5;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(value);
+    GBE_FORMAT_IF(g_filter, LogLocation::LOGFILE, buffer, GBE_FMT("sensor %s value %f limit %d"), "hall-3", value, 42);
+    benchmark::doNotOptimize(buffer);
+  }
+}
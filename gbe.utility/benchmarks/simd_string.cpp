@@ -0,0 +1,68 @@
+#include <cstring>
+#include <string>
+
+#include <gobeyond/utility/simd_string.hpp>
+
+#include "benchmark.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <strings.h>
+#endif
+
+namespace {
+  /// A typical routed message, the pattern sits near the end like most rule matches
+  const std::string g_text = "2026-10-16 12:00:00.000000 [MQTT] sensors/hall-3/temperature: value 21.5 above threshold 21.0, notifying ALARM";
+  const char* volatile g_pattern = "ALARM";
+  const char* volatile g_upper = "2026-10-16 12:00:00.000000 [MQTT] SENSORS/HALL-3/TEMPERATURE: VALUE 21.5 ABOVE THRESHOLD 21.0, NOTIFYING ALARM";
+}
+
+BENCHMARK_CASE("simd_string/find/strstr") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const char* found = std::strstr(g_text.c_str(), g_pattern);
+    benchmark::doNotOptimize(found);
+  }
+}
+
+BENCHMARK_CASE("simd_string/find/string_view") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t found = std::string_view(g_text).find(g_pattern);
+    benchmark::doNotOptimize(found);
+  }
+}
+
+BENCHMARK_CASE("simd_string/find/str_find") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t found = gobeyond::utility::str_find(g_text, g_pattern);
+    benchmark::doNotOptimize(found);
+  }
+}
+
+BENCHMARK_CASE("simd_string/find any of/string_view") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t found = std::string_view(g_text).find_first_of(",;!");
+    benchmark::doNotOptimize(found);
+  }
+}
+
+BENCHMARK_CASE("simd_string/find any of/str_find_any_of") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    std::size_t found = gobeyond::utility::str_find_any_of(g_text, ",;!");
+    benchmark::doNotOptimize(found);
+  }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+BENCHMARK_CASE("simd_string/compare ignore case/strncasecmp") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    int order = strncasecmp(g_text.c_str(), g_upper, g_text.size());
+    benchmark::doNotOptimize(order);
+  }
+}
+#endif
+
+BENCHMARK_CASE("simd_string/compare ignore case/str_compare_ignore_case") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    int order = gobeyond::utility::str_compare_ignore_case(g_text, g_upper);
+    benchmark::doNotOptimize(order);
+  }
+}
@@ -0,0 +1,28 @@
+#include <utility>
+
+#include <gobeyond/utility/string_buffer.hpp>
+
+#include "benchmark.hpp"
+
+using buffer_type = gobeyond::utility::StringBuffer<1024>;
+
+BENCHMARK_CASE("string_buffer/copy 20 bytes of 1024") {
+  buffer_type source{"a twenty byte string"};
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(source);
+    buffer_type copy{source};
+    benchmark::doNotOptimize(copy);
+  }
+}
+
+BENCHMARK_CASE("string_buffer/move 20 bytes of 1024") {
+  buffer_type source{"a twenty byte string"};
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(source);
+    buffer_type moved{std::move(source)};
+    benchmark::doNotOptimize(moved);
+    source = std::move(moved);
+  }
+}
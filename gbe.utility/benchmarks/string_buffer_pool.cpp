@@ -0,0 +1,25 @@
+#include <memory>
+
+#include <gobeyond/utility/string_buffer_pool.hpp>
+
+#include "benchmark.hpp"
+
+using pool_type = gobeyond::utility::StringBufferPool<512>;
+
+BENCHMARK_CASE("string_buffer_pool/heap new+delete") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    auto buffer = std::make_unique<pool_type::buffer_type>();
+    buffer->append("message");
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("string_buffer_pool/acquire+release") {
+  static pool_type pool{1024};
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    pool_type::Handle buffer = pool.acquire();
+    buffer->append("message");
+    benchmark::doNotOptimize(buffer);
+  }
+}
@@ -0,0 +1,58 @@
+#include <string>
+#include <string_view>
+
+#include <gobeyond/utility/string_buffer.hpp>
+#include <gobeyond/utility/utf8.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  /// A long payload, mostly ASCII with a few umlauts and symbols like typical user facing messages
+  std::string payload() {
+    std::string text;
+
+    while ( text.size() < 900 ) {
+      text += "Temperatur in Halle 3 \xC3\xBC" "ber Grenzwert: 21.5 \xC2\xB0" "C > 21.0 \xC2\xB0" "C \xE2\x80\x94 Alarm ausgel\xC3\xB6st\n";
+    }
+
+    return text;
+  }
+
+  const std::string g_payload = payload();
+}
+
+BENCHMARK_CASE("utf8/valid/scalar") {
+  const auto& kernels = gobeyond::utility::utf8_detail::kernelsFor(gobeyond::utility::SimdLevel::Scalar);
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const bool valid = kernels.valid(g_payload.data(), g_payload.size());
+    benchmark::doNotOptimize(valid);
+  }
+}
+
+BENCHMARK_CASE("utf8/valid/dispatched") {
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    const bool valid = gobeyond::utility::utf8_valid(g_payload);
+    benchmark::doNotOptimize(valid);
+  }
+}
+
+BENCHMARK_CASE("utf8/append/plain") {
+  gobeyond::utility::StringBuffer<512> buffer;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer.clear();
+    buffer.append(g_payload);
+    benchmark::doNotOptimize(buffer);
+  }
+}
+
+BENCHMARK_CASE("utf8/append/append_utf8") {
+  gobeyond::utility::StringBuffer<512> buffer;
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    buffer.clear();
+    buffer.append_utf8(g_payload, "\xE2\x80\xA6");
+    benchmark::doNotOptimize(buffer);
+  }
+}
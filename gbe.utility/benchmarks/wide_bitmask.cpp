@@ -0,0 +1,48 @@
+#include <bitset>
+#include <cstdint>
+
+#include <gobeyond/utility/wide_bitmask.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+  enum class Permission : std::uint16_t {};
+
+  using mask_type = gobeyond::utility::WideBitMask<Permission, 160>;
+
+  template <typename TMask, typename TSet>
+  void fillMasks(TMask& a, TMask& b, TSet set) {
+    for ( std::size_t i = 0; i < 160; i += 3 ) {
+      set(a, i);
+      set(b, (i * 7) % 160);
+    }
+  }
+}
+
+BENCHMARK_CASE("wide_bitmask/subset and count/std::bitset") {
+  std::bitset<160> a;
+  std::bitset<160> b;
+  fillMasks(a, b, [](std::bitset<160>& mask, std::size_t i) { mask.set(i); });
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(a);
+    const bool subset = (a & ~b).none();
+    const std::size_t count = (a ^ b).count();
+    benchmark::doNotOptimize(subset);
+    benchmark::doNotOptimize(count);
+  }
+}
+
+BENCHMARK_CASE("wide_bitmask/subset and count/WideBitMask") {
+  mask_type a;
+  mask_type b;
+  fillMasks(a, b, [](mask_type& mask, std::size_t i) { mask.enable(static_cast<Permission>(i)); });
+
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    benchmark::doNotOptimize(a);
+    const bool subset = a.isSubsetOf(b);
+    const std::size_t count = (a ^ b).count();
+    benchmark::doNotOptimize(subset);
+    benchmark::doNotOptimize(count);
+  }
+}
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+namespace gobeyond::utility 
+{
+  namespace arena_detail 
+  {
+    /// A piece of memory the arena hands out, chained blocks keep this header in front of their memory
+    struct Block 
+    {
+      Block* next;
+      char* begin;
+      char* end;
+    };
+
+    /// The size of the header in front of a chained block, keeps the memory behind it maximally aligned
+    inline constexpr std::size_t header_size = (sizeof(Block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+  }
+
+  /**
+   * @brief MonotonicArena
+   * 
+   * A bump allocator. Allocations only move a pointer forward, single
+   * allocations are never freed, reset() or rewind() release
+   * everything allocated after a point at once.
+   * 
+   * In fixed-capacity mode the arena hands out memory from a caller
+   * supplied buffer only and allocate() returns nullptr once it is
+   * exhausted. In chained mode (block_size not 0) the arena continues
+   * with blocks from malloc. Blocks are kept after a reset or rewind
+   * and reused, so a warmed up arena does not call malloc anymore.
+   * 
+   * The arena is not thread safe, use one arena per thread (see
+   * thread_arena()).
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class MonotonicArena 
+  {
+    public:
+      /// The block size of thread_arena()
+      static constexpr std::size_t default_block_size = 64 * 1024;
+
+      /**
+       * @brief Marker
+       * 
+       * A position in the arena returned by mark(), see rewind().
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      struct Marker 
+      {
+        /// The current block
+        arena_detail::Block* block;
+        /// The next free byte in the block
+        char* current;
+        /// The bytes of the blocks before the current one
+        std::size_t passed;
+      };
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs an arena that hands out memory from the given buffer
+       * and, if block_size is not 0, from chained blocks of at least
+       * block_size bytes afterwards. The buffer has to outlive the arena.
+       * 
+       * @param buffer The memory to hand out
+       * @param size The size of the buffer in bytes
+       * @param block_size The minimum size of chained blocks, 0 for a
+       * fixed-capacity arena
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline MonotonicArena(void* buffer, std::size_t size, std::size_t block_size = 0) noexcept
+        : m_first{nullptr, static_cast<char*>(buffer), static_cast<char*>(buffer) + size},
+          m_block(&m_first),
+          m_current(m_first.begin),
+          m_end(m_first.end),
+          m_block_size(block_size) 
+      {
+      }
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs an arena that hands out memory from the given array
+       * only.
+       * 
+       * @tparam TSize The size of the array
+       * 
+       * @param buffer The memory to hand out
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <std::size_t TSize>
+      explicit inline MonotonicArena(unsigned char (&buffer)[TSize]) noexcept
+        : MonotonicArena(buffer, TSize) 
+      {
+      }
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs a chained arena without an initial buffer. The first
+       * block is allocated with the first allocation.
+       * 
+       * @param block_size The minimum size of chained blocks
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit inline MonotonicArena(std::size_t block_size) noexcept
+        : MonotonicArena(nullptr, 0, block_size) 
+      {
+      }
+
+      MonotonicArena(const MonotonicArena&) = delete;
+      MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+      /**
+       * @brief Destructor
+       * 
+       * Gives the chained blocks back.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline ~MonotonicArena() 
+      {
+        release();
+      }
+
+      /**
+       * @brief Allocate
+       * 
+       * Hands out size bytes aligned to alignment.
+       * 
+       * @param size The number of bytes
+       * @param alignment The alignment, a power of two
+       * 
+       * @return The memory, nullptr if the arena is exhausted
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept 
+      {
+        void* result = bump(size, alignment);
+
+        if ( nullptr == result && 0 != m_block_size && nextBlock(size + alignment - 1) ) {
+          result = bump(size, alignment);
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief Extend
+       * 
+       * Grows the most recent allocation in place, which makes appending
+       * to a buffer that lives at the end of the arena free of copies.
+       * 
+       * @param p The most recent allocation
+       * @param size The new size of the allocation in bytes
+       * 
+       * @return true if the allocation was grown, false if p is not the
+       * most recent allocation or its block is exhausted
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool extend(void* p, std::size_t size) noexcept 
+      {
+        if ( nullptr == p || p != m_last ) {
+          return false;
+        }
+
+        // Moves back from the end of the block, so no pointer beyond the block is ever formed
+        const std::size_t room = static_cast<std::size_t>(m_end - m_last);
+
+        if ( size > room ) {
+          return false;
+        }
+
+        m_current = m_end - (room - size);
+        return true;
+      }
+
+      /**
+       * @brief Mark
+       * 
+       * @return The current position, see rewind()
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline Marker mark() const noexcept 
+      {
+        return Marker{m_block, m_current, m_passed};
+      }
+
+      /**
+       * @brief Rewind
+       * 
+       * Releases everything allocated after the marker was taken in
+       * constant time. The blocks are kept for reuse.
+       * 
+       * @param marker A position returned by mark() of this arena that was
+       * not released since
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void rewind(const Marker& marker) noexcept 
+      {
+        m_block = marker.block;
+        m_current = marker.current;
+        m_end = m_block->end;
+        m_passed = marker.passed;
+        m_last = nullptr;
+      }
+
+      /**
+       * @brief Reset
+       * 
+       * Releases all allocations at once. Memory handed out before must
+       * not be used afterwards. The blocks are kept for reuse.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void reset() noexcept 
+      {
+        rewind(Marker{&m_first, m_first.begin, 0});
+      }
+
+      /**
+       * @brief Release
+       * 
+       * Releases all allocations and gives the chained blocks back.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void release() noexcept 
+      {
+        arena_detail::Block* block = m_first.next;
+
+        while ( nullptr != block ) {
+          arena_detail::Block* next = block->next;
+          std::free(block);
+          block = next;
+        }
+
+        m_first.next = nullptr;
+        reset();
+      }
+
+      /**
+       * @brief Owns
+       * 
+       * @param p The pointer to check
+       * 
+       * @return true if p points into the memory of the arena, false
+       * otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool owns(const void* p) const noexcept 
+      {
+        const char* c = static_cast<const char*>(p);
+
+        for ( const arena_detail::Block* block = &m_first; nullptr != block; block = block->next ) {
+          if ( c >= block->begin && c < block->end ) {
+            return true;
+          }
+        }
+
+        return false;
+      }
+
+      /**
+       * @brief Used
+       * 
+       * @return The number of bytes handed out including alignment padding
+       * and the unused ends of blocks that were left behind
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t used() const noexcept 
+      {
+        return m_passed + static_cast<std::size_t>(m_current - m_block->begin);
+      }
+
+      /**
+       * @brief Remaining
+       * 
+       * @return The number of bytes that can still be handed out without
+       * moving on to the next block
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t remaining() const noexcept 
+      {
+        return static_cast<std::size_t>(m_end - m_current);
+      }
+
+      /**
+       * @brief Capacity
+       * 
+       * @return The size of the buffer and all chained blocks in bytes
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t capacity() const noexcept 
+      {
+        std::size_t capacity = 0;
+
+        for ( const arena_detail::Block* block = &m_first; nullptr != block; block = block->next ) {
+          capacity += static_cast<std::size_t>(block->end - block->begin);
+        }
+
+        return capacity;
+      }
+
+      /**
+       * @brief Block size
+       * 
+       * @return The minimum size of chained blocks, 0 for a fixed-capacity
+       * arena
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t block_size() const noexcept 
+      {
+        return m_block_size;
+      }
+
+    private:
+      /// Hands out memory from the current block
+      inline void* bump(std::size_t size, std::size_t alignment) noexcept 
+      {
+        const std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_current);
+        const std::size_t padding = static_cast<std::size_t>((alignment - (current & (alignment - 1))) & (alignment - 1));
+
+        if ( padding > remaining() || size > remaining() - padding ) {
+          return nullptr;
+        }
+
+        char* result = m_current + padding;
+        m_current = result + size;
+        m_last = result;
+
+        return result;
+      }
+
+      /// Moves on to a block with at least n bytes, reusing the block after the current one if it is large enough
+      inline bool nextBlock(std::size_t n) noexcept 
+      {
+        arena_detail::Block* block = m_block->next;
+
+        if ( nullptr == block || static_cast<std::size_t>(block->end - block->begin) < n ) {
+          const std::size_t size = n < m_block_size ? m_block_size : n;
+          void* memory = std::malloc(arena_detail::header_size + size);
+
+          if ( nullptr == memory ) {
+            return false;
+          }
+
+          char* begin = static_cast<char*>(memory) + arena_detail::header_size;
+          block = new (memory) arena_detail::Block{m_block->next, begin, begin + size};
+          m_block->next = block;
+        }
+
+        m_passed += static_cast<std::size_t>(m_block->end - m_block->begin);
+        m_block = block;
+        m_current = block->begin;
+        m_end = block->end;
+        m_last = nullptr;
+
+        return true;
+      }
+
+      /// The caller supplied buffer, the head of the chained blocks
+      arena_detail::Block m_first;
+      /// The block memory is handed out from
+      arena_detail::Block* m_block;
+      /// The next free byte
+      char* m_current;
+      /// The end of the current block
+      char* m_end;
+      /// The bytes of the blocks before the current one
+      std::size_t m_passed = 0;
+      /// The minimum size of chained blocks, 0 for a fixed-capacity arena
+      std::size_t m_block_size;
+      /// The most recent allocation, the only one that can be extended
+      char* m_last = nullptr;
+  };
+
+  /**
+   * @brief Thread arena
+   * 
+   * A chained arena per thread for transient work like formatting.
+   * Use it through a FrameScope, so everything allocated is released
+   * when the scope ends.
+   * 
+   * @return The arena of the calling thread
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline MonotonicArena& thread_arena() noexcept 
+  {
+    thread_local MonotonicArena arena{MonotonicArena::default_block_size};
+    return arena;
+  }
+
+  /**
+   * @brief FrameScope
+   * 
+   * Marks an arena on construction and rewinds it on destruction, which
+   * releases everything allocated in the scope in constant time. Scopes
+   * nest like stack frames.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class FrameScope 
+  {
+    public:
+      /**
+       * @brief Constructor
+       * 
+       * Opens a frame on the arena of the calling thread.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline FrameScope() noexcept
+        : FrameScope(thread_arena()) 
+      {
+      }
+
+      /**
+       * @brief Constructor
+       * 
+       * Opens a frame on the given arena.
+       * 
+       * @param arena The arena
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit inline FrameScope(MonotonicArena& arena) noexcept
+        : m_arena(arena),
+          m_marker(arena.mark()) 
+      {
+      }
+
+      FrameScope(const FrameScope&) = delete;
+      FrameScope& operator=(const FrameScope&) = delete;
+
+      /**
+       * @brief Destructor
+       * 
+       * Releases everything allocated in the frame.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline ~FrameScope() 
+      {
+        m_arena.rewind(m_marker);
+      }
+
+      /**
+       * @brief Arena
+       * 
+       * @return The arena of the frame
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline MonotonicArena& arena() const noexcept 
+      {
+        return m_arena;
+      }
+
+    private:
+      /// The arena
+      MonotonicArena& m_arena;
+      /// The position of the arena when the frame was opened
+      MonotonicArena::Marker m_marker;
+  };
+
+  /**
+   * @brief ArenaResource
+   * 
+   * Adapts a MonotonicArena to std::pmr::memory_resource, so pmr
+   * containers and strings allocate from the arena. Deallocation is a
+   * no-op like in std::pmr::monotonic_buffer_resource. Requests the
+   * arena cannot serve go to the upstream resource, the default throws
+   * std::bad_alloc as the memory_resource contract requires.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class ArenaResource : public std::pmr::memory_resource 
+  {
+    public:
+      /**
+       * @brief Constructor
+       * 
+       * @param arena The arena to allocate from
+       * @param upstream The resource for requests the arena cannot serve
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit inline ArenaResource(MonotonicArena& arena, std::pmr::memory_resource* upstream = std::pmr::null_memory_resource()) noexcept
+        : m_arena(arena),
+          m_upstream(upstream) 
+      {
+      }
+
+      /**
+       * @brief Arena
+       * 
+       * @return The arena
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline MonotonicArena& arena() const noexcept 
+      {
+        return m_arena;
+      }
+
+    protected:
+      void* do_allocate(std::size_t bytes, std::size_t alignment) override 
+      {
+        void* p = m_arena.allocate(bytes, alignment);
+        return nullptr != p ? p : m_upstream->allocate(bytes, alignment);
+      }
+
+      void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override 
+      {
+        if ( !m_arena.owns(p) ) {
+          m_upstream->deallocate(p, bytes, alignment);
+        }
+      }
+
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override 
+      {
+        return this == &other;
+      }
+
+    private:
+      /// The arena
+      MonotonicArena& m_arena;
+      /// The resource for requests the arena cannot serve
+      std::pmr::memory_resource* m_upstream;
+  };
+}
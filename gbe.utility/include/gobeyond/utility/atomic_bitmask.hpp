@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/thread_slots.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief AtomicBitMask
+   * 
+   * A BitMask that may be changed by a control thread while any number
+   * of threads read it. Flags are changed with fetch_or and fetch_and,
+   * so concurrent changes of different flags never get lost. The mask
+   * occupies a cache line of its own, so it does not share a line with
+   * data written on the hot path.
+   * 
+   * Reads default to relaxed, a hot path check is a single load. Writes
+   * default to release and snapshot() to acquire, for flags that guard
+   * data published before they were enabled.
+   * 
+   * @tparam TEnum The flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum>
+  class alignas(cache_line_size) AtomicBitMask 
+  {
+    public:
+      using enum_type = TEnum;
+      using underlying_type = std::underlying_type_t<enum_type>;
+      /// The plain mask type
+      using mask_type = BitMask<TEnum>;
+
+      static_assert(std::atomic<underlying_type>::is_always_lock_free, "the underlying type of the flags has to be lock-free");
+
+      inline AtomicBitMask() noexcept
+        : m_value(static_cast<underlying_type>(enum_type()))
+      {}
+
+      explicit inline AtomicBitMask(const enum_type& value) noexcept
+        : m_value(static_cast<underlying_type>(value))
+      {}
+
+      explicit inline AtomicBitMask(const mask_type& value) noexcept
+        : m_value(static_cast<underlying_type>(value))
+      {}
+
+      AtomicBitMask(const AtomicBitMask&) = delete;
+      AtomicBitMask& operator=(const AtomicBitMask&) = delete;
+
+      /**
+       * @brief Enable
+       * 
+       * @param value The flags to enable
+       * @param order The memory order of the change
+       * 
+       * @return The mask before the change
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline mask_type enable(const enum_type& value, std::memory_order order = std::memory_order_release) noexcept 
+      {
+        return toMask(m_value.fetch_or(static_cast<underlying_type>(value), order));
+      }
+
+      /**
+       * @brief Disable
+       * 
+       * @param value The flags to disable
+       * @param order The memory order of the change
+       * 
+       * @return The mask before the change
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline mask_type disable(const enum_type& value, std::memory_order order = std::memory_order_release) noexcept 
+      {
+        return toMask(m_value.fetch_and(static_cast<underlying_type>(~static_cast<underlying_type>(value)), order));
+      }
+
+      /**
+       * @brief Is enabled
+       * 
+       * @param value The flags
+       * @param order The memory order of the load
+       * 
+       * @return true if all of the flags are enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool isEnabled(const enum_type& value, std::memory_order order = std::memory_order_relaxed) const noexcept 
+      {
+        return (m_value.load(order) & static_cast<underlying_type>(value)) == static_cast<underlying_type>(value);
+      }
+
+      /**
+       * @brief Is disabled
+       * 
+       * @param value The flags
+       * @param order The memory order of the load
+       * 
+       * @return true if none of the flags is enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool isDisabled(const enum_type& value, std::memory_order order = std::memory_order_relaxed) const noexcept 
+      {
+        return (m_value.load(order) & static_cast<underlying_type>(value)) == 0;
+      }
+
+      /**
+       * @brief Snapshot
+       * 
+       * @param order The memory order of the load
+       * 
+       * @return All flags, read at once
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline mask_type snapshot(std::memory_order order = std::memory_order_acquire) const noexcept 
+      {
+        return toMask(m_value.load(order));
+      }
+
+      /**
+       * @brief Store
+       * 
+       * Replaces all flags at once.
+       * 
+       * @param value The new mask
+       * @param order The memory order of the store
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void store(const mask_type& value, std::memory_order order = std::memory_order_release) noexcept 
+      {
+        m_value.store(static_cast<underlying_type>(value), order);
+      }
+
+      /**
+       * @brief Exchange
+       * 
+       * @param value The new mask
+       * @param order The memory order of the exchange
+       * 
+       * @return The mask before the change
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline mask_type exchange(const mask_type& value, std::memory_order order = std::memory_order_acq_rel) noexcept 
+      {
+        return toMask(m_value.exchange(static_cast<underlying_type>(value), order));
+      }
+
+      /**
+       * @brief Compare exchange
+       * 
+       * Replaces the whole mask if it still equals expected, e.g. to
+       * switch several flags that depend on each other at once.
+       * 
+       * @param expected The mask the change is based on, set to the current mask on failure
+       * @param desired The new mask
+       * @param success The memory order if the mask was replaced
+       * @param failure The memory order if the mask was changed in between
+       * 
+       * @return true if the mask was replaced
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool compare_exchange(mask_type& expected, const mask_type& desired,
+                                   std::memory_order success = std::memory_order_acq_rel,
+                                   std::memory_order failure = std::memory_order_acquire) noexcept 
+      {
+        underlying_type current = static_cast<underlying_type>(expected);
+        const bool replaced = m_value.compare_exchange_strong(current, static_cast<underlying_type>(desired), success, failure);
+
+        expected = toMask(current);
+        return replaced;
+      }
+
+      inline AtomicBitMask& operator=(const mask_type& value) noexcept 
+      {
+        store(value);
+        return *this;
+      }
+
+      inline AtomicBitMask& operator=(const typename mask_type::Enable& flag) noexcept 
+      {
+        enable(flag.value);
+        return *this;
+      }
+
+      inline AtomicBitMask& operator=(const typename mask_type::Disable& flag) noexcept 
+      {
+        disable(flag.value);
+        return *this;
+      }
+
+      friend inline bool operator==(const AtomicBitMask& lhs, const typename mask_type::Enabled& rhs) noexcept 
+      {
+        return lhs.isEnabled(rhs.value);
+      }
+
+      friend inline bool operator==(const AtomicBitMask& lhs, const typename mask_type::Disabled& rhs) noexcept 
+      {
+        return lhs.isDisabled(rhs.value);
+      }
+
+    private:
+      static inline mask_type toMask(underlying_type value) noexcept 
+      {
+        return mask_type(static_cast<enum_type>(value));
+      }
+
+      /// The flags
+      std::atomic<underlying_type> m_value;
+  };
+}
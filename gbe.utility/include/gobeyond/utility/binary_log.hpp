@@ -0,0 +1,1046 @@
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/deferred_format.hpp>
+#include <gobeyond/utility/version.hpp>
+
+namespace gobeyond::utility 
+{
+  /// The version of the binary log file format written by BinaryLogWriter
+  inline constexpr Version binary_log_version{0, 2, 0};
+
+  /**
+   * @brief BinaryLogRecordKind
+   * 
+   * The kinds of records in a binary log segment.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class BinaryLogRecordKind : std::uint8_t 
+  {
+    /// The definition of a format: id, argument count (one byte), argument types and text
+    Format = 1,
+    /// A deferred message: timestamp, route, format id and arguments
+    Deferred = 2,
+    /// A plain text message: timestamp, route and text
+    Text = 3
+  };
+
+  /**
+   * @brief BinaryLogHeader
+   * 
+   * The header at the start of every segment file. All numbers in a
+   * segment are stored in the byte order of the writer; variable length
+   * fields use LEB128 varints.
+   * 
+   * A record is a varint length of the record body, a kind byte and the
+   * body. Timestamps are nanoseconds since the epoch, stored as the
+   * difference to the previous message of the segment. Every segment
+   * defines the formats it uses, so segments decode independently.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct BinaryLogHeader 
+  {
+    /// "GBE.BLOG"
+    char magic[8];
+    /// The file format version
+    std::uint8_t major;
+    std::uint8_t minor;
+    std::uint8_t patch;
+    /// 1 on little endian writers
+    std::uint8_t little_endian;
+    /// sizeof(BinaryLogHeader)
+    std::uint32_t header_size;
+    /// The index of the segment
+    std::uint32_t segment;
+    /// sizeof(long double) of the writer, %Lf arguments are stored natively. 0 in segments of older writers
+    std::uint8_t long_double_size;
+    std::uint8_t reserved[3];
+    /// The creation time in nanoseconds since the epoch
+    std::uint64_t created;
+  };
+
+  static_assert(sizeof(BinaryLogHeader) == 32, "BinaryLogHeader must not contain padding");
+
+  namespace binary_log_detail 
+  {
+    inline constexpr char magic[8] = {'G', 'B', 'E', '.', 'B', 'L', 'O', 'G'};
+
+    /// The most bytes a varint of a 64 bit value takes
+    inline constexpr std::size_t max_varint_length = 10;
+
+    /// The most arguments of a format, the definition stores the count in one byte
+    inline constexpr std::size_t max_arguments = UINT8_MAX;
+
+    inline bool isLittleEndian() noexcept 
+    {
+      const std::uint16_t probe = 1;
+      std::uint8_t first = 0;
+      std::memcpy(&first, &probe, 1);
+      return 1 == first;
+    }
+
+    inline std::uint64_t now() noexcept 
+    {
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    inline unsigned char* writeVarint(unsigned char* p, std::uint64_t value) noexcept 
+    {
+      while ( value >= 0x80 ) {
+        *p++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+      }
+
+      *p++ = static_cast<unsigned char>(value);
+      return p;
+    }
+
+    inline bool readVarint(const unsigned char*& p, const unsigned char* last, std::uint64_t& value) noexcept 
+    {
+      value = 0;
+
+      for ( unsigned shift = 0; shift < 64 && p < last; shift += 7 ) {
+        const unsigned char byte = *p++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+        if ( 0 == (byte & 0x80) ) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    constexpr std::uint64_t zigzag(std::int64_t value) noexcept 
+    {
+      return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    constexpr std::int64_t unzigzag(std::uint64_t value) noexcept 
+    {
+      return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    /// Reads an integer of the given size from native record bytes
+    inline std::uint64_t loadInteger(const unsigned char* p, std::size_t size, bool is_signed) noexcept 
+    {
+      switch ( size ) {
+        case 1: {
+          std::uint8_t v = 0;
+          std::memcpy(&v, p, 1);
+          return is_signed ? static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int8_t>(v))) : v;
+        }
+        case 2: {
+          std::uint16_t v = 0;
+          std::memcpy(&v, p, 2);
+          return is_signed ? static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int16_t>(v))) : v;
+        }
+        case 4: {
+          std::uint32_t v = 0;
+          std::memcpy(&v, p, 4);
+          return is_signed ? static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int32_t>(v))) : v;
+        }
+        default: {
+          std::uint64_t v = 0;
+          std::memcpy(&v, p, 8);
+          return v;
+        }
+      }
+    }
+
+    /// Stores the low size bytes of an integer as native record bytes
+    inline void storeInteger(unsigned char* p, std::size_t size, std::uint64_t value) noexcept 
+    {
+      switch ( size ) {
+        case 1: {
+          const std::uint8_t v = static_cast<std::uint8_t>(value);
+          std::memcpy(p, &v, 1);
+          break;
+        }
+        case 2: {
+          const std::uint16_t v = static_cast<std::uint16_t>(value);
+          std::memcpy(p, &v, 2);
+          break;
+        }
+        case 4: {
+          const std::uint32_t v = static_cast<std::uint32_t>(value);
+          std::memcpy(p, &v, 4);
+          break;
+        }
+        default:
+          std::memcpy(p, &value, 8);
+          break;
+      }
+    }
+
+    /**
+     * Converts native DeferredRecord argument bytes into the compact file
+     * encoding: integers and pointers become varints, strings get a
+     * varint length. Returns the end of the output, nullptr if the
+     * input does not match the types. The output needs room for
+     * size + arguments * max_varint_length bytes.
+     */
+    inline unsigned char* compactArguments(const DeferredType* types, std::size_t arguments,
+      const unsigned char* data, std::size_t size, unsigned char* out) noexcept 
+    {
+      const unsigned char* last = data + size;
+
+      for ( std::size_t i = 0; i < arguments; ++i ) {
+        const DeferredType type = types[i];
+
+        if ( DeferredType::String == type ) {
+          std::uint16_t length = 0;
+
+          if ( static_cast<std::size_t>(last - data) < sizeof(length) ) {
+            return nullptr;
+          }
+
+          std::memcpy(&length, data, sizeof(length));
+          data += sizeof(length);
+
+          if ( static_cast<std::size_t>(last - data) < length ) {
+            return nullptr;
+          }
+
+          out = writeVarint(out, length);
+          std::memcpy(out, data, length);
+          out += length;
+          data += length;
+          continue;
+        }
+
+        const std::size_t native = deferred_detail::nativeSize(type);
+
+        if ( static_cast<std::size_t>(last - data) < native ) {
+          return nullptr;
+        }
+
+        if ( DeferredType::Float == type || DeferredType::Double == type || DeferredType::LongDouble == type ) {
+          std::memcpy(out, data, native);
+          out += native;
+        } else if ( deferred_detail::isSigned(type) ) {
+          out = writeVarint(out, zigzag(static_cast<std::int64_t>(loadInteger(data, native, true))));
+        } else {
+          out = writeVarint(out, loadInteger(data, native, false));
+        }
+
+        data += native;
+      }
+
+      return out;
+    }
+
+    /// The inverse of compactArguments, appends the native bytes to out
+    inline bool expandArguments(const DeferredType* types, std::size_t arguments,
+      const unsigned char* data, const unsigned char* last, std::vector<unsigned char>& out) 
+    {
+      for ( std::size_t i = 0; i < arguments; ++i ) {
+        const DeferredType type = types[i];
+        const std::size_t offset = out.size();
+
+        if ( DeferredType::String == type ) {
+          std::uint64_t length = 0;
+
+          if ( !readVarint(data, last, length) || length > UINT16_MAX || static_cast<std::uint64_t>(last - data) < length ) {
+            return false;
+          }
+
+          const std::uint16_t stored = static_cast<std::uint16_t>(length);
+          out.resize(offset + sizeof(stored) + stored);
+          std::memcpy(out.data() + offset, &stored, sizeof(stored));
+          std::memcpy(out.data() + offset + sizeof(stored), data, stored);
+          data += stored;
+          continue;
+        }
+
+        const std::size_t native = deferred_detail::nativeSize(type);
+        out.resize(offset + native);
+
+        if ( DeferredType::Float == type || DeferredType::Double == type || DeferredType::LongDouble == type ) {
+          if ( static_cast<std::size_t>(last - data) < native ) {
+            return false;
+          }
+
+          std::memcpy(out.data() + offset, data, native);
+          data += native;
+          continue;
+        }
+
+        std::uint64_t value = 0;
+
+        if ( !readVarint(data, last, value) ) {
+          return false;
+        }
+
+        storeInteger(out.data() + offset, native, deferred_detail::isSigned(type) ? static_cast<std::uint64_t>(unzigzag(value)) : value);
+      }
+
+      return data == last;
+    }
+  }
+
+#if defined(__unix__) || defined(__APPLE__)
+  /**
+   * @brief BinaryLogWriter
+   * 
+   * Appends log records to memory-mapped segment files named
+   * <base>.<index>.gblog. A segment is allocated in full when it is
+   * opened, so appending a record is a copy into the mapping without a
+   * system call; only rotating to the next segment talks to the kernel.
+   * Closed segments are cut to their used size.
+   * 
+   * The writer is not thread safe, it is meant to be driven by a single
+   * sink worker.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class BinaryLogWriter 
+  {
+    public:
+      /**
+       * @brief Statistics
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      struct Statistics 
+      {
+        /// The number of appended messages
+        std::uint64_t records = 0;
+        /// The number of bytes written including headers and format definitions
+        std::uint64_t bytes = 0;
+        /// The number of segment changes
+        std::uint64_t rotations = 0;
+        /// The number of messages that could not be written
+        std::uint64_t dropped = 0;
+      };
+
+      /**
+       * @brief Constructor
+       * 
+       * Opens the segment after the highest existing one of the base path.
+       * Check ok() to find out whether that worked.
+       * 
+       * @param base The path of the segments without index and extension
+       * @param segment_size The size of a segment file in bytes
+       * @param max_segments The number of segments kept on disk, 0 keeps all
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit BinaryLogWriter(std::string base, std::size_t segment_size = 4 * 1024 * 1024, std::uint32_t max_segments = 8)
+        : m_base(std::move(base)),
+          m_segment_size(segment_size < 4096 ? 4096 : segment_size),
+          m_max_segments(max_segments) 
+      {
+        m_ok = openSegment(nextIndex());
+      }
+
+      BinaryLogWriter(const BinaryLogWriter&) = delete;
+      BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+      ~BinaryLogWriter() 
+      {
+        close();
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a deferred message. The format is defined in the segment
+       * on its first use, formats with more than 255 arguments are rejected.
+       * 
+       * @param route The sinks the message was meant for
+       * @param record The captured message
+       * @param timestamp Nanoseconds since the epoch
+       * 
+       * @return false if the writer is closed, the format is rejected or the message does not fit into a segment
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TEnum, std::size_t TSize>
+      bool append(const BitMask<TEnum>& route, const DeferredRecord<TSize>& record, std::uint64_t timestamp = binary_log_detail::now()) 
+      {
+        const DeferredFormat* format = DeferredFormatRegistry::instance().find(record.id());
+
+        if ( nullptr == format ) {
+          ++m_statistics.dropped;
+          return false;
+        }
+
+        const std::size_t body_limit = 3 * binary_log_detail::max_varint_length + TSize + format->arguments * binary_log_detail::max_varint_length;
+
+        if ( !ensureDefined(*format, body_limit) ) {
+          ++m_statistics.dropped;
+          return false;
+        }
+
+        unsigned char* body = beginRecord(BinaryLogRecordKind::Deferred, body_limit);
+
+        if ( nullptr == body ) {
+          return false;
+        }
+
+        unsigned char* p = writeMessageHeader(body, route, timestamp);
+        p = binary_log_detail::writeVarint(p, format->id);
+        p = binary_log_detail::compactArguments(format->types, format->arguments, record.data(), record.size(), p);
+
+        if ( nullptr == p ) {
+          ++m_statistics.dropped;
+          return false;
+        }
+
+        endRecord(body, p);
+        ++m_statistics.records;
+
+        return true;
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a plain text message.
+       * 
+       * @param route The sinks the message was meant for
+       * @param text The text
+       * @param timestamp Nanoseconds since the epoch
+       * 
+       * @return false if the writer is closed or the message does not fit into a segment
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TEnum>
+      bool append(const BitMask<TEnum>& route, std::string_view text, std::uint64_t timestamp = binary_log_detail::now()) 
+      {
+        unsigned char* body = beginRecord(BinaryLogRecordKind::Text, 2 * binary_log_detail::max_varint_length + text.size());
+
+        if ( nullptr == body ) {
+          return false;
+        }
+
+        unsigned char* p = writeMessageHeader(body, route, timestamp);
+        std::memcpy(p, text.data(), text.size());
+
+        endRecord(body, p + text.size());
+        ++m_statistics.records;
+
+        return true;
+      }
+
+      /**
+       * @brief Flush
+       * 
+       * Schedules the written part of the segment for writing to disk
+       * without waiting for it.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void flush() noexcept 
+      {
+        if ( nullptr != m_mapping ) {
+          ::msync(m_mapping, m_used, MS_ASYNC);
+        }
+      }
+
+      /**
+       * @brief Close
+       * 
+       * Unmaps the segment and cuts the file to its used size.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void close() noexcept 
+      {
+        if ( nullptr != m_mapping ) {
+          ::munmap(m_mapping, m_segment_size);
+          m_mapping = nullptr;
+        }
+
+        if ( m_fd >= 0 ) {
+          [[maybe_unused]] const int result = ::ftruncate(m_fd, static_cast<::off_t>(m_used));
+          ::close(m_fd);
+          m_fd = -1;
+        }
+      }
+
+      /// true if a segment is open
+      [[nodiscard]] inline bool is_open() const noexcept 
+      {
+        return nullptr != m_mapping;
+      }
+
+      /// false if opening a segment failed, the writer stays closed then
+      [[nodiscard]] inline bool ok() const noexcept 
+      {
+        return m_ok;
+      }
+
+      /// The index of the current segment
+      [[nodiscard]] inline std::uint32_t segment() const noexcept 
+      {
+        return m_segment;
+      }
+
+      /// The counters of the writer
+      [[nodiscard]] inline const Statistics& statistics() const noexcept 
+      {
+        return m_statistics;
+      }
+
+      /**
+       * @brief Segment path
+       * 
+       * @param base The path of the segments without index and extension
+       * @param index The segment index
+       * 
+       * @return The path of the segment file
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] static std::string segment_path(const std::string& base, std::uint32_t index) 
+      {
+        char suffix[24];
+        std::snprintf(suffix, sizeof(suffix), ".%06u.gblog", static_cast<unsigned>(index));
+        return base + suffix;
+      }
+
+    private:
+      /// The index after the highest existing segment of the base path
+      std::uint32_t nextIndex() const 
+      {
+        const std::filesystem::path base(m_base);
+        const std::string prefix = base.filename().string() + ".";
+        const std::string extension = ".gblog";
+        std::error_code error;
+        std::uint32_t next = 0;
+
+        for ( std::filesystem::directory_iterator it(base.has_parent_path() ? base.parent_path() : std::filesystem::path("."), error), last; !error && it != last; it.increment(error) ) {
+          const std::string name = it->path().filename().string();
+
+          if ( name.size() <= prefix.size() + extension.size() || 0 != name.compare(0, prefix.size(), prefix)
+            || 0 != name.compare(name.size() - extension.size(), extension.size(), extension) ) {
+            continue;
+          }
+
+          const std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+          std::uint32_t index = 0;
+          const auto result = std::from_chars(digits.data(), digits.data() + digits.size(), index);
+
+          if ( result.ec == std::errc() && result.ptr == digits.data() + digits.size() && index + 1 > next ) {
+            next = index + 1;
+          }
+        }
+
+        return next;
+      }
+
+      bool openSegment(std::uint32_t index) 
+      {
+        m_segment = index;
+        m_used = 0;
+        m_previous_timestamp = 0;
+        m_defined.clear();
+
+        m_fd = ::open(segment_path(m_base, index).c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if ( m_fd < 0 ) {
+          return false;
+        }
+
+#if defined(__linux__)
+        // Reserves the blocks up front, so appending never runs into a full disk inside the mapping
+        const bool allocated = 0 == ::posix_fallocate(m_fd, 0, static_cast<::off_t>(m_segment_size))
+          || 0 == ::ftruncate(m_fd, static_cast<::off_t>(m_segment_size));
+#else
+        const bool allocated = 0 == ::ftruncate(m_fd, static_cast<::off_t>(m_segment_size));
+#endif
+        void* mapping = allocated ? ::mmap(nullptr, m_segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0) : MAP_FAILED;
+
+        if ( MAP_FAILED == mapping ) {
+          ::close(m_fd);
+          m_fd = -1;
+          return false;
+        }
+
+        m_mapping = static_cast<unsigned char*>(mapping);
+
+        BinaryLogHeader header{};
+        std::memcpy(header.magic, binary_log_detail::magic, sizeof(header.magic));
+        header.major = binary_log_version.major;
+        header.minor = binary_log_version.minor;
+        header.patch = binary_log_version.patch;
+        header.little_endian = binary_log_detail::isLittleEndian() ? 1 : 0;
+        header.long_double_size = static_cast<std::uint8_t>(sizeof(long double));
+        header.header_size = sizeof(BinaryLogHeader);
+        header.segment = index;
+        header.created = binary_log_detail::now();
+
+        std::memcpy(m_mapping, &header, sizeof(header));
+        m_used = sizeof(header);
+        m_statistics.bytes += sizeof(header);
+
+        if ( m_max_segments > 0 && index >= m_max_segments ) {
+          ::unlink(segment_path(m_base, index - m_max_segments).c_str());
+        }
+
+        return true;
+      }
+
+      bool rotate() 
+      {
+        close();
+        ++m_statistics.rotations;
+        m_ok = openSegment(m_segment + 1);
+        return m_ok;
+      }
+
+      /// Makes sure the format is defined in the current segment and the following message fits behind it
+      bool ensureDefined(const DeferredFormat& format, std::size_t body_limit) 
+      {
+        const std::size_t definition_limit = 2 * binary_log_detail::max_varint_length + format.arguments + format.text.size() + 1;
+
+        if ( !is_open() || format.arguments > binary_log_detail::max_arguments ) {
+          return false;
+        }
+
+        if ( sizeof(BinaryLogHeader) + definition_limit + 1 + binary_log_detail::max_varint_length + body_limit > m_segment_size ) {
+          return false;
+        }
+
+        if ( m_used + definition_limit + 1 + binary_log_detail::max_varint_length + body_limit + 1 + binary_log_detail::max_varint_length > m_segment_size ) {
+          if ( !rotate() ) {
+            return false;
+          }
+        }
+
+        if ( format.id < m_defined.size() && m_defined[format.id] ) {
+          return true;
+        }
+
+        unsigned char* body = beginRecord(BinaryLogRecordKind::Format, definition_limit);
+        unsigned char* p = binary_log_detail::writeVarint(body, format.id);
+
+        *p++ = static_cast<unsigned char>(format.arguments);
+
+        for ( std::size_t i = 0; i < format.arguments; ++i ) {
+          *p++ = static_cast<unsigned char>(format.types[i]);
+        }
+
+        std::memcpy(p, format.text.data(), format.text.size());
+        p += format.text.size();
+
+        if ( format.id >= m_defined.size() ) {
+          m_defined.resize(format.id + 1, false);
+        }
+
+        m_defined[format.id] = true;
+
+        endRecord(body, p);
+
+        return true;
+      }
+
+      /**
+       * Reserves room for a record with a body of at most body_limit bytes
+       * and writes its kind. The length is written by endRecord() in front
+       * of the kind, at most max_varint_length bytes are kept for it.
+       */
+      unsigned char* beginRecord(BinaryLogRecordKind kind, std::size_t body_limit) 
+      {
+        const std::size_t needed = binary_log_detail::max_varint_length + 1 + body_limit;
+
+        if ( sizeof(BinaryLogHeader) + needed > m_segment_size ) {
+          ++m_statistics.dropped;
+          return nullptr;
+        }
+
+        if ( !is_open() ) {
+          ++m_statistics.dropped;
+          return nullptr;
+        }
+
+        if ( m_used + needed > m_segment_size ) {
+          if ( !rotate() ) {
+            ++m_statistics.dropped;
+            return nullptr;
+          }
+        }
+
+        m_record_kind = kind;
+        return m_mapping + m_used + binary_log_detail::max_varint_length + 1;
+      }
+
+      /// Moves the body of the record behind its length and kind
+      void endRecord(unsigned char* body, unsigned char* end) noexcept 
+      {
+        const std::size_t length = static_cast<std::size_t>(end - body);
+        unsigned char prefix[binary_log_detail::max_varint_length + 1];
+        unsigned char* p = binary_log_detail::writeVarint(prefix, length);
+
+        *p++ = static_cast<unsigned char>(m_record_kind);
+
+        const std::size_t prefix_length = static_cast<std::size_t>(p - prefix);
+        unsigned char* record = m_mapping + m_used;
+
+        std::memmove(record + prefix_length, body, length);
+        std::memcpy(record, prefix, prefix_length);
+        // Clears the end of the moved body, readers of an unclosed segment stop at the first zero length
+        std::memset(record + prefix_length + length, 0, binary_log_detail::max_varint_length + 1 - prefix_length);
+
+        m_used += prefix_length + length;
+        m_statistics.bytes += prefix_length + length;
+      }
+
+      template <typename TEnum>
+      unsigned char* writeMessageHeader(unsigned char* p, const BitMask<TEnum>& route, std::uint64_t timestamp) noexcept 
+      {
+        using underlying_type = typename BitMask<TEnum>::underlying_type;
+
+        p = binary_log_detail::writeVarint(p, binary_log_detail::zigzag(static_cast<std::int64_t>(timestamp - m_previous_timestamp)));
+        p = binary_log_detail::writeVarint(p, static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<underlying_type>>(static_cast<underlying_type>(route))));
+        m_previous_timestamp = timestamp;
+
+        return p;
+      }
+
+      /// The path of the segments without index and extension
+      std::string m_base;
+      /// The size of a segment file
+      std::size_t m_segment_size;
+      /// The number of segments kept on disk
+      std::uint32_t m_max_segments;
+      /// The current segment
+      std::uint32_t m_segment = 0;
+      int m_fd = -1;
+      unsigned char* m_mapping = nullptr;
+      /// The number of written bytes of the segment
+      std::size_t m_used = 0;
+      /// The timestamp of the previous message of the segment
+      std::uint64_t m_previous_timestamp = 0;
+      /// The formats defined in the current segment, indexed by id
+      std::vector<bool> m_defined;
+      /// false once opening a segment failed
+      bool m_ok = false;
+      /// The kind of the record between beginRecord() and endRecord()
+      BinaryLogRecordKind m_record_kind = BinaryLogRecordKind::Text;
+      Statistics m_statistics;
+  };
+#endif
+
+  /**
+   * @brief BinaryLogReader
+   * 
+   * Reads a segment written by BinaryLogWriter and renders its messages.
+   * Only needs the segment itself, the formats are rendered from their
+   * definitions in the file with render_deferred().
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class BinaryLogReader 
+  {
+    public:
+      /**
+       * @brief Entry
+       * 
+       * A decoded message, valid until the next call to next().
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      struct Entry 
+      {
+        /// Deferred or Text
+        BinaryLogRecordKind kind = BinaryLogRecordKind::Text;
+        /// Nanoseconds since the epoch
+        std::uint64_t timestamp = 0;
+        /// The raw value of the route BitMask
+        std::uint64_t route = 0;
+        /// The rendered text
+        std::string_view text;
+      };
+
+      /**
+       * @brief Open
+       * 
+       * Reads a segment and checks its header.
+       * 
+       * @param path The segment file
+       * 
+       * @return false if the file cannot be read, is no binary log or
+       * was written with an incompatible version, byte order or long
+       * double size
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      bool open(const std::string& path) 
+      {
+        m_data.clear();
+        m_formats.clear();
+        m_position = 0;
+        m_corrupt = false;
+        m_timestamp = 0;
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+
+        if ( nullptr == file ) {
+          return false;
+        }
+
+        unsigned char chunk[65536];
+        std::size_t read = 0;
+
+        while ( (read = std::fread(chunk, 1, sizeof(chunk), file)) > 0 ) {
+          m_data.insert(m_data.end(), chunk, chunk + read);
+        }
+
+        std::fclose(file);
+
+        if ( m_data.size() < sizeof(BinaryLogHeader) ) {
+          return false;
+        }
+
+        std::memcpy(&m_header, m_data.data(), sizeof(m_header));
+
+        if ( 0 != std::memcmp(m_header.magic, binary_log_detail::magic, sizeof(m_header.magic)) || m_header.header_size < sizeof(BinaryLogHeader)
+          || m_header.header_size > m_data.size() || (1 == m_header.little_endian) != binary_log_detail::isLittleEndian() ) {
+          return false;
+        }
+
+        // long double differs between architectures (16 bytes on x86-64, 8 on AArch64), its arguments would decode wrongly
+        if ( 0 != m_header.long_double_size && sizeof(long double) != m_header.long_double_size ) {
+          return false;
+        }
+
+        // A new major version may change the meaning of records, a new minor version only adds record kinds
+        if ( m_header.major != binary_log_version.major ) {
+          return false;
+        }
+
+        m_position = m_header.header_size;
+        return true;
+      }
+
+      /**
+       * @brief Next
+       * 
+       * Decodes the next message.
+       * 
+       * @param entry Receives the message
+       * 
+       * @return false at the end of the segment or if the rest of the
+       * segment is corrupt (see corrupt())
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      bool next(Entry& entry) 
+      {
+        while ( !m_corrupt && m_position < m_data.size() ) {
+          const unsigned char* p = m_data.data() + m_position;
+          const unsigned char* end = m_data.data() + m_data.size();
+          std::uint64_t length = 0;
+
+          // A zero length marks the unused, pre-allocated rest of a segment that was not closed
+          if ( 0 == *p ) {
+            return false;
+          }
+
+          if ( !binary_log_detail::readVarint(p, end, length) || p >= end || static_cast<std::uint64_t>(end - p - 1) < length ) {
+            m_corrupt = true;
+            return false;
+          }
+
+          const BinaryLogRecordKind kind = static_cast<BinaryLogRecordKind>(*p++);
+          const unsigned char* body = p;
+          const unsigned char* body_end = p + length;
+
+          m_position = static_cast<std::size_t>(body_end - m_data.data());
+
+          if ( BinaryLogRecordKind::Format == kind ) {
+            if ( !readFormat(body, body_end) ) {
+              m_corrupt = true;
+            }
+          } else if ( BinaryLogRecordKind::Deferred == kind || BinaryLogRecordKind::Text == kind ) {
+            if ( !readMessage(kind, body, body_end, entry) ) {
+              m_corrupt = true;
+              return false;
+            }
+
+            return true;
+          }
+          // Unknown kinds of newer minor versions are skipped
+        }
+
+        return false;
+      }
+
+      /// The header of the segment
+      [[nodiscard]] inline const BinaryLogHeader& header() const noexcept 
+      {
+        return m_header;
+      }
+
+      /// The file format version of the segment
+      [[nodiscard]] inline Version version() const noexcept 
+      {
+        return Version{m_header.major, m_header.minor, m_header.patch};
+      }
+
+      /// true if next() stopped at a record it could not decode
+      [[nodiscard]] inline bool corrupt() const noexcept 
+      {
+        return m_corrupt;
+      }
+
+    private:
+      struct Format 
+      {
+        std::string text;
+        std::vector<DeferredType> types;
+      };
+
+      bool readFormat(const unsigned char* p, const unsigned char* end) 
+      {
+        std::uint64_t id = 0;
+
+        if ( !binary_log_detail::readVarint(p, end, id) || p >= end ) {
+          return false;
+        }
+
+        const std::size_t arguments = *p++;
+
+        if ( static_cast<std::size_t>(end - p) < arguments ) {
+          return false;
+        }
+
+        Format& format = m_formats[id];
+        format.types.clear();
+
+        for ( std::size_t i = 0; i < arguments; ++i ) {
+          const unsigned char type = *p++;
+
+          if ( type > static_cast<unsigned char>(DeferredType::String) ) {
+            return false;
+          }
+
+          format.types.push_back(static_cast<DeferredType>(type));
+        }
+
+        format.text.assign(reinterpret_cast<const char*>(p), static_cast<std::size_t>(end - p));
+        return true;
+      }
+
+      bool readMessage(BinaryLogRecordKind kind, const unsigned char* p, const unsigned char* end, Entry& entry) 
+      {
+        std::uint64_t delta = 0;
+        std::uint64_t route = 0;
+
+        if ( !binary_log_detail::readVarint(p, end, delta) || !binary_log_detail::readVarint(p, end, route) ) {
+          return false;
+        }
+
+        m_timestamp += static_cast<std::uint64_t>(binary_log_detail::unzigzag(delta));
+
+        entry.kind = kind;
+        entry.timestamp = m_timestamp;
+        entry.route = route;
+
+        if ( BinaryLogRecordKind::Text == kind ) {
+          entry.text = std::string_view(reinterpret_cast<const char*>(p), static_cast<std::size_t>(end - p));
+          return true;
+        }
+
+        std::uint64_t id = 0;
+
+        if ( !binary_log_detail::readVarint(p, end, id) ) {
+          return false;
+        }
+
+        const auto found = m_formats.find(id);
+
+        if ( m_formats.end() == found ) {
+          return false;
+        }
+
+        const Format& format = found->second;
+        m_arguments.clear();
+
+        if ( !binary_log_detail::expandArguments(format.types.data(), format.types.size(), p, end, m_arguments) ) {
+          return false;
+        }
+
+        m_text.resize(m_text.capacity() < 256 ? 256 : m_text.capacity());
+
+        for ( ;; ) {
+          const std::size_t length = render_deferred(format.text, format.types.data(), format.types.size(),
+            m_arguments.data(), m_arguments.size(), m_text.data(), m_text.size());
+
+          if ( length < m_text.size() ) {
+            entry.text = std::string_view(m_text.data(), length);
+            return true;
+          }
+
+          m_text.resize(length + 1);
+        }
+      }
+
+      /// The segment
+      std::vector<unsigned char> m_data;
+      BinaryLogHeader m_header{};
+      /// The read position
+      std::size_t m_position = 0;
+      bool m_corrupt = false;
+      /// The timestamp of the previous message
+      std::uint64_t m_timestamp = 0;
+      /// The formats defined so far, by id
+      std::unordered_map<std::uint64_t, Format> m_formats;
+      /// Scratch space for the native argument bytes and the rendered text
+      std::vector<unsigned char> m_arguments;
+      std::string m_text;
+  };
+}
@@ -0,0 +1,793 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/bits.hpp>
+#include <gobeyond/utility/wide_bitmask.hpp>
+
+namespace gobeyond::utility 
+{
+  namespace roaring_detail 
+  {
+    using word_type = std::uint64_t;
+    using Op = wide_bitmask_detail::Op;
+
+    /// The words of a bitmap container, one bit per value of the low 16 bits
+    inline constexpr std::size_t bitmap_words = 1024;
+    /// Array containers hold at most this many values, more take less space as a bitmap
+    inline constexpr std::size_t array_limit = 4096;
+
+    enum class ContainerType : std::uint8_t 
+    {
+      /// Sorted values
+      Array,
+      /// One bit per value
+      Bitmap,
+      /// Sorted pairs of the first and last value of each run
+      Run
+    };
+
+    /// The values of a record id range of 65536 ids that share the high 16 bits
+    struct Container 
+    {
+      std::uint16_t key = 0;
+      ContainerType type = ContainerType::Array;
+      std::uint32_t cardinality = 0;
+      /// The values of an array, the run boundaries of a run container
+      std::vector<std::uint16_t> values;
+      /// The words of a bitmap container
+      std::vector<word_type> words;
+
+      bool contains(std::uint16_t value) const noexcept 
+      {
+        switch ( type ) {
+          case ContainerType::Array:
+            return std::binary_search(values.begin(), values.end(), value);
+          case ContainerType::Bitmap:
+            return 0 != ((words[value / 64] >> (value % 64)) & 1);
+          default: {
+            // The last run that starts at or before value
+            std::size_t low = 0;
+            std::size_t high = values.size() / 2;
+
+            while ( low < high ) {
+              const std::size_t middle = (low + high) / 2;
+
+              if ( values[2 * middle] <= value ) {
+                low = middle + 1;
+              } else {
+                high = middle;
+              }
+            }
+
+            return low > 0 && value <= values[2 * (low - 1) + 1];
+          }
+        }
+      }
+
+      void add(std::uint16_t value) 
+      {
+        if ( ContainerType::Run == type ) {
+          // Appending in order extends or follows the last run
+          if ( values.back() + 1u == value ) {
+            values.back() = value;
+            ++cardinality;
+            return;
+          }
+
+          if ( values.back() < value ) {
+            values.push_back(value);
+            values.push_back(value);
+            ++cardinality;
+            return;
+          }
+
+          if ( contains(value) ) {
+            return;
+          }
+
+          if ( cardinality < array_limit ) {
+            toArray();
+          } else {
+            toBitmap();
+          }
+        }
+
+        if ( ContainerType::Bitmap == type ) {
+          word_type& word = words[value / 64];
+          const word_type bit = word_type{1} << (value % 64);
+
+          cardinality += 0 == (word & bit) ? 1 : 0;
+          word |= bit;
+          return;
+        }
+
+        // Records are appended in order, so the value usually goes to the end
+        if ( values.empty() || values.back() < value ) {
+          values.push_back(value);
+        } else {
+          const auto position = std::lower_bound(values.begin(), values.end(), value);
+
+          if ( *position == value ) {
+            return;
+          }
+
+          values.insert(position, value);
+        }
+
+        if ( ++cardinality > array_limit ) {
+          toBitmap();
+        }
+      }
+
+      template <typename TFunction>
+      void forEach(std::uint32_t high, TFunction& function) const 
+      {
+        switch ( type ) {
+          case ContainerType::Array:
+            for ( std::uint16_t value : values ) {
+              function(high | value);
+            }
+            break;
+          case ContainerType::Bitmap:
+            for ( std::size_t i = 0; i < bitmap_words; ++i ) {
+              for ( word_type word = words[i]; 0 != word; word &= word - 1 ) {
+                function(high | static_cast<std::uint32_t>(i * 64 + static_cast<std::size_t>(countr_zero(word))));
+              }
+            }
+            break;
+          default:
+            for ( std::size_t r = 0; r < values.size(); r += 2 ) {
+              for ( std::uint32_t value = values[r]; value <= values[r + 1]; ++value ) {
+                function(high | value);
+              }
+            }
+            break;
+        }
+      }
+
+      void toBitmap() 
+      {
+        std::vector<word_type> bitmap(bitmap_words, 0);
+
+        if ( ContainerType::Array == type ) {
+          for ( std::uint16_t value : values ) {
+            bitmap[value / 64] |= word_type{1} << (value % 64);
+          }
+        } else if ( ContainerType::Run == type ) {
+          for ( std::size_t r = 0; r < values.size(); r += 2 ) {
+            setRange(bitmap.data(), values[r], values[r + 1]);
+          }
+        } else {
+          return;
+        }
+
+        words = std::move(bitmap);
+        values = std::vector<std::uint16_t>();
+        type = ContainerType::Bitmap;
+      }
+
+      /// Converts runs into an array, they have to hold at most array_limit values
+      void toArray() 
+      {
+        std::vector<std::uint16_t> array;
+        array.reserve(cardinality);
+
+        for ( std::size_t r = 0; r < values.size(); r += 2 ) {
+          for ( std::uint32_t value = values[r]; value <= values[r + 1]; ++value ) {
+            array.push_back(static_cast<std::uint16_t>(value));
+          }
+        }
+
+        values = std::move(array);
+        type = ContainerType::Array;
+      }
+
+      /// Converts a bitmap with few values into an array
+      void toArrayIfSparse() 
+      {
+        if ( ContainerType::Bitmap != type || cardinality > array_limit ) {
+          return;
+        }
+
+        std::vector<std::uint16_t> array;
+        array.reserve(cardinality);
+
+        for ( std::size_t i = 0; i < bitmap_words; ++i ) {
+          for ( word_type word = words[i]; 0 != word; word &= word - 1 ) {
+            array.push_back(static_cast<std::uint16_t>(i * 64 + static_cast<std::size_t>(countr_zero(word))));
+          }
+        }
+
+        values = std::move(array);
+        words = std::vector<word_type>();
+        type = ContainerType::Array;
+      }
+
+      /// Converts to runs if they take less space than the current representation
+      void toRunIfSmaller() 
+      {
+        if ( ContainerType::Run == type ) {
+          return;
+        }
+
+        std::vector<std::uint16_t> runs;
+        const auto extend = [&runs](std::uint32_t value) {
+          if ( !runs.empty() && runs.back() + 1u == value ) {
+            runs.back() = static_cast<std::uint16_t>(value);
+          } else {
+            runs.push_back(static_cast<std::uint16_t>(value));
+            runs.push_back(static_cast<std::uint16_t>(value));
+          }
+        };
+
+        forEach(0, extend);
+
+        if ( runs.size() * sizeof(std::uint16_t) < memory() ) {
+          runs.shrink_to_fit();
+          values = std::move(runs);
+          words = std::vector<word_type>();
+          type = ContainerType::Run;
+        }
+      }
+
+      /// The bytes used by the values
+      std::size_t memory() const noexcept 
+      {
+        return ContainerType::Bitmap == type ? bitmap_words * sizeof(word_type) : values.size() * sizeof(std::uint16_t);
+      }
+
+      static void setRange(word_type* bitmap, std::uint32_t first, std::uint32_t last) noexcept 
+      {
+        for ( std::uint32_t value = first; value <= last; ) {
+          if ( 0 == value % 64 && value + 63 <= last ) {
+            bitmap[value / 64] = ~word_type{0};
+            value += 64;
+          } else {
+            bitmap[value / 64] |= word_type{1} << (value % 64);
+            ++value;
+          }
+        }
+      }
+    };
+
+    /// The bitmap of a container, converted if needed
+    inline const word_type* bitmapOf(const Container& container, Container& scratch) 
+    {
+      if ( ContainerType::Bitmap == container.type ) {
+        return container.words.data();
+      }
+
+      scratch = container;
+      scratch.toBitmap();
+      return scratch.words.data();
+    }
+
+    inline std::uint32_t countBits(const word_type* words) noexcept 
+    {
+      return static_cast<std::uint32_t>(wide_bitmask_detail::popcount<bitmap_words>(words));
+    }
+
+    template <Op TOp>
+    Container combineArrays(const Container& lhs, const Container& rhs) 
+    {
+      Container result;
+      auto out = std::back_inserter(result.values);
+
+      if constexpr ( Op::And == TOp ) {
+        std::set_intersection(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), out);
+      } else if constexpr ( Op::Or == TOp ) {
+        std::set_union(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), out);
+      } else if constexpr ( Op::Xor == TOp ) {
+        std::set_symmetric_difference(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), out);
+      } else {
+        std::set_difference(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), out);
+      }
+
+      result.cardinality = static_cast<std::uint32_t>(result.values.size());
+
+      if ( result.cardinality > array_limit ) {
+        result.toBitmap();
+      }
+
+      return result;
+    }
+
+    /// Combines two containers of the same key
+    template <Op TOp>
+    Container combine(const Container& lhs, const Container& rhs) 
+    {
+      if ( ContainerType::Array == lhs.type && ContainerType::Array == rhs.type ) {
+        return combineArrays<TOp>(lhs, rhs);
+      }
+
+      // An intersection or difference with an array only has to look up the array values
+      if ( ContainerType::Array == lhs.type && (Op::And == TOp || Op::AndNot == TOp) ) {
+        Container result;
+
+        for ( std::uint16_t value : lhs.values ) {
+          if ( rhs.contains(value) == (Op::And == TOp) ) {
+            result.values.push_back(value);
+          }
+        }
+
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+        return result;
+      }
+
+      if ( ContainerType::Array == rhs.type && Op::And == TOp ) {
+        return combine<TOp>(rhs, lhs);
+      }
+
+      // Everything else is combined as bitmaps, 2 words per vector
+      Container lhs_scratch;
+      Container rhs_scratch;
+      Container result;
+
+      result.type = ContainerType::Bitmap;
+      result.words.resize(bitmap_words);
+      wide_bitmask_detail::apply<TOp, bitmap_words>(result.words.data(), bitmapOf(lhs, lhs_scratch), bitmapOf(rhs, rhs_scratch));
+      result.cardinality = countBits(result.words.data());
+      result.toArrayIfSparse();
+
+      return result;
+    }
+  }
+
+  /**
+   * @brief RoaringBitmap
+   * 
+   * A compressed set of 32 bit record ids. The ids are split by their
+   * high 16 bits into containers, each container keeps its low 16 bits
+   * as a sorted array (sparse), a bitmap (dense) or a list of runs
+   * (consecutive ids). Set operations combine the containers pairwise,
+   * bitmaps two words per SSE2 or NEON vector.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class RoaringBitmap 
+  {
+    public:
+      using value_type = std::uint32_t;
+
+      RoaringBitmap() = default;
+
+      /**
+       * @brief Range
+       * 
+       * @param first The first id
+       * @param last The end of the range
+       * 
+       * @return The ids [first, last), kept as runs
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] static RoaringBitmap range(std::uint64_t first, std::uint64_t last) 
+      {
+        RoaringBitmap result;
+
+        while ( first < last ) {
+          const std::uint64_t end = std::min(last, (first | 0xFFFF) + 1);
+          roaring_detail::Container container;
+
+          container.key = static_cast<std::uint16_t>(first >> 16);
+          container.type = roaring_detail::ContainerType::Run;
+          container.cardinality = static_cast<std::uint32_t>(end - first);
+          container.values = {static_cast<std::uint16_t>(first), static_cast<std::uint16_t>(end - 1)};
+          result.m_containers.push_back(std::move(container));
+
+          first = end;
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief Add
+       * 
+       * Adding ids in ascending order is the fast path, a container
+       * that is left behind gets converted to runs if they are smaller.
+       * 
+       * @param id The id
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void add(value_type id) 
+      {
+        const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+
+        if ( m_containers.empty() || m_containers.back().key < key ) {
+          if ( !m_containers.empty() ) {
+            m_containers.back().toRunIfSmaller();
+          }
+
+          m_containers.emplace_back();
+          m_containers.back().key = key;
+        }
+
+        find(key)->add(static_cast<std::uint16_t>(id));
+      }
+
+      /**
+       * @brief Contains
+       * 
+       * @param id The id
+       * 
+       * @return true if the id is part of the set
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] bool contains(value_type id) const noexcept 
+      {
+        const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+        const auto position = lowerBound(m_containers, key);
+
+        return m_containers.end() != position && position->key == key && position->contains(static_cast<std::uint16_t>(id));
+      }
+
+      /// The number of ids
+      [[nodiscard]] std::uint64_t cardinality() const noexcept 
+      {
+        std::uint64_t result = 0;
+
+        for ( const roaring_detail::Container& container : m_containers ) {
+          result += container.cardinality;
+        }
+
+        return result;
+      }
+
+      /// true if the set has no id
+      [[nodiscard]] bool empty() const noexcept 
+      {
+        return m_containers.empty();
+      }
+
+      /**
+       * @brief For each
+       * 
+       * @param function Called as function(id) in ascending order
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFunction>
+      void for_each(TFunction&& function) const 
+      {
+        for ( const roaring_detail::Container& container : m_containers ) {
+          container.forEach(static_cast<std::uint32_t>(container.key) << 16, function);
+        }
+      }
+
+      /// The ids in ascending order
+      [[nodiscard]] std::vector<value_type> to_vector() const 
+      {
+        std::vector<value_type> result;
+        result.reserve(static_cast<std::size_t>(cardinality()));
+        for_each([&result](value_type id) { result.push_back(id); });
+        return result;
+      }
+
+      /// Converts every container to runs where they are smaller
+      void optimize() 
+      {
+        for ( roaring_detail::Container& container : m_containers ) {
+          container.toRunIfSmaller();
+        }
+      }
+
+      /// The bytes used, including the container headers
+      [[nodiscard]] std::size_t memory_usage() const noexcept 
+      {
+        std::size_t result = sizeof(RoaringBitmap);
+
+        for ( const roaring_detail::Container& container : m_containers ) {
+          result += sizeof(roaring_detail::Container) + container.memory();
+        }
+
+        return result;
+      }
+
+      /// The ids in both sets
+      [[nodiscard]] RoaringBitmap operator&(const RoaringBitmap& other) const 
+      {
+        return combine<roaring_detail::Op::And>(*this, other);
+      }
+
+      /// The ids in any of the sets
+      [[nodiscard]] RoaringBitmap operator|(const RoaringBitmap& other) const 
+      {
+        return combine<roaring_detail::Op::Or>(*this, other);
+      }
+
+      /// The ids in exactly one of the sets
+      [[nodiscard]] RoaringBitmap operator^(const RoaringBitmap& other) const 
+      {
+        return combine<roaring_detail::Op::Xor>(*this, other);
+      }
+
+      /// The ids in this set but not in other
+      [[nodiscard]] RoaringBitmap andNot(const RoaringBitmap& other) const 
+      {
+        return combine<roaring_detail::Op::AndNot>(*this, other);
+      }
+
+      friend bool operator==(const RoaringBitmap& lhs, const RoaringBitmap& rhs) 
+      {
+        return lhs.cardinality() == rhs.cardinality() && (lhs ^ rhs).empty();
+      }
+
+      friend bool operator!=(const RoaringBitmap& lhs, const RoaringBitmap& rhs) 
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+      template <typename TContainers>
+      static auto lowerBound(TContainers& containers, std::uint16_t key) noexcept -> decltype(containers.begin()) 
+      {
+        return std::lower_bound(containers.begin(), containers.end(), key, [](const roaring_detail::Container& container, std::uint16_t k) {
+          return container.key < k;
+        });
+      }
+
+      /// The container of the key, created if there is none
+      roaring_detail::Container* find(std::uint16_t key) 
+      {
+        if ( !m_containers.empty() && m_containers.back().key == key ) {
+          return &m_containers.back();
+        }
+
+        const auto position = lowerBound(m_containers, key);
+
+        if ( m_containers.end() != position && position->key == key ) {
+          return &*position;
+        }
+
+        roaring_detail::Container container;
+        container.key = key;
+        return &*m_containers.insert(position, std::move(container));
+      }
+
+      template <roaring_detail::Op TOp>
+      static RoaringBitmap combine(const RoaringBitmap& lhs, const RoaringBitmap& rhs) 
+      {
+        constexpr bool keep_lhs = roaring_detail::Op::And != TOp;
+        constexpr bool keep_rhs = roaring_detail::Op::Or == TOp || roaring_detail::Op::Xor == TOp;
+
+        RoaringBitmap result;
+        std::size_t i = 0;
+        std::size_t k = 0;
+
+        while ( i < lhs.m_containers.size() || k < rhs.m_containers.size() ) {
+          const roaring_detail::Container* a = i < lhs.m_containers.size() ? &lhs.m_containers[i] : nullptr;
+          const roaring_detail::Container* b = k < rhs.m_containers.size() ? &rhs.m_containers[k] : nullptr;
+
+          if ( nullptr != a && (nullptr == b || a->key < b->key) ) {
+            if ( keep_lhs ) {
+              result.m_containers.push_back(*a);
+            }
+
+            ++i;
+          } else if ( nullptr == a || b->key < a->key ) {
+            if ( keep_rhs ) {
+              result.m_containers.push_back(*b);
+            }
+
+            ++k;
+          } else {
+            roaring_detail::Container combined = roaring_detail::combine<TOp>(*a, *b);
+
+            if ( combined.cardinality > 0 ) {
+              combined.key = a->key;
+              result.m_containers.push_back(std::move(combined));
+            }
+
+            ++i;
+            ++k;
+          }
+        }
+
+        return result;
+      }
+
+      /// The containers, sorted by key
+      std::vector<roaring_detail::Container> m_containers;
+  };
+
+  /**
+   * @brief BitmapIndex
+   * 
+   * Indexes records by their flags, one RoaringBitmap of record ids per
+   * flag. Records are appended with increasing 32 bit ids, so an index
+   * holds at most max_records records. Queries combine the
+   * per-flag bitmaps instead of scanning the records, e.g. the messages
+   * that went to MQTT but not to LOGFILE:
+   * 
+   *   index.bitmap(LogLocation::MQTT).andNot(index.bitmap(LogLocation::LOGFILE))
+   * 
+   * @tparam TEnum The flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum>
+  class BitmapIndex 
+  {
+    public:
+      using enum_type = TEnum;
+      using mask_type = BitMask<TEnum>;
+      using underlying_type = std::underlying_type_t<TEnum>;
+
+      /// The number of bitmaps, one per bit of the underlying type
+      static constexpr std::size_t flag_count = 8 * sizeof(underlying_type);
+
+      /// Returned by append() if the index is full
+      static constexpr RoaringBitmap::value_type invalid_id = UINT32_MAX;
+
+      /// The maximum number of records, every id below invalid_id is used
+      static constexpr std::uint64_t max_records = invalid_id;
+
+      /**
+       * @brief Append
+       * 
+       * @param mask The flags of the record
+       * 
+       * @return The id of the record, invalid_id if the index already
+       * holds max_records records and the record was not added
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      RoaringBitmap::value_type append(const mask_type& mask) 
+      {
+        if ( m_size >= max_records ) {
+          return invalid_id;
+        }
+
+        const auto id = static_cast<RoaringBitmap::value_type>(m_size++);
+
+        mask.for_each_enabled([&](enum_type flag) {
+          m_bitmaps[column(flag)].add(id);
+        });
+
+        return id;
+      }
+
+      /// The number of records
+      [[nodiscard]] inline std::uint64_t size() const noexcept 
+      {
+        return m_size;
+      }
+
+      /**
+       * @brief Bitmap
+       * 
+       * @param flag A single flag
+       * 
+       * @return The ids of the records with the flag enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const RoaringBitmap& bitmap(const enum_type& flag) const noexcept 
+      {
+        return m_bitmaps[column(flag)];
+      }
+
+      /**
+       * @brief Query
+       * 
+       * Intersects the bitmaps from the smallest to the largest, so every
+       * step works on the smallest intermediate result.
+       * 
+       * @param flag The flags that have to be enabled
+       * 
+       * @return The ids of the records with all of the flags enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] RoaringBitmap query(const typename mask_type::Enabled& flag) const 
+      {
+        const mask_type flags(flag.value);
+
+        if ( 0 == flags.count() ) {
+          return RoaringBitmap::range(0, m_size);
+        }
+
+        std::array<std::pair<std::uint64_t, const RoaringBitmap*>, flag_count> bitmaps{};
+        std::size_t count = 0;
+
+        flags.for_each_enabled([&](enum_type bit) {
+          bitmaps[count++] = {bitmap(bit).cardinality(), &bitmap(bit)};
+        });
+
+        std::sort(bitmaps.begin(), bitmaps.begin() + static_cast<std::ptrdiff_t>(count), [](const auto& lhs, const auto& rhs) {
+          return lhs.first < rhs.first;
+        });
+
+        RoaringBitmap result = *bitmaps[0].second;
+
+        for ( std::size_t i = 1; i < count && !result.empty(); ++i ) {
+          result = result & *bitmaps[i].second;
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief Query
+       * 
+       * @param flag The flags that have to be disabled
+       * 
+       * @return The ids of the records with none of the flags enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] RoaringBitmap query(const typename mask_type::Disabled& flag) const 
+      {
+        RoaringBitmap any;
+
+        mask_type(flag.value).for_each_enabled([&](enum_type bit) {
+          any = any | bitmap(bit);
+        });
+
+        return RoaringBitmap::range(0, m_size).andNot(any);
+      }
+
+      /// Converts the containers of every bitmap to runs where they are smaller
+      void optimize() 
+      {
+        for ( RoaringBitmap& bitmap : m_bitmaps ) {
+          bitmap.optimize();
+        }
+      }
+
+      /// The bytes used by all bitmaps
+      [[nodiscard]] std::size_t memory_usage() const noexcept 
+      {
+        std::size_t result = sizeof(BitmapIndex) - sizeof(m_bitmaps);
+
+        for ( const RoaringBitmap& bitmap : m_bitmaps ) {
+          result += bitmap.memory_usage();
+        }
+
+        return result;
+      }
+
+    private:
+      static inline std::size_t column(const enum_type& flag) noexcept 
+      {
+        return static_cast<std::size_t>(countr_zero(static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<underlying_type>>(flag))));
+      }
+
+      /// The ids of the records per flag
+      std::array<RoaringBitmap, flag_count> m_bitmaps;
+      /// The number of records
+      std::uint64_t m_size = 0;
+  };
+}
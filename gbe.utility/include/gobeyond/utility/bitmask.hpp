@@ -1,9 +1,40 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <type_traits>
 
+#include <gobeyond/utility/bits.hpp>
+
 namespace gobeyond::utility 
 {
+  /**
+   * @brief BitMaskTraits
+   * 
+   * The valid bits of an enum, the complement of a BitMask is limited to
+   * them. Defaults to the enumerator ALL if the enum has one and to every
+   * bit of the underlying type otherwise. Specialize it for enums whose
+   * valid bits are not named ALL.
+   * 
+   * @tparam TEnum The flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, typename = void>
+  struct BitMaskTraits 
+  {
+    static constexpr std::underlying_type_t<TEnum> valid = static_cast<std::underlying_type_t<TEnum>>(~std::underlying_type_t<TEnum>{0});
+  };
+
+  template <typename TEnum>
+  struct BitMaskTraits<TEnum, std::void_t<decltype(TEnum::ALL)>> 
+  {
+    static constexpr std::underlying_type_t<TEnum> valid = static_cast<std::underlying_type_t<TEnum>>(TEnum::ALL);
+  };
+
   template <typename TEnum>
   class BitMask 
   {
@@ -15,175 +46,347 @@ namespace gobeyond::utility
       {
         enum_type value;
 
-        explicit inline Enable(const enum_type& value)
+        explicit constexpr Enable(const enum_type& value)
           : value(value)
         {}
+
+        /// Enables the flags of a combined mask, e.g. mask = Enable{LogLocation::MQTT | LogLocation::LOGFILE}
+        explicit constexpr Enable(const BitMask& mask)
+          : value(static_cast<enum_type>(static_cast<underlying_type>(mask)))
+        {}
       };
 
       struct Disable 
       {
         enum_type value;
 
-        explicit inline Disable(const enum_type& value)
+        explicit constexpr Disable(const enum_type& value)
           : value(value)
         {}
+
+        /// Disables the flags of a combined mask, e.g. mask = Disable{LogLocation::MQTT | LogLocation::LOGFILE}
+        explicit constexpr Disable(const BitMask& mask)
+          : value(static_cast<enum_type>(static_cast<underlying_type>(mask)))
+        {}
       };
 
       struct Enabled 
       {
         enum_type value;
 
-        explicit inline Enabled(const enum_type& value)
+        explicit constexpr Enabled(const enum_type& value)
           : value(value)
         {}
+
+        /// Requires all flags of a combined mask, e.g. mask == Enabled{LogLocation::MQTT | LogLocation::LOGFILE}
+        explicit constexpr Enabled(const BitMask& mask)
+          : value(static_cast<enum_type>(static_cast<underlying_type>(mask)))
+        {}
       };
 
       struct Disabled 
       {
         enum_type value;
 
-        explicit inline Disabled(const enum_type& value)
+        explicit constexpr Disabled(const enum_type& value)
           : value(value)
         {}
+
+        /// Requires none of the flags of a combined mask, e.g. mask == Disabled{LogLocation::MQTT | LogLocation::LOGFILE}
+        explicit constexpr Disabled(const BitMask& mask)
+          : value(static_cast<enum_type>(static_cast<underlying_type>(mask)))
+        {}
+      };
+
+      /// Iterates the enabled flags from the lowest to the highest bit
+      class Iterator 
+      {
+        public:
+          using iterator_category = std::forward_iterator_tag;
+          using value_type = enum_type;
+          using difference_type = std::ptrdiff_t;
+          using pointer = const enum_type*;
+          using reference = enum_type;
+
+          explicit constexpr Iterator(std::uint64_t bits = 0) noexcept
+            : m_bits(bits)
+          {}
+
+          constexpr enum_type operator*() const noexcept 
+          {
+            return toEnum(m_bits & (~m_bits + 1));
+          }
+
+          constexpr Iterator& operator++() noexcept 
+          {
+            m_bits &= m_bits - 1;
+            return *this;
+          }
+
+          constexpr Iterator operator++(int) noexcept 
+          {
+            Iterator previous(*this);
+            ++*this;
+            return previous;
+          }
+
+          friend constexpr bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept 
+          {
+            return lhs.m_bits == rhs.m_bits;
+          }
+
+          friend constexpr bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept 
+          {
+            return lhs.m_bits != rhs.m_bits;
+          }
+
+        private:
+          /// The flags not visited yet
+          std::uint64_t m_bits;
       };
 
-      inline BitMask()
+      /// The enabled flags as a range, e.g. for ( LogLocation flag : mask.flags() )
+      struct Range 
+      {
+        std::uint64_t bits;
+
+        constexpr Iterator begin() const noexcept 
+        {
+          return Iterator(bits);
+        }
+
+        constexpr Iterator end() const noexcept 
+        {
+          return Iterator();
+        }
+      };
+
+      constexpr BitMask()
         : m_value(static_cast<underlying_type>(enum_type()))
       {}
 
-      explicit inline BitMask(const enum_type& value)
+      explicit constexpr BitMask(const enum_type& value)
         : m_value(static_cast<underlying_type>(value))
       {}
 
-      inline BitMask(const BitMask& other) noexcept
+      constexpr BitMask(const BitMask& other) noexcept
         : m_value(other.m_value)
       {}
 
-      inline void enable(const enum_type& value) noexcept 
+      constexpr void enable(const enum_type& value) noexcept 
       {
         m_value |= static_cast<underlying_type>(value);
       }
 
-      inline void disable(const enum_type& value) noexcept 
+      constexpr void disable(const enum_type& value) noexcept 
       {
         m_value &= ~static_cast<underlying_type>(value);
       }
 
-      inline bool isEnabled(const enum_type& value) const noexcept 
+      constexpr bool isEnabled(const enum_type& value) const noexcept 
       {
         return (m_value & static_cast<underlying_type>(value)) == static_cast<underlying_type>(value);
       }
 
-      inline bool isDisabled(const enum_type& value) const noexcept 
+      constexpr bool isDisabled(const enum_type& value) const noexcept 
       {
         return (m_value & static_cast<underlying_type>(value)) == 0;
       }
 
-      inline BitMask& operator=(const BitMask& other) noexcept 
+      /// The number of enabled bits
+      constexpr std::size_t count() const noexcept 
+      {
+        return static_cast<std::size_t>(popcount(bits()));
+      }
+
+      /// Calls function(flag) for every enabled bit, from the lowest to the highest, skipping disabled bits
+      template <typename TFunction>
+      constexpr void for_each_enabled(TFunction&& function) const 
+      {
+        for ( std::uint64_t remaining = bits(); 0 != remaining; remaining &= remaining - 1 ) {
+          function(toEnum(remaining & (~remaining + 1)));
+        }
+      }
+
+      constexpr Range flags() const noexcept 
+      {
+        return Range{bits()};
+      }
+
+      /// The lowest enabled bit, enum_type() if none is enabled
+      constexpr enum_type lowest() const noexcept 
+      {
+        const std::uint64_t value = bits();
+        return 0 == value ? enum_type() : toEnum(value & (~value + 1));
+      }
+
+      /// The highest enabled bit, enum_type() if none is enabled
+      constexpr enum_type highest() const noexcept 
+      {
+        const std::uint64_t value = bits();
+        return 0 == value ? enum_type() : toEnum(std::uint64_t{1} << (63 - countl_zero(value)));
+      }
+
+      constexpr BitMask& operator=(const BitMask& other) noexcept 
       {
         m_value = other.m_value;
         return *this;
       }
 
-      inline BitMask& operator=(const enum_type& value) noexcept 
+      constexpr BitMask& operator=(const enum_type& value) noexcept 
       {
         m_value = static_cast<underlying_type>(value);
         return *this;
       }
 
-      inline BitMask& operator=(const Enable& flag) noexcept 
+      constexpr BitMask& operator=(const Enable& flag) noexcept 
       {
         enable(flag.value);
         return *this;
       }
 
-      inline BitMask& operator=(const Disable& flag) noexcept 
+      constexpr BitMask& operator=(const Disable& flag) noexcept 
       {
         disable(flag.value);
         return *this;
       }
 
-      explicit inline operator underlying_type() const noexcept 
+      constexpr BitMask& operator|=(const BitMask& other) noexcept 
+      {
+        m_value |= other.m_value;
+        return *this;
+      }
+
+      constexpr BitMask& operator&=(const BitMask& other) noexcept 
+      {
+        m_value &= other.m_value;
+        return *this;
+      }
+
+      constexpr BitMask& operator^=(const BitMask& other) noexcept 
+      {
+        m_value ^= other.m_value;
+        return *this;
+      }
+
+      /// The complement, limited to the valid bits of BitMaskTraits
+      constexpr BitMask operator~() const noexcept 
+      {
+        return BitMask(static_cast<underlying_type>(~m_value & BitMaskTraits<enum_type>::valid));
+      }
+
+      explicit constexpr operator underlying_type() const noexcept 
       {
         return static_cast<underlying_type>(m_value);
       }
 
-      friend inline bool operator==(const BitMask& lhs, const BitMask& rhs) noexcept 
+      friend constexpr bool operator==(const BitMask& lhs, const BitMask& rhs) noexcept 
       {
         return static_cast<underlying_type>(lhs) == static_cast<underlying_type>(rhs);
       }
 
-      friend inline bool operator==(const BitMask& lhs, const enum_type& rhs) noexcept 
+      friend constexpr bool operator==(const BitMask& lhs, const enum_type& rhs) noexcept 
       {
         return static_cast<underlying_type>(lhs) == static_cast<underlying_type>(rhs);
       }
 
-      friend inline bool operator==(const BitMask& lhs, const Enabled& rhs) noexcept 
+      friend constexpr bool operator==(const BitMask& lhs, const Enabled& rhs) noexcept 
       {
         return lhs.isEnabled(rhs.value);
       }
 
-      friend inline bool operator==(const BitMask& lhs, const Disabled& rhs) noexcept 
+      friend constexpr bool operator==(const BitMask& lhs, const Disabled& rhs) noexcept 
       {
         return lhs.isDisabled(rhs.value);
       }
 
-      friend inline bool operator!=(const BitMask& lhs, const BitMask& rhs) noexcept 
+      friend constexpr bool operator!=(const BitMask& lhs, const BitMask& rhs) noexcept 
       {
         return !(lhs == rhs);
       }
 
-      friend inline bool operator!=(const BitMask& lhs, const enum_type& rhs) noexcept 
+      friend constexpr bool operator!=(const BitMask& lhs, const enum_type& rhs) noexcept 
       {
         return !(lhs == rhs);
       }
 
-      friend inline BitMask operator|(const BitMask& lhs, const BitMask& rhs) noexcept 
+      friend constexpr BitMask operator|(const BitMask& lhs, const BitMask& rhs) noexcept 
       {
         return BitMask(static_cast<underlying_type>(lhs) | static_cast<underlying_type>(rhs));
       }
 
-      friend inline BitMask operator|(const BitMask& lhs, const enum_type& rhs) noexcept 
+      friend constexpr BitMask operator|(const BitMask& lhs, const enum_type& rhs) noexcept 
       {
         return BitMask(static_cast<underlying_type>(lhs) | static_cast<underlying_type>(rhs));
       }
 
-      friend inline BitMask operator|(const enum_type& lhs, const BitMask& rhs) noexcept 
+      friend constexpr BitMask operator|(const enum_type& lhs, const BitMask& rhs) noexcept 
       {
         return BitMask(static_cast<underlying_type>(lhs) | static_cast<underlying_type>(rhs));
       }
 
-      friend inline BitMask operator&(const BitMask& lhs, const BitMask& rhs) noexcept 
+      friend constexpr BitMask operator&(const BitMask& lhs, const BitMask& rhs) noexcept 
       {
         return BitMask(static_cast<underlying_type>(lhs) & static_cast<underlying_type>(rhs));
       }
 
-      friend inline BitMask operator&(const BitMask& lhs, const enum_type& rhs) noexcept 
+      friend constexpr BitMask operator&(const BitMask& lhs, const enum_type& rhs) noexcept 
       {
         return BitMask(static_cast<underlying_type>(lhs) & static_cast<underlying_type>(rhs));
       }
 
-      friend inline BitMask operator&(const enum_type& lhs, const BitMask& rhs) noexcept 
+      friend constexpr BitMask operator&(const enum_type& lhs, const BitMask& rhs) noexcept 
       {
         return BitMask(static_cast<underlying_type>(lhs) & static_cast<underlying_type>(rhs));
       }
 
+      friend constexpr BitMask operator^(const BitMask& lhs, const BitMask& rhs) noexcept 
+      {
+        return BitMask(static_cast<underlying_type>(static_cast<underlying_type>(lhs) ^ static_cast<underlying_type>(rhs)));
+      }
+
+      friend constexpr BitMask operator^(const BitMask& lhs, const enum_type& rhs) noexcept 
+      {
+        return BitMask(static_cast<underlying_type>(static_cast<underlying_type>(lhs) ^ static_cast<underlying_type>(rhs)));
+      }
+
+      friend constexpr BitMask operator^(const enum_type& lhs, const BitMask& rhs) noexcept 
+      {
+        return BitMask(static_cast<underlying_type>(static_cast<underlying_type>(lhs) ^ static_cast<underlying_type>(rhs)));
+      }
+
     protected:
-      inline explicit BitMask(const underlying_type& value)
+      constexpr explicit BitMask(const underlying_type& value)
         : m_value(value)
       {}
 
     private:
+      /// The flags as unsigned bits, without sign extension
+      constexpr std::uint64_t bits() const noexcept 
+      {
+        return static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<underlying_type>>(m_value));
+      }
+
+      static constexpr enum_type toEnum(std::uint64_t bit) noexcept 
+      {
+        return static_cast<enum_type>(static_cast<underlying_type>(bit));
+      }
+
       underlying_type m_value;
   };
 }
 
 template <typename TEnum, typename = std::enable_if_t<std::is_enum_v<TEnum>>>
-[[nodiscard]] inline gobeyond::utility::BitMask<TEnum> operator|(const TEnum& lhs, const TEnum& rhs) noexcept {
+[[nodiscard]] constexpr gobeyond::utility::BitMask<TEnum> operator|(const TEnum& lhs, const TEnum& rhs) noexcept {
   return gobeyond::utility::BitMask<TEnum>(lhs) | rhs;
 }
 
 template <typename TEnum, typename = std::enable_if_t<std::is_enum_v<TEnum>>>
-[[nodiscard]] inline gobeyond::utility::BitMask<TEnum> operator&(const TEnum& lhs, const TEnum& rhs) noexcept {
+[[nodiscard]] constexpr gobeyond::utility::BitMask<TEnum> operator&(const TEnum& lhs, const TEnum& rhs) noexcept {
   return gobeyond::utility::BitMask<TEnum>(lhs) & rhs;
-}
\ No newline at end of file
+}
+
+template <typename TEnum, typename = std::enable_if_t<std::is_enum_v<TEnum>>>
+[[nodiscard]] constexpr gobeyond::utility::BitMask<TEnum> operator^(const TEnum& lhs, const TEnum& rhs) noexcept {
+  return gobeyond::utility::BitMask<TEnum>(lhs) ^ rhs;
+}
@@ -0,0 +1,620 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/bits.hpp>
+#include <gobeyond/utility/wide_bitmask.hpp>
+
+namespace gobeyond::utility 
+{
+  namespace bitmask_array_detail 
+  {
+    using word_type = std::uint64_t;
+
+    inline constexpr std::size_t word_bits = 64;
+
+    /// Arrays with fewer words are never split across threads
+    inline constexpr std::size_t min_words_per_thread = 1 << 14;
+
+    /// The columns a query combines, the records match if all (enabled) or none (disabled) of their bits are set
+    struct Query 
+    {
+      const word_type* columns[word_bits];
+      std::size_t column_count;
+      bool enabled;
+    };
+
+    /// The matching records of one word
+    inline word_type match(const Query& query, std::size_t i) noexcept 
+    {
+      word_type combined = query.enabled ? ~word_type{0} : 0;
+
+      for ( std::size_t c = 0; c < query.column_count; ++c ) {
+        combined = query.enabled ? combined & query.columns[c][i] : combined | query.columns[c][i];
+      }
+
+      return query.enabled ? combined : ~combined;
+    }
+
+#if defined(GBE_UTILITY_SIMD_X86)
+    /// The matching records of two words
+    inline __m128i sse2Match(const Query& query, std::size_t i) noexcept 
+    {
+      if ( query.enabled ) {
+        __m128i combined = _mm_set1_epi8(-1);
+
+        for ( std::size_t c = 0; c < query.column_count; ++c ) {
+          combined = _mm_and_si128(combined, wide_bitmask_detail::sse2Words(query.columns[c] + i));
+        }
+
+        return combined;
+      }
+
+      __m128i combined = _mm_setzero_si128();
+
+      for ( std::size_t c = 0; c < query.column_count; ++c ) {
+        combined = _mm_or_si128(combined, wide_bitmask_detail::sse2Words(query.columns[c] + i));
+      }
+
+      return _mm_xor_si128(combined, _mm_set1_epi8(-1));
+    }
+#elif defined(GBE_UTILITY_SIMD_NEON)
+    /// The matching records of two words
+    inline uint64x2_t neonMatch(const Query& query, std::size_t i) noexcept 
+    {
+      if ( query.enabled ) {
+        uint64x2_t combined = vdupq_n_u64(~word_type{0});
+
+        for ( std::size_t c = 0; c < query.column_count; ++c ) {
+          combined = vandq_u64(combined, vld1q_u64(query.columns[c] + i));
+        }
+
+        return combined;
+      }
+
+      uint64x2_t combined = vdupq_n_u64(0);
+
+      for ( std::size_t c = 0; c < query.column_count; ++c ) {
+        combined = vorrq_u64(combined, vld1q_u64(query.columns[c] + i));
+      }
+
+      return veorq_u64(combined, vdupq_n_u64(~word_type{0}));
+    }
+#endif
+
+    /// Counts the matching records of the full words [first, last)
+    inline std::size_t count(const Query& query, std::size_t first, std::size_t last) noexcept 
+    {
+      std::size_t i = first;
+      std::size_t result = 0;
+
+#if defined(GBE_UTILITY_SIMD_X86)
+      __m128i counts = _mm_setzero_si128();
+
+      for ( ; i + 2 <= last; i += 2 ) {
+        counts = _mm_add_epi64(counts, wide_bitmask_detail::sse2Popcount(sse2Match(query, i)));
+      }
+
+      word_type lanes[2];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+      result = static_cast<std::size_t>(lanes[0] + lanes[1]);
+#elif defined(GBE_UTILITY_SIMD_NEON)
+      for ( ; i + 2 <= last; i += 2 ) {
+        result += vaddvq_u8(vcntq_u8(vreinterpretq_u8_u64(neonMatch(query, i))));
+      }
+#endif
+
+      for ( ; i < last; ++i ) {
+        result += static_cast<std::size_t>(popcount(match(query, i)));
+      }
+
+      return result;
+    }
+
+    /// Appends the positions of the set bits of word i
+    inline void collect(word_type word, std::size_t i, std::vector<std::size_t>& out) 
+    {
+      for ( ; 0 != word; word &= word - 1 ) {
+        out.push_back(i * word_bits + static_cast<std::size_t>(countr_zero(word)));
+      }
+    }
+
+    /// Appends the matching records of the full words [first, last)
+    inline void select(const Query& query, std::size_t first, std::size_t last, std::vector<std::size_t>& out) 
+    {
+      std::size_t i = first;
+
+#if defined(GBE_UTILITY_SIMD_X86)
+      for ( ; i + 2 <= last; i += 2 ) {
+        const __m128i words = sse2Match(query, i);
+
+        // Most blocks of a selective query match nothing
+        if ( 0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi8(words, _mm_setzero_si128())) ) {
+          continue;
+        }
+
+        word_type lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), words);
+        collect(lanes[0], i, out);
+        collect(lanes[1], i + 1, out);
+      }
+#elif defined(GBE_UTILITY_SIMD_NEON)
+      for ( ; i + 2 <= last; i += 2 ) {
+        const uint64x2_t words = neonMatch(query, i);
+
+        if ( 0 == vmaxvq_u32(vreinterpretq_u32_u64(words)) ) {
+          continue;
+        }
+
+        collect(vgetq_lane_u64(words, 0), i, out);
+        collect(vgetq_lane_u64(words, 1), i + 1, out);
+      }
+#endif
+
+      for ( ; i < last; ++i ) {
+        collect(match(query, i), i, out);
+      }
+    }
+
+    /// Splits the words [0, words) into one range per thread
+    template <typename TFunction>
+    inline void partition(std::size_t words, std::size_t threads, TFunction&& function) 
+    {
+      threads = std::max<std::size_t>(1, std::min(threads, words / min_words_per_thread));
+
+      if ( 1 == threads ) {
+        function(std::size_t{0}, std::size_t{0}, words);
+        return;
+      }
+
+      // Ranges start on an even word, so the vector loops see whole blocks
+      const std::size_t chunk = ((words + threads - 1) / threads + 1) & ~std::size_t{1};
+      std::vector<std::thread> workers;
+
+      for ( std::size_t t = 1; t < threads && t * chunk < words; ++t ) {
+        workers.emplace_back([&function, t, chunk, words] {
+          function(t, t * chunk, std::min(words, (t + 1) * chunk));
+        });
+      }
+
+      function(std::size_t{0}, std::size_t{0}, std::min(words, chunk));
+
+      for ( std::thread& worker : workers ) {
+        worker.join();
+      }
+    }
+  }
+
+  /**
+   * @brief BitMaskArray
+   * 
+   * The flags of many records, kept as one column per bit instead of
+   * one BitMask per record. A query only reads the columns of the flags
+   * it tests, one bit per record, and combines them two words per SSE2
+   * or NEON vector. Filtering runs at memory bandwidth instead of one
+   * branch per record.
+   * 
+   * The parallel variants split large arrays across threads, arrays
+   * below 1M records are processed by the calling thread alone.
+   * 
+   * @tparam TEnum The flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum>
+  class BitMaskArray 
+  {
+    public:
+      using enum_type = TEnum;
+      using mask_type = BitMask<TEnum>;
+      using underlying_type = std::underlying_type_t<TEnum>;
+      using word_type = bitmask_array_detail::word_type;
+
+      /// The number of columns, one per bit of the underlying type
+      static constexpr std::size_t column_count = 8 * sizeof(underlying_type);
+
+      inline BitMaskArray() noexcept = default;
+
+      /**
+       * @brief Constructor
+       * 
+       * @param size The number of records, all flags disabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit BitMaskArray(std::size_t size) 
+      {
+        resize(size);
+      }
+
+      /// The number of records
+      [[nodiscard]] inline std::size_t size() const noexcept 
+      {
+        return m_size;
+      }
+
+      /**
+       * @brief Resize
+       * 
+       * @param size The number of records, new records have all flags disabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void resize(std::size_t size) 
+      {
+        const std::size_t words = wordCount(size);
+
+        if ( size < m_size ) {
+          // Bits beyond the size stay 0, so disabled queries can count whole words
+          for ( std::vector<word_type>& column : m_columns ) {
+            clearRange(column, size, std::min(m_size, words * bitmask_array_detail::word_bits));
+          }
+        }
+
+        for ( std::vector<word_type>& column : m_columns ) {
+          column.resize(words, 0);
+        }
+
+        m_size = size;
+      }
+
+      /**
+       * @brief Push back
+       * 
+       * @param mask The flags of the new record
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void push_back(const mask_type& mask) 
+      {
+        if ( 0 == m_size % bitmask_array_detail::word_bits ) {
+          for ( std::vector<word_type>& column : m_columns ) {
+            column.push_back(0);
+          }
+        }
+
+        ++m_size;
+        set(m_size - 1, mask);
+      }
+
+      /**
+       * @brief Get
+       * 
+       * @param index The record, smaller than size()
+       * 
+       * @return The flags of the record, gathered from all columns
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] mask_type get(std::size_t index) const noexcept 
+      {
+        std::uint64_t bits = 0;
+
+        for ( std::size_t c = 0; c < column_count; ++c ) {
+          bits |= ((m_columns[c][index / bitmask_array_detail::word_bits] >> (index % bitmask_array_detail::word_bits)) & 1) << c;
+        }
+
+        return mask_type(static_cast<enum_type>(static_cast<underlying_type>(bits)));
+      }
+
+      /**
+       * @brief Set
+       * 
+       * @param index The record, smaller than size()
+       * @param mask The new flags of the record
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void set(std::size_t index, const mask_type& mask) noexcept 
+      {
+        const std::uint64_t bits = toBits(static_cast<underlying_type>(mask));
+        const word_type bit = word_type{1} << (index % bitmask_array_detail::word_bits);
+
+        for ( std::size_t c = 0; c < column_count; ++c ) {
+          word_type& word = m_columns[c][index / bitmask_array_detail::word_bits];
+          word = 0 != ((bits >> c) & 1) ? word | bit : word & ~bit;
+        }
+      }
+
+      /**
+       * @brief Count
+       * 
+       * @param flag The flags that have to be enabled
+       * 
+       * @return The number of records with all of the flags enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] std::size_t count(const typename mask_type::Enabled& flag) const noexcept 
+      {
+        return countMatches(query(flag.value, true), 1);
+      }
+
+      /**
+       * @brief Count
+       * 
+       * @param flag The flags that have to be disabled
+       * 
+       * @return The number of records with none of the flags enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] std::size_t count(const typename mask_type::Disabled& flag) const noexcept 
+      {
+        return countMatches(query(flag.value, false), 1);
+      }
+
+      /// count(), split across up to threads threads
+      template <typename TFlag>
+      [[nodiscard]] std::size_t parallel_count(const TFlag& flag, std::size_t threads = std::thread::hardware_concurrency()) const 
+      {
+        return countMatches(query(flag.value, isEnabledQuery<TFlag>()), threads);
+      }
+
+      /**
+       * @brief Select
+       * 
+       * @param flag The flags that have to be enabled
+       * 
+       * @return The ascending indices of the records with all of the flags enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] std::vector<std::size_t> select(const typename mask_type::Enabled& flag) const 
+      {
+        return selectMatches(query(flag.value, true), 1);
+      }
+
+      /**
+       * @brief Select
+       * 
+       * @param flag The flags that have to be disabled
+       * 
+       * @return The ascending indices of the records with none of the flags enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] std::vector<std::size_t> select(const typename mask_type::Disabled& flag) const 
+      {
+        return selectMatches(query(flag.value, false), 1);
+      }
+
+      /// select(), split across up to threads threads
+      template <typename TFlag>
+      [[nodiscard]] std::vector<std::size_t> parallel_select(const TFlag& flag, std::size_t threads = std::thread::hardware_concurrency()) const 
+      {
+        return selectMatches(query(flag.value, isEnabledQuery<TFlag>()), threads);
+      }
+
+      /**
+       * @brief Apply
+       * 
+       * Enables or disables flags of the records [first, last), whole
+       * words at once.
+       * 
+       * @param flag The flags to enable
+       * @param first The first record
+       * @param last The end of the range, at most size()
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void apply(const typename mask_type::Enable& flag, std::size_t first, std::size_t last) noexcept 
+      {
+        mask_type(flag.value).for_each_enabled([&](enum_type bit) {
+          setRange(m_columns[column(bit)], first, last);
+        });
+      }
+
+      /// @copydoc apply(const typename mask_type::Enable&, std::size_t, std::size_t)
+      void apply(const typename mask_type::Disable& flag, std::size_t first, std::size_t last) noexcept 
+      {
+        mask_type(flag.value).for_each_enabled([&](enum_type bit) {
+          clearRange(m_columns[column(bit)], first, last);
+        });
+      }
+
+      /**
+       * @brief Apply
+       * 
+       * Enables or disables flags of the listed records, e.g. the result
+       * of select().
+       * 
+       * @param flag The flags to enable
+       * @param indices The records, each smaller than size()
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void apply(const typename mask_type::Enable& flag, const std::vector<std::size_t>& indices) noexcept 
+      {
+        mask_type(flag.value).for_each_enabled([&](enum_type bit) {
+          word_type* words = m_columns[column(bit)].data();
+
+          for ( std::size_t index : indices ) {
+            words[index / bitmask_array_detail::word_bits] |= word_type{1} << (index % bitmask_array_detail::word_bits);
+          }
+        });
+      }
+
+      /// @copydoc apply(const typename mask_type::Enable&, const std::vector<std::size_t>&)
+      void apply(const typename mask_type::Disable& flag, const std::vector<std::size_t>& indices) noexcept 
+      {
+        mask_type(flag.value).for_each_enabled([&](enum_type bit) {
+          word_type* words = m_columns[column(bit)].data();
+
+          for ( std::size_t index : indices ) {
+            words[index / bitmask_array_detail::word_bits] &= ~(word_type{1} << (index % bitmask_array_detail::word_bits));
+          }
+        });
+      }
+
+      /**
+       * @brief Column
+       * 
+       * @param flag A single flag
+       * 
+       * @return The words of the flag, record i is bit i % 64 of word i / 64
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const std::vector<word_type>& column_words(const enum_type& flag) const noexcept 
+      {
+        return m_columns[column(flag)];
+      }
+
+    private:
+      static constexpr std::size_t wordCount(std::size_t size) noexcept 
+      {
+        return (size + bitmask_array_detail::word_bits - 1) / bitmask_array_detail::word_bits;
+      }
+
+      static constexpr std::uint64_t toBits(underlying_type value) noexcept 
+      {
+        return static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<underlying_type>>(value));
+      }
+
+      static inline std::size_t column(const enum_type& flag) noexcept 
+      {
+        return static_cast<std::size_t>(countr_zero(toBits(static_cast<underlying_type>(flag))));
+      }
+
+      template <typename TFlag>
+      static constexpr bool isEnabledQuery() noexcept 
+      {
+        static_assert(std::is_same_v<TFlag, typename mask_type::Enabled> || std::is_same_v<TFlag, typename mask_type::Disabled>, "only Enabled and Disabled queries are supported");
+        return std::is_same_v<TFlag, typename mask_type::Enabled>;
+      }
+
+      bitmask_array_detail::Query query(const enum_type& flags, bool enabled) const noexcept 
+      {
+        bitmask_array_detail::Query result{};
+
+        result.enabled = enabled;
+        mask_type(flags).for_each_enabled([&](enum_type bit) {
+          result.columns[result.column_count++] = m_columns[column(bit)].data();
+        });
+
+        return result;
+      }
+
+      /// The records of the last, partial word that are not part of the array
+      word_type tailPadding() const noexcept 
+      {
+        const std::size_t used = m_size % bitmask_array_detail::word_bits;
+        return 0 == used ? 0 : ~word_type{0} << used;
+      }
+
+      std::size_t countMatches(const bitmask_array_detail::Query& query, std::size_t threads) const 
+      {
+        const std::size_t words = wordCount(m_size);
+        std::vector<std::size_t> counts(std::max<std::size_t>(1, threads), 0);
+
+        bitmask_array_detail::partition(words, threads, [&](std::size_t t, std::size_t first, std::size_t last) {
+          counts[t] = bitmask_array_detail::count(query, first, last);
+        });
+
+        std::size_t result = 0;
+
+        for ( std::size_t count : counts ) {
+          result += count;
+        }
+
+        // A disabled query also matches the padding of the last word
+        if ( words > 0 ) {
+          result -= static_cast<std::size_t>(popcount(bitmask_array_detail::match(query, words - 1) & tailPadding()));
+        }
+
+        return result;
+      }
+
+      std::vector<std::size_t> selectMatches(const bitmask_array_detail::Query& query, std::size_t threads) const 
+      {
+        const std::size_t words = wordCount(m_size);
+        std::vector<std::vector<std::size_t>> parts(std::max<std::size_t>(1, threads));
+
+        bitmask_array_detail::partition(words, threads, [&](std::size_t t, std::size_t first, std::size_t last) {
+          bitmask_array_detail::select(query, first, last, parts[t]);
+        });
+
+        std::vector<std::size_t> result = std::move(parts[0]);
+
+        for ( std::size_t t = 1; t < parts.size(); ++t ) {
+          result.insert(result.end(), parts[t].begin(), parts[t].end());
+        }
+
+        while ( !result.empty() && result.back() >= m_size ) {
+          result.pop_back();
+        }
+
+        return result;
+      }
+
+      static void setRange(std::vector<word_type>& words, std::size_t first, std::size_t last) noexcept 
+      {
+        updateRange(words, first, last, true);
+      }
+
+      static void clearRange(std::vector<word_type>& words, std::size_t first, std::size_t last) noexcept 
+      {
+        updateRange(words, first, last, false);
+      }
+
+      static void updateRange(std::vector<word_type>& words, std::size_t first, std::size_t last, bool value) noexcept 
+      {
+        if ( first >= last ) {
+          return;
+        }
+
+        const std::size_t first_word = first / bitmask_array_detail::word_bits;
+        const std::size_t last_word = (last - 1) / bitmask_array_detail::word_bits;
+        const word_type head = ~word_type{0} << (first % bitmask_array_detail::word_bits);
+        const word_type tail = ~word_type{0} >> (bitmask_array_detail::word_bits - 1 - (last - 1) % bitmask_array_detail::word_bits);
+
+        if ( first_word == last_word ) {
+          words[first_word] = value ? words[first_word] | (head & tail) : words[first_word] & ~(head & tail);
+          return;
+        }
+
+        words[first_word] = value ? words[first_word] | head : words[first_word] & ~head;
+        std::fill(words.begin() + static_cast<std::ptrdiff_t>(first_word + 1), words.begin() + static_cast<std::ptrdiff_t>(last_word), value ? ~word_type{0} : 0);
+        words[last_word] = value ? words[last_word] | tail : words[last_word] & ~tail;
+      }
+
+      /// One column per bit, record i is bit i % 64 of word i / 64
+      std::array<std::vector<word_type>, column_count> m_columns;
+      /// The number of records
+      std::size_t m_size = 0;
+  };
+}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/thread_slots.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief BitMaskConfig
+   * 
+   * A read-mostly table of one BitMask per module, e.g. the routing of
+   * hundreds of modules, that an admin thread replaces as a whole while
+   * any number of threads read it.
+   * 
+   * Every version is an immutable Snapshot published with a single
+   * pointer exchange, so a reader always sees all masks of the same
+   * version. Reclamation is epoch based: a reader announces the current
+   * epoch in a slot of its own cache line and clears it when done, it
+   * never writes to a line shared with other threads. A replaced
+   * snapshot is freed once no reader slot announces an epoch from
+   * before the replacement.
+   * 
+   * Readers never wait. Threads beyond the reader slot count fall back
+   * to a shared counter, which is correct but slower.
+   * 
+   * @tparam TEnum The flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum>
+  class BitMaskConfig 
+  {
+    private:
+      /// The epoch of a slot without a view
+      static constexpr std::uint64_t idle = 0;
+
+      /// The state of a reading thread, written by that thread only
+      struct Slot 
+      {
+        /// The epoch the thread started reading in, idle if it has no view
+        std::atomic<std::uint64_t> epoch{idle};
+        /// The number of nested views, only used by the owning thread
+        std::size_t depth = 0;
+      };
+
+    public:
+      using enum_type = TEnum;
+      using mask_type = BitMask<TEnum>;
+
+      /**
+       * @brief Snapshot
+       * 
+       * One version of the masks of all modules, never changed after it
+       * was published.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      class Snapshot 
+      {
+        public:
+          Snapshot(std::uint64_t version, std::vector<mask_type> masks)
+            : m_version(version),
+              m_masks(std::move(masks))
+          {}
+
+          [[nodiscard]] inline std::uint64_t version() const noexcept 
+          {
+            return m_version;
+          }
+
+          [[nodiscard]] inline std::size_t size() const noexcept 
+          {
+            return m_masks.size();
+          }
+
+          /// The mask of a module, an empty mask for modules beyond size()
+          [[nodiscard]] inline mask_type operator[](std::size_t module) const noexcept 
+          {
+            return module < m_masks.size() ? m_masks[module] : mask_type();
+          }
+
+          [[nodiscard]] inline const std::vector<mask_type>& masks() const noexcept 
+          {
+            return m_masks;
+          }
+
+        private:
+          /// The version, counted from 0 for the initial masks
+          std::uint64_t m_version;
+          /// The mask of each module
+          std::vector<mask_type> m_masks;
+      };
+
+      /**
+       * @brief View
+       * 
+       * Keeps a snapshot alive while it is read. A view is meant to be
+       * short lived, a snapshot is only reclaimed after every view that
+       * may use it was destroyed.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      class View 
+      {
+        public:
+          View(View&& other) noexcept
+            : m_config(std::exchange(other.m_config, nullptr)),
+              m_slot(other.m_slot),
+              m_snapshot(other.m_snapshot)
+          {}
+
+          View(const View&) = delete;
+          View& operator=(const View&) = delete;
+          View& operator=(View&&) = delete;
+
+          ~View() 
+          {
+            if ( nullptr != m_config ) {
+              m_config->leave(m_slot);
+            }
+          }
+
+          [[nodiscard]] inline const Snapshot& operator*() const noexcept 
+          {
+            return *m_snapshot;
+          }
+
+          [[nodiscard]] inline const Snapshot* operator->() const noexcept 
+          {
+            return m_snapshot;
+          }
+
+        private:
+          friend class BitMaskConfig;
+
+          View(const BitMaskConfig* config, Slot* slot, const Snapshot* snapshot) noexcept
+            : m_config(config),
+              m_slot(slot),
+              m_snapshot(snapshot)
+          {}
+
+          const BitMaskConfig* m_config;
+          /// The slot of the reading thread, nullptr for the shared counter
+          Slot* m_slot;
+          const Snapshot* m_snapshot;
+      };
+
+      /**
+       * @brief Constructor
+       * 
+       * @param masks The initial mask of each module
+       * @param readers The maximum number of threads reading without the shared fallback
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit BitMaskConfig(std::vector<mask_type> masks = {}, std::size_t readers = 64)
+        : m_slots(readers, [](Slot& slot) {
+            slot.depth = 0;
+            slot.epoch.store(idle, std::memory_order_relaxed);
+          }),
+          m_current(new Snapshot(0, std::move(masks)))
+      {}
+
+      BitMaskConfig(const BitMaskConfig&) = delete;
+      BitMaskConfig& operator=(const BitMaskConfig&) = delete;
+
+      /// Requires that no view is alive
+      ~BitMaskConfig() 
+      {
+        delete m_current.load(std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Read
+       * 
+       * Pins the current snapshot. Views may be nested on the same
+       * thread.
+       * 
+       * @return The view of the current snapshot
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline View read() const noexcept 
+      {
+        Slot* slot = m_slots.local();
+
+        if ( nullptr == slot ) {
+          m_overflow.fetch_add(1, std::memory_order_seq_cst);
+        } else if ( 0 == slot->depth++ ) {
+          // Announcing the epoch has to be ordered before the pointer load, the writer relies on it
+          slot->epoch.store(m_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        return View(this, slot, m_current.load(std::memory_order_seq_cst));
+      }
+
+      /**
+       * @brief Get
+       * 
+       * @param module The module
+       * 
+       * @return The current mask of the module
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline mask_type get(std::size_t module) const noexcept 
+      {
+        return (*read())[module];
+      }
+
+      /**
+       * @brief Version
+       * 
+       * @return The version of the current snapshot
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::uint64_t version() const noexcept 
+      {
+        return read()->version();
+      }
+
+      /**
+       * @brief Publish
+       * 
+       * Replaces all masks at once and reclaims the snapshots no reader
+       * can see anymore. Readers that started before keep their snapshot.
+       * 
+       * @param masks The new mask of each module
+       * 
+       * @return The version of the new snapshot
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      std::uint64_t publish(std::vector<mask_type> masks) 
+      {
+        std::lock_guard<std::mutex> lock(m_write);
+        return replace(std::move(masks));
+      }
+
+      /**
+       * @brief Update
+       * 
+       * Publishes a modified copy of the current masks, updates never
+       * overwrite each other.
+       * 
+       * @param function Called with the masks to change, void(std::vector<mask_type>&)
+       * 
+       * @return The version of the new snapshot
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFunction>
+      std::uint64_t update(TFunction&& function) 
+      {
+        std::lock_guard<std::mutex> lock(m_write);
+        std::vector<mask_type> masks = m_current.load(std::memory_order_relaxed)->masks();
+
+        function(masks);
+        return replace(std::move(masks));
+      }
+
+      /**
+       * @brief Reclaim
+       * 
+       * Frees the replaced snapshots that no reader can see anymore.
+       * 
+       * @return The number of snapshots still waiting for readers
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      std::size_t reclaim() 
+      {
+        std::lock_guard<std::mutex> lock(m_write);
+        return reclaimRetired();
+      }
+
+      /**
+       * @brief Synchronize
+       * 
+       * Waits until every replaced snapshot was freed, i.e. until every
+       * view that started before the call was destroyed. Must not be
+       * called while the calling thread holds a view.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void synchronize() 
+      {
+        while ( 0 != reclaim() ) {
+          std::this_thread::yield();
+        }
+      }
+
+    private:
+      /// A replaced snapshot and the first epoch it is invisible in
+      struct Retired 
+      {
+        std::unique_ptr<const Snapshot> snapshot;
+        std::uint64_t epoch;
+      };
+
+      inline void leave(Slot* slot) const noexcept 
+      {
+        if ( nullptr == slot ) {
+          m_overflow.fetch_sub(1, std::memory_order_release);
+        } else if ( 0 == --slot->depth ) {
+          slot->epoch.store(idle, std::memory_order_release);
+        }
+      }
+
+      std::uint64_t replace(std::vector<mask_type> masks) 
+      {
+        const Snapshot* current = m_current.load(std::memory_order_relaxed);
+        const std::uint64_t version = current->version() + 1;
+        const Snapshot* previous = m_current.exchange(new Snapshot(version, std::move(masks)), std::memory_order_seq_cst);
+
+        // Readers announcing the new epoch load the pointer after the exchange
+        const std::uint64_t epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+        m_retired.push_back({std::unique_ptr<const Snapshot>(previous), epoch});
+        reclaimRetired();
+        return version;
+      }
+
+      std::size_t reclaimRetired() 
+      {
+        if ( m_retired.empty() ) {
+          return 0;
+        }
+
+        // Views on the shared counter have no epoch and may see any snapshot
+        std::uint64_t oldest = 0 == m_overflow.load(std::memory_order_seq_cst) ? std::numeric_limits<std::uint64_t>::max() : idle;
+
+        for ( std::size_t i = 0; i < m_slots.count() && idle != oldest; ++i ) {
+          const std::uint64_t epoch = m_slots[i].epoch.load(std::memory_order_seq_cst);
+
+          if ( idle != epoch && epoch < oldest ) {
+            oldest = epoch;
+          }
+        }
+
+        std::size_t kept = 0;
+
+        for ( Retired& retired : m_retired ) {
+          if ( retired.epoch > oldest ) {
+            m_retired[kept++] = std::move(retired);
+          }
+        }
+
+        m_retired.resize(kept);
+        return kept;
+      }
+
+      /// The epoch of each reading thread
+      mutable ThreadSlots<Slot> m_slots;
+      /// The number of views of threads without a slot
+      mutable std::atomic<std::size_t> m_overflow{0};
+      /// Incremented on each publish, starts above idle
+      std::atomic<std::uint64_t> m_epoch{1};
+      /// The snapshot new views get
+      std::atomic<const Snapshot*> m_current;
+      /// Serializes publish, update and reclaim
+      std::mutex m_write;
+      /// The replaced snapshots readers may still see
+      std::vector<Retired> m_retired;
+  };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief Count leading zeros
+   * 
+   * C++17 stand-in for std::countl_zero.
+   * 
+   * @param value The value
+   * 
+   * @return The number of consecutive zero bits starting at the most
+   * significant bit, 64 for 0
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] constexpr int countl_zero(std::uint64_t value) noexcept 
+  {
+#if defined(__GNUC__)
+    return 0 == value ? 64 : __builtin_clzll(value);
+#else
+    int count = 0;
+
+    for ( std::uint64_t bit = std::uint64_t{1} << 63; bit != 0 && (value & bit) == 0; bit >>= 1 ) {
+      ++count;
+    }
+
+    return count;
+#endif
+  }
+
+  /**
+   * @brief Count trailing zeros
+   * 
+   * C++17 stand-in for std::countr_zero.
+   * 
+   * @param value The value
+   * 
+   * @return The number of consecutive zero bits starting at the least
+   * significant bit, 64 for 0
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] constexpr int countr_zero(std::uint64_t value) noexcept 
+  {
+#if defined(__GNUC__)
+    return 0 == value ? 64 : __builtin_ctzll(value);
+#else
+    int count = 0;
+
+    for ( std::uint64_t bit = 1; bit != 0 && (value & bit) == 0; bit <<= 1 ) {
+      ++count;
+    }
+
+    return count;
+#endif
+  }
+
+  /**
+   * @brief Population count
+   * 
+   * C++17 stand-in for std::popcount.
+   * 
+   * @param value The value
+   * 
+   * @return The number of set bits
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] constexpr int popcount(std::uint64_t value) noexcept 
+  {
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ull);
+    value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+    value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+    return static_cast<int>((value * 0x0101010101010101ull) >> 56);
+#endif
+  }
+}
@@ -0,0 +1,733 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <gobeyond/utility/format.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief DeferredType
+   * 
+   * How a captured argument is stored in a DeferredRecord. Integers and
+   * floating point values are stored with their native size and byte
+   * order, strings as a 16 bit length followed by the characters and
+   * pointers as 64 bit addresses.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class DeferredType : std::uint8_t 
+  {
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float,
+    Double,
+    LongDouble,
+    Pointer,
+    String
+  };
+
+  /**
+   * @brief DeferredFormat
+   * 
+   * Describes a format string captured by DeferredRecord::capture(). One
+   * instance exists per call site and argument type list, it is created
+   * and registered on first use.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct DeferredFormat 
+  {
+    /// Renders captured argument bytes, returns the length of the complete output like snprintf
+    using render_function = std::size_t (*)(const unsigned char* data, std::size_t size, char* dst, std::size_t dst_size) noexcept;
+
+    /// The id stored in the records, valid within the current process
+    std::uint32_t id = 0;
+    /// The format string
+    std::string_view text;
+    /// The storage type of each argument
+    const DeferredType* types = nullptr;
+    /// The number of arguments
+    std::size_t arguments = 0;
+    /// Renders the arguments with the argument types of the call site
+    render_function render = nullptr;
+  };
+
+  /**
+   * @brief DeferredFormatRegistry
+   * 
+   * Maps format ids to their descriptions. Registration is lock-free,
+   * lookups are a single load.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class DeferredFormatRegistry 
+  {
+    public:
+      /// The maximum number of registered formats
+      static constexpr std::uint32_t capacity = 4096;
+
+      /// An id that is never assigned
+      static constexpr std::uint32_t invalid_id = UINT32_MAX;
+
+      /// The process wide registry
+      static DeferredFormatRegistry& instance() noexcept 
+      {
+        static DeferredFormatRegistry registry;
+        return registry;
+      }
+
+      /**
+       * @brief Add
+       * 
+       * Assigns the next id to the format and publishes it.
+       * 
+       * @param format The format, must outlive the registry
+       * 
+       * @return The id, invalid_id if the registry is full
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      std::uint32_t add(DeferredFormat& format) noexcept 
+      {
+        const std::uint32_t id = m_count.fetch_add(1, std::memory_order_relaxed);
+
+        if ( id >= capacity ) {
+          return invalid_id;
+        }
+
+        format.id = id;
+        m_formats[id].store(&format, std::memory_order_release);
+
+        return id;
+      }
+
+      /**
+       * @brief Find
+       * 
+       * @param id The format id
+       * 
+       * @return The format, nullptr if the id is unknown
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const DeferredFormat* find(std::uint32_t id) const noexcept 
+      {
+        return id < capacity ? m_formats[id].load(std::memory_order_acquire) : nullptr;
+      }
+
+      /**
+       * @brief Size
+       * 
+       * @return The number of ids handed out so far
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::uint32_t size() const noexcept 
+      {
+        const std::uint32_t count = m_count.load(std::memory_order_relaxed);
+        return count < capacity ? count : capacity;
+      }
+
+    private:
+      DeferredFormatRegistry() = default;
+
+      std::atomic<std::uint32_t> m_count{0};
+      std::atomic<const DeferredFormat*> m_formats[capacity] = {};
+  };
+
+  namespace deferred_detail 
+  {
+    using format_detail::decay_t;
+
+    /// The type an argument is decoded to before it is handed to the format engine
+    template <typename T, FormatConversion TConversion>
+    struct Stored 
+    {
+      using type = T;
+    };
+
+    template <typename T>
+    struct Stored<T, FormatConversion::String> 
+    {
+      using type = std::string_view;
+    };
+
+    template <typename T>
+    struct Stored<T, FormatConversion::Pointer> 
+    {
+      using type = const void*;
+    };
+
+    template <typename T, FormatConversion TConversion>
+    using stored_t = typename Stored<T, TConversion>::type;
+
+    template <typename T>
+    constexpr DeferredType typeOf() noexcept 
+    {
+      if constexpr ( std::is_same_v<T, std::string_view> ) {
+        return DeferredType::String;
+      } else if constexpr ( std::is_same_v<T, const void*> ) {
+        return DeferredType::Pointer;
+      } else if constexpr ( std::is_same_v<T, float> ) {
+        return DeferredType::Float;
+      } else if constexpr ( std::is_same_v<T, double> ) {
+        return DeferredType::Double;
+      } else if constexpr ( std::is_same_v<T, long double> ) {
+        return DeferredType::LongDouble;
+      } else {
+        using integer_type = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::common_type<T>>::type;
+        constexpr bool is_signed = std::is_signed_v<integer_type>;
+
+        switch ( sizeof(integer_type) ) {
+          case 1:
+            return is_signed ? DeferredType::Int8 : DeferredType::UInt8;
+          case 2:
+            return is_signed ? DeferredType::Int16 : DeferredType::UInt16;
+          case 4:
+            return is_signed ? DeferredType::Int32 : DeferredType::UInt32;
+          default:
+            return is_signed ? DeferredType::Int64 : DeferredType::UInt64;
+        }
+      }
+    }
+
+    /// The number of bytes an argument needs independent of its value
+    template <typename T>
+    constexpr std::size_t fixedSize() noexcept 
+    {
+      if constexpr ( std::is_same_v<T, std::string_view> ) {
+        return sizeof(std::uint16_t);
+      } else if constexpr ( std::is_same_v<T, const void*> ) {
+        return sizeof(std::uint64_t);
+      } else {
+        return sizeof(T);
+      }
+    }
+
+    /// Appends the bytes of an argument, strings are cut to the remaining string budget
+    template <typename TStored, typename T>
+    inline void encode(unsigned char*& cursor, std::size_t& budget, bool& truncated, const T& value) noexcept 
+    {
+      if constexpr ( std::is_same_v<TStored, std::string_view> ) {
+        std::string_view text = format_detail::toStringView(value);
+
+        if ( text.size() > budget || text.size() > UINT16_MAX ) {
+          text = text.substr(0, budget < UINT16_MAX ? budget : UINT16_MAX);
+          truncated = true;
+        }
+
+        const std::uint16_t length = static_cast<std::uint16_t>(text.size());
+        std::memcpy(cursor, &length, sizeof(length));
+        format_detail::copyBytes(reinterpret_cast<char*>(cursor) + sizeof(length), text.data(), text.size());
+        cursor += sizeof(length) + text.size();
+        budget -= text.size();
+      } else if constexpr ( std::is_same_v<TStored, const void*> ) {
+        std::uint64_t address = 0;
+
+        if constexpr ( !std::is_null_pointer_v<T> ) {
+          address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value));
+        }
+
+        std::memcpy(cursor, &address, sizeof(address));
+        cursor += sizeof(address);
+      } else {
+        const TStored stored = static_cast<TStored>(value);
+        std::memcpy(cursor, &stored, sizeof(stored));
+        cursor += sizeof(stored);
+      }
+    }
+
+    template <typename TStored>
+    inline TStored decode(const unsigned char*& cursor) noexcept 
+    {
+      if constexpr ( std::is_same_v<TStored, std::string_view> ) {
+        std::uint16_t length = 0;
+        std::memcpy(&length, cursor, sizeof(length));
+        const std::string_view text(reinterpret_cast<const char*>(cursor) + sizeof(length), length);
+        cursor += sizeof(length) + length;
+        return text;
+      } else if constexpr ( std::is_same_v<TStored, const void*> ) {
+        std::uint64_t address = 0;
+        std::memcpy(&address, cursor, sizeof(address));
+        cursor += sizeof(address);
+        return reinterpret_cast<const void*>(static_cast<std::uintptr_t>(address));
+      } else {
+        TStored value;
+        std::memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+        return value;
+      }
+    }
+
+    /// The storage types of a call site
+    template <typename TFormat, typename TArgs, typename TIndices>
+    struct Signature;
+
+    template <typename TFormat, typename... TArgs, std::size_t... TIndices>
+    struct Signature<TFormat, std::tuple<TArgs...>, std::index_sequence<TIndices...>> 
+    {
+      using stored = std::tuple<stored_t<decay_t<TArgs>, format_detail::argumentConversion<TFormat>(TIndices)>...>;
+
+      static constexpr std::size_t fixed_size = (std::size_t{0} + ... + fixedSize<std::tuple_element_t<TIndices, stored>>());
+      static constexpr DeferredType types[sizeof...(TArgs) == 0 ? 1 : sizeof...(TArgs)] = {typeOf<std::tuple_element_t<TIndices, stored>>()...};
+
+      static std::size_t render(const unsigned char* data, std::size_t size, char* dst, std::size_t dst_size) noexcept 
+      {
+        using compiled = format_detail::Compiled<TFormat>;
+
+        (void)size;
+        const unsigned char* cursor = data;
+        // Braced initialization decodes the arguments from left to right
+        const stored arguments{decode<std::tuple_element_t<TIndices, stored>>(cursor)...};
+        (void)cursor;
+
+        format_detail::Writer writer(dst, dst_size == 0 ? 0 : dst_size - 1);
+        format_detail::writeAll<TFormat>(writer, arguments, std::make_index_sequence<compiled::count>());
+
+        if ( dst_size > 0 ) {
+          dst[writer.written()] = '\0';
+        }
+
+        return writer.length();
+      }
+    };
+
+    /// The number of bytes a value of the type occupies in a record, 0 for strings
+    constexpr std::size_t nativeSize(DeferredType type) noexcept 
+    {
+      switch ( type ) {
+        case DeferredType::Int8:
+        case DeferredType::UInt8:
+          return 1;
+        case DeferredType::Int16:
+        case DeferredType::UInt16:
+          return 2;
+        case DeferredType::Int32:
+        case DeferredType::UInt32:
+        case DeferredType::Float:
+          return 4;
+        case DeferredType::Int64:
+        case DeferredType::UInt64:
+        case DeferredType::Double:
+        case DeferredType::Pointer:
+          return 8;
+        case DeferredType::LongDouble:
+          return sizeof(long double);
+        case DeferredType::String:
+          return 0;
+      }
+
+      return 0;
+    }
+
+    constexpr bool isSigned(DeferredType type) noexcept 
+    {
+      return DeferredType::Int8 == type || DeferredType::Int16 == type || DeferredType::Int32 == type || DeferredType::Int64 == type;
+    }
+
+    /// Writes one argument described by a runtime type, mirroring format_detail::writeArgument
+    inline bool writeRuntimeArgument(format_detail::Writer& writer, FormatSpec spec, DeferredType type,
+      const unsigned char*& cursor, const unsigned char* last) noexcept 
+    {
+      if ( DeferredType::String == type ) {
+        std::uint16_t length = 0;
+
+        if ( FormatConversion::String != spec.conversion || static_cast<std::size_t>(last - cursor) < sizeof(length) ) {
+          return false;
+        }
+
+        std::memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+
+        if ( static_cast<std::size_t>(last - cursor) < length ) {
+          return false;
+        }
+
+        format_detail::writeString(writer, spec, std::string_view(reinterpret_cast<const char*>(cursor), length));
+        cursor += length;
+
+        return true;
+      }
+
+      const std::size_t size = nativeSize(type);
+
+      if ( static_cast<std::size_t>(last - cursor) < size ) {
+        return false;
+      }
+
+      const unsigned char* value = cursor;
+      cursor += size;
+
+      if ( DeferredType::Float == type || DeferredType::Double == type ) {
+        if ( FormatConversion::FloatFixed > spec.conversion || FormatConversion::FloatGeneralUpper < spec.conversion ) {
+          return false;
+        }
+
+        double v = 0;
+
+        if ( DeferredType::Float == type ) {
+          float f = 0;
+          std::memcpy(&f, value, sizeof(f));
+          v = f;
+        } else {
+          std::memcpy(&v, value, sizeof(v));
+        }
+
+        format_detail::writeFloat<double>(writer, spec, v);
+        return true;
+      }
+
+      if ( DeferredType::LongDouble == type ) {
+        if ( FormatConversion::FloatFixed > spec.conversion || FormatConversion::FloatGeneralUpper < spec.conversion ) {
+          return false;
+        }
+
+        long double v = 0;
+        std::memcpy(&v, value, sizeof(v));
+        format_detail::writeFloat<long double>(writer, spec, v);
+        return true;
+      }
+
+      std::uint64_t bits = 0;
+
+      switch ( size ) {
+        case 1: {
+          std::uint8_t v = 0;
+          std::memcpy(&v, value, sizeof(v));
+          bits = v;
+          break;
+        }
+        case 2: {
+          std::uint16_t v = 0;
+          std::memcpy(&v, value, sizeof(v));
+          bits = v;
+          break;
+        }
+        case 4: {
+          std::uint32_t v = 0;
+          std::memcpy(&v, value, sizeof(v));
+          bits = v;
+          break;
+        }
+        default:
+          std::memcpy(&bits, value, sizeof(bits));
+          break;
+      }
+
+      if ( DeferredType::Pointer == type ) {
+        if ( FormatConversion::Pointer != spec.conversion ) {
+          return false;
+        }
+
+        if ( 0 == bits ) {
+          format_detail::writeString(writer, spec, "(nil)");
+        } else {
+          format_detail::writeInteger(writer, spec, bits, false);
+        }
+
+        return true;
+      }
+
+      const std::uint64_t mask = 8 == size ? ~std::uint64_t{0} : (std::uint64_t{1} << (8 * size)) - 1;
+      const bool negative = isSigned(type) && 0 != (bits & (std::uint64_t{1} << (8 * size - 1)));
+
+      switch ( spec.conversion ) {
+        case FormatConversion::Character: {
+          const char c = static_cast<char>(bits);
+          format_detail::writeString(writer, spec, std::string_view(&c, 1));
+          return true;
+        }
+        case FormatConversion::SignedDecimal:
+          if ( negative ) {
+            format_detail::writeInteger(writer, spec, (0 - bits) & mask, true);
+          } else {
+            format_detail::writeInteger(writer, spec, bits, false);
+          }
+
+          return true;
+        case FormatConversion::UnsignedDecimal:
+          format_detail::writeInteger(writer, spec, bits, false);
+          return true;
+        case FormatConversion::Octal:
+        case FormatConversion::HexLower:
+        case FormatConversion::HexUpper:
+        case FormatConversion::Binary:
+          spec.plus_sign = false;
+          spec.space_sign = false;
+          format_detail::writeInteger(writer, spec, bits, false);
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    /// Registers the format of a call site on first use
+    template <typename TFormat, typename... TArgs>
+    struct Site 
+    {
+      using signature = Signature<TFormat, std::tuple<TArgs...>, std::index_sequence_for<TArgs...>>;
+
+      static std::uint32_t id() noexcept 
+      {
+        static const std::uint32_t value = [] {
+          static DeferredFormat format{0, TFormat::value(), signature::types, sizeof...(TArgs), &signature::render};
+          return DeferredFormatRegistry::instance().add(format);
+        }();
+
+        return value;
+      }
+    };
+  }
+
+  /**
+   * @brief DeferredRecord
+   * 
+   * A captured log call: the id of the format and the raw bytes of the
+   * arguments. Capturing validates the format string exactly like
+   * StringBuffer::format but only copies the arguments, the text is
+   * rendered later, e.g. on a consumer thread. The record is trivially
+   * copyable.
+   * 
+   * @tparam TSize The number of bytes available for arguments
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TSize>
+  class DeferredRecord 
+  {
+    public:
+      static_assert(TSize <= UINT16_MAX, "DeferredRecord is limited to 65535 argument bytes");
+
+      /// The number of bytes available for arguments
+      static constexpr std::size_t capacity = TSize;
+
+      /**
+       * @brief Capture
+       * 
+       * Stores the format id and the arguments. Strings are copied, so
+       * they do not need to outlive the record; strings that do not fit
+       * are cut.
+       * 
+       * @tparam TFormat The format string type (see GBE_FMT)
+       * @tparam TArgs The argument types
+       * 
+       * @param fmt The format string
+       * @param args The arguments
+       * 
+       * @return false if the registry is full or a string was cut
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+      bool capture(TFormat fmt, const TArgs&... args) noexcept 
+      {
+        static_assert(format_detail::Validated<TFormat, TArgs...>::value);
+
+        using site = deferred_detail::Site<TFormat, format_detail::decay_t<TArgs>...>;
+        using signature = typename site::signature;
+        static_assert(signature::fixed_size <= TSize, "the arguments do not fit into the record");
+
+        (void)fmt;
+
+        m_id = site::id();
+        m_truncated = false;
+
+        unsigned char* cursor = m_data;
+        std::size_t budget = TSize - signature::fixed_size;
+
+        captureAll<typename signature::stored>(cursor, budget, std::index_sequence_for<TArgs...>(), args...);
+        m_size = static_cast<std::uint16_t>(cursor - m_data);
+
+        return DeferredFormatRegistry::invalid_id != m_id && !m_truncated;
+      }
+
+      /**
+       * @brief Render to
+       * 
+       * @param dst The destination
+       * @param size The size of the destination including the terminator
+       * 
+       * @return The length of the complete output (like snprintf), 0 if
+       * the record is empty or its format is unknown
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      std::size_t render_to(char* dst, std::size_t size) const noexcept 
+      {
+        const DeferredFormat* format = DeferredFormatRegistry::instance().find(m_id);
+
+        if ( nullptr == format ) {
+          if ( size > 0 ) {
+            dst[0] = '\0';
+          }
+
+          return 0;
+        }
+
+        return format->render(m_data, m_size, dst, size);
+      }
+
+      /**
+       * @brief Render
+       * 
+       * Replaces the content of the buffer with the rendered text.
+       * 
+       * @param buffer The destination
+       * 
+       * @return false if the text was truncated or the format is unknown
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <std::size_t TBufferSize>
+      bool render(StringBuffer<TBufferSize>& buffer) const noexcept 
+      {
+        const DeferredFormat* format = DeferredFormatRegistry::instance().find(m_id);
+
+        buffer.clear();
+
+        if ( nullptr == format ) {
+          return false;
+        }
+
+        const typename StringBuffer<TBufferSize>::Tail tail = buffer.reserve_tail();
+        return buffer.commit_truncated(format->render(m_data, m_size, tail.data, tail.size + 1));
+      }
+
+      /// The format id, DeferredFormatRegistry::invalid_id if nothing was captured
+      [[nodiscard]] inline std::uint32_t id() const noexcept 
+      {
+        return m_id;
+      }
+
+      /// The captured argument bytes
+      [[nodiscard]] inline const unsigned char* data() const noexcept 
+      {
+        return m_data;
+      }
+
+      /// The number of captured argument bytes
+      [[nodiscard]] inline std::size_t size() const noexcept 
+      {
+        return m_size;
+      }
+
+      /// true if a string argument was cut during capture
+      [[nodiscard]] inline bool truncated() const noexcept 
+      {
+        return m_truncated;
+      }
+
+    private:
+      template <typename TStored, std::size_t... TIndices, typename... TArgs>
+      inline void captureAll(unsigned char*& cursor, std::size_t& budget, std::index_sequence<TIndices...>, const TArgs&... args) noexcept 
+      {
+        (deferred_detail::encode<std::tuple_element_t<TIndices, TStored>>(cursor, budget, m_truncated, args), ...);
+      }
+
+      /// The format id
+      std::uint32_t m_id = DeferredFormatRegistry::invalid_id;
+      /// The number of used argument bytes
+      std::uint16_t m_size = 0;
+      /// A string argument was cut
+      bool m_truncated = false;
+      /// The argument bytes
+      unsigned char m_data[TSize];
+  };
+
+  /**
+   * @brief Render deferred
+   * 
+   * Renders captured argument bytes with a format string and argument
+   * types known only at runtime, e.g. read back from a log file. The
+   * output is the same as the one of DeferredRecord::render_to(). Bytes
+   * that do not match the types are rendered as "(invalid)".
+   * 
+   * @param text The format string
+   * @param types The storage type of each argument
+   * @param arguments The number of arguments
+   * @param data The argument bytes in DeferredRecord layout
+   * @param size The number of argument bytes
+   * @param dst The destination
+   * @param dst_size The size of the destination including the terminator
+   * 
+   * @return The length of the complete output (like snprintf)
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline std::size_t render_deferred(std::string_view text, const DeferredType* types, std::size_t arguments,
+    const unsigned char* data, std::size_t size, char* dst, std::size_t dst_size) noexcept 
+  {
+    format_detail::Writer writer(dst, dst_size == 0 ? 0 : dst_size - 1);
+    const unsigned char* cursor = data;
+    const unsigned char* last = data + size;
+    std::size_t argument = 0;
+    std::size_t pos = 0;
+
+    while ( pos < text.size() ) {
+      const format_detail::ParseStep step = format_detail::parseNext(text, pos);
+
+      writer.write(text.data() + step.spec.literal_offset, step.spec.literal_length);
+
+      if ( step.error != FormatError::None ) {
+        writer.write(text.data() + step.spec.literal_offset + step.spec.literal_length, text.size() - step.spec.literal_offset - step.spec.literal_length);
+        break;
+      }
+
+      if ( step.found && FormatConversion::Percent == step.spec.conversion ) {
+        writer.put('%');
+      } else if ( step.found ) {
+        if ( argument >= arguments || !deferred_detail::writeRuntimeArgument(writer, step.spec, types[argument], cursor, last) ) {
+          writer.write("(invalid)", 9);
+          break;
+        }
+
+        ++argument;
+      }
+
+      pos = step.next;
+    }
+
+    if ( dst_size > 0 ) {
+      dst[writer.written()] = '\0';
+    }
+
+    return writer.length();
+  }
+}
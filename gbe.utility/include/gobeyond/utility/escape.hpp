@@ -0,0 +1,388 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <gobeyond/utility/bits.hpp>
+#include <gobeyond/utility/simd_string.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief Escape
+   * 
+   * The encodings supported by escape_to().
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class Escape 
+  {
+    /// JSON string content: quote, backslash and control characters, other bytes including UTF-8 are kept
+    Json,
+    /// Percent encoding of everything except the unreserved characters of RFC 3986
+    Url,
+    /// HTML text and attribute values: & < > " and '
+    Html
+  };
+
+  /**
+   * @brief EscapeResult
+   * 
+   * The progress of escape_to().
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct EscapeResult 
+  {
+    /// The number of characters written to the output
+    std::size_t written = 0;
+    /// The number of input characters encoded, less than the input size if the output was too small
+    std::size_t consumed = 0;
+  };
+
+  namespace escape_detail 
+  {
+    /// Returns the position of the first character that needs escaping, size if there is none
+    using Scan = std::size_t (*)(const char* s, std::size_t size) noexcept;
+
+    /// The scanners of one instruction set, indexed by Escape
+    struct Kernels 
+    {
+      Scan scan[3];
+    };
+
+    inline bool jsonNeedsEscape(unsigned char c) noexcept 
+    {
+      return c < 0x20 || '"' == c || '\\' == c;
+    }
+
+    inline bool urlNeedsEscape(unsigned char c) noexcept 
+    {
+      const bool alphanumeric = static_cast<unsigned char>((c | 0x20) - 'a') < 26u || static_cast<unsigned char>(c - '0') < 10u;
+      return !(alphanumeric || '-' == c || '.' == c || '_' == c || '~' == c);
+    }
+
+    inline bool htmlNeedsEscape(unsigned char c) noexcept 
+    {
+      return '&' == c || '<' == c || '>' == c || '"' == c || '\'' == c;
+    }
+
+    template <bool (*TNeedsEscape)(unsigned char)>
+    inline std::size_t scalarScan(const char* s, std::size_t size) noexcept 
+    {
+      for ( std::size_t i = 0; i < size; ++i ) {
+        if ( TNeedsEscape(static_cast<unsigned char>(s[i])) ) {
+          return i;
+        }
+      }
+
+      return size;
+    }
+
+    inline constexpr Kernels scalar_kernels = {{scalarScan<jsonNeedsEscape>, scalarScan<urlNeedsEscape>, scalarScan<htmlNeedsEscape>}};
+
+#if defined(GBE_UTILITY_SIMD_X86)
+    /// All bytes of c that are less than or equal to limit, unsigned
+    inline __m128i sse2AtMost(__m128i c, char limit) noexcept 
+    {
+      return _mm_cmpeq_epi8(_mm_min_epu8(c, _mm_set1_epi8(limit)), c);
+    }
+
+    inline __m128i sse2Json(__m128i c) noexcept 
+    {
+      const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\\')));
+      return _mm_or_si128(sse2AtMost(c, 0x1F), special);
+    }
+
+    inline __m128i sse2Url(__m128i c) noexcept 
+    {
+      const __m128i letter = sse2AtMost(_mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a')), 25);
+      const __m128i digit = sse2AtMost(_mm_sub_epi8(c, _mm_set1_epi8('0')), 9);
+      const __m128i marks = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('-')), _mm_cmpeq_epi8(c, _mm_set1_epi8('.'))),
+                                         _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('_')), _mm_cmpeq_epi8(c, _mm_set1_epi8('~'))));
+      return _mm_xor_si128(_mm_or_si128(_mm_or_si128(letter, digit), marks), _mm_set1_epi8(-1));
+    }
+
+    inline __m128i sse2Html(__m128i c) noexcept 
+    {
+      const __m128i markup = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('&')), _mm_cmpeq_epi8(c, _mm_set1_epi8('<'))), _mm_cmpeq_epi8(c, _mm_set1_epi8('>')));
+      const __m128i quotes = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\'')));
+      return _mm_or_si128(markup, quotes);
+    }
+
+    template <__m128i (*TClassify)(__m128i), bool (*TNeedsEscape)(unsigned char)>
+    inline std::size_t sse2Scan(const char* s, std::size_t size) noexcept 
+    {
+      std::size_t i = 0;
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const unsigned mask = simd_detail::sse2Mask(TClassify(simd_detail::sse2Load(s + i)));
+
+        if ( 0 != mask ) {
+          return i + static_cast<std::size_t>(countr_zero(mask));
+        }
+      }
+
+      return i + scalarScan<TNeedsEscape>(s + i, size - i);
+    }
+
+    inline constexpr Kernels sse2_kernels = {{sse2Scan<sse2Json, jsonNeedsEscape>, sse2Scan<sse2Url, urlNeedsEscape>, sse2Scan<sse2Html, htmlNeedsEscape>}};
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2AtMost(__m256i c, char limit) noexcept 
+    {
+      return _mm256_cmpeq_epi8(_mm256_min_epu8(c, _mm256_set1_epi8(limit)), c);
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Json(__m256i c) noexcept 
+    {
+      const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\')));
+      return _mm256_or_si256(avx2AtMost(c, 0x1F), special);
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Url(__m256i c) noexcept 
+    {
+      const __m256i letter = avx2AtMost(_mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a')), 25);
+      const __m256i digit = avx2AtMost(_mm256_sub_epi8(c, _mm256_set1_epi8('0')), 9);
+      const __m256i marks = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('.'))),
+                                            _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('_')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('~'))));
+      return _mm256_xor_si256(_mm256_or_si256(_mm256_or_si256(letter, digit), marks), _mm256_set1_epi8(-1));
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Html(__m256i c) noexcept 
+    {
+      const __m256i markup = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('&')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('<'))), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('>')));
+      const __m256i quotes = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\'')));
+      return _mm256_or_si256(markup, quotes);
+    }
+
+    template <__m256i (*TClassify)(__m256i), __m128i (*TClassifyHalf)(__m128i), bool (*TNeedsEscape)(unsigned char)>
+    GBE_UTILITY_TARGET_AVX2 inline std::size_t avx2Scan(const char* s, std::size_t size) noexcept 
+    {
+      std::size_t i = 0;
+
+      for ( ; i + 32 <= size; i += 32 ) {
+        const std::uint32_t mask = simd_detail::avx2Mask(TClassify(simd_detail::avx2Load(s + i)));
+
+        if ( 0 != mask ) {
+          return i + static_cast<std::size_t>(countr_zero(mask));
+        }
+      }
+
+      return i + sse2Scan<TClassifyHalf, TNeedsEscape>(s + i, size - i);
+    }
+
+    inline constexpr Kernels avx2_kernels = {{avx2Scan<avx2Json, sse2Json, jsonNeedsEscape>, avx2Scan<avx2Url, sse2Url, urlNeedsEscape>, avx2Scan<avx2Html, sse2Html, htmlNeedsEscape>}};
+#endif
+
+#if defined(GBE_UTILITY_SIMD_NEON)
+    inline uint8x16_t neonJson(uint8x16_t c) noexcept 
+    {
+      const uint8x16_t special = vorrq_u8(vceqq_u8(c, vdupq_n_u8('"')), vceqq_u8(c, vdupq_n_u8('\\')));
+      return vorrq_u8(vcltq_u8(c, vdupq_n_u8(0x20)), special);
+    }
+
+    inline uint8x16_t neonUrl(uint8x16_t c) noexcept 
+    {
+      const uint8x16_t letter = vcltq_u8(vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a')), vdupq_n_u8(26));
+      const uint8x16_t digit = vcltq_u8(vsubq_u8(c, vdupq_n_u8('0')), vdupq_n_u8(10));
+      const uint8x16_t marks = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8('-')), vceqq_u8(c, vdupq_n_u8('.'))),
+                                        vorrq_u8(vceqq_u8(c, vdupq_n_u8('_')), vceqq_u8(c, vdupq_n_u8('~'))));
+      return vmvnq_u8(vorrq_u8(vorrq_u8(letter, digit), marks));
+    }
+
+    inline uint8x16_t neonHtml(uint8x16_t c) noexcept 
+    {
+      const uint8x16_t markup = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8('&')), vceqq_u8(c, vdupq_n_u8('<'))), vceqq_u8(c, vdupq_n_u8('>')));
+      const uint8x16_t quotes = vorrq_u8(vceqq_u8(c, vdupq_n_u8('"')), vceqq_u8(c, vdupq_n_u8('\'')));
+      return vorrq_u8(markup, quotes);
+    }
+
+    template <uint8x16_t (*TClassify)(uint8x16_t), bool (*TNeedsEscape)(unsigned char)>
+    inline std::size_t neonScan(const char* s, std::size_t size) noexcept 
+    {
+      std::size_t i = 0;
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const std::uint64_t mask = simd_detail::neonMask(TClassify(simd_detail::neonLoad(s + i)));
+
+        if ( 0 != mask ) {
+          return i + simd_detail::neonIndex(mask);
+        }
+      }
+
+      return i + scalarScan<TNeedsEscape>(s + i, size - i);
+    }
+
+    inline constexpr Kernels neon_kernels = {{neonScan<neonJson, jsonNeedsEscape>, neonScan<neonUrl, urlNeedsEscape>, neonScan<neonHtml, htmlNeedsEscape>}};
+#endif
+
+    /// The scanners of the given level, the scalar ones if the level is not supported
+    inline const Kernels& kernelsFor(SimdLevel level) noexcept 
+    {
+      switch ( level ) {
+#if defined(GBE_UTILITY_SIMD_X86)
+        case SimdLevel::SSE2:
+          return sse2_kernels;
+        case SimdLevel::AVX2:
+          return SimdLevel::AVX2 == simd_level() ? avx2_kernels : sse2_kernels;
+#endif
+#if defined(GBE_UTILITY_SIMD_NEON)
+        case SimdLevel::NEON:
+          return neon_kernels;
+#endif
+        default:
+          return scalar_kernels;
+      }
+    }
+
+    /// The scanners selected once for the running CPU
+    inline const Kernels& kernels() noexcept 
+    {
+      static const Kernels& selected = kernelsFor(simd_level());
+      return selected;
+    }
+
+    /// Writes the escape sequence of c to out, which has room for 6 characters, and returns its length
+    inline std::size_t encode(unsigned char c, Escape mode, char* out) noexcept 
+    {
+      static constexpr char hex[] = "0123456789ABCDEF";
+
+      if ( Escape::Url == mode ) {
+        out[0] = '%';
+        out[1] = hex[c >> 4];
+        out[2] = hex[c & 0x0F];
+        return 3;
+      }
+
+      if ( Escape::Html == mode ) {
+        const char* sequence = '&' == c ? "&amp;" : ('<' == c ? "&lt;" : ('>' == c ? "&gt;" : ('"' == c ? "&quot;" : "&#39;")));
+        const std::size_t length = std::strlen(sequence);
+
+        std::memcpy(out, sequence, length);
+        return length;
+      }
+
+      static constexpr char special[] = "\"\\\b\f\n\r\t";
+      static constexpr char replacement[] = "\"\\bfnrt";
+      const void* found = std::memchr(special, c, sizeof(special) - 1);
+
+      out[0] = '\\';
+
+      if ( nullptr != found ) {
+        out[1] = replacement[static_cast<const char*>(found) - special];
+        return 2;
+      }
+
+      std::memcpy(out + 1, "u00", 3);
+      out[4] = hex[c >> 4];
+      out[5] = hex[c & 0x0F];
+
+      return 6;
+    }
+  }
+
+  /**
+   * @brief Escape to
+   * 
+   * Escapes text into a raw output range, e.g. the free tail of a
+   * buffer. A vectorized scan finds the next character that needs
+   * escaping, the clean run before it is copied in bulk. An escape
+   * sequence and a UTF-8 code point are written entirely or not at all,
+   * so truncated output is still valid. A caller can continue with the
+   * unconsumed rest of the input in a new buffer.
+   * 
+   * @param out The output, not null terminated
+   * @param space The size of the output
+   * @param text The text to escape
+   * @param mode The encoding
+   * 
+   * @return The number of characters written and of input characters
+   * consumed
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline EscapeResult escape_to(char* out, std::size_t space, std::string_view text, Escape mode = Escape::Json) noexcept 
+  {
+    const escape_detail::Scan scan = escape_detail::kernels().scan[static_cast<int>(mode)];
+    EscapeResult result;
+
+    while ( result.consumed < text.size() ) {
+      const char* clean = text.data() + result.consumed;
+      const std::size_t run = scan(clean, text.size() - result.consumed);
+      const std::size_t room = space - result.written;
+      std::size_t copied = run < room ? run : room;
+
+      // A cut off run ends before the code point it would split, a code point has at most 3 continuation bytes
+      for ( std::size_t i = 0; i < 3 && copied < run && copied > 0 && 0x80 == (static_cast<unsigned char>(clean[copied]) & 0xC0); ++i ) {
+        --copied;
+      }
+
+      if ( copied > 0 ) {
+        std::memcpy(out + result.written, clean, copied);
+      }
+
+      result.written += copied;
+      result.consumed += copied;
+
+      if ( copied < run || result.consumed == text.size() ) {
+        break;
+      }
+
+      char sequence[6];
+      const std::size_t length = escape_detail::encode(static_cast<unsigned char>(text[result.consumed]), mode, sequence);
+
+      if ( length > space - result.written ) {
+        break;
+      }
+
+      std::memcpy(out + result.written, sequence, length);
+      result.written += length;
+      ++result.consumed;
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Escaped size
+   * 
+   * @param text The text to escape
+   * @param mode The encoding
+   * 
+   * @return The number of characters escape_to() needs for the complete
+   * text
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t escaped_size(std::string_view text, Escape mode = Escape::Json) noexcept 
+  {
+    const escape_detail::Scan scan = escape_detail::kernels().scan[static_cast<int>(mode)];
+    std::size_t size = 0;
+    std::size_t i = 0;
+
+    while ( i < text.size() ) {
+      const std::size_t run = scan(text.data() + i, text.size() - i);
+      char sequence[6];
+
+      size += run;
+      i += run;
+
+      if ( i < text.size() ) {
+        size += escape_detail::encode(static_cast<unsigned char>(text[i]), mode, sequence);
+        ++i;
+      }
+    }
+
+    return size;
+  }
+}
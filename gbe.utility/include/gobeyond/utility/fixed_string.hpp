@@ -0,0 +1,447 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace gobeyond::utility 
+{
+  namespace fixed_string_detail 
+  {
+    /// The number of characters of the decimal representation of value
+    template <typename T>
+    constexpr std::size_t digitCount(T value) noexcept 
+    {
+      std::size_t count = 1;
+
+      if constexpr ( std::is_signed_v<T> ) {
+        if ( value < 0 ) {
+          ++count;
+        }
+      }
+
+      while ( value / 10 != 0 ) {
+        value /= 10;
+        ++count;
+      }
+
+      return count;
+    }
+
+    /**
+     * Copies fmt from position up to the next conversion, "%%" becomes
+     * '%'. Returns true and moves position behind the conversion if
+     * there is one.
+     */
+    template <typename TString>
+    constexpr bool appendUntilConversion(TString& string, std::string_view fmt, std::size_t& position) noexcept 
+    {
+      while ( position < fmt.size() ) {
+        const std::size_t percent = fmt.find('%', position);
+
+        string.append(fmt.substr(position, percent - position));
+
+        if ( std::string_view::npos == percent || percent + 1 == fmt.size() ) {
+          if ( std::string_view::npos != percent ) {
+            string.append('%');
+          }
+
+          position = fmt.size();
+          return false;
+        }
+
+        position = percent + 2;
+
+        if ( '%' != fmt[percent + 1] ) {
+          return true;
+        }
+
+        string.append('%');
+      }
+
+      return false;
+    }
+  }
+
+  /**
+   * @brief FixedString
+   * 
+   * The compile-time counterpart of StringBuffer. All operations are
+   * constexpr, so tags, topic prefixes and static message headers can be
+   * built, concatenated and formatted entirely at compile time and end up
+   * in read-only data. Like StringBuffer the content is null terminated
+   * and cut off at the capacity.
+   * 
+   * The type is structural, in C++20 it can be used directly as a
+   * non-type template parameter:
+   * 
+   *     template <FixedString TTopic> class Publisher;
+   *     Publisher<"sensors/temperature"> publisher;
+   * 
+   * In C++17 a reference to a constexpr FixedString with static storage
+   * duration can be passed instead (template <const auto& TTopic>).
+   * 
+   * The members are public only because structural types require it,
+   * they must not be modified directly.
+   * 
+   * @tparam TCapacity The maximum number of characters, without the null terminator
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TCapacity>
+  struct FixedString 
+  {
+    /// The maximum number of characters
+    static constexpr std::size_t buffer_capacity = TCapacity;
+
+    /// Constructs an empty string
+    constexpr FixedString() noexcept = default;
+
+    /**
+     * @brief Constructor
+     * 
+     * Copies a string literal, the capacity is deduced from it.
+     * 
+     * @param literal The literal
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    constexpr FixedString(const char (&literal)[TCapacity + 1]) noexcept 
+    {
+      append(std::string_view(literal, TCapacity));
+    }
+
+    /**
+     * @brief Constructor
+     * 
+     * @param text The content, cut off at the capacity
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    constexpr explicit FixedString(std::string_view text) noexcept 
+    {
+      append(text);
+    }
+
+    /**
+     * @brief Append
+     * 
+     * @param text The string to append, cut off at the capacity
+     * 
+     * @return The string itself
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    constexpr FixedString& append(std::string_view text) noexcept 
+    {
+      for ( std::size_t i = 0; i < text.size() && m_size < TCapacity; ++i ) {
+        m_buffer[m_size++] = text[i];
+      }
+
+      m_buffer[m_size] = '\0';
+
+      return *this;
+    }
+
+    /**
+     * @brief Append
+     * 
+     * @param text The null terminated string to append, cut off at the capacity
+     * 
+     * @return The string itself
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    constexpr FixedString& append(const char* text) noexcept 
+    {
+      return append(std::string_view(text));
+    }
+
+    /**
+     * @brief Append
+     * 
+     * @param c The character to append
+     * 
+     * @return The string itself
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    constexpr FixedString& append(char c) noexcept 
+    {
+      return append(std::string_view(&c, 1));
+    }
+
+    /**
+     * @brief Append
+     * 
+     * @param value The boolean to append as true or false
+     * 
+     * @return The string itself
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    constexpr FixedString& append(bool value) noexcept 
+    {
+      return append(value ? std::string_view("true") : std::string_view("false"));
+    }
+
+    /**
+     * @brief Append
+     * 
+     * Appends the decimal representation of an integer.
+     * 
+     * @param value The integer to append
+     * 
+     * @return The string itself
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, int> = 0>
+    constexpr FixedString& append(T value) noexcept 
+    {
+      char digits[24] = {};
+      std::size_t count = 0;
+      const bool negative = value < 0;
+
+      // Digits are taken from the negative value, so the minimum does not overflow
+      do {
+        const int digit = static_cast<int>(value % 10);
+
+        digits[count++] = static_cast<char>('0' + (digit < 0 ? -digit : digit));
+        value /= 10;
+      } while ( 0 != value );
+
+      if ( negative ) {
+        digits[count++] = '-';
+      }
+
+      while ( count > 0 && m_size < TCapacity ) {
+        m_buffer[m_size++] = digits[--count];
+      }
+
+      m_buffer[m_size] = '\0';
+
+      return *this;
+    }
+
+    /**
+     * @brief Append format
+     * 
+     * A constexpr subset of printf: every conversion ("%s", "%d", ...)
+     * is replaced by the next argument, appended with the append()
+     * overload of its type, "%%" is a '%'. Flags, width and precision
+     * are not supported, neither are floating point arguments.
+     * Conversions without an argument are copied as they are, arguments
+     * without a conversion are ignored.
+     * 
+     * @param fmt The format string
+     * @param args The arguments
+     * 
+     * @return The string itself
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    template <typename... TArgs>
+    constexpr FixedString& append_format(std::string_view fmt, const TArgs&... args) noexcept 
+    {
+      static_assert((!std::is_floating_point_v<TArgs> && ...), "FixedString cannot format floating point values");
+
+      std::size_t position = 0;
+
+      ((fixed_string_detail::appendUntilConversion(*this, fmt, position) ? (void)append(args) : (void)0), ...);
+
+      while ( fixed_string_detail::appendUntilConversion(*this, fmt, position) ) {
+        append(fmt.substr(position - 2, 2));
+      }
+
+      return *this;
+    }
+
+    /**
+     * @brief Format
+     * 
+     * @param fmt The format string, see append_format()
+     * @param args The arguments
+     * 
+     * @return The formatted string, cut off at the capacity
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    template <typename... TArgs>
+    [[nodiscard]] static constexpr FixedString format(std::string_view fmt, const TArgs&... args) noexcept 
+    {
+      FixedString result;
+      result.append_format(fmt, args...);
+      return result;
+    }
+
+    /// Clears the content
+    constexpr void clear() noexcept 
+    {
+      m_size = 0;
+      m_buffer[0] = '\0';
+    }
+
+    /// The content
+    [[nodiscard]] constexpr std::string_view view() const noexcept 
+    {
+      return std::string_view(m_buffer, m_size);
+    }
+
+    /// The null terminated content
+    [[nodiscard]] constexpr const char* c_str() const noexcept 
+    {
+      return m_buffer;
+    }
+
+    /// The null terminated content
+    [[nodiscard]] constexpr const char* data() const noexcept 
+    {
+      return m_buffer;
+    }
+
+    /// The number of characters
+    [[nodiscard]] constexpr std::size_t size() const noexcept 
+    {
+      return m_size;
+    }
+
+    /// The maximum number of characters
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept 
+    {
+      return TCapacity;
+    }
+
+    /// true if the string has no characters
+    [[nodiscard]] constexpr bool empty() const noexcept 
+    {
+      return 0 == m_size;
+    }
+
+    [[nodiscard]] constexpr char operator[](std::size_t index) const noexcept 
+    {
+      return m_buffer[index];
+    }
+
+    [[nodiscard]] constexpr const char* begin() const noexcept 
+    {
+      return m_buffer;
+    }
+
+    [[nodiscard]] constexpr const char* end() const noexcept 
+    {
+      return m_buffer + m_size;
+    }
+
+    template <std::size_t TOtherCapacity>
+    [[nodiscard]] constexpr bool operator==(const FixedString<TOtherCapacity>& other) const noexcept 
+    {
+      return view() == other.view();
+    }
+
+    template <std::size_t TOtherCapacity>
+    [[nodiscard]] constexpr bool operator!=(const FixedString<TOtherCapacity>& other) const noexcept 
+    {
+      return view() != other.view();
+    }
+
+    [[nodiscard]] constexpr bool operator==(std::string_view other) const noexcept 
+    {
+      return view() == other;
+    }
+
+    [[nodiscard]] constexpr bool operator!=(std::string_view other) const noexcept 
+    {
+      return view() != other;
+    }
+
+    /// The characters, null terminated
+    char m_buffer[TCapacity + 1] = {};
+    /// The number of characters
+    std::size_t m_size = 0;
+  };
+
+  template <std::size_t TSize>
+  FixedString(const char (&)[TSize]) -> FixedString<TSize - 1>;
+
+  /**
+   * @brief Concatenation
+   * 
+   * @param a The first string
+   * @param b The second string
+   * 
+   * @return A string large enough for both
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TCapacityA, std::size_t TCapacityB>
+  [[nodiscard]] constexpr FixedString<TCapacityA + TCapacityB> operator+(const FixedString<TCapacityA>& a, const FixedString<TCapacityB>& b) noexcept 
+  {
+    FixedString<TCapacityA + TCapacityB> result;
+
+    result.append(a.view());
+    result.append(b.view());
+
+    return result;
+  }
+
+  template <std::size_t TCapacity, std::size_t TSize>
+  [[nodiscard]] constexpr FixedString<TCapacity + TSize - 1> operator+(const FixedString<TCapacity>& a, const char (&b)[TSize]) noexcept 
+  {
+    return a + FixedString<TSize - 1>(b);
+  }
+
+  template <std::size_t TSize, std::size_t TCapacity>
+  [[nodiscard]] constexpr FixedString<TSize - 1 + TCapacity> operator+(const char (&a)[TSize], const FixedString<TCapacity>& b) noexcept 
+  {
+    return FixedString<TSize - 1>(a) + b;
+  }
+
+  /**
+   * @brief To fixed string
+   * 
+   * Formats an integer constant into a string of exactly its length, e.g.
+   * to build "port " + to_fixed_string<1883>() at compile time.
+   * 
+   * @tparam TValue The integer
+   * 
+   * @return The decimal representation
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <auto TValue>
+  [[nodiscard]] constexpr FixedString<fixed_string_detail::digitCount(TValue)> to_fixed_string() noexcept 
+  {
+    static_assert(std::is_integral_v<decltype(TValue)> && !std::is_same_v<decltype(TValue), bool>, "TValue must be an integer");
+
+    FixedString<fixed_string_detail::digitCount(TValue)> result;
+    result.append(TValue);
+
+    return result;
+  }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/bits.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief FlagDispatchTable
+   * 
+   * Maps each flag to a handler. dispatch() visits only the enabled bits
+   * that have a handler, so fanning a message out to N handlers costs N
+   * indirect calls and no scan over the other flags. The table can be
+   * built as constexpr data, e.g.
+   * 
+   *   constexpr FlagDispatchTable<LogLocation, const Message&> table{
+   *     {LogLocation::LOGFILE, &writeFile},
+   *     {LogLocation::MQTT, &publish}
+   *   };
+   * 
+   * @tparam TEnum The flags, every handler is registered for a single bit
+   * @tparam TArgs The arguments passed to the handlers
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, typename... TArgs>
+  class FlagDispatchTable 
+  {
+    public:
+      using enum_type = TEnum;
+      using mask_type = BitMask<TEnum>;
+      using underlying_type = std::underlying_type_t<TEnum>;
+      /// The handler of a flag
+      using handler_type = void (*)(TArgs...);
+
+      /// The number of bits a flag may occupy
+      static constexpr std::size_t flag_count = 8 * sizeof(underlying_type);
+
+      /// A flag and its handler
+      struct Entry 
+      {
+        enum_type flag;
+        handler_type handler;
+      };
+
+      /**
+       * @brief Constructor
+       * 
+       * @param entries The handlers, a later entry for the same flag
+       * replaces an earlier one. Entries without handler or with a flag
+       * that is not a single bit are ignored.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      constexpr FlagDispatchTable(std::initializer_list<Entry> entries) noexcept
+        : m_handlers() 
+      {
+        for ( const Entry& entry : entries ) {
+          const std::uint64_t bit = toBits(entry.flag);
+
+          if ( 0 == bit || 0 != (bit & (bit - 1)) || nullptr == entry.handler ) {
+            continue;
+          }
+
+          m_handlers[countr_zero(bit)] = entry.handler;
+          m_handled |= bit;
+        }
+      }
+
+      /**
+       * @brief Dispatch
+       * 
+       * Calls the handler of every flag enabled in the mask, from the
+       * lowest to the highest bit.
+       * 
+       * @param mask The flags
+       * @param args The arguments passed to every handler
+       * 
+       * @return The number of handlers called
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline std::size_t dispatch(const mask_type& mask, TArgs... args) const 
+      {
+        std::uint64_t remaining = toBits(static_cast<enum_type>(static_cast<underlying_type>(mask))) & m_handled;
+        std::size_t called = 0;
+
+        for ( ; 0 != remaining; remaining &= remaining - 1 ) {
+          m_handlers[countr_zero(remaining)](args...);
+          ++called;
+        }
+
+        return called;
+      }
+
+      /**
+       * @brief Handles
+       * 
+       * @param flag A single flag
+       * 
+       * @return true if the flag has a handler
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] constexpr bool handles(const enum_type& flag) const noexcept 
+      {
+        return 0 != (toBits(flag) & m_handled);
+      }
+
+      /**
+       * @brief Handled
+       * 
+       * @return All flags with a handler
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] constexpr mask_type handled() const noexcept 
+      {
+        return mask_type(static_cast<enum_type>(static_cast<underlying_type>(m_handled)));
+      }
+
+    private:
+      static constexpr std::uint64_t toBits(const enum_type& flag) noexcept 
+      {
+        return static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<underlying_type>>(flag));
+      }
+
+      /// The handler of each bit, nullptr for bits without handler
+      handler_type m_handlers[flag_count];
+      /// The bits with a handler
+      std::uint64_t m_handled = 0;
+  };
+}
@@ -0,0 +1,1000 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include <gobeyond/utility/arena.hpp>
+#include <gobeyond/utility/numeric.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief FormatString
+   * 
+   * Tag base of all compile-time format strings. A format string type
+   * provides a static constexpr function value() returning the format
+   * text. Use the GBE_FMT macro to create one from a string literal.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct FormatString {};
+
+  /// True if the given type is a compile-time format string
+  template <typename T>
+  inline constexpr bool is_format_string_v = std::is_base_of_v<FormatString, T>;
+
+  /**
+   * @brief FormatConversion
+   * 
+   * The conversions understood by the compile-time format engine. They
+   * follow the printf conversion characters.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class FormatConversion : std::uint8_t 
+  {
+    Percent,              ///< %%
+    SignedDecimal,        ///< %d, %i
+    UnsignedDecimal,      ///< %u
+    Octal,                ///< %o
+    HexLower,             ///< %x
+    HexUpper,             ///< %X
+    Binary,               ///< %b
+    Character,            ///< %c
+    String,               ///< %s
+    FloatFixed,           ///< %f, %F
+    FloatScientific,      ///< %e
+    FloatScientificUpper, ///< %E
+    FloatGeneral,         ///< %g
+    FloatGeneralUpper,    ///< %G
+    Pointer               ///< %p
+  };
+
+  /**
+   * @brief FormatError
+   * 
+   * The result of validating a format string at compile time.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class FormatError : std::uint8_t 
+  {
+    None,
+    DanglingPercent,
+    UnsupportedConversion,
+    UnsupportedWidth
+  };
+
+  /**
+   * @brief FormatSpec
+   * 
+   * A single parsed conversion together with the literal text that
+   * precedes it.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct FormatSpec 
+  {
+    /// Offset of the preceding literal text in the format string
+    std::size_t literal_offset = 0;
+    /// Length of the preceding literal text
+    std::size_t literal_length = 0;
+    /// Index of the consumed argument (unused for %%)
+    std::size_t argument = 0;
+    /// The conversion
+    FormatConversion conversion = FormatConversion::Percent;
+    /// '-' flag
+    bool left_align = false;
+    /// '0' flag
+    bool zero_pad = false;
+    /// '+' flag
+    bool plus_sign = false;
+    /// ' ' flag
+    bool space_sign = false;
+    /// '#' flag
+    bool alternate = false;
+    /// Minimum field width (0 if none)
+    int width = 0;
+    /// Precision (-1 if none)
+    int precision = -1;
+  };
+
+  /**
+   * @brief FormatLayout
+   * 
+   * The complete compile-time representation of a format string.
+   * 
+   * @tparam TCount The number of conversions (including %%)
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TCount>
+  struct FormatLayout 
+  {
+    /// The conversions in order of appearance
+    FormatSpec specs[TCount == 0 ? 1 : TCount] = {};
+    /// Offset of the literal text after the last conversion
+    std::size_t tail_offset = 0;
+    /// Length of the literal text after the last conversion
+    std::size_t tail_length = 0;
+    /// Number of arguments consumed by the conversions
+    std::size_t arguments = 0;
+    /// The validation result
+    FormatError error = FormatError::None;
+  };
+
+  namespace format_detail 
+  {
+    struct ParseStep 
+    {
+      FormatSpec spec;
+      std::size_t next = 0;
+      bool found = false;
+      FormatError error = FormatError::None;
+    };
+
+    constexpr bool isDigit(char c) noexcept 
+    {
+      return c >= '0' && c <= '9';
+    }
+
+    constexpr ParseStep parseNext(std::string_view fmt, std::size_t pos) noexcept 
+    {
+      ParseStep step;
+      std::size_t i = pos;
+
+      while ( i < fmt.size() && fmt[i] != '%' ) {
+        ++i;
+      }
+
+      step.spec.literal_offset = pos;
+      step.spec.literal_length = i - pos;
+
+      if ( i == fmt.size() ) {
+        step.next = i;
+        return step;
+      }
+
+      step.found = true;
+      ++i;
+
+      for ( ; i < fmt.size(); ++i ) {
+        const char c = fmt[i];
+
+        if ( '-' == c ) {
+          step.spec.left_align = true;
+        } else if ( '0' == c ) {
+          step.spec.zero_pad = true;
+        } else if ( '+' == c ) {
+          step.spec.plus_sign = true;
+        } else if ( ' ' == c ) {
+          step.spec.space_sign = true;
+        } else if ( '#' == c ) {
+          step.spec.alternate = true;
+        } else {
+          break;
+        }
+      }
+
+      if ( i < fmt.size() && '*' == fmt[i] ) {
+        step.error = FormatError::UnsupportedWidth;
+        return step;
+      }
+
+      while ( i < fmt.size() && isDigit(fmt[i]) ) {
+        step.spec.width = step.spec.width * 10 + (fmt[i] - '0');
+        ++i;
+      }
+
+      if ( i < fmt.size() && '.' == fmt[i] ) {
+        ++i;
+
+        if ( i < fmt.size() && '*' == fmt[i] ) {
+          step.error = FormatError::UnsupportedWidth;
+          return step;
+        }
+
+        step.spec.precision = 0;
+
+        while ( i < fmt.size() && isDigit(fmt[i]) ) {
+          step.spec.precision = step.spec.precision * 10 + (fmt[i] - '0');
+          ++i;
+        }
+      }
+
+      // Length modifiers are accepted for compatibility; the argument type decides the width
+      while ( i < fmt.size() && (fmt[i] == 'h' || fmt[i] == 'l' || fmt[i] == 'L' || fmt[i] == 'z' || fmt[i] == 'j' || fmt[i] == 't' || fmt[i] == 'q') ) {
+        ++i;
+      }
+
+      if ( i == fmt.size() ) {
+        step.error = FormatError::DanglingPercent;
+        return step;
+      }
+
+      switch ( fmt[i] ) {
+        case '%': step.spec.conversion = FormatConversion::Percent; break;
+        case 'd':
+        case 'i': step.spec.conversion = FormatConversion::SignedDecimal; break;
+        case 'u': step.spec.conversion = FormatConversion::UnsignedDecimal; break;
+        case 'o': step.spec.conversion = FormatConversion::Octal; break;
+        case 'x': step.spec.conversion = FormatConversion::HexLower; break;
+        case 'X': step.spec.conversion = FormatConversion::HexUpper; break;
+        case 'b': step.spec.conversion = FormatConversion::Binary; break;
+        case 'c': step.spec.conversion = FormatConversion::Character; break;
+        case 's': step.spec.conversion = FormatConversion::String; break;
+        case 'f':
+        case 'F': step.spec.conversion = FormatConversion::FloatFixed; break;
+        case 'e': step.spec.conversion = FormatConversion::FloatScientific; break;
+        case 'E': step.spec.conversion = FormatConversion::FloatScientificUpper; break;
+        case 'g': step.spec.conversion = FormatConversion::FloatGeneral; break;
+        case 'G': step.spec.conversion = FormatConversion::FloatGeneralUpper; break;
+        case 'p': step.spec.conversion = FormatConversion::Pointer; break;
+        default:
+          step.error = FormatError::UnsupportedConversion;
+          return step;
+      }
+
+      step.next = i + 1;
+      return step;
+    }
+
+    constexpr std::size_t countSpecs(std::string_view fmt) noexcept 
+    {
+      std::size_t count = 0;
+      std::size_t pos = 0;
+
+      while ( pos < fmt.size() ) {
+        const ParseStep step = parseNext(fmt, pos);
+
+        if ( step.error != FormatError::None ) {
+          return count;
+        }
+
+        if ( step.found ) {
+          ++count;
+        }
+
+        pos = step.next;
+      }
+
+      return count;
+    }
+
+    template <std::size_t TCount>
+    constexpr FormatLayout<TCount> parse(std::string_view fmt) noexcept 
+    {
+      FormatLayout<TCount> layout;
+      std::size_t pos = 0;
+      std::size_t index = 0;
+
+      while ( pos < fmt.size() ) {
+        ParseStep step = parseNext(fmt, pos);
+
+        if ( step.error != FormatError::None ) {
+          layout.error = step.error;
+          return layout;
+        }
+
+        if ( !step.found ) {
+          layout.tail_offset = step.spec.literal_offset;
+          layout.tail_length = step.spec.literal_length;
+          return layout;
+        }
+
+        if ( step.spec.conversion != FormatConversion::Percent ) {
+          step.spec.argument = layout.arguments++;
+        }
+
+        layout.specs[index++] = step.spec;
+        pos = step.next;
+      }
+
+      layout.tail_offset = fmt.size();
+      layout.tail_length = 0;
+
+      return layout;
+    }
+
+    template <typename T>
+    using decay_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    template <typename T>
+    inline constexpr bool is_integer_v = std::is_integral_v<T> || std::is_enum_v<T>;
+
+    template <typename T>
+    inline constexpr bool is_string_v = std::is_convertible_v<const T&, std::string_view>
+      || std::is_constructible_v<const char*, const T&>;
+
+    template <typename T>
+    constexpr bool accepts(FormatConversion conversion) noexcept 
+    {
+      switch ( conversion ) {
+        case FormatConversion::Percent:
+          return true;
+        case FormatConversion::SignedDecimal:
+        case FormatConversion::UnsignedDecimal:
+        case FormatConversion::Octal:
+        case FormatConversion::HexLower:
+        case FormatConversion::HexUpper:
+        case FormatConversion::Binary:
+        case FormatConversion::Character:
+          return is_integer_v<T>;
+        case FormatConversion::String:
+          return is_string_v<T>;
+        case FormatConversion::FloatFixed:
+        case FormatConversion::FloatScientific:
+        case FormatConversion::FloatScientificUpper:
+        case FormatConversion::FloatGeneral:
+        case FormatConversion::FloatGeneralUpper:
+          return std::is_floating_point_v<T>;
+        case FormatConversion::Pointer:
+          return std::is_pointer_v<T> || std::is_null_pointer_v<T>;
+      }
+
+      return false;
+    }
+
+    /**
+     * Copies n bytes. The value range of n is hidden from GCC, which 
+     * otherwise expands copies into buffers of known size to rep movs, 
+     * which is much slower than the library memcpy for short strings.
+     */
+    inline void copyBytes(char* dst, const char* src, std::size_t n) noexcept 
+    {
+#if defined(__GNUC__)
+      asm("" : "+r"(n));
+#endif
+      std::memcpy(dst, src, n);
+    }
+
+    /**
+     * Writes into a fixed destination and keeps counting once the 
+     * destination is full, so the required length is known like with 
+     * snprintf.
+     */
+    class Writer 
+    {
+      public:
+        inline Writer(char* data, std::size_t capacity) noexcept
+          : m_data(data),
+            m_capacity(capacity)
+        {}
+
+        inline void put(char c) noexcept 
+        {
+          if ( m_length < m_capacity ) {
+            m_data[m_length] = c;
+          }
+
+          ++m_length;
+        }
+
+        inline void write(const char* s, std::size_t n) noexcept 
+        {
+          const std::size_t space = remaining();
+          copyBytes(m_data + (m_length < m_capacity ? m_length : m_capacity), s, n < space ? n : space);
+          m_length += n;
+        }
+
+        inline void fill(char c, std::size_t n) noexcept 
+        {
+          if ( m_length < m_capacity ) {
+            const std::size_t space = m_capacity - m_length;
+            std::memset(m_data + m_length, c, n < space ? n : space);
+          }
+
+          m_length += n;
+        }
+
+        /**
+         * Writes up to TMaxLength characters produced by func(first, last), 
+         * which returns the end of its output. The output goes straight 
+         * into the destination if it is guaranteed to fit.
+         */
+        template <std::size_t TMaxLength, typename TFunc>
+        inline void produce(TFunc&& func) noexcept 
+        {
+          if ( remaining() >= TMaxLength ) {
+            char* first = m_data + m_length;
+            m_length += static_cast<std::size_t>(func(first, first + TMaxLength) - first);
+            return;
+          }
+
+          char scratch[TMaxLength];
+          write(scratch, static_cast<std::size_t>(func(scratch, scratch + TMaxLength) - scratch));
+        }
+
+        /**
+         * Lets func(first, last) write into the free space. It returns the 
+         * end of its output, or nullptr if the output did not fit, in which 
+         * case nothing is written and false is returned.
+         */
+        template <typename TFunc>
+        inline bool tryProduce(TFunc&& func) noexcept 
+        {
+          char* first = m_data + written();
+          char* last = func(first, first + remaining());
+
+          if ( nullptr == last ) {
+            return false;
+          }
+
+          m_length += static_cast<std::size_t>(last - first);
+          return true;
+        }
+
+        [[nodiscard]] inline std::size_t remaining() const noexcept 
+        {
+          return m_length < m_capacity ? m_capacity - m_length : 0;
+        }
+
+        [[nodiscard]] inline std::size_t length() const noexcept 
+        {
+          return m_length;
+        }
+
+        [[nodiscard]] inline std::size_t written() const noexcept 
+        {
+          return m_length < m_capacity ? m_length : m_capacity;
+        }
+
+      private:
+        char* m_data;
+        std::size_t m_capacity;
+        std::size_t m_length = 0;
+    };
+
+    /// Writes prefix, zeros and a body of body_length characters written by write_body(), padded to the width
+    template <typename TBody>
+    inline void writePaddedWith(Writer& writer, const FormatSpec& spec, std::string_view prefix,
+      std::size_t zeros, std::size_t body_length, TBody&& write_body) noexcept 
+    {
+      const std::size_t content = prefix.size() + zeros + body_length;
+      const std::size_t width = static_cast<std::size_t>(spec.width);
+      std::size_t padding = width > content ? width - content : 0;
+
+      if ( padding > 0 && spec.zero_pad && !spec.left_align ) {
+        zeros += padding;
+        padding = 0;
+      }
+
+      if ( !spec.left_align ) {
+        writer.fill(' ', padding);
+      }
+
+      writer.write(prefix.data(), prefix.size());
+      writer.fill('0', zeros);
+      write_body();
+
+      if ( spec.left_align ) {
+        writer.fill(' ', padding);
+      }
+    }
+
+    inline void writePadded(Writer& writer, const FormatSpec& spec, std::string_view prefix,
+      std::size_t zeros, const char* body, std::size_t body_length) noexcept 
+    {
+      writePaddedWith(writer, spec, prefix, zeros, body_length, [&writer, body, body_length]() { writer.write(body, body_length); });
+    }
+
+    /// Formats a value whose digits do not fit the stack buffer of writeFloat() with snprintf
+    template <typename T>
+    inline void writeLongFloat(Writer& writer, const FormatSpec& spec, std::string_view prefix, T magnitude, int precision) noexcept 
+    {
+      char format[8] = {'%', '.', '*'};
+      std::size_t position = 3;
+
+      if constexpr ( std::is_same_v<T, long double> ) {
+        format[position++] = 'L';
+      }
+
+      switch ( spec.conversion ) {
+        case FormatConversion::FloatScientific: format[position] = 'e'; break;
+        case FormatConversion::FloatScientificUpper: format[position] = 'E'; break;
+        case FormatConversion::FloatGeneral: format[position] = 'g'; break;
+        case FormatConversion::FloatGeneralUpper: format[position] = 'G'; break;
+        default: format[position] = 'f'; break;
+      }
+
+      using print_type = std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+      const print_type value = static_cast<print_type>(magnitude);
+      const int length = std::snprintf(nullptr, 0, format, precision, value);
+
+      if ( length < 0 ) {
+        return;
+      }
+
+      const std::size_t body_length = static_cast<std::size_t>(length);
+
+      writePaddedWith(writer, spec, prefix, 0, body_length, [&]() {
+        // Straight into the destination if the digits and the terminator of snprintf fit
+        const bool fits = writer.tryProduce([&](char* first, char* last) -> char* {
+          if ( static_cast<std::size_t>(last - first) <= body_length ) {
+            return nullptr;
+          }
+
+          std::snprintf(first, body_length + 1, format, precision, value);
+          return first + body_length;
+        });
+
+        if ( fits ) {
+          return;
+        }
+
+        const std::unique_ptr<char[]> digits(new (std::nothrow) char[body_length + 1]);
+
+        if ( nullptr == digits ) {
+          // Keeps the length right, the digits are lost
+          writer.fill('#', body_length);
+          return;
+        }
+
+        std::snprintf(digits.get(), body_length + 1, format, precision, value);
+        writer.write(digits.get(), body_length);
+      });
+    }
+
+    inline std::string_view signPrefix(const FormatSpec& spec, bool negative) noexcept 
+    {
+      if ( negative ) {
+        return "-";
+      }
+
+      if ( spec.plus_sign ) {
+        return "+";
+      }
+
+      if ( spec.space_sign ) {
+        return " ";
+      }
+
+      return {};
+    }
+
+    inline void writeInteger(Writer& writer, FormatSpec spec, std::uint64_t magnitude, bool negative) noexcept 
+    {
+      char digits[64];
+      char* end = digits;
+      std::string_view prefix;
+
+      switch ( spec.conversion ) {
+        case FormatConversion::Octal: end = write_octal(digits, magnitude); break;
+        case FormatConversion::HexLower:
+        case FormatConversion::Pointer: end = write_hex(digits, magnitude, false); break;
+        case FormatConversion::HexUpper: end = write_hex(digits, magnitude, true); break;
+        case FormatConversion::Binary: end = write_binary(digits, magnitude); break;
+        default: end = write_decimal(digits, magnitude); break;
+      }
+
+      std::size_t length = static_cast<std::size_t>(end - digits);
+
+      if ( FormatConversion::SignedDecimal == spec.conversion || FormatConversion::UnsignedDecimal == spec.conversion ) {
+        prefix = signPrefix(spec, negative);
+      } else if ( FormatConversion::Pointer == spec.conversion ) {
+        prefix = "0x";
+      } else if ( spec.alternate && magnitude != 0 ) {
+        switch ( spec.conversion ) {
+          case FormatConversion::HexLower: prefix = "0x"; break;
+          case FormatConversion::HexUpper: prefix = "0X"; break;
+          case FormatConversion::Binary: prefix = "0b"; break;
+          default: prefix = "0"; break;
+        }
+      }
+
+      std::size_t zeros = 0;
+
+      if ( spec.precision >= 0 ) {
+        // An explicit precision is the minimum number of digits and disables the '0' flag
+        spec.zero_pad = false;
+
+        if ( 0 == spec.precision && 0 == magnitude ) {
+          length = 0;
+        } else if ( static_cast<std::size_t>(spec.precision) > length ) {
+          zeros = static_cast<std::size_t>(spec.precision) - length;
+        }
+      }
+
+      writePadded(writer, spec, prefix, zeros, digits, length);
+    }
+
+    template <typename T>
+    inline void writeFloat(Writer& writer, FormatSpec spec, T value) noexcept 
+    {
+      const bool negative = std::signbit(value);
+      const T magnitude = negative ? -value : value;
+      const int precision = spec.precision < 0 ? 6 : spec.precision;
+      const std::string_view prefix = signPrefix(spec, negative);
+
+      if ( !std::isfinite(magnitude) ) {
+        const bool upper = FormatConversion::FloatScientificUpper == spec.conversion
+          || FormatConversion::FloatGeneralUpper == spec.conversion;
+        const char* text = std::isnan(magnitude) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+
+        spec.zero_pad = false;
+        writePadded(writer, spec, prefix, 0, text, 3);
+        return;
+      }
+
+      std::chars_format format = std::chars_format::fixed;
+
+      switch ( spec.conversion ) {
+        case FormatConversion::FloatScientific:
+        case FormatConversion::FloatScientificUpper: format = std::chars_format::scientific; break;
+        case FormatConversion::FloatGeneral:
+        case FormatConversion::FloatGeneralUpper: format = std::chars_format::general; break;
+        default: break;
+      }
+
+      char digits[512];
+      char* end = nullptr;
+
+      if constexpr ( std::is_same_v<T, double> ) {
+        if ( std::chars_format::fixed == format ) {
+          end = write_fixed(digits, digits + sizeof(digits), magnitude, precision);
+        }
+      }
+
+      if ( nullptr == end ) {
+        const auto result = std::to_chars(digits, digits + sizeof(digits), magnitude, format, precision);
+        end = result.ec == std::errc() ? result.ptr : nullptr;
+      }
+
+      if ( nullptr == end ) {
+        writeLongFloat(writer, spec, prefix, magnitude, precision);
+        return;
+      }
+
+      const std::size_t length = static_cast<std::size_t>(end - digits);
+
+      if ( FormatConversion::FloatScientificUpper == spec.conversion || FormatConversion::FloatGeneralUpper == spec.conversion ) {
+        for ( std::size_t i = 0; i < length; ++i ) {
+          if ( 'e' == digits[i] ) {
+            digits[i] = 'E';
+          }
+        }
+      }
+
+      writePadded(writer, spec, prefix, 0, digits, length);
+    }
+
+    inline void writeString(Writer& writer, FormatSpec spec, std::string_view text) noexcept 
+    {
+      if ( spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < text.size() ) {
+        text = text.substr(0, static_cast<std::size_t>(spec.precision));
+      }
+
+      spec.zero_pad = false;
+      writePadded(writer, spec, {}, 0, text.data(), text.size());
+    }
+
+    /// A C string is only read up to precision characters, it does not need a terminator then
+    template <typename T>
+    inline std::string_view toStringView(const T& value, int precision = -1) noexcept 
+    {
+      if constexpr ( std::is_convertible_v<const T&, std::string_view> && !std::is_pointer_v<T> && !std::is_array_v<T> ) {
+        return std::string_view(value);
+      } else {
+        const char* s = static_cast<const char*>(value);
+
+        if ( nullptr == s ) {
+          return std::string_view("(null)");
+        }
+
+        if ( precision >= 0 ) {
+          const void* terminator = std::memchr(s, '\0', static_cast<std::size_t>(precision));
+          return std::string_view(s, nullptr == terminator ? static_cast<std::size_t>(precision) : static_cast<std::size_t>(static_cast<const char*>(terminator) - s));
+        }
+
+        return std::string_view(s, std::strlen(s));
+      }
+    }
+
+    /// True if the spec has no flags, width or precision
+    constexpr bool isPlain(const FormatSpec& spec) noexcept 
+    {
+      return !spec.left_align && !spec.zero_pad && !spec.plus_sign && !spec.space_sign && !spec.alternate
+        && 0 == spec.width && spec.precision < 0;
+    }
+
+    template <typename TSpec, typename T>
+    inline void writeArgument(Writer& writer, const T& value) noexcept 
+    {
+      constexpr FormatSpec spec = TSpec::value;
+
+      if constexpr ( is_integer_v<T> ) {
+        using integer_type = std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::common_type<T>>;
+        using value_type = std::conditional_t<std::is_same_v<typename integer_type::type, bool>, unsigned int, typename integer_type::type>;
+        using unsigned_type = std::make_unsigned_t<value_type>;
+
+        const value_type v = static_cast<value_type>(value);
+
+        if constexpr ( FormatConversion::Character == spec.conversion ) {
+          if constexpr ( isPlain(spec) ) {
+            writer.put(static_cast<char>(v));
+          } else {
+            const char c = static_cast<char>(v);
+            writeString(writer, spec, std::string_view(&c, 1));
+          }
+        } else if constexpr ( isPlain(spec) && (FormatConversion::SignedDecimal == spec.conversion || FormatConversion::UnsignedDecimal == spec.conversion) ) {
+          // Fast path: the digits go straight into the destination
+          writer.produce<24>([v](char* first, char*) noexcept {
+            if constexpr ( FormatConversion::UnsignedDecimal == spec.conversion ) {
+              return write_decimal(first, static_cast<unsigned_type>(v));
+            } else {
+              return write_decimal(first, v);
+            }
+          });
+        } else if constexpr ( FormatConversion::SignedDecimal == spec.conversion && std::is_signed_v<value_type> ) {
+          if ( v < 0 ) {
+            writeInteger(writer, spec, static_cast<std::uint64_t>(0 - static_cast<unsigned_type>(v)), true);
+          } else {
+            writeInteger(writer, spec, static_cast<std::uint64_t>(v), false);
+          }
+        } else if constexpr ( FormatConversion::SignedDecimal == spec.conversion || FormatConversion::UnsignedDecimal == spec.conversion ) {
+          writeInteger(writer, spec, static_cast<std::uint64_t>(static_cast<unsigned_type>(v)), false);
+        } else {
+          FormatSpec unsigned_spec = spec;
+          unsigned_spec.plus_sign = false;
+          unsigned_spec.space_sign = false;
+          writeInteger(writer, unsigned_spec, static_cast<std::uint64_t>(static_cast<unsigned_type>(v)), false);
+        }
+      } else if constexpr ( std::is_floating_point_v<T> ) {
+        using float_type = std::conditional_t<std::is_same_v<T, float>, double, T>;
+        const float_type v = static_cast<float_type>(value);
+
+        if constexpr ( 0 == spec.width && !spec.left_align && !spec.zero_pad && !spec.plus_sign && !spec.space_sign && !spec.alternate
+          && (FormatConversion::FloatFixed == spec.conversion || FormatConversion::FloatScientific == spec.conversion || FormatConversion::FloatGeneral == spec.conversion) ) {
+          // Fast path: finite values without padding go straight into the destination
+          constexpr std::chars_format format = FormatConversion::FloatFixed == spec.conversion ? std::chars_format::fixed
+            : FormatConversion::FloatScientific == spec.conversion ? std::chars_format::scientific : std::chars_format::general;
+          constexpr int precision = spec.precision < 0 ? 6 : spec.precision;
+
+          if ( std::isfinite(v) && writer.tryProduce([v](char* first, char* last) noexcept {
+                if constexpr ( std::chars_format::fixed == format && std::is_same_v<float_type, double> ) {
+                  return write_fixed(first, last, v, precision);
+                } else {
+                  const auto result = std::to_chars(first, last, v, format, precision);
+                  return result.ec == std::errc() ? result.ptr : nullptr;
+                }
+              }) ) {
+            return;
+          }
+        }
+
+        writeFloat<float_type>(writer, spec, v);
+      } else if constexpr ( std::is_pointer_v<T> && FormatConversion::String == spec.conversion ) {
+        const std::string_view text = toStringView(value, spec.precision);
+
+        if constexpr ( isPlain(spec) ) {
+          writer.write(text.data(), text.size());
+        } else {
+          writeString(writer, spec, text);
+        }
+      } else if constexpr ( std::is_pointer_v<T> ) {
+        if ( nullptr == value ) {
+          writeString(writer, spec, "(nil)");
+        } else {
+          writeInteger(writer, spec, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)), false);
+        }
+      } else if constexpr ( std::is_null_pointer_v<T> ) {
+        writeString(writer, spec, FormatConversion::Pointer == spec.conversion ? "(nil)" : "(null)");
+      } else if constexpr ( isPlain(spec) ) {
+        const std::string_view text = toStringView(value);
+        writer.write(text.data(), text.size());
+      } else {
+        writeString(writer, spec, toStringView(value, spec.precision));
+      }
+    }
+
+    template <typename TFormat>
+    struct Compiled 
+    {
+      static constexpr std::string_view text = TFormat::value();
+      static constexpr std::size_t count = countSpecs(text);
+      static constexpr FormatLayout<count> layout = parse<count>(text);
+
+      static_assert(layout.error != FormatError::DanglingPercent, "format string ends with an incomplete conversion");
+      static_assert(layout.error != FormatError::UnsupportedConversion, "format string contains an unsupported conversion");
+      static_assert(layout.error != FormatError::UnsupportedWidth, "format string uses '*' width or precision, which is not supported");
+    };
+
+    /// The conversion consuming the given argument, Percent if there is none
+    template <typename TFormat>
+    constexpr FormatConversion argumentConversion(std::size_t argument) noexcept 
+    {
+      using compiled = Compiled<TFormat>;
+
+      for ( std::size_t i = 0; i < compiled::count; ++i ) {
+        if ( FormatConversion::Percent != compiled::layout.specs[i].conversion && compiled::layout.specs[i].argument == argument ) {
+          return compiled::layout.specs[i].conversion;
+        }
+      }
+
+      return FormatConversion::Percent;
+    }
+
+    template <typename TFormat, typename... TArgs, std::size_t... TIndices>
+    constexpr bool acceptsAll(std::index_sequence<TIndices...>) noexcept 
+    {
+      return (accepts<decay_t<TArgs>>(argumentConversion<TFormat>(TIndices)) && ...);
+    }
+
+    /// Checks an argument list against a format string, shared by every entry point of the engine
+    template <typename TFormat, typename... TArgs>
+    struct Validated 
+    {
+      static_assert(Compiled<TFormat>::layout.arguments == sizeof...(TArgs), "number of format arguments does not match the format string");
+      static_assert(acceptsAll<TFormat, TArgs...>(std::index_sequence_for<TArgs...>()), "format argument type does not match its conversion");
+
+      static constexpr bool value = true;
+    };
+
+    template <typename TFormat, std::size_t TIndex>
+    struct SpecOf 
+    {
+      static constexpr FormatSpec value = Compiled<TFormat>::layout.specs[TIndex];
+    };
+
+    template <typename TFormat, std::size_t TIndex, typename TTuple>
+    inline void writeSpec(Writer& writer, const TTuple& args) noexcept 
+    {
+      using compiled = Compiled<TFormat>;
+      constexpr FormatSpec spec = SpecOf<TFormat, TIndex>::value;
+
+      if constexpr ( spec.literal_length > 0 ) {
+        writer.write(compiled::text.data() + spec.literal_offset, spec.literal_length);
+      }
+
+      if constexpr ( FormatConversion::Percent == spec.conversion ) {
+        writer.put('%');
+      } else {
+        using argument_type = decay_t<std::tuple_element_t<spec.argument, TTuple>>;
+        static_assert(accepts<argument_type>(spec.conversion), "format argument type does not match its conversion");
+
+        writeArgument<SpecOf<TFormat, TIndex>>(writer, std::get<spec.argument>(args));
+      }
+    }
+
+    template <typename TFormat, typename TTuple, std::size_t... TIndices>
+    inline void writeAll(Writer& writer, const TTuple& args, std::index_sequence<TIndices...>) noexcept 
+    {
+      using compiled = Compiled<TFormat>;
+
+      (writeSpec<TFormat, TIndices>(writer, args), ...);
+
+      if constexpr ( compiled::layout.tail_length > 0 ) {
+        writer.write(compiled::text.data() + compiled::layout.tail_offset, compiled::layout.tail_length);
+      }
+    }
+  }
+
+  /**
+   * @brief Format to
+   * 
+   * Formats the arguments into the given destination. The format string
+   * is parsed and checked against the argument types at compile time,
+   * a mismatch is a compile error. The destination is always null
+   * terminated if size is not 0.
+   * 
+   * @tparam TFormat The format string type (see GBE_FMT)
+   * @tparam TArgs The argument types
+   * 
+   * @param dst The destination
+   * @param size The size of the destination including the terminator
+   * @param fmt The format string
+   * @param args The arguments
+   * 
+   * @return The length of the complete output (like snprintf), a value
+   * not less than size means the output was truncated
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+  inline std::size_t format_to(char* dst, std::size_t size, TFormat fmt, const TArgs&... args) noexcept 
+  {
+    using compiled = format_detail::Compiled<TFormat>;
+    static_assert(format_detail::Validated<TFormat, TArgs...>::value);
+
+    (void)fmt;
+
+    format_detail::Writer writer(dst, size == 0 ? 0 : size - 1);
+    format_detail::writeAll<TFormat>(writer, std::forward_as_tuple(args...), std::make_index_sequence<compiled::count>());
+
+    if ( size > 0 ) {
+      dst[writer.written()] = '\0';
+    }
+
+    return writer.length();
+  }
+
+  /**
+   * @brief Format to
+   * 
+   * Formats the arguments into memory of the given arena, e.g. the
+   * thread_arena() inside a FrameScope. The output is written straight
+   * behind the last allocation and only formatted a second time if it
+   * does not fit into the current block.
+   * 
+   * @tparam TFormat The format string type (see GBE_FMT)
+   * @tparam TArgs The argument types
+   * 
+   * @param arena The arena
+   * @param fmt The format string
+   * @param args The arguments
+   * 
+   * @return The null terminated output, cut off if the arena is
+   * exhausted
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+  inline std::string_view format_to(MonotonicArena& arena, TFormat fmt, const TArgs&... args) noexcept 
+  {
+    char* first = static_cast<char*>(arena.allocate(0, 1));
+
+    if ( nullptr == first ) {
+      return std::string_view();
+    }
+
+    const std::size_t space = arena.remaining();
+    const std::size_t length = format_to(first, space, fmt, args...);
+
+    if ( length < space ) {
+      arena.extend(first, length + 1);
+      return std::string_view(first, length);
+    }
+
+    char* second = static_cast<char*>(arena.allocate(length + 1, 1));
+
+    if ( nullptr == second ) {
+      arena.extend(first, space);
+      return std::string_view(first, 0 == space ? 0 : space - 1);
+    }
+
+    format_to(second, length + 1, fmt, args...);
+    return std::string_view(second, length);
+  }
+}
+
+/**
+ * @brief GBE_FMT
+ * 
+ * Creates a compile-time format string from a string literal, e.g.
+ * StringBuffer<128>::format(GBE_FMT("%s=%d"), name, value).
+ * 
+ * @since 0.2
+ * 
+ * @author t.schwarzinger@dina.de
+ */
+#define GBE_FMT(literal) \
+  ([] { \
+    struct GbeFormatLiteral : ::gobeyond::utility::FormatString \
+    { \
+      static constexpr std::string_view value() noexcept { return literal; } \
+    }; \
+    return GbeFormatLiteral{}; \
+  }())
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace gobeyond::utility 
+{
+  namespace hash_detail 
+  {
+    /// The mixing constants, odd 64 bit values with balanced bits
+    inline constexpr std::uint64_t secret[4] = {
+      0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+    };
+
+    inline std::uint64_t read64(const unsigned char* p) noexcept 
+    {
+      std::uint64_t value;
+      std::memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    inline std::uint64_t read32(const unsigned char* p) noexcept 
+    {
+      std::uint32_t value;
+      std::memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    /// Reads 1 to 3 bytes without branching on the exact size
+    inline std::uint64_t readSmall(const unsigned char* p, std::size_t size) noexcept 
+    {
+      return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+    }
+
+    /// Multiplies a and b to 128 bit and returns the low half in a and the high half in b
+    inline void multiply(std::uint64_t& a, std::uint64_t& b) noexcept 
+    {
+#if defined(__SIZEOF_INT128__)
+      __extension__ using uint128 = unsigned __int128;
+      const uint128 product = static_cast<uint128>(a) * b;
+
+      a = static_cast<std::uint64_t>(product);
+      b = static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+      a = _umul128(a, b, &b);
+#else
+      const std::uint64_t ha = a >> 32;
+      const std::uint64_t hb = b >> 32;
+      const std::uint64_t la = static_cast<std::uint32_t>(a);
+      const std::uint64_t lb = static_cast<std::uint32_t>(b);
+      const std::uint64_t hh = ha * hb;
+      const std::uint64_t hl = ha * lb;
+      const std::uint64_t lh = la * hb;
+      const std::uint64_t ll = la * lb;
+      const std::uint64_t t = ll + (hl << 32);
+      const std::uint64_t lo = t + (lh << 32);
+      const std::uint64_t carry = static_cast<std::uint64_t>(t < ll) + static_cast<std::uint64_t>(lo < t);
+
+      a = lo;
+      b = hh + (hl >> 32) + (lh >> 32) + carry;
+#endif
+    }
+
+    /// Folds the 128 bit product of a and b to 64 bit
+    inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept 
+    {
+      multiply(a, b);
+      return a ^ b;
+    }
+  }
+
+  /**
+   * @brief Hash bytes
+   * 
+   * A fast non-cryptographic 64 bit hash in the style of wyhash. Inputs
+   * longer than 48 bytes are consumed by three independent multiply
+   * lanes, so the core loop is bound by the multiplier throughput rather
+   * than its latency. Inputs up to 16 bytes are read with two
+   * overlapping loads and need no loop at all.
+   * 
+   * The values depend on the byte order and may change between releases,
+   * they must not be persisted or sent over the wire.
+   * 
+   * @param data The bytes
+   * @param size The number of bytes
+   * @param seed The seed, use a random one for tables filled from untrusted input
+   * 
+   * @return The hash value
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept 
+  {
+    using hash_detail::mix;
+    using hash_detail::read32;
+    using hash_detail::read64;
+    using hash_detail::secret;
+
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+
+    seed ^= mix(seed ^ secret[0], secret[1]);
+
+    if ( size <= 16 ) {
+      if ( size >= 4 ) {
+        const std::size_t offset = (size >> 3) << 2;
+
+        a = (read32(p) << 32) | read32(p + offset);
+        b = (read32(p + size - 4) << 32) | read32(p + size - 4 - offset);
+      } else if ( size > 0 ) {
+        a = hash_detail::readSmall(p, size);
+      }
+    } else {
+      std::size_t remaining = size;
+
+      if ( remaining > 48 ) {
+        std::uint64_t lane1 = seed;
+        std::uint64_t lane2 = seed;
+
+        do {
+          seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+          lane1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ lane1);
+          lane2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ lane2);
+          p += 48;
+          remaining -= 48;
+        } while ( remaining > 48 );
+
+        seed ^= lane1 ^ lane2;
+      }
+
+      while ( remaining > 16 ) {
+        seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+        p += 16;
+        remaining -= 16;
+      }
+
+      // The last 16 bytes, overlapping with the ones already consumed
+      a = read64(p + remaining - 16);
+      b = read64(p + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    hash_detail::multiply(a, b);
+
+    return mix(a ^ secret[0] ^ size, b ^ secret[1]);
+  }
+
+  /**
+   * @brief Hash string
+   * 
+   * @param text The string
+   * @param seed The seed
+   * 
+   * @return The hash_bytes() value of the characters
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::uint64_t hash_string(std::string_view text, std::uint64_t seed = 0) noexcept 
+  {
+    return hash_bytes(text.data(), text.size(), seed);
+  }
+
+  /**
+   * @brief String equals
+   * 
+   * Compares the lengths first and the characters only if they match.
+   * Strings up to 16 characters are compared with two overlapping loads
+   * instead of a call to memcmp.
+   * 
+   * @param a The first string
+   * @param b The second string
+   * 
+   * @return true if both strings have the same characters, false otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline bool str_equals(std::string_view a, std::string_view b) noexcept 
+  {
+    const std::size_t size = a.size();
+
+    if ( size != b.size() ) {
+      return false;
+    }
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(a.data());
+    const unsigned char* q = reinterpret_cast<const unsigned char*>(b.data());
+
+    if ( p == q ) {
+      return true;
+    }
+
+    if ( size >= 8 ) {
+      if ( size > 16 ) {
+        return 0 == std::memcmp(p, q, size);
+      }
+
+      return 0 == ((hash_detail::read64(p) ^ hash_detail::read64(q)) | (hash_detail::read64(p + size - 8) ^ hash_detail::read64(q + size - 8)));
+    }
+
+    if ( size >= 4 ) {
+      return 0 == ((hash_detail::read32(p) ^ hash_detail::read32(q)) | (hash_detail::read32(p + size - 4) ^ hash_detail::read32(q + size - 4)));
+    }
+
+    for ( std::size_t i = 0; i < size; ++i ) {
+      if ( p[i] != q[i] ) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief StringHash
+   * 
+   * A transparent hash function object for unordered containers with
+   * string keys. Accepts everything convertible to std::string_view, as
+   * well as types with a view() member like StringBuffer and SpillString,
+   * so lookups need no temporary key.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct StringHash 
+  {
+    using is_transparent = void;
+
+    [[nodiscard]] inline std::size_t operator()(std::string_view text) const noexcept 
+    {
+      return static_cast<std::size_t>(hash_string(text));
+    }
+
+    template <typename T, typename = decltype(std::declval<const T&>().view())>
+    [[nodiscard]] inline std::size_t operator()(const T& text) const noexcept 
+    {
+      return static_cast<std::size_t>(hash_string(text.view()));
+    }
+  };
+
+  /**
+   * @brief StringEqual
+   * 
+   * The transparent equality counterpart of StringHash, based on
+   * str_equals().
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct StringEqual 
+  {
+    using is_transparent = void;
+
+    template <typename TA, typename TB>
+    [[nodiscard]] inline bool operator()(const TA& a, const TB& b) const noexcept 
+    {
+      return str_equals(toView(a), toView(b));
+    }
+
+    private:
+      static inline std::string_view toView(std::string_view text) noexcept 
+      {
+        return text;
+      }
+
+      template <typename T, typename = decltype(std::declval<const T&>().view())>
+      static inline std::string_view toView(const T& text) noexcept 
+      {
+        return text.view();
+      }
+  };
+}
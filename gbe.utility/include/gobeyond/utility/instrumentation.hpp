@@ -0,0 +1,478 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <gobeyond/utility/bits.hpp>
+
+/**
+ * @brief GBE_UTILITY_INSTRUMENTATION
+ * 
+ * Define as 1 for the whole program to let the utility primitives
+ * count and time their hot paths. With the default 0 every hook is an
+ * empty inline function and costs nothing.
+ * 
+ * @since 0.2
+ * 
+ * @author t.schwarzinger@dina.de
+ */
+#if !defined(GBE_UTILITY_INSTRUMENTATION)
+#define GBE_UTILITY_INSTRUMENTATION 0
+#endif
+
+#if GBE_UTILITY_INSTRUMENTATION
+#include <gobeyond/utility/thread_slots.hpp>
+#endif
+
+namespace gobeyond::utility 
+{
+  /// true if the program was built with GBE_UTILITY_INSTRUMENTATION
+  inline constexpr bool instrumentation_enabled = 0 != GBE_UTILITY_INSTRUMENTATION;
+
+  /**
+   * @brief Counter
+   * 
+   * The events counted by the instrumentation.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class Counter : std::size_t 
+  {
+    /// StringBuffer format and append_format calls
+    FormatCalls,
+    /// Characters written by format calls
+    FormatBytes,
+    /// Format calls whose output was cut off
+    FormatTruncations,
+    /// Bytes copied by StringBuffer copies
+    CopyBytes,
+    /// Bytes copied by StringBuffer moves
+    MoveBytes,
+    /// Messages pushed into a MessageQueue
+    QueuePushes,
+    /// Messages a MessageQueue dropped
+    QueueDrops,
+    /// Messages a MessageQueue overwrote
+    QueueOverwrites,
+    /// Messages taken out of a MessageQueue
+    QueueConsumed,
+    /// Buffers taken out of a StringBufferPool
+    PoolAcquires,
+    /// Acquisitions of an exhausted StringBufferPool
+    PoolExhausted
+  };
+
+  /// The number of counters
+  inline constexpr std::size_t counter_count = static_cast<std::size_t>(Counter::PoolExhausted) + 1;
+
+  /**
+   * @brief Histogram
+   * 
+   * The distributions recorded by the instrumentation.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class Histogram : std::size_t 
+  {
+    /// Nanoseconds spent in StringBuffer format and append_format
+    FormatLatency,
+    /// The complete output length of format calls, including what was cut off
+    FormatLength,
+    /// Nanoseconds spent in MessageQueue emplace, including back-pressure
+    QueuePushLatency
+  };
+
+  /// The number of histograms
+  inline constexpr std::size_t histogram_count = static_cast<std::size_t>(Histogram::QueuePushLatency) + 1;
+
+  namespace instrumentation_detail 
+  {
+    /// Every power of two is split into 2^sub_bucket_bits linear buckets, which bounds the error to 1/16
+    inline constexpr unsigned sub_bucket_bits = 4;
+    /// Values from 2^max_exponent on share the last bucket (about 18 minutes in nanoseconds)
+    inline constexpr unsigned max_exponent = 40;
+
+    inline constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+    inline constexpr std::size_t bucket_count = (max_exponent - sub_bucket_bits + 1) << sub_bucket_bits;
+
+    [[nodiscard]] constexpr std::size_t bucketOf(std::uint64_t value) noexcept 
+    {
+      if ( value < sub_bucket_count ) {
+        return static_cast<std::size_t>(value);
+      }
+
+      const unsigned exponent = static_cast<unsigned>(63 - countl_zero(value));
+
+      if ( exponent >= max_exponent ) {
+        return bucket_count - 1;
+      }
+
+      const std::uint64_t mantissa = value >> (exponent - sub_bucket_bits);
+      return ((exponent - sub_bucket_bits + 1) << sub_bucket_bits) + static_cast<std::size_t>(mantissa - sub_bucket_count);
+    }
+
+    [[nodiscard]] constexpr std::uint64_t bucketLowerBound(std::size_t bucket) noexcept 
+    {
+      if ( bucket < sub_bucket_count ) {
+        return bucket;
+      }
+
+      const unsigned exponent = static_cast<unsigned>(bucket >> sub_bucket_bits) + sub_bucket_bits - 1;
+      const std::uint64_t mantissa = (bucket & (sub_bucket_count - 1)) + sub_bucket_count;
+
+      return mantissa << (exponent - sub_bucket_bits);
+    }
+  }
+
+  /**
+   * @brief HistogramSnapshot
+   * 
+   * A merged copy of a histogram. Values are kept in log-linear buckets
+   * like in an HDR histogram, so quantiles are accurate to 1/16 of the
+   * value over the whole range.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct HistogramSnapshot 
+  {
+    /// The number of buckets
+    static constexpr std::size_t bucket_count = instrumentation_detail::bucket_count;
+
+    /// The number of recorded values
+    std::uint64_t count = 0;
+    /// The sum of the recorded values
+    std::uint64_t sum = 0;
+    /// The largest recorded value
+    std::uint64_t max = 0;
+    /// The number of values per bucket
+    std::array<std::uint64_t, bucket_count> buckets{};
+
+    /**
+     * @brief Mean
+     * 
+     * @return The mean of the recorded values, 0 if there are none
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    [[nodiscard]] inline double mean() const noexcept 
+    {
+      return 0 == count ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+    }
+
+    /**
+     * @brief Quantile
+     * 
+     * @param q The quantile between 0 and 1, e.g. 0.99
+     * 
+     * @return An upper bound of the value below which the fraction q of
+     * the recorded values lie, 0 if there are none
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    [[nodiscard]] inline std::uint64_t quantile(double q) const noexcept 
+    {
+      if ( 0 == count ) {
+        return 0;
+      }
+
+      const double position = std::ceil(q * static_cast<double>(count));
+      const std::uint64_t rank = position < 1.0 ? 1 : (position >= static_cast<double>(count) ? count : static_cast<std::uint64_t>(position));
+
+      std::uint64_t seen = 0;
+
+      for ( std::size_t bucket = 0; bucket < bucket_count; ++bucket ) {
+        seen += buckets[bucket];
+
+        if ( seen >= rank ) {
+          const std::uint64_t upper = bucket + 1 < bucket_count ? instrumentation_detail::bucketLowerBound(bucket + 1) - 1 : max;
+          return upper < max ? upper : max;
+        }
+      }
+
+      return max;
+    }
+  };
+
+  /**
+   * @brief InstrumentationSnapshot
+   * 
+   * The counters and histograms of all threads merged at one point.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  struct InstrumentationSnapshot 
+  {
+    /// The counters, indexed by Counter
+    std::array<std::uint64_t, counter_count> counters{};
+    /// The histograms, indexed by Histogram
+    std::array<HistogramSnapshot, histogram_count> histograms{};
+
+    /**
+     * @brief Counter
+     * 
+     * @param counter The counter
+     * 
+     * @return The value of the counter
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    [[nodiscard]] inline std::uint64_t counter(Counter counter) const noexcept 
+    {
+      return counters[static_cast<std::size_t>(counter)];
+    }
+
+    /**
+     * @brief Histogram
+     * 
+     * @param histogram The histogram
+     * 
+     * @return The merged histogram
+     * 
+     * @since 0.2
+     * 
+     * @author t.schwarzinger@dina.de
+     */
+    [[nodiscard]] inline const HistogramSnapshot& histogram(Histogram histogram) const noexcept 
+    {
+      return histograms[static_cast<std::size_t>(histogram)];
+    }
+  };
+
+#if GBE_UTILITY_INSTRUMENTATION
+  namespace instrumentation_detail 
+  {
+    /// The maximum number of threads with their own shard, further threads share one
+    inline constexpr std::size_t shard_count = 64;
+
+    struct HistogramShard 
+    {
+      std::atomic<std::uint64_t> sum{0};
+      std::atomic<std::uint64_t> max{0};
+      std::atomic<std::uint64_t> buckets[bucket_count] = {};
+    };
+
+    struct Shard 
+    {
+      std::atomic<std::uint64_t> counters[counter_count] = {};
+      HistogramShard histograms[histogram_count];
+    };
+
+    /// Adds to a counter, shards owned by a single thread do without a read-modify-write
+    inline void add(std::atomic<std::uint64_t>& value, std::uint64_t n, bool shared) noexcept 
+    {
+      if ( shared ) {
+        value.fetch_add(n, std::memory_order_relaxed);
+      } else {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      }
+    }
+
+    inline void raise(std::atomic<std::uint64_t>& value, std::uint64_t n) noexcept 
+    {
+      std::uint64_t current = value.load(std::memory_order_relaxed);
+
+      while ( current < n && !value.compare_exchange_weak(current, n, std::memory_order_relaxed) ) {
+      }
+    }
+
+    class Registry 
+    {
+      public:
+        inline Shard& local(bool& shared) noexcept 
+        {
+          Shard* shard = m_shards.local();
+          shared = nullptr == shard;
+
+          return shared ? m_shared : *shard;
+        }
+
+        template <typename TFunc>
+        inline void each(TFunc&& func) const noexcept 
+        {
+          for ( std::size_t i = 0; i < m_shards.count(); ++i ) {
+            func(m_shards[i]);
+          }
+
+          func(m_shared);
+        }
+
+      private:
+        /// The shards of the threads, kept when a thread exits so totals never go down
+        ThreadSlots<Shard> m_shards{shard_count};
+        /// The shard of the threads that did not get one of their own
+        Shard m_shared;
+    };
+
+    inline Registry& registry() noexcept 
+    {
+      static Registry instance;
+      return instance;
+    }
+  }
+#endif
+
+  /**
+   * @brief Instrument count
+   * 
+   * Adds to a counter of the calling thread. Does nothing unless built
+   * with GBE_UTILITY_INSTRUMENTATION.
+   * 
+   * @param counter The counter
+   * @param n The amount to add
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline void instrument_count([[maybe_unused]] Counter counter, [[maybe_unused]] std::uint64_t n = 1) noexcept 
+  {
+#if GBE_UTILITY_INSTRUMENTATION
+    bool shared = false;
+    instrumentation_detail::Shard& shard = instrumentation_detail::registry().local(shared);
+    instrumentation_detail::add(shard.counters[static_cast<std::size_t>(counter)], n, shared);
+#endif
+  }
+
+  /**
+   * @brief Instrument record
+   * 
+   * Records a value in a histogram of the calling thread. Does nothing
+   * unless built with GBE_UTILITY_INSTRUMENTATION.
+   * 
+   * @param histogram The histogram
+   * @param value The value
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline void instrument_record([[maybe_unused]] Histogram histogram, [[maybe_unused]] std::uint64_t value) noexcept 
+  {
+#if GBE_UTILITY_INSTRUMENTATION
+    bool shared = false;
+    instrumentation_detail::HistogramShard& shard = instrumentation_detail::registry().local(shared).histograms[static_cast<std::size_t>(histogram)];
+
+    instrumentation_detail::add(shard.buckets[instrumentation_detail::bucketOf(value)], 1, shared);
+    instrumentation_detail::add(shard.sum, value, shared);
+    instrumentation_detail::raise(shard.max, value);
+#endif
+  }
+
+  /**
+   * @brief Instrumentation snapshot
+   * 
+   * Merges the counters and histograms of all threads. Writers are not
+   * stopped, a value recorded during the merge may or may not be part
+   * of the snapshot.
+   * 
+   * @return The merged values, all 0 unless built with
+   * GBE_UTILITY_INSTRUMENTATION
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline InstrumentationSnapshot instrumentation_snapshot() noexcept 
+  {
+    InstrumentationSnapshot snapshot;
+
+#if GBE_UTILITY_INSTRUMENTATION
+    instrumentation_detail::registry().each([&snapshot](const instrumentation_detail::Shard& shard) {
+      for ( std::size_t i = 0; i < counter_count; ++i ) {
+        snapshot.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+      }
+
+      for ( std::size_t h = 0; h < histogram_count; ++h ) {
+        const instrumentation_detail::HistogramShard& source = shard.histograms[h];
+        HistogramSnapshot& target = snapshot.histograms[h];
+
+        for ( std::size_t b = 0; b < HistogramSnapshot::bucket_count; ++b ) {
+          const std::uint64_t n = source.buckets[b].load(std::memory_order_relaxed);
+          target.buckets[b] += n;
+          target.count += n;
+        }
+
+        target.sum += source.sum.load(std::memory_order_relaxed);
+
+        const std::uint64_t max = source.max.load(std::memory_order_relaxed);
+        target.max = max > target.max ? max : target.max;
+      }
+    });
+#endif
+
+    return snapshot;
+  }
+
+  /**
+   * @brief InstrumentationTimer
+   * 
+   * Records the nanoseconds between construction and destruction in a
+   * histogram. Does not read the clock unless built with
+   * GBE_UTILITY_INSTRUMENTATION.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class InstrumentationTimer 
+  {
+    public:
+      /**
+       * @brief Constructor
+       * 
+       * @param histogram The histogram the duration is recorded in
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit inline InstrumentationTimer(Histogram histogram) noexcept
+        : m_histogram(histogram),
+          m_start(now()) 
+      {
+      }
+
+      InstrumentationTimer(const InstrumentationTimer&) = delete;
+      InstrumentationTimer& operator=(const InstrumentationTimer&) = delete;
+
+      inline ~InstrumentationTimer() 
+      {
+        if constexpr ( instrumentation_enabled ) {
+          instrument_record(m_histogram, now() - m_start);
+        }
+      }
+
+    private:
+      static inline std::uint64_t now() noexcept 
+      {
+        if constexpr ( instrumentation_enabled ) {
+          return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        } else {
+          return 0;
+        }
+      }
+
+      /// The histogram the duration is recorded in
+      Histogram m_histogram;
+      /// The start in nanoseconds
+      std::uint64_t m_start;
+  };
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include <gobeyond/utility/hash.hpp>
+#include <gobeyond/utility/thread_slots.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief InternTable
+   * 
+   * Maps strings to stable, dense 32 bit ids, so hot loops can compare
+   * and aggregate ids instead of message text (for example rate limiting
+   * identical alerts). Ids are handed out in insertion order starting at
+   * 0 and stay valid for the lifetime of the table, the interned text is
+   * copied into a buffer owned by the table.
+   * 
+   * The table is an open addressing hash table with a fixed capacity,
+   * allocated up front. Every slot is a single atomic word holding 32
+   * bits of the hash and the id, so find() and interning an already
+   * known string are lock-free and never write shared memory. Inserting
+   * a new string reserves a slot with a compare-and-swap, a thread that
+   * interns the very same string at the same moment waits until the
+   * reservation is published.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  class InternTable 
+  {
+    public:
+      /// Returned if a string is unknown or could not be interned because the table is full
+      static constexpr std::uint32_t invalid_id = UINT32_MAX;
+
+      /**
+       * @brief Constructor
+       * 
+       * Allocates the slots, the id directory and the text buffer.
+       * 
+       * @param capacity The maximum number of strings
+       * @param text_capacity The maximum number of characters of all strings together
+       * @param seed The hash seed, use a random one if the strings come from untrusted input
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      InternTable(std::size_t capacity, std::size_t text_capacity, std::uint64_t seed = 0)
+        : m_capacity(capacity < invalid_id - 1 ? capacity : invalid_id - 2),
+          m_text_capacity(text_capacity),
+          m_seed(seed) 
+      {
+        // At most half of the slots are used, which keeps the probe sequences short
+        std::size_t slot_count = 2;
+
+        while ( slot_count < 2 * m_capacity ) {
+          slot_count <<= 1;
+        }
+
+        m_mask = slot_count - 1;
+        m_slots.reset(new std::atomic<std::uint64_t>[slot_count]);
+        m_entries.reset(new Entry[m_capacity > 0 ? m_capacity : 1]);
+        m_text.reset(new char[text_capacity > 0 ? text_capacity : 1]);
+
+        for ( std::size_t i = 0; i < slot_count; ++i ) {
+          m_slots[i].store(0, std::memory_order_relaxed);
+        }
+      }
+
+      InternTable(const InternTable&) = delete;
+      InternTable& operator=(const InternTable&) = delete;
+
+      /**
+       * @brief Intern
+       * 
+       * Returns the id of text, adding it to the table if it is not known
+       * yet.
+       * 
+       * @param text The string
+       * 
+       * @return The id, invalid_id if text is new and the table or its text
+       * buffer is full
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] std::uint32_t intern(std::string_view text) noexcept 
+      {
+        const std::uint64_t hash = hash_string(text, m_seed);
+        const std::uint64_t tag = hash >> 32;
+        std::size_t index = static_cast<std::size_t>(hash) & m_mask;
+
+        for ( std::size_t probe = 0; probe <= m_mask; ++probe, index = (index + 1) & m_mask ) {
+          std::atomic<std::uint64_t>& slot = m_slots[index];
+          std::uint64_t value = slot.load(std::memory_order_acquire);
+
+          for ( ;; ) {
+            if ( 0 == value ) {
+              // text is unknown, a full table must not use up the free slots the probe sequences end at
+              if ( !hasRoom(text) ) {
+                return invalid_id;
+              }
+
+              if ( !slot.compare_exchange_weak(value, pack(tag, pending), std::memory_order_acquire, std::memory_order_acquire) ) {
+                continue;
+              }
+
+              const std::uint32_t id = insert(text);
+
+              // A failed reservation stays occupied, other strings may already be probed past it.
+              // This only happens if other threads filled the table after hasRoom()
+              slot.store(pack(tag, invalid_id == id ? unused : id + 1), std::memory_order_release);
+
+              return id;
+            }
+
+            if ( (value >> 32) != tag || unused == static_cast<std::uint32_t>(value) ) {
+              break;
+            }
+
+            if ( pending == static_cast<std::uint32_t>(value) ) {
+              // Possibly the same string, wait until the other thread published it
+              std::this_thread::yield();
+              value = slot.load(std::memory_order_acquire);
+              continue;
+            }
+
+            const std::uint32_t id = static_cast<std::uint32_t>(value) - 1;
+
+            if ( str_equals(view(id), text) ) {
+              return id;
+            }
+
+            break;
+          }
+        }
+
+        return invalid_id;
+      }
+
+      /**
+       * @brief Find
+       * 
+       * Looks text up without adding it. Strings that are inserted by
+       * another thread at the same moment may not be found yet.
+       * 
+       * @param text The string
+       * 
+       * @return The id, invalid_id if text is not interned
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] std::uint32_t find(std::string_view text) const noexcept 
+      {
+        const std::uint64_t hash = hash_string(text, m_seed);
+        const std::uint64_t tag = hash >> 32;
+        std::size_t index = static_cast<std::size_t>(hash) & m_mask;
+
+        for ( std::size_t probe = 0; probe <= m_mask; ++probe, index = (index + 1) & m_mask ) {
+          const std::uint64_t value = m_slots[index].load(std::memory_order_acquire);
+
+          if ( 0 == value ) {
+            return invalid_id;
+          }
+
+          if ( (value >> 32) == tag && pending != static_cast<std::uint32_t>(value) && unused != static_cast<std::uint32_t>(value) ) {
+            const std::uint32_t id = static_cast<std::uint32_t>(value) - 1;
+
+            if ( str_equals(view(id), text) ) {
+              return id;
+            }
+          }
+        }
+
+        return invalid_id;
+      }
+
+      /**
+       * @brief View
+       * 
+       * @param id An id returned by intern() or find()
+       * 
+       * @return The interned string, empty for invalid_id
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::string_view view(std::uint32_t id) const noexcept 
+      {
+        if ( id >= m_capacity ) {
+          return std::string_view();
+        }
+
+        const Entry& entry = m_entries[id];
+
+        return std::string_view(entry.data, entry.size);
+      }
+
+      /// The number of interned strings, includes insertions still in progress
+      [[nodiscard]] inline std::size_t size() const noexcept 
+      {
+        const std::size_t count = m_count.load(std::memory_order_relaxed);
+
+        return count < m_capacity ? count : m_capacity;
+      }
+
+      /// The maximum number of strings
+      [[nodiscard]] inline std::size_t capacity() const noexcept 
+      {
+        return m_capacity;
+      }
+
+      /// The number of characters used in the text buffer
+      [[nodiscard]] inline std::size_t text_size() const noexcept 
+      {
+        return m_text_used.load(std::memory_order_relaxed);
+      }
+
+      /// The size of the text buffer
+      [[nodiscard]] inline std::size_t text_capacity() const noexcept 
+      {
+        return m_text_capacity;
+      }
+
+    private:
+      /// The lower half of a slot that is reserved but not yet published
+      static constexpr std::uint32_t pending = UINT32_MAX;
+      /// The lower half of a slot whose reservation failed because the table was full
+      static constexpr std::uint32_t unused = UINT32_MAX - 1;
+
+      struct Entry 
+      {
+        const char* data = nullptr;
+        std::size_t size = 0;
+      };
+
+      /// A slot holds the upper half of the hash and the id + 1, so 0 marks a free slot
+      static inline std::uint64_t pack(std::uint64_t tag, std::uint32_t low) noexcept 
+      {
+        return (tag << 32) | low;
+      }
+
+      /// true if there is an id and enough text buffer left for text
+      inline bool hasRoom(std::string_view text) const noexcept 
+      {
+        return m_count.load(std::memory_order_relaxed) < m_capacity
+          && text.size() <= m_text_capacity - m_text_used.load(std::memory_order_relaxed);
+      }
+
+      /// Takes an id and copies the text, called with the slot reserved
+      std::uint32_t insert(std::string_view text) noexcept 
+      {
+        std::size_t used = m_text_used.load(std::memory_order_relaxed);
+
+        do {
+          if ( text.size() > m_text_capacity - used ) {
+            return invalid_id;
+          }
+        } while ( !m_text_used.compare_exchange_weak(used, used + text.size(), std::memory_order_relaxed) );
+
+        std::size_t count = m_count.load(std::memory_order_relaxed);
+
+        do {
+          if ( count >= m_capacity ) {
+            // Give the text back, unless another thread reserved text behind it in the meantime
+            std::size_t reserved = used + text.size();
+            m_text_used.compare_exchange_strong(reserved, used, std::memory_order_relaxed);
+            return invalid_id;
+          }
+        } while ( !m_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed) );
+
+        Entry& entry = m_entries[count];
+
+        if ( !text.empty() ) {
+          std::memcpy(m_text.get() + used, text.data(), text.size());
+        }
+
+        entry.data = m_text.get() + used;
+        entry.size = text.size();
+
+        return static_cast<std::uint32_t>(count);
+      }
+
+      /// The maximum number of strings
+      std::size_t m_capacity;
+      /// The size of the text buffer
+      std::size_t m_text_capacity;
+      /// The hash seed
+      std::uint64_t m_seed;
+      /// The number of slots - 1
+      std::size_t m_mask = 0;
+      /// The hash table
+      std::unique_ptr<std::atomic<std::uint64_t>[]> m_slots;
+      /// The strings by id
+      std::unique_ptr<Entry[]> m_entries;
+      /// The interned characters
+      std::unique_ptr<char[]> m_text;
+      /// The number of ids handed out
+      alignas(cache_line_size) std::atomic<std::size_t> m_count{0};
+      /// The number of characters used in m_text
+      alignas(cache_line_size) std::atomic<std::size_t> m_text_used{0};
+  };
+}
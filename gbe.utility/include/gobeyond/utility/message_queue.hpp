@@ -0,0 +1,508 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/instrumentation.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+#include <gobeyond/utility/thread_slots.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief BackPressure
+   * 
+   * What a producer does when the queue is full.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class BackPressure 
+  {
+    /// Discard the new message
+    Drop,
+    /// Discard the oldest unconsumed message to make room
+    OverwriteOldest,
+    /// Busy wait until the consumer made room
+    Spin,
+    /// Sleep until the consumer made room
+    Block
+  };
+
+  namespace message_queue_detail 
+  {
+    /// Tells the CPU that the thread is spinning
+    inline void relax() noexcept 
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+      __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+      asm volatile("yield");
+#else
+      std::this_thread::yield();
+#endif
+    }
+
+    /// Spins for the first attempts, then gives the time slice away so a descheduled thread can make progress
+    inline void backOff(std::size_t& attempt) noexcept 
+    {
+      if ( attempt < 64 ) {
+        ++attempt;
+        relax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    inline std::size_t roundUpToPowerOfTwo(std::size_t value) noexcept 
+    {
+      std::size_t result = 2;
+
+      while ( result < value ) {
+        result <<= 1;
+      }
+
+      return result;
+    }
+  }
+
+  /**
+   * @brief RoutedMessage
+   * 
+   * A text and the sinks it is meant for.
+   * 
+   * @tparam TEnum The route flags
+   * @tparam TBufferSize The size of the buffer
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, std::size_t TBufferSize>
+  struct RoutedMessage 
+  {
+    /// The sinks the message is meant for
+    BitMask<TEnum> route;
+    /// The text
+    StringBuffer<TBufferSize> text;
+  };
+
+  /**
+   * @brief MessageQueue
+   * 
+   * A bounded multi-producer/single-consumer ring of StringBuffer
+   * messages, each carrying a BitMask route. Every slot has a sequence
+   * number telling producers and the consumer whose turn it is (Vyukov),
+   * so an uncontended enqueue is one compare-and-swap on the tail plus
+   * the copy into the slot. Slots, head and tail live on their own cache
+   * lines.
+   * 
+   * @tparam TEnum The route flags
+   * @tparam TBufferSize The size of the message buffers
+   * @tparam TPolicy What producers do when the queue is full
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, std::size_t TBufferSize, BackPressure TPolicy = BackPressure::Drop>
+  class MessageQueue 
+  {
+    public:
+      /// The route type
+      using route_type = BitMask<TEnum>;
+      /// The message buffer type
+      using buffer_type = StringBuffer<TBufferSize>;
+      /// The message type
+      using Message = RoutedMessage<TEnum, TBufferSize>;
+
+      /// The back-pressure policy
+      static constexpr BackPressure policy = TPolicy;
+      /// The maximum number of messages handed to a batch consumer at once
+      static constexpr std::size_t max_batch_size = 64;
+
+      /**
+       * @brief Statistics
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      struct Statistics 
+      {
+        /// The number of slots
+        std::size_t capacity = 0;
+        /// The number of messages waiting for the consumer
+        std::size_t size = 0;
+        /// The number of messages discarded by the Drop policy
+        std::uint64_t dropped = 0;
+        /// The number of messages discarded by the OverwriteOldest policy
+        std::uint64_t overwritten = 0;
+      };
+
+      /**
+       * @brief Constructor
+       * 
+       * @param capacity The minimum number of slots, rounded up to a power of two
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit MessageQueue(std::size_t capacity)
+        : m_capacity(message_queue_detail::roundUpToPowerOfTwo(capacity)),
+          m_mask(m_capacity - 1),
+          m_slots(new Slot[m_capacity]) 
+      {
+        for ( std::size_t i = 0; i < m_capacity; ++i ) {
+          m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+      }
+
+      MessageQueue(const MessageQueue&) = delete;
+      MessageQueue& operator=(const MessageQueue&) = delete;
+
+      /**
+       * @brief Emplace
+       * 
+       * Claims a slot and lets the writer fill the cleared buffer in place.
+       * If the writer throws, the slot is published as skipped, the consumer
+       * never sees it, and the exception is rethrown.
+       * 
+       * @param route The sinks the message is meant for
+       * @param writer Called with the buffer_type& of the claimed slot
+       * 
+       * @return false if the message was dropped
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TWriter>
+      bool emplace(const route_type& route, TWriter&& writer) 
+      {
+        InstrumentationTimer timer(Histogram::QueuePushLatency);
+        Slot* slot = claim();
+
+        if ( nullptr == slot ) {
+          return false;
+        }
+
+        instrument_count(Counter::QueuePushes);
+
+        slot->message.route = route;
+        slot->message.text.clear();
+
+        try {
+          writer(slot->message.text);
+        } catch ( ... ) {
+          // An unpublished slot would stop the consumer for good
+          slot->skipped = true;
+          slot->sequence.store(slot->pending + 1, std::memory_order_release);
+          throw;
+        }
+
+        slot->skipped = false;
+        slot->sequence.store(slot->pending + 1, std::memory_order_release);
+
+        return true;
+      }
+
+      /**
+       * @brief Push
+       * 
+       * @param route The sinks the message is meant for
+       * @param text The text, truncated to the buffer size
+       * 
+       * @return false if the message was dropped
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool push(const route_type& route, std::string_view text) 
+      {
+        return emplace(route, [text](buffer_type& buffer) { buffer.assign(text); });
+      }
+
+      /**
+       * @brief Consume
+       * 
+       * Hands the waiting messages to func one by one. Must only be
+       * called from the consumer thread.
+       * 
+       * @param func Called with const Message&
+       * @param max The maximum number of messages to consume
+       * 
+       * @return The number of consumed messages
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFunc>
+      std::size_t consume(TFunc&& func, std::size_t max = SIZE_MAX) 
+      {
+        return consume_batch([&func](const Message* const* messages, std::size_t count) {
+          for ( std::size_t i = 0; i < count; ++i ) {
+            func(*messages[i]);
+          }
+        }, max);
+      }
+
+      /**
+       * @brief Consume batch
+       * 
+       * Hands the waiting messages to func in batches of up to
+       * max_batch_size, so a sink can write them with a single call.
+       * The slots are given back after func returns. Must only be called
+       * from the consumer thread.
+       * 
+       * @param func Called with (const Message* const* messages, std::size_t count)
+       * @param max The maximum number of messages to consume
+       * 
+       * @return The number of consumed messages
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFunc>
+      std::size_t consume_batch(TFunc&& func, std::size_t max = SIZE_MAX) 
+      {
+        const Message* batch[max_batch_size];
+        std::size_t total = 0;
+
+        while ( total < max ) {
+          const std::size_t limit = max - total < max_batch_size ? max - total : max_batch_size;
+          std::size_t head = m_head.load(std::memory_order_relaxed);
+          std::size_t count = 0;
+
+          while ( count < limit && m_slots[(head + count) & m_mask].sequence.load(std::memory_order_acquire) == head + count + 1 ) {
+            ++count;
+          }
+
+          if ( 0 == count ) {
+            break;
+          }
+
+          if constexpr ( BackPressure::OverwriteOldest == TPolicy ) {
+            // Producers may steal the oldest slots, so the consumer has to claim them too
+            if ( !m_head.compare_exchange_strong(head, head + count, std::memory_order_acquire, std::memory_order_relaxed) ) {
+              continue;
+            }
+          } else {
+            m_head.store(head + count, std::memory_order_relaxed);
+          }
+
+          std::size_t delivered = 0;
+
+          for ( std::size_t i = 0; i < count; ++i ) {
+            const Slot& slot = m_slots[(head + i) & m_mask];
+
+            if ( !slot.skipped ) {
+              batch[delivered++] = &slot.message;
+            }
+          }
+
+          if ( 0 != delivered ) {
+            func(static_cast<const Message* const*>(batch), delivered);
+          }
+
+          for ( std::size_t i = 0; i < count; ++i ) {
+            m_slots[(head + i) & m_mask].sequence.store(head + i + m_capacity, std::memory_order_release);
+          }
+
+          total += delivered;
+          instrument_count(Counter::QueueConsumed, delivered);
+
+          if constexpr ( BackPressure::Block == TPolicy ) {
+            wakeProducers();
+          }
+        }
+
+        return total;
+      }
+
+      /**
+       * @brief Empty
+       * 
+       * @return true if no message is ready for the consumer
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool empty() const noexcept 
+      {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        return m_slots[head & m_mask].sequence.load(std::memory_order_acquire) != head + 1;
+      }
+
+      /**
+       * @brief Capacity
+       * 
+       * @return The number of slots
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t capacity() const noexcept 
+      {
+        return m_capacity;
+      }
+
+      /**
+       * @brief Statistics
+       * 
+       * @return A snapshot of the queue counters
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] Statistics statistics() const noexcept 
+      {
+        Statistics stats;
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        stats.capacity = m_capacity;
+        stats.size = tail > head ? tail - head : 0;
+        stats.dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.overwritten = m_overwritten.load(std::memory_order_relaxed);
+
+        return stats;
+      }
+
+    private:
+      struct alignas(cache_line_size) Slot 
+      {
+        /// pos: free for the producer of pos, pos + 1: ready for the consumer, pos + capacity: free for the next round
+        std::atomic<std::size_t> sequence{0};
+        /// The position claimed by the producer writing the slot
+        std::size_t pending = 0;
+        /// Set if the writer threw, the consumer releases the slot without handing it out
+        bool skipped = false;
+        /// The message
+        Message message;
+      };
+
+      /// Claims the slot for the next position, applies the policy if the queue is full
+      Slot* claim() 
+      {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        std::size_t attempt = 0;
+
+        for ( ;; ) {
+          Slot* slot = &m_slots[tail & m_mask];
+          const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+          const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - tail);
+
+          if ( 0 == difference ) {
+            if ( m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed, std::memory_order_relaxed) ) {
+              slot->pending = tail;
+              return slot;
+            }
+          } else if ( difference > 0 ) {
+            // Another producer took the position
+            tail = m_tail.load(std::memory_order_relaxed);
+          } else {
+            if constexpr ( BackPressure::Drop == TPolicy ) {
+              m_dropped.fetch_add(1, std::memory_order_relaxed);
+              instrument_count(Counter::QueueDrops);
+              return nullptr;
+            } else if constexpr ( BackPressure::OverwriteOldest == TPolicy ) {
+              discardOldest(tail);
+            } else if constexpr ( BackPressure::Spin == TPolicy ) {
+              message_queue_detail::backOff(attempt);
+            } else {
+              waitForRoom(tail);
+            }
+
+            tail = m_tail.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      /// Takes the oldest published message away from the consumer if it is the one blocking tail
+      void discardOldest(std::size_t tail) noexcept 
+      {
+        std::size_t head = m_head.load(std::memory_order_acquire);
+
+        if ( head + m_capacity != tail ) {
+          // The consumer already holds the blocking slot in a batch, wait until it releases it
+          message_queue_detail::relax();
+          return;
+        }
+
+        Slot& slot = m_slots[head & m_mask];
+
+        if ( slot.sequence.load(std::memory_order_acquire) != head + 1 ) {
+          // Not published yet or already taken, let the owner finish
+          message_queue_detail::relax();
+          return;
+        }
+
+        if ( m_head.compare_exchange_strong(head, head + 1, std::memory_order_acquire, std::memory_order_relaxed) ) {
+          slot.sequence.store(head + m_capacity, std::memory_order_release);
+          m_overwritten.fetch_add(1, std::memory_order_relaxed);
+          instrument_count(Counter::QueueOverwrites);
+        }
+      }
+
+      void waitForRoom(std::size_t tail) 
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_waiters.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the fence in wakeProducers, either the consumer sees the waiter or the waiter sees the room
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        m_room.wait(lock, [this, tail]() {
+          return m_slots[tail & m_mask].sequence.load(std::memory_order_acquire) == tail
+            || m_tail.load(std::memory_order_relaxed) != tail;
+        });
+
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      void wakeProducers() 
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( m_waiters.load(std::memory_order_seq_cst) > 0 ) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_room.notify_all();
+        }
+      }
+
+      /// The number of slots
+      const std::size_t m_capacity;
+      /// m_capacity - 1
+      const std::size_t m_mask;
+      /// The slots
+      std::unique_ptr<Slot[]> m_slots;
+      /// The next position to consume
+      alignas(cache_line_size) std::atomic<std::size_t> m_head{0};
+      /// The next position to produce
+      alignas(cache_line_size) std::atomic<std::size_t> m_tail{0};
+      /// Policy counters, only touched when the queue is full
+      alignas(cache_line_size) std::atomic<std::uint64_t> m_dropped{0};
+      std::atomic<std::uint64_t> m_overwritten{0};
+      /// Producers sleeping in waitForRoom (Block policy)
+      std::atomic<std::size_t> m_waiters{0};
+      std::mutex m_mutex;
+      std::condition_variable m_room;
+  };
+}
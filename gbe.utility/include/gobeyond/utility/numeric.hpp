@@ -0,0 +1,347 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <gobeyond/utility/bits.hpp>
+
+namespace gobeyond::utility 
+{
+  namespace numeric_detail 
+  {
+    inline constexpr char digit_pairs[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+
+    inline constexpr std::uint64_t powers_of_10[] = {
+      1ull,
+      10ull,
+      100ull,
+      1000ull,
+      10000ull,
+      100000ull,
+      1000000ull,
+      10000000ull,
+      100000000ull,
+      1000000000ull,
+      10000000000ull,
+      100000000000ull,
+      1000000000000ull,
+      10000000000000ull,
+      100000000000000ull,
+      1000000000000000ull,
+      10000000000000000ull,
+      100000000000000000ull,
+      1000000000000000000ull,
+      10000000000000000000ull
+    };
+
+    inline constexpr char hex_lower[] = "0123456789abcdef";
+    inline constexpr char hex_upper[] = "0123456789ABCDEF";
+
+    /// Writes exactly count digits of value backwards from last, two at a time
+    template <typename TUnsigned>
+    inline void writeDigitsBackwards(char* last, TUnsigned value) noexcept 
+    {
+      while ( value >= 100 ) {
+        const std::size_t index = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        last -= 2;
+        std::memcpy(last, digit_pairs + index, 2);
+      }
+
+      if ( value >= 10 ) {
+        std::memcpy(last - 2, digit_pairs + static_cast<std::size_t>(value) * 2, 2);
+      } else {
+        *(last - 1) = static_cast<char>('0' + value);
+      }
+    }
+
+    /// Writes value in a power of two base with at least min_digits digits
+    template <int TBits>
+    inline char* writePowerOfTwo(char* first, std::uint64_t value, int min_digits, const char* alphabet) noexcept 
+    {
+      const int significant = 64 - countl_zero(value | 1);
+      int digits = (significant + TBits - 1) / TBits;
+
+      if ( digits < min_digits ) {
+        digits = min_digits;
+      }
+
+      char* last = first + digits;
+
+      for ( char* p = last; p != first; value >>= TBits ) {
+        *--p = alphabet[value & ((1u << TBits) - 1)];
+      }
+
+      return last;
+    }
+  }
+
+  /// The maximum number of characters written by write_decimal for T
+  template <typename T>
+  inline constexpr std::size_t max_decimal_length_v = static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 1 + (std::is_signed_v<T> ? 1 : 0);
+
+  /**
+   * @brief Decimal digits
+   * 
+   * Counts the decimal digits of a value without dividing.
+   * 
+   * @param value The value
+   * 
+   * @return The number of decimal digits (1 for 0)
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] constexpr int decimal_digits(std::uint64_t value) noexcept 
+  {
+    // log10(2) ~ 1233 / 4096 gives the digit count up to an off by one
+    const int guess = ((64 - countl_zero(value | 1)) * 1233) >> 12;
+
+    return guess + ((value | 1) >= numeric_detail::powers_of_10[guess] ? 1 : 0);
+  }
+
+  /**
+   * @brief Decimal length
+   * 
+   * @tparam T The integer type
+   * 
+   * @param value The value
+   * 
+   * @return The number of characters write_decimal writes for the value
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  [[nodiscard]] constexpr std::size_t decimal_length(T value) noexcept 
+  {
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    if constexpr ( std::is_signed_v<T> ) {
+      if ( value < 0 ) {
+        return 1 + static_cast<std::size_t>(decimal_digits(static_cast<unsigned_type>(0 - static_cast<unsigned_type>(value))));
+      }
+    }
+
+    return static_cast<std::size_t>(decimal_digits(static_cast<unsigned_type>(value)));
+  }
+
+  /**
+   * @brief Write decimal
+   * 
+   * Writes the decimal representation of an integer using a digit pair
+   * table. The destination needs room for max_decimal_length_v<T>
+   * characters, no terminator is written.
+   * 
+   * @tparam T The integer type
+   * 
+   * @param first The destination
+   * @param value The value
+   * 
+   * @return The end of the written characters
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  inline char* write_decimal(char* first, T value) noexcept 
+  {
+    using unsigned_type = std::make_unsigned_t<T>;
+    // 32 bit division is a lot cheaper than 64 bit division on 32 bit ARM
+    using work_type = std::conditional_t<(sizeof(T) <= 4), std::uint32_t, std::uint64_t>;
+
+    work_type magnitude = static_cast<work_type>(static_cast<unsigned_type>(value));
+
+    if constexpr ( std::is_signed_v<T> ) {
+      if ( value < 0 ) {
+        *first++ = '-';
+        magnitude = static_cast<work_type>(static_cast<unsigned_type>(0 - static_cast<unsigned_type>(value)));
+      }
+    }
+
+    char* last = first + decimal_digits(magnitude);
+    numeric_detail::writeDigitsBackwards(last, magnitude);
+
+    return last;
+  }
+
+  /**
+   * @brief Write hex
+   * 
+   * Writes the hexadecimal representation of a value without prefix.
+   * The destination needs room for max(16, min_digits) characters.
+   * 
+   * @param first The destination
+   * @param value The value
+   * @param upper Use upper case digits
+   * @param min_digits The minimum number of digits, padded with zeros
+   * 
+   * @return The end of the written characters
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline char* write_hex(char* first, std::uint64_t value, bool upper = false, int min_digits = 1) noexcept 
+  {
+    return numeric_detail::writePowerOfTwo<4>(first, value, min_digits, upper ? numeric_detail::hex_upper : numeric_detail::hex_lower);
+  }
+
+  /**
+   * @brief Write octal
+   * 
+   * Writes the octal representation of a value without prefix. The
+   * destination needs room for max(22, min_digits) characters.
+   * 
+   * @param first The destination
+   * @param value The value
+   * @param min_digits The minimum number of digits, padded with zeros
+   * 
+   * @return The end of the written characters
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline char* write_octal(char* first, std::uint64_t value, int min_digits = 1) noexcept 
+  {
+    return numeric_detail::writePowerOfTwo<3>(first, value, min_digits, numeric_detail::hex_lower);
+  }
+
+  /**
+   * @brief Write binary
+   * 
+   * Writes the binary representation of a value without prefix. The
+   * destination needs room for max(64, min_digits) characters.
+   * 
+   * @param first The destination
+   * @param value The value
+   * @param min_digits The minimum number of digits, padded with zeros
+   * 
+   * @return The end of the written characters
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline char* write_binary(char* first, std::uint64_t value, int min_digits = 1) noexcept 
+  {
+    return numeric_detail::writePowerOfTwo<1>(first, value, min_digits, numeric_detail::hex_lower);
+  }
+
+  /**
+   * @brief Write shortest
+   * 
+   * Writes the shortest representation of a floating point value that
+   * reads back to the same value.
+   * 
+   * @tparam T The floating point type
+   * 
+   * @param first The destination
+   * @param last The end of the destination
+   * @param value The value
+   * 
+   * @return The end of the written characters, nullptr if the
+   * destination is too small
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+  inline char* write_shortest(char* first, char* last, T value) noexcept 
+  {
+    const auto result = std::to_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+
+  /**
+   * @brief Write fixed
+   * 
+   * Writes a floating point value with a fixed number of fractional
+   * digits, rounded exactly like printf("%.*f"). Values that can be
+   * scaled to an integer without losing the rounding decision take a
+   * fast integer path, everything else goes through std::to_chars.
+   * 
+   * @param first The destination
+   * @param last The end of the destination
+   * @param value The value
+   * @param precision The number of fractional digits
+   * 
+   * @return The end of the written characters, nullptr if the
+   * destination is too small
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline char* write_fixed(char* first, char* last, double value, int precision) noexcept 
+  {
+    if ( precision >= 0 && precision <= 9 && std::isfinite(value) ) {
+      const bool negative = std::signbit(value);
+      const double scaled = std::fabs(value) * static_cast<double>(numeric_detail::powers_of_10[precision]);
+
+      // Below 2^43 the scaled value keeps at least ten fractional bits
+      if ( scaled < 8796093022208.0 ) {
+        const double integral = std::floor(scaled);
+        const double fraction = scaled - integral;
+        const double distance = std::fabs(fraction - 0.5);
+
+        // The multiplication is off by at most half an ulp. Closer to a tie the decision needs exact arithmetic
+        if ( distance > scaled * 0x1p-50 + 0x1p-60 ) {
+          const std::uint64_t rounded = static_cast<std::uint64_t>(integral) + (fraction > 0.5 ? 1 : 0);
+          const std::uint64_t divisor = numeric_detail::powers_of_10[precision];
+          const std::uint64_t whole = rounded / divisor;
+          const std::uint64_t part = rounded % divisor;
+          const std::size_t length = (negative ? 1u : 0u) + static_cast<std::size_t>(decimal_digits(whole))
+            + (precision > 0 ? 1u + static_cast<std::size_t>(precision) : 0u);
+
+          if ( static_cast<std::size_t>(last - first) < length ) {
+            return nullptr;
+          }
+
+          char* p = first;
+
+          if ( negative ) {
+            *p++ = '-';
+          }
+
+          p = write_decimal(p, whole);
+
+          if ( precision > 0 ) {
+            *p++ = '.';
+            p += precision;
+            std::memset(p - precision, '0', static_cast<std::size_t>(precision));
+
+            if ( part > 0 ) {
+              numeric_detail::writeDigitsBackwards(p, part);
+            }
+          }
+
+          return p;
+        }
+      }
+    }
+
+    const auto result = std::to_chars(first, last, value, std::chars_format::fixed, precision);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+}
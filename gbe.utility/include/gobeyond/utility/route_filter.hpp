@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include <gobeyond/utility/atomic_bitmask.hpp>
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief RouteFilter
+   * 
+   * The active route configuration, checked before a message is
+   * formatted. The configuration may be changed by one thread while any
+   * number of threads filter, a check is a single relaxed load of an
+   * AtomicBitMask and a branch.
+   * 
+   * @tparam TEnum The route flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum>
+  class RouteFilter 
+  {
+    public:
+      /// The route type
+      using route_type = BitMask<TEnum>;
+      /// The underlying type of the route flags
+      using underlying_type = typename route_type::underlying_type;
+
+      /**
+       * @brief Constructor
+       * 
+       * @param active The enabled routes
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit RouteFilter(const route_type& active = route_type()) noexcept
+        : m_active(active)
+      {}
+
+      RouteFilter(const RouteFilter&) = delete;
+      RouteFilter& operator=(const RouteFilter&) = delete;
+
+      /**
+       * @brief Set
+       * 
+       * Replaces the enabled routes. Messages already past the filter are
+       * still formatted.
+       * 
+       * @param active The enabled routes
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void set(const route_type& active) noexcept 
+      {
+        m_active.store(active, std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Active
+       * 
+       * @return The enabled routes
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline route_type active() const noexcept 
+      {
+        return m_active.snapshot(std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Accepts
+       * 
+       * @param route The routes of a message
+       * 
+       * @return true if at least one of the routes is enabled
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool accepts(const route_type& route) const noexcept 
+      {
+        // Any of the routes, unlike AtomicBitMask::isEnabled() which requires all of them
+        return !m_active.isDisabled(static_cast<TEnum>(static_cast<underlying_type>(route)));
+      }
+
+      /// @copydoc accepts(const route_type&) const
+      [[nodiscard]] inline bool accepts(const TEnum& route) const noexcept 
+      {
+        return !m_active.isDisabled(route);
+      }
+
+      /**
+       * @brief When
+       * 
+       * Calls function with the enabled part of the route, only if at
+       * least one of the routes is enabled. Everything the function
+       * captures is formatted inside of it, so a filtered message costs
+       * one load and one branch.
+       * 
+       * @param route The routes of the message
+       * @param function Called as function(enabled_route)
+       * 
+       * @return true if the function was called
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFunction>
+      inline bool when(const route_type& route, TFunction&& function) const 
+      {
+        const route_type enabled = m_active.snapshot(std::memory_order_relaxed) & route;
+
+        if ( 0 == static_cast<underlying_type>(enabled) ) {
+          return false;
+        }
+
+        std::forward<TFunction>(function)(enabled);
+        return true;
+      }
+
+    private:
+      /// The enabled routes
+      AtomicBitMask<TEnum> m_active;
+  };
+}
+
+/**
+ * @brief GBE_FORMAT_IF
+ * 
+ * Formats into a StringBuffer only if the filter accepts the route, e.g.
+ * GBE_FORMAT_IF(filter, LogLocation::MQTT, buffer, GBE_FMT("%s=%d"), name, value).
+ * The format arguments are not evaluated for a filtered message. The
+ * expression is true if the message was formatted.
+ * 
+ * @since 0.2
+ * 
+ * @author t.schwarzinger@dina.de
+ */
+#define GBE_FORMAT_IF(filter, route, buffer, ...) \
+  ((filter).accepts(route) \
+    ? ((buffer) = ::std::remove_reference_t<decltype(buffer)>::format(__VA_ARGS__), true) \
+    : false)
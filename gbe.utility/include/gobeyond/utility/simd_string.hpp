@@ -0,0 +1,880 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <gobeyond/utility/bits.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define GBE_UTILITY_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GBE_UTILITY_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(GBE_UTILITY_SIMD_X86) && defined(__GNUC__)
+#define GBE_UTILITY_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GBE_UTILITY_TARGET_AVX2
+#endif
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief SimdLevel
+   * 
+   * The instruction sets the string kernels are available for.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  enum class SimdLevel 
+  {
+    /// Plain C++, available everywhere
+    Scalar,
+    /// 16 byte vectors, the baseline of x86-64
+    SSE2,
+    /// 32 byte vectors, selected at runtime if the CPU supports it
+    AVX2,
+    /// 16 byte vectors, the baseline of AArch64
+    NEON
+  };
+
+  namespace simd_detail 
+  {
+    inline constexpr std::size_t npos = std::string_view::npos;
+
+    /// Sets larger than this are looked up in a table instead of being compared one by one
+    inline constexpr std::size_t max_vector_set = 16;
+
+    /// The kernels of one instruction set
+    struct Kernels 
+    {
+      std::size_t (*find)(const char* haystack, std::size_t haystack_size, const char* needle, std::size_t needle_size) noexcept;
+      std::size_t (*findAnyOf)(const char* s, std::size_t size, const char* set, std::size_t set_size) noexcept;
+      int (*compare)(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept;
+      int (*compareIgnoreCase)(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept;
+      std::size_t (*length)(const char* s) noexcept;
+    };
+
+    inline unsigned char foldCase(unsigned char c) noexcept 
+    {
+      return static_cast<unsigned char>(c - 'A') < 26u ? static_cast<unsigned char>(c | 0x20) : c;
+    }
+
+    inline int lengthOrder(std::size_t a_size, std::size_t b_size) noexcept 
+    {
+      return a_size < b_size ? -1 : (a_size > b_size ? 1 : 0);
+    }
+
+    inline int byteOrder(char a, char b) noexcept 
+    {
+      return static_cast<unsigned char>(a) < static_cast<unsigned char>(b) ? -1 : 1;
+    }
+
+    inline std::size_t scalarFindAnyOf(const char* s, std::size_t size, const char* set, std::size_t set_size) noexcept 
+    {
+      if ( set_size <= 8 ) {
+        for ( std::size_t i = 0; i < size; ++i ) {
+          if ( nullptr != std::memchr(set, s[i], set_size) ) {
+            return i;
+          }
+        }
+
+        return npos;
+      }
+
+      bool table[256] = {};
+
+      for ( std::size_t k = 0; k < set_size; ++k ) {
+        table[static_cast<unsigned char>(set[k])] = true;
+      }
+
+      for ( std::size_t i = 0; i < size; ++i ) {
+        if ( table[static_cast<unsigned char>(s[i])] ) {
+          return i;
+        }
+      }
+
+      return npos;
+    }
+
+    inline std::size_t scalarFind(const char* haystack, std::size_t haystack_size, const char* needle, std::size_t needle_size) noexcept 
+    {
+      if ( 0 == needle_size ) {
+        return 0;
+      }
+
+      for ( std::size_t i = 0; i + needle_size <= haystack_size; ++i ) {
+        if ( haystack[i] == needle[0] && 0 == std::memcmp(haystack + i + 1, needle + 1, needle_size - 1) ) {
+          return i;
+        }
+      }
+
+      return npos;
+    }
+
+    inline int scalarCompare(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+
+      for ( std::size_t i = 0; i < size; ++i ) {
+        if ( a[i] != b[i] ) {
+          return byteOrder(a[i], b[i]);
+        }
+      }
+
+      return lengthOrder(a_size, b_size);
+    }
+
+    inline int scalarCompareIgnoreCase(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+
+      for ( std::size_t i = 0; i < size; ++i ) {
+        const unsigned char x = foldCase(static_cast<unsigned char>(a[i]));
+        const unsigned char y = foldCase(static_cast<unsigned char>(b[i]));
+
+        if ( x != y ) {
+          return x < y ? -1 : 1;
+        }
+      }
+
+      return lengthOrder(a_size, b_size);
+    }
+
+    inline std::size_t scalarLength(const char* s) noexcept 
+    {
+      const char* p = s;
+
+      while ( '\0' != *p ) {
+        ++p;
+      }
+
+      return static_cast<std::size_t>(p - s);
+    }
+
+    inline constexpr Kernels scalar_kernels = {scalarFind, scalarFindAnyOf, scalarCompare, scalarCompareIgnoreCase, scalarLength};
+
+#if defined(GBE_UTILITY_SIMD_X86)
+    inline __m128i sse2Load(const char* p) noexcept 
+    {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    inline unsigned sse2Mask(__m128i v) noexcept 
+    {
+      return static_cast<unsigned>(_mm_movemask_epi8(v));
+    }
+
+    /// Moves 'A'..'Z' to the bottom of the signed range, so a single signed compare finds the upper case letters
+    inline __m128i sse2Fold(__m128i c) noexcept 
+    {
+      const __m128i shifted = _mm_add_epi8(c, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+      const __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+      return _mm_or_si128(c, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+
+    inline std::size_t sse2FindAnyOf(const char* s, std::size_t size, const char* set, std::size_t set_size) noexcept 
+    {
+      if ( 0 == set_size || set_size > max_vector_set ) {
+        return 0 == set_size ? npos : scalarFindAnyOf(s, size, set, set_size);
+      }
+
+      __m128i characters[max_vector_set];
+
+      for ( std::size_t k = 0; k < set_size; ++k ) {
+        characters[k] = _mm_set1_epi8(set[k]);
+      }
+
+      std::size_t i = 0;
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const __m128i block = sse2Load(s + i);
+        __m128i hits = _mm_cmpeq_epi8(block, characters[0]);
+
+        for ( std::size_t k = 1; k < set_size; ++k ) {
+          hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, characters[k]));
+        }
+
+        const unsigned mask = sse2Mask(hits);
+
+        if ( 0 != mask ) {
+          return i + static_cast<std::size_t>(countr_zero(mask));
+        }
+      }
+
+      const std::size_t found = scalarFindAnyOf(s + i, size - i, set, set_size);
+      return npos == found ? npos : i + found;
+    }
+
+    /// Compares the first and the last character of the needle at 16 positions at once and verifies the candidates
+    inline std::size_t sse2Find(const char* haystack, std::size_t haystack_size, const char* needle, std::size_t needle_size) noexcept 
+    {
+      if ( needle_size <= 1 || needle_size > haystack_size ) {
+        return 1 == needle_size ? sse2FindAnyOf(haystack, haystack_size, needle, 1) : (0 == needle_size ? 0 : npos);
+      }
+
+      const __m128i first = _mm_set1_epi8(needle[0]);
+      const __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+      std::size_t i = 0;
+
+      for ( ; i + needle_size - 1 + 16 <= haystack_size; i += 16 ) {
+        const __m128i block_first = sse2Load(haystack + i);
+        const __m128i block_last = sse2Load(haystack + i + needle_size - 1);
+        unsigned mask = sse2Mask(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+
+        while ( 0 != mask ) {
+          const std::size_t candidate = i + static_cast<std::size_t>(countr_zero(mask));
+
+          if ( 0 == std::memcmp(haystack + candidate + 1, needle + 1, needle_size - 2) ) {
+            return candidate;
+          }
+
+          mask &= mask - 1;
+        }
+      }
+
+      const std::size_t found = scalarFind(haystack + i, haystack_size - i, needle, needle_size);
+      return npos == found ? npos : i + found;
+    }
+
+    inline int sse2Compare(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+      std::size_t i = 0;
+
+      for ( ; i + 32 <= size; i += 32 ) {
+        const __m128i low = _mm_cmpeq_epi8(sse2Load(a + i), sse2Load(b + i));
+        const __m128i high = _mm_cmpeq_epi8(sse2Load(a + i + 16), sse2Load(b + i + 16));
+
+        if ( 0xFFFFu != sse2Mask(_mm_and_si128(low, high)) ) {
+          break;
+        }
+      }
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const unsigned mask = sse2Mask(_mm_cmpeq_epi8(sse2Load(a + i), sse2Load(b + i))) ^ 0xFFFFu;
+
+        if ( 0 != mask ) {
+          const std::size_t k = i + static_cast<std::size_t>(countr_zero(mask));
+          return byteOrder(a[k], b[k]);
+        }
+      }
+
+      return scalarCompare(a + i, a_size - i, b + i, b_size - i);
+    }
+
+    inline int sse2CompareIgnoreCase(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+      std::size_t i = 0;
+
+      for ( ; i + 32 <= size; i += 32 ) {
+        const __m128i low = _mm_cmpeq_epi8(sse2Fold(sse2Load(a + i)), sse2Fold(sse2Load(b + i)));
+        const __m128i high = _mm_cmpeq_epi8(sse2Fold(sse2Load(a + i + 16)), sse2Fold(sse2Load(b + i + 16)));
+
+        if ( 0xFFFFu != sse2Mask(_mm_and_si128(low, high)) ) {
+          break;
+        }
+      }
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const unsigned mask = sse2Mask(_mm_cmpeq_epi8(sse2Fold(sse2Load(a + i)), sse2Fold(sse2Load(b + i)))) ^ 0xFFFFu;
+
+        if ( 0 != mask ) {
+          const std::size_t k = i + static_cast<std::size_t>(countr_zero(mask));
+          return foldCase(static_cast<unsigned char>(a[k])) < foldCase(static_cast<unsigned char>(b[k])) ? -1 : 1;
+        }
+      }
+
+      return scalarCompareIgnoreCase(a + i, a_size - i, b + i, b_size - i);
+    }
+
+    /// Aligned loads never cross a page boundary, so reading before the start and behind the terminator is safe
+    inline std::size_t sse2Length(const char* s) noexcept 
+    {
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(s);
+      const char* block = reinterpret_cast<const char*>(address & ~std::uintptr_t{15});
+      const __m128i zero = _mm_setzero_si128();
+      unsigned mask = sse2Mask(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero)) >> (address & 15);
+
+      if ( 0 != mask ) {
+        return static_cast<std::size_t>(countr_zero(mask));
+      }
+
+      for ( ;; ) {
+        block += 16;
+        mask = sse2Mask(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero));
+
+        if ( 0 != mask ) {
+          return static_cast<std::size_t>(block - s) + static_cast<std::size_t>(countr_zero(mask));
+        }
+      }
+    }
+
+    inline constexpr Kernels sse2_kernels = {sse2Find, sse2FindAnyOf, sse2Compare, sse2CompareIgnoreCase, sse2Length};
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Load(const char* p) noexcept 
+    {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline std::uint32_t avx2Mask(__m256i v) noexcept 
+    {
+      return static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Fold(__m256i c) noexcept 
+    {
+      const __m256i shifted = _mm256_add_epi8(c, _mm256_set1_epi8(static_cast<char>(0x80 - 'A')));
+      const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 26)), shifted);
+      return _mm256_or_si256(c, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline std::size_t avx2FindAnyOf(const char* s, std::size_t size, const char* set, std::size_t set_size) noexcept 
+    {
+      if ( 0 == set_size || set_size > max_vector_set ) {
+        return 0 == set_size ? npos : scalarFindAnyOf(s, size, set, set_size);
+      }
+
+      __m256i characters[max_vector_set];
+
+      for ( std::size_t k = 0; k < set_size; ++k ) {
+        characters[k] = _mm256_set1_epi8(set[k]);
+      }
+
+      std::size_t i = 0;
+
+      for ( ; i + 32 <= size; i += 32 ) {
+        const __m256i block = avx2Load(s + i);
+        __m256i hits = _mm256_cmpeq_epi8(block, characters[0]);
+
+        for ( std::size_t k = 1; k < set_size; ++k ) {
+          hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, characters[k]));
+        }
+
+        const std::uint32_t mask = avx2Mask(hits);
+
+        if ( 0 != mask ) {
+          return i + static_cast<std::size_t>(countr_zero(mask));
+        }
+      }
+
+      const std::size_t found = sse2FindAnyOf(s + i, size - i, set, set_size);
+      return npos == found ? npos : i + found;
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline std::size_t avx2Find(const char* haystack, std::size_t haystack_size, const char* needle, std::size_t needle_size) noexcept 
+    {
+      if ( needle_size <= 1 || needle_size > haystack_size ) {
+        return 1 == needle_size ? avx2FindAnyOf(haystack, haystack_size, needle, 1) : (0 == needle_size ? 0 : npos);
+      }
+
+      const __m256i first = _mm256_set1_epi8(needle[0]);
+      const __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+      std::size_t i = 0;
+
+      // Blocks without a candidate are skipped two at a time
+      for ( ; i + needle_size - 1 + 64 <= haystack_size; i += 64 ) {
+        const __m256i low = _mm256_and_si256(_mm256_cmpeq_epi8(first, avx2Load(haystack + i)), _mm256_cmpeq_epi8(last, avx2Load(haystack + i + needle_size - 1)));
+        const __m256i high = _mm256_and_si256(_mm256_cmpeq_epi8(first, avx2Load(haystack + i + 32)), _mm256_cmpeq_epi8(last, avx2Load(haystack + i + 32 + needle_size - 1)));
+
+        if ( 0 != avx2Mask(_mm256_or_si256(low, high)) ) {
+          break;
+        }
+      }
+
+      for ( ; i + needle_size - 1 + 32 <= haystack_size; i += 32 ) {
+        const __m256i block_first = avx2Load(haystack + i);
+        const __m256i block_last = avx2Load(haystack + i + needle_size - 1);
+        std::uint32_t mask = avx2Mask(_mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last)));
+
+        while ( 0 != mask ) {
+          const std::size_t candidate = i + static_cast<std::size_t>(countr_zero(mask));
+
+          if ( 0 == std::memcmp(haystack + candidate + 1, needle + 1, needle_size - 2) ) {
+            return candidate;
+          }
+
+          mask &= mask - 1;
+        }
+      }
+
+      const std::size_t found = sse2Find(haystack + i, haystack_size - i, needle, needle_size);
+      return npos == found ? npos : i + found;
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline int avx2Compare(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+      std::size_t i = 0;
+
+      for ( ; i + 64 <= size; i += 64 ) {
+        const __m256i low = _mm256_cmpeq_epi8(avx2Load(a + i), avx2Load(b + i));
+        const __m256i high = _mm256_cmpeq_epi8(avx2Load(a + i + 32), avx2Load(b + i + 32));
+
+        if ( 0xFFFFFFFFu != avx2Mask(_mm256_and_si256(low, high)) ) {
+          break;
+        }
+      }
+
+      for ( ; i + 32 <= size; i += 32 ) {
+        const std::uint32_t mask = ~avx2Mask(_mm256_cmpeq_epi8(avx2Load(a + i), avx2Load(b + i)));
+
+        if ( 0 != mask ) {
+          const std::size_t k = i + static_cast<std::size_t>(countr_zero(mask));
+          return byteOrder(a[k], b[k]);
+        }
+      }
+
+      return sse2Compare(a + i, a_size - i, b + i, b_size - i);
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline int avx2CompareIgnoreCase(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+      std::size_t i = 0;
+
+      // Two vectors per iteration keep both load ports busy, the mismatch is located in the loop below
+      for ( ; i + 64 <= size; i += 64 ) {
+        const __m256i low = _mm256_cmpeq_epi8(avx2Fold(avx2Load(a + i)), avx2Fold(avx2Load(b + i)));
+        const __m256i high = _mm256_cmpeq_epi8(avx2Fold(avx2Load(a + i + 32)), avx2Fold(avx2Load(b + i + 32)));
+
+        if ( 0xFFFFFFFFu != avx2Mask(_mm256_and_si256(low, high)) ) {
+          break;
+        }
+      }
+
+      for ( ; i + 32 <= size; i += 32 ) {
+        const std::uint32_t mask = ~avx2Mask(_mm256_cmpeq_epi8(avx2Fold(avx2Load(a + i)), avx2Fold(avx2Load(b + i))));
+
+        if ( 0 != mask ) {
+          const std::size_t k = i + static_cast<std::size_t>(countr_zero(mask));
+          return foldCase(static_cast<unsigned char>(a[k])) < foldCase(static_cast<unsigned char>(b[k])) ? -1 : 1;
+        }
+      }
+
+      return sse2CompareIgnoreCase(a + i, a_size - i, b + i, b_size - i);
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline std::size_t avx2Length(const char* s) noexcept 
+    {
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(s);
+      const char* block = reinterpret_cast<const char*>(address & ~std::uintptr_t{31});
+      const __m256i zero = _mm256_setzero_si256();
+      std::uint32_t mask = avx2Mask(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero)) >> (address & 31);
+
+      if ( 0 != mask ) {
+        return static_cast<std::size_t>(countr_zero(mask));
+      }
+
+      for ( ;; ) {
+        block += 32;
+        mask = avx2Mask(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero));
+
+        if ( 0 != mask ) {
+          return static_cast<std::size_t>(block - s) + static_cast<std::size_t>(countr_zero(mask));
+        }
+      }
+    }
+
+    inline constexpr Kernels avx2_kernels = {avx2Find, avx2FindAnyOf, avx2Compare, avx2CompareIgnoreCase, avx2Length};
+
+    inline bool cpuHasAvx2() noexcept 
+    {
+#if defined(__GNUC__)
+      __builtin_cpu_init();
+      return 0 != __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+      int info[4];
+      __cpuid(info, 0);
+
+      if ( info[0] < 7 ) {
+        return false;
+      }
+
+      __cpuid(info, 1);
+
+      // The OS has to save the YMM registers (OSXSAVE and AVX, then XCR0)
+      if ( (info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6 ) {
+        return false;
+      }
+
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+#else
+      return false;
+#endif
+    }
+#endif
+
+#if defined(GBE_UTILITY_SIMD_NEON)
+    inline uint8x16_t neonLoad(const char* p) noexcept 
+    {
+      return vld1q_u8(reinterpret_cast<const std::uint8_t*>(p));
+    }
+
+    /// NEON has no movemask, narrowing keeps 4 bits per byte, the high bit of each nibble marks a match
+    inline std::uint64_t neonMask(uint8x16_t v) noexcept 
+    {
+      return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0) & 0x8888888888888888ull;
+    }
+
+    inline std::size_t neonIndex(std::uint64_t mask) noexcept 
+    {
+      return static_cast<std::size_t>(countr_zero(mask)) >> 2;
+    }
+
+    inline uint8x16_t neonFold(uint8x16_t c) noexcept 
+    {
+      const uint8x16_t upper = vcltq_u8(vsubq_u8(c, vdupq_n_u8('A')), vdupq_n_u8(26));
+      return vorrq_u8(c, vandq_u8(upper, vdupq_n_u8(0x20)));
+    }
+
+    inline std::size_t neonFindAnyOf(const char* s, std::size_t size, const char* set, std::size_t set_size) noexcept 
+    {
+      if ( 0 == set_size || set_size > max_vector_set ) {
+        return 0 == set_size ? npos : scalarFindAnyOf(s, size, set, set_size);
+      }
+
+      uint8x16_t characters[max_vector_set];
+
+      for ( std::size_t k = 0; k < set_size; ++k ) {
+        characters[k] = vdupq_n_u8(static_cast<std::uint8_t>(set[k]));
+      }
+
+      std::size_t i = 0;
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const uint8x16_t block = neonLoad(s + i);
+        uint8x16_t hits = vceqq_u8(block, characters[0]);
+
+        for ( std::size_t k = 1; k < set_size; ++k ) {
+          hits = vorrq_u8(hits, vceqq_u8(block, characters[k]));
+        }
+
+        const std::uint64_t mask = neonMask(hits);
+
+        if ( 0 != mask ) {
+          return i + neonIndex(mask);
+        }
+      }
+
+      const std::size_t found = scalarFindAnyOf(s + i, size - i, set, set_size);
+      return npos == found ? npos : i + found;
+    }
+
+    inline std::size_t neonFind(const char* haystack, std::size_t haystack_size, const char* needle, std::size_t needle_size) noexcept 
+    {
+      if ( needle_size <= 1 || needle_size > haystack_size ) {
+        return 1 == needle_size ? neonFindAnyOf(haystack, haystack_size, needle, 1) : (0 == needle_size ? 0 : npos);
+      }
+
+      const uint8x16_t first = vdupq_n_u8(static_cast<std::uint8_t>(needle[0]));
+      const uint8x16_t last = vdupq_n_u8(static_cast<std::uint8_t>(needle[needle_size - 1]));
+      std::size_t i = 0;
+
+      for ( ; i + needle_size - 1 + 16 <= haystack_size; i += 16 ) {
+        const uint8x16_t block_first = neonLoad(haystack + i);
+        const uint8x16_t block_last = neonLoad(haystack + i + needle_size - 1);
+        std::uint64_t mask = neonMask(vandq_u8(vceqq_u8(first, block_first), vceqq_u8(last, block_last)));
+
+        while ( 0 != mask ) {
+          const std::size_t candidate = i + neonIndex(mask);
+
+          if ( 0 == std::memcmp(haystack + candidate + 1, needle + 1, needle_size - 2) ) {
+            return candidate;
+          }
+
+          mask &= mask - 1;
+        }
+      }
+
+      const std::size_t found = scalarFind(haystack + i, haystack_size - i, needle, needle_size);
+      return npos == found ? npos : i + found;
+    }
+
+    inline int neonCompare(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+      std::size_t i = 0;
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const std::uint64_t mask = neonMask(vmvnq_u8(vceqq_u8(neonLoad(a + i), neonLoad(b + i))));
+
+        if ( 0 != mask ) {
+          const std::size_t k = i + neonIndex(mask);
+          return byteOrder(a[k], b[k]);
+        }
+      }
+
+      return scalarCompare(a + i, a_size - i, b + i, b_size - i);
+    }
+
+    inline int neonCompareIgnoreCase(const char* a, std::size_t a_size, const char* b, std::size_t b_size) noexcept 
+    {
+      const std::size_t size = a_size < b_size ? a_size : b_size;
+      std::size_t i = 0;
+
+      for ( ; i + 16 <= size; i += 16 ) {
+        const std::uint64_t mask = neonMask(vmvnq_u8(vceqq_u8(neonFold(neonLoad(a + i)), neonFold(neonLoad(b + i)))));
+
+        if ( 0 != mask ) {
+          const std::size_t k = i + neonIndex(mask);
+          return foldCase(static_cast<unsigned char>(a[k])) < foldCase(static_cast<unsigned char>(b[k])) ? -1 : 1;
+        }
+      }
+
+      return scalarCompareIgnoreCase(a + i, a_size - i, b + i, b_size - i);
+    }
+
+    inline std::size_t neonLength(const char* s) noexcept 
+    {
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(s);
+      const char* block = reinterpret_cast<const char*>(address & ~std::uintptr_t{15});
+      const uint8x16_t zero = vdupq_n_u8(0);
+      std::uint64_t mask = neonMask(vceqq_u8(neonLoad(block), zero)) >> ((address & 15) * 4);
+
+      if ( 0 != mask ) {
+        return neonIndex(mask);
+      }
+
+      for ( ;; ) {
+        block += 16;
+        mask = neonMask(vceqq_u8(neonLoad(block), zero));
+
+        if ( 0 != mask ) {
+          return static_cast<std::size_t>(block - s) + neonIndex(mask);
+        }
+      }
+    }
+
+    inline constexpr Kernels neon_kernels = {neonFind, neonFindAnyOf, neonCompare, neonCompareIgnoreCase, neonLength};
+#endif
+
+    /// The best level the CPU supports
+    inline SimdLevel detectLevel() noexcept 
+    {
+#if defined(GBE_UTILITY_SIMD_X86)
+      return cpuHasAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(GBE_UTILITY_SIMD_NEON)
+      return SimdLevel::NEON;
+#else
+      return SimdLevel::Scalar;
+#endif
+    }
+
+    /// The kernels of the given level, the scalar kernels if the level is not supported
+    inline const Kernels& kernelsFor(SimdLevel level) noexcept 
+    {
+      switch ( level ) {
+#if defined(GBE_UTILITY_SIMD_X86)
+        case SimdLevel::SSE2:
+          return sse2_kernels;
+        case SimdLevel::AVX2:
+          return SimdLevel::AVX2 == detectLevel() ? avx2_kernels : sse2_kernels;
+#endif
+#if defined(GBE_UTILITY_SIMD_NEON)
+        case SimdLevel::NEON:
+          return neon_kernels;
+#endif
+        default:
+          return scalar_kernels;
+      }
+    }
+
+    /// The kernels selected once for the running CPU
+    inline const Kernels& kernels() noexcept 
+    {
+      static const Kernels& selected = kernelsFor(detectLevel());
+      return selected;
+    }
+  }
+
+  /**
+   * @brief SIMD level
+   * 
+   * @return The instruction set the string kernels use on this CPU
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline SimdLevel simd_level() noexcept 
+  {
+    static const SimdLevel level = simd_detail::detectLevel();
+    return level;
+  }
+
+  /**
+   * @brief String find
+   * 
+   * Vectorized counterpart of std::string_view::find.
+   * 
+   * @param haystack The string to search in
+   * @param needle The string to search for
+   * @param pos The position to start at
+   * 
+   * @return The position of the first occurrence, std::string_view::npos
+   * if there is none
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t str_find(std::string_view haystack, std::string_view needle, std::size_t pos = 0) noexcept 
+  {
+    if ( pos > haystack.size() ) {
+      return std::string_view::npos;
+    }
+
+    const std::size_t found = simd_detail::kernels().find(haystack.data() + pos, haystack.size() - pos, needle.data(), needle.size());
+    return std::string_view::npos == found ? found : pos + found;
+  }
+
+  /**
+   * @brief String find any of
+   * 
+   * Vectorized counterpart of std::string_view::find_first_of.
+   * 
+   * @param s The string to search in
+   * @param set The characters to search for
+   * @param pos The position to start at
+   * 
+   * @return The position of the first character contained in set,
+   * std::string_view::npos if there is none
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t str_find_any_of(std::string_view s, std::string_view set, std::size_t pos = 0) noexcept 
+  {
+    if ( pos >= s.size() ) {
+      return std::string_view::npos;
+    }
+
+    const std::size_t found = simd_detail::kernels().findAnyOf(s.data() + pos, s.size() - pos, set.data(), set.size());
+    return std::string_view::npos == found ? found : pos + found;
+  }
+
+  /**
+   * @brief String compare
+   * 
+   * Compares byte-wise like memcmp, a shorter string orders before a
+   * longer one it is a prefix of.
+   * 
+   * @param a The first string
+   * @param b The second string
+   * 
+   * @return A negative value if a orders before b, 0 if they are equal,
+   * a positive value otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline int str_compare(std::string_view a, std::string_view b) noexcept 
+  {
+    return simd_detail::kernels().compare(a.data(), a.size(), b.data(), b.size());
+  }
+
+  /**
+   * @brief String compare ignore case
+   * 
+   * Like str_compare(), but ASCII letters compare equal to their lower
+   * case form. Other bytes, including UTF-8 sequences, compare as is.
+   * 
+   * @param a The first string
+   * @param b The second string
+   * 
+   * @return A negative value if a orders before b, 0 if they are equal,
+   * a positive value otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline int str_compare_ignore_case(std::string_view a, std::string_view b) noexcept 
+  {
+    return simd_detail::kernels().compareIgnoreCase(a.data(), a.size(), b.data(), b.size());
+  }
+
+  /**
+   * @brief String equals ignore case
+   * 
+   * @param a The first string
+   * @param b The second string
+   * 
+   * @return true if the strings are equal apart from the case of ASCII
+   * letters, false otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline bool str_equals_ignore_case(std::string_view a, std::string_view b) noexcept 
+  {
+    return a.size() == b.size() && 0 == str_compare_ignore_case(a, b);
+  }
+
+  /**
+   * @brief String starts with
+   * 
+   * @param s The string
+   * @param prefix The prefix
+   * 
+   * @return true if s starts with prefix, false otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline bool str_starts_with(std::string_view s, std::string_view prefix) noexcept 
+  {
+    return s.size() >= prefix.size() && 0 == str_compare(s.substr(0, prefix.size()), prefix);
+  }
+
+  /**
+   * @brief String ends with
+   * 
+   * @param s The string
+   * @param suffix The suffix
+   * 
+   * @return true if s ends with suffix, false otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline bool str_ends_with(std::string_view s, std::string_view suffix) noexcept 
+  {
+    return s.size() >= suffix.size() && 0 == str_compare(s.substr(s.size() - suffix.size()), suffix);
+  }
+
+  /**
+   * @brief String length
+   * 
+   * Vectorized counterpart of strlen.
+   * 
+   * @param s A null terminated string
+   * 
+   * @return The number of characters before the terminator
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t str_length(const char* s) noexcept 
+  {
+    return simd_detail::kernels().length(s);
+  }
+}
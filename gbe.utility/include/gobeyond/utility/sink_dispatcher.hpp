@@ -0,0 +1,502 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <gobeyond/utility/bitmask.hpp>
+#include <gobeyond/utility/message_queue.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief Sink
+   * 
+   * The destination of the messages routed to one flag. write() is only
+   * ever called from the worker thread of the sink.
+   * 
+   * @tparam TEnum The route flags
+   * @tparam TBufferSize The size of the message buffers
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, std::size_t TBufferSize>
+  class Sink 
+  {
+    public:
+      /// The message type
+      using message_type = RoutedMessage<TEnum, TBufferSize>;
+
+      virtual ~Sink() = default;
+
+      /**
+       * @brief Write
+       * 
+       * Writes a batch of messages in queue order.
+       * 
+       * @param messages The messages
+       * @param count The number of messages
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      virtual void write(const message_type* const* messages, std::size_t count) = 0;
+
+      /**
+       * @brief Flush
+       * 
+       * Called when the queue of the sink ran empty and before the
+       * worker thread stops.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      virtual void flush()
+      {}
+  };
+
+#if defined(__unix__) || defined(__APPLE__)
+  /**
+   * @brief FileDescriptorSink
+   * 
+   * Writes each batch to a file descriptor with a single writev, one
+   * message per line.
+   * 
+   * @tparam TEnum The route flags
+   * @tparam TBufferSize The size of the message buffers
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, std::size_t TBufferSize>
+  class FileDescriptorSink : public Sink<TEnum, TBufferSize> 
+  {
+    public:
+      using typename Sink<TEnum, TBufferSize>::message_type;
+
+      /**
+       * @brief Constructor
+       * 
+       * @param fd The file descriptor
+       * @param owns_fd Close the file descriptor on destruction
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit FileDescriptorSink(int fd, bool owns_fd = false) noexcept
+        : m_fd(fd),
+          m_owns_fd(owns_fd)
+      {}
+
+      FileDescriptorSink(const FileDescriptorSink&) = delete;
+      FileDescriptorSink& operator=(const FileDescriptorSink&) = delete;
+
+      ~FileDescriptorSink() override 
+      {
+        if ( m_owns_fd && m_fd >= 0 ) {
+          ::close(m_fd);
+        }
+      }
+
+      void write(const message_type* const* messages, std::size_t count) override 
+      {
+        static char newline = '\n';
+        ::iovec vectors[2 * MessageQueue<TEnum, TBufferSize>::max_batch_size];
+        std::size_t used = 0;
+
+        for ( std::size_t i = 0; i < count; ++i ) {
+          if ( 2 * MessageQueue<TEnum, TBufferSize>::max_batch_size == used ) {
+            writeAll(vectors, used);
+            used = 0;
+          }
+
+          vectors[used].iov_base = const_cast<char*>(messages[i]->text.data());
+          vectors[used++].iov_len = messages[i]->text.size();
+          vectors[used].iov_base = &newline;
+          vectors[used++].iov_len = 1;
+        }
+
+        writeAll(vectors, used);
+      }
+
+      /**
+       * @brief Errors
+       * 
+       * @return The number of failed writes
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::uint64_t errors() const noexcept 
+      {
+        return m_errors.load(std::memory_order_relaxed);
+      }
+
+    private:
+      /// Writes all vectors, continuing after partial writes
+      void writeAll(::iovec* vectors, std::size_t count) noexcept 
+      {
+        while ( count > 0 ) {
+          const ::ssize_t written = ::writev(m_fd, vectors, static_cast<int>(count));
+
+          if ( written < 0 ) {
+            if ( EINTR == errno ) {
+              continue;
+            }
+
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+          }
+
+          std::size_t remaining = static_cast<std::size_t>(written);
+
+          while ( count > 0 && remaining >= vectors->iov_len ) {
+            remaining -= vectors->iov_len;
+            ++vectors;
+            --count;
+          }
+
+          if ( count > 0 ) {
+            vectors->iov_base = static_cast<char*>(vectors->iov_base) + remaining;
+            vectors->iov_len -= remaining;
+          }
+        }
+      }
+
+      /// The file descriptor
+      int m_fd;
+      /// Close the file descriptor on destruction
+      bool m_owns_fd;
+      /// The number of failed writes
+      std::atomic<std::uint64_t> m_errors{0};
+  };
+#endif
+
+  /**
+   * @brief SinkDispatcher
+   * 
+   * Fans routed messages out to one sink per flag. Every sink has its
+   * own MessageQueue and worker thread, so producers only pay for a copy
+   * into each queue and a slow sink never stalls the others. Workers
+   * hand their sink whole batches and sleep while their queue is empty.
+   * 
+   * Sinks are registered before start(), the set of sinks is fixed while
+   * the dispatcher runs.
+   * 
+   * @tparam TEnum The route flags, every sink is registered for a single bit
+   * @tparam TBufferSize The size of the message buffers
+   * @tparam TPolicy What producers do when the queue of a sink is full
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, std::size_t TBufferSize, BackPressure TPolicy = BackPressure::Drop>
+  class SinkDispatcher 
+  {
+    public:
+      /// The route type
+      using route_type = BitMask<TEnum>;
+      /// The message buffer type
+      using buffer_type = StringBuffer<TBufferSize>;
+      /// The sink type
+      using sink_type = Sink<TEnum, TBufferSize>;
+      /// The per-sink queue type
+      using queue_type = MessageQueue<TEnum, TBufferSize, TPolicy>;
+
+      /**
+       * @brief Constructor
+       * 
+       * @param queue_capacity The capacity of each per-sink queue
+       * @param idle_timeout The longest time a worker sleeps without being woken up
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit SinkDispatcher(std::size_t queue_capacity = 1024, std::chrono::milliseconds idle_timeout = std::chrono::milliseconds(100))
+        : m_queue_capacity(queue_capacity),
+          m_idle_timeout(idle_timeout)
+      {}
+
+      SinkDispatcher(const SinkDispatcher&) = delete;
+      SinkDispatcher& operator=(const SinkDispatcher&) = delete;
+
+      /// Stops the workers after they wrote all queued messages
+      ~SinkDispatcher() 
+      {
+        stop();
+      }
+
+      /**
+       * @brief Add sink
+       * 
+       * @param flag The flag routed to the sink, a single bit
+       * @param sink The sink
+       * 
+       * @return false if the dispatcher is running, the flag is not a
+       * single bit, already has a sink or the sink is nullptr
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      bool add_sink(TEnum flag, std::shared_ptr<sink_type> sink) 
+      {
+        const auto bits = static_cast<std::uint64_t>(static_cast<std::underlying_type_t<TEnum>>(flag));
+
+        if ( m_running || nullptr == sink || 0 == bits || 0 != (bits & (bits - 1)) ) {
+          return false;
+        }
+
+        for ( const std::unique_ptr<Channel>& channel : m_channels ) {
+          if ( channel->flag == flag ) {
+            return false;
+          }
+        }
+
+        m_channels.push_back(std::make_unique<Channel>(flag, std::move(sink), m_queue_capacity));
+        m_by_bit[bitIndex(flag)] = m_channels.back().get();
+        m_registered.enable(flag);
+        return true;
+      }
+
+      /**
+       * @brief Start
+       * 
+       * Starts one worker thread per sink.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void start() 
+      {
+        if ( m_running ) {
+          return;
+        }
+
+        m_running = true;
+
+        for ( const std::unique_ptr<Channel>& channel : m_channels ) {
+          channel->stopping.store(false, std::memory_order_relaxed);
+          channel->worker = std::thread(&SinkDispatcher::run, this, channel.get());
+        }
+      }
+
+      /**
+       * @brief Stop
+       * 
+       * Lets the workers write the queued messages, flush their sinks
+       * and exit. Producers must not dispatch concurrently.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      void stop() 
+      {
+        if ( !m_running ) {
+          return;
+        }
+
+        for ( const std::unique_ptr<Channel>& channel : m_channels ) { 
+          {
+            std::lock_guard<std::mutex> lock(channel->mutex);
+            channel->stopping.store(true, std::memory_order_relaxed);
+          }
+
+          channel->wake.notify_one();
+        }
+
+        for ( const std::unique_ptr<Channel>& channel : m_channels ) {
+          channel->worker.join();
+        }
+
+        m_running = false;
+      }
+
+      /**
+       * @brief Dispatch
+       * 
+       * Copies the text into the queue of every sink enabled in the route.
+       * 
+       * @param route The sinks the message is meant for
+       * @param text The text, truncated to the buffer size
+       * 
+       * @return The number of sinks that accepted the message
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      std::size_t dispatch(const route_type& route, std::string_view text) 
+      {
+        std::size_t accepted = 0;
+
+        // Only the bits of the route that have a sink are visited
+        (route & m_registered).for_each_enabled([&](TEnum flag) {
+          Channel& channel = *m_by_bit[bitIndex(flag)];
+
+          if ( channel.queue.push(route, text) ) {
+            ++accepted;
+            notify(channel);
+          }
+        });
+
+        return accepted;
+      }
+
+      /// @copydoc dispatch
+      template <std::size_t TOtherSize>
+      inline std::size_t dispatch(const route_type& route, const StringBuffer<TOtherSize>& text) 
+      {
+        return dispatch(route, text.view());
+      }
+
+      /**
+       * @brief Statistics
+       * 
+       * @param flag The flag of the sink
+       * 
+       * @return The statistics of the queue of the sink, all zero if the
+       * flag has no sink
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] typename queue_type::Statistics statistics(TEnum flag) const noexcept 
+      {
+        for ( const std::unique_ptr<Channel>& channel : m_channels ) {
+          if ( channel->flag == flag ) {
+            return channel->queue.statistics();
+          }
+        }
+
+        return {};
+      }
+
+    private:
+      struct Channel 
+      {
+        Channel(TEnum flag, std::shared_ptr<sink_type> sink, std::size_t capacity)
+          : flag(flag),
+            sink(std::move(sink)),
+            queue(capacity)
+        {}
+
+        /// The flag routed to the sink
+        TEnum flag;
+        /// The sink
+        std::shared_ptr<sink_type> sink;
+        /// The messages waiting for the sink
+        queue_type queue;
+        /// The worker writing to the sink
+        std::thread worker;
+        /// Set while the worker waits for messages
+        alignas(cache_line_size) std::atomic<bool> sleeping{false};
+        /// Set when the worker should drain the queue and exit
+        std::atomic<bool> stopping{false};
+        std::mutex mutex;
+        std::condition_variable wake;
+      };
+
+      /// The position of a single bit flag
+      static inline int bitIndex(TEnum flag) noexcept 
+      {
+        return countr_zero(static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<std::underlying_type_t<TEnum>>>(flag)));
+      }
+
+      /// Wakes the worker of the channel if it sleeps, producers stay lock-free otherwise
+      static void notify(Channel& channel) 
+      {
+        // Orders the publishing store of the message before the load of the flag, pairs with the fence in run()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( channel.sleeping.load(std::memory_order_seq_cst) ) {
+          std::lock_guard<std::mutex> lock(channel.mutex);
+          channel.wake.notify_one();
+        }
+      }
+
+      void run(Channel* channel) 
+      {
+        const auto write = [channel](const typename queue_type::Message* const* messages, std::size_t count) {
+          channel->sink->write(messages, count);
+        };
+
+        bool written = false;
+
+        for ( ;; ) {
+          if ( channel->queue.consume_batch(write) > 0 ) {
+            written = true;
+            continue;
+          }
+
+          if ( written ) {
+            channel->sink->flush();
+            written = false;
+          }
+
+          std::unique_lock<std::mutex> lock(channel->mutex);
+
+          if ( channel->stopping.load(std::memory_order_relaxed) ) {
+            lock.unlock();
+
+            if ( channel->queue.consume_batch(write) > 0 ) {
+              channel->sink->flush();
+            }
+
+            return;
+          }
+
+          channel->sleeping.store(true, std::memory_order_seq_cst);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+
+          // A producer that pushed before seeing the flag did not notify
+          if ( channel->queue.empty() ) {
+            channel->wake.wait_for(lock, m_idle_timeout);
+          }
+
+          channel->sleeping.store(false, std::memory_order_relaxed);
+        }
+      }
+
+      /// The capacity of the per-sink queues
+      std::size_t m_queue_capacity;
+      /// The longest time a worker sleeps without being woken up
+      std::chrono::milliseconds m_idle_timeout;
+      /// The sinks, their queues and workers
+      std::vector<std::unique_ptr<Channel>> m_channels;
+      /// The channel of each bit, nullptr for bits without sink
+      Channel* m_by_bit[8 * sizeof(std::underlying_type_t<TEnum>)] = {};
+      /// The flags with a sink
+      route_type m_registered;
+      /// Set between start() and stop()
+      bool m_running = false;
+  };
+}
@@ -0,0 +1,802 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include <gobeyond/utility/arena.hpp>
+#include <gobeyond/utility/format.hpp>
+#include <gobeyond/utility/numeric.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief SpillString
+   * 
+   * A companion of StringBuffer with the same append and format API.
+   * Short content lives in a small inline buffer, content that does not
+   * fit spills into a MonotonicArena instead of being cut off. Only if
+   * there is no arena or the arena is exhausted the content is
+   * truncated like in a StringBuffer.
+   * 
+   * Spilled content lives in the arena, so the string must not be used
+   * after the arena was reset. Copies spill into the arena of the
+   * source, moves take the spilled content over.
+   * 
+   * @tparam TInlineSize The size of the inline buffer including the
+   * terminator
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TInlineSize>
+  class SpillString 
+  {
+    static_assert(TInlineSize > 0, "SpillString needs room for the terminator");
+
+    public:
+      /// The inline buffer size
+      static constexpr std::size_t inline_size = TInlineSize;
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs an empty string that truncates instead of spilling.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline SpillString() noexcept 
+      {
+        m_inline[0] = '\0';
+      }
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs an empty string that spills into the given arena.
+       * 
+       * @param arena The arena for content that does not fit inline
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit inline SpillString(MonotonicArena& arena) noexcept
+        : m_arena(&arena) 
+      {
+        m_inline[0] = '\0';
+      }
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs a string with the given content that spills into the
+       * given arena.
+       * 
+       * @param arena The arena for content that does not fit inline
+       * @param s The string to store
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline SpillString(MonotonicArena& arena, std::string_view s) noexcept
+        : SpillString(arena) 
+      {
+        assign(s);
+      }
+
+      /**
+       * @brief Copy constructor
+       * 
+       * Copies the content. Content that does not fit inline is copied
+       * into the arena of the other string.
+       * 
+       * @param other The other string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline SpillString(const SpillString& other) noexcept
+        : m_arena(other.m_arena) 
+      {
+        m_inline[0] = '\0';
+        assign(other.view());
+        m_truncated = m_truncated || other.m_truncated;
+      }
+
+      /**
+       * @brief Move constructor
+       * 
+       * Takes the content of the other string over without copying
+       * spilled content. The other string is empty afterwards.
+       * 
+       * @param other The other string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline SpillString(SpillString&& other) noexcept
+        : m_arena(other.m_arena) 
+      {
+        take(other);
+      }
+
+      /**
+       * @brief Copy assignment
+       * 
+       * Copies the content, the arena of this string is kept.
+       * 
+       * @param other The other string
+       * 
+       * @return This string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      SpillString& operator=(const SpillString& other) noexcept 
+      {
+        if ( this != &other ) {
+          assign(other.view());
+          m_truncated = m_truncated || other.m_truncated;
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Move assignment
+       * 
+       * Takes the content and the arena of the other string over. The
+       * other string is empty afterwards.
+       * 
+       * @param other The other string
+       * 
+       * @return This string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      SpillString& operator=(SpillString&& other) noexcept 
+      {
+        if ( this != &other ) {
+          m_arena = other.m_arena;
+          take(other);
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief C string
+       * 
+       * @return The null terminated content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const char* c_str() const noexcept 
+      {
+        return data();
+      }
+
+      /**
+       * @brief Data
+       * 
+       * @return The null terminated content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const char* data() const noexcept 
+      {
+        return nullptr == m_spill ? m_inline : m_spill;
+      }
+
+      /**
+       * @brief View
+       * 
+       * @return The content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::string_view view() const noexcept 
+      {
+        return std::string_view(data(), m_size);
+      }
+
+      /**
+       * @brief Size
+       * 
+       * @return The length of the content without the terminator
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t size() const noexcept 
+      {
+        return m_size;
+      }
+
+      /**
+       * @brief Empty
+       * 
+       * @return true if the string has no content, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool empty() const noexcept 
+      {
+        return 0 == m_size;
+      }
+
+      /**
+       * @brief Capacity
+       * 
+       * @return The maximum length of the content before the string has
+       * to spill (again)
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t capacity() const noexcept 
+      {
+        return nullptr == m_spill ? inline_capacity() : m_capacity - 1;
+      }
+
+      /**
+       * @brief Inline capacity
+       * 
+       * @return The maximum length of content that is kept inline
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] static constexpr std::size_t inline_capacity() noexcept 
+      {
+        return inline_size - 1;
+      }
+
+      /**
+       * @brief Spilled
+       * 
+       * @return true if the content lives in the arena, false if it is
+       * kept inline
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool spilled() const noexcept 
+      {
+        return nullptr != m_spill;
+      }
+
+      /**
+       * @brief Truncated
+       * 
+       * Reports whether content was cut off because neither the inline
+       * buffer nor the arena had room for it since the last clear or
+       * assignment.
+       * 
+       * @return true if content was lost, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool truncated() const noexcept 
+      {
+        return m_truncated;
+      }
+
+      /**
+       * @brief Arena
+       * 
+       * @return The arena content spills into, nullptr if there is none
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline MonotonicArena* arena() const noexcept 
+      {
+        return m_arena;
+      }
+
+      /**
+       * @brief Clear
+       * 
+       * Removes the content and goes back to the inline buffer. Spilled
+       * memory is given back when the arena is reset.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void clear() noexcept 
+      {
+        m_spill = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_truncated = false;
+        m_inline[0] = '\0';
+      }
+
+      /**
+       * @brief Reserve
+       * 
+       * Makes room for n characters, spilling into the arena if they do
+       * not fit inline.
+       * 
+       * @param n The number of characters
+       * 
+       * @return true if there is room for n characters, false otherwise,
+       *         the capacity may still have grown
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool reserve(std::size_t n) noexcept 
+      {
+        return n <= capacity() || grow(n);
+      }
+
+      /**
+       * @brief Assign
+       * 
+       * Replaces the content with the given string.
+       * 
+       * @param s The string to store
+       * 
+       * @return true if the string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool assign(std::string_view s) noexcept 
+      {
+        clear();
+        return append(s);
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a string at the current write position.
+       * 
+       * @param s The string to append
+       * 
+       * @return true if the string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(std::string_view s) noexcept 
+      {
+        reserve(m_size + s.size());
+
+        const std::size_t space = capacity() - m_size;
+        const std::size_t length = s.size() < space ? s.size() : space;
+
+        if ( length > 0 ) {
+          std::memcpy(buffer() + m_size, s.data(), length);
+        }
+
+        advance(length);
+
+        if ( length < s.size() ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a null terminated string. nullptr appends nothing.
+       * 
+       * @param s The string to append
+       * 
+       * @return true if the string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(const char* s) noexcept 
+      {
+        return nullptr == s || append(std::string_view(s, std::strlen(s)));
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the content of a StringBuffer.
+       * 
+       * @param other The buffer to append
+       * 
+       * @return true if the content fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <std::size_t TOtherSize>
+      inline bool append(const StringBuffer<TOtherSize>& other) noexcept 
+      {
+        return append(other.view());
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the content of another SpillString.
+       * 
+       * @param other The string to append
+       * 
+       * @return true if the content fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <std::size_t TOtherSize>
+      inline bool append(const SpillString<TOtherSize>& other) noexcept 
+      {
+        return append(other.view());
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a single character.
+       * 
+       * @param c The character to append
+       * 
+       * @return true if the character fit, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(char c) noexcept 
+      {
+        if ( !reserve(m_size + 1) ) {
+          m_truncated = true;
+          return false;
+        }
+
+        buffer()[m_size] = c;
+        return advance(1);
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends "true" or "false".
+       * 
+       * @param value The value to append
+       * 
+       * @return true if the text fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(bool value) noexcept 
+      {
+        return append(value ? std::string_view("true") : std::string_view("false"));
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the decimal representation of an integer. The number is
+       * either appended completely or not at all.
+       * 
+       * @tparam T The integer type
+       * 
+       * @param value The value to append
+       * 
+       * @return true if the number fit, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+      inline bool append(T value) noexcept 
+      {
+        if ( !reserve(m_size + decimal_length(value)) ) {
+          m_truncated = true;
+          return false;
+        }
+
+        char* tail = buffer() + m_size;
+        return advance(static_cast<std::size_t>(write_decimal(tail, value) - tail));
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the shortest representation of a floating point value that
+       * reads back to the same value. The number is either appended
+       * completely or not at all.
+       * 
+       * @tparam T The floating point type
+       * 
+       * @param value The value to append
+       * 
+       * @return true if the number fit, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>, typename = void>
+      inline bool append(T value) noexcept 
+      {
+        char digits[64];
+        char* last = write_shortest(digits, digits + sizeof(digits), value);
+
+        if ( nullptr == last || !reserve(m_size + static_cast<std::size_t>(last - digits)) ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return append(std::string_view(digits, static_cast<std::size_t>(last - digits)));
+      }
+
+      /**
+       * @brief Append format
+       * 
+       * Formats the arguments with a compile-time format string and
+       * appends the result at the current write position. If the output
+       * does not fit, the string spills and formats a second time.
+       * 
+       * @tparam TFormat The format string type (see GBE_FMT)
+       * @tparam TArgs The argument types
+       * 
+       * @param fmt The format string
+       * @param args The arguments
+       * 
+       * @return true if the output fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+      inline bool append_format(TFormat fmt, const TArgs&... args) noexcept 
+      {
+        const std::size_t length = format_to(buffer() + m_size, capacity() - m_size + 1, fmt, args...);
+
+        if ( length > capacity() - m_size ) {
+          // A failed reserve may still have moved the content into a larger spill
+          reserve(m_size + length);
+          format_to(buffer() + m_size, capacity() - m_size + 1, fmt, args...);
+        }
+
+        return advance(length);
+      }
+
+      /**
+       * @brief Stream operator
+       * 
+       * Appends anything accepted by append(). Check truncated() to find
+       * out whether content was cut off.
+       * 
+       * @tparam T The value type
+       * 
+       * @param value The value to append
+       * 
+       * @return This string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename T>
+      inline SpillString& operator<<(const T& value) noexcept 
+      {
+        append(value);
+        return *this;
+      }
+
+      /**
+       * @brief Format
+       * 
+       * Formats a string with a printf format string and arguments.
+       * 
+       * @tparam TArgs The argument types
+       * 
+       * @param arena The arena for content that does not fit inline
+       * @param fmt The format string
+       * @param args The arguments
+       * 
+       * @return The formatted string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename... TArgs>
+      [[nodiscard]] static SpillString format(MonotonicArena& arena, const char* fmt, TArgs... args) 
+      {
+        SpillString string(arena);
+
+        if constexpr ( 0 == sizeof...(TArgs) ) {
+          string.append(fmt);
+        } else {
+          const int length = std::snprintf(string.m_inline, inline_size, fmt, args...);
+
+          if ( length < 0 ) {
+            string.clear();
+            return string;
+          }
+
+          if ( static_cast<std::size_t>(length) > inline_capacity() ) {
+            string.reserve(static_cast<std::size_t>(length));
+            std::snprintf(string.buffer(), string.capacity() + 1, fmt, args...);
+          }
+
+          string.advance(static_cast<std::size_t>(length));
+        }
+
+        return string;
+      }
+
+      /**
+       * @brief Format
+       * 
+       * Formats a string with a compile-time format string.
+       * 
+       * @tparam TFormat The format string type (see GBE_FMT)
+       * @tparam TArgs The argument types
+       * 
+       * @param arena The arena for content that does not fit inline
+       * @param fmt The format string, e.g. GBE_FMT("%s=%d")
+       * @param args The arguments
+       * 
+       * @return The formatted string
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+      [[nodiscard]] static SpillString format(MonotonicArena& arena, TFormat fmt, const TArgs&... args) noexcept 
+      {
+        SpillString string(arena);
+        string.append_format(fmt, args...);
+
+        return string;
+      }
+
+    private:
+      /// The writable storage of the content
+      inline char* buffer() noexcept 
+      {
+        return nullptr == m_spill ? m_inline : m_spill;
+      }
+
+      /// Moves the content into a larger arena allocation, true only if it has room for n characters
+      inline bool grow(std::size_t n) noexcept 
+      {
+        if ( nullptr == m_arena ) {
+          return false;
+        }
+
+        std::size_t size = 2 * (capacity() + 1);
+
+        if ( size < n + 1 ) {
+          size = n + 1;
+        }
+
+        // The spill is usually the most recent allocation, growing it in place saves the copy
+        if ( nullptr != m_spill ) {
+          if ( m_arena->extend(m_spill, size) ) {
+            m_capacity = size;
+            return true;
+          }
+
+          if ( m_arena->extend(m_spill, n + 1) ) {
+            m_capacity = n + 1;
+            return true;
+          }
+        }
+
+        char* spill = static_cast<char*>(m_arena->allocate(size, 1));
+
+        if ( nullptr == spill ) {
+          size = n + 1;
+          spill = static_cast<char*>(m_arena->allocate(size, 1));
+        }
+
+        // Whatever is left in the arena still keeps more content than the current buffer
+        if ( nullptr == spill && m_arena->remaining() > capacity() + 1 ) {
+          size = m_arena->remaining();
+          spill = static_cast<char*>(m_arena->allocate(size, 1));
+        }
+
+        if ( nullptr == spill ) {
+          return false;
+        }
+
+        std::memcpy(spill, buffer(), m_size + 1);
+        m_spill = spill;
+        m_capacity = size;
+
+        // The rest of the arena may still be too small, callers writing n characters must not rely on it
+        return capacity() >= n;
+      }
+
+      /// Takes the content of other over and leaves other empty
+      inline void take(SpillString& other) noexcept 
+      {
+        m_spill = other.m_spill;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+        m_truncated = other.m_truncated;
+
+        if ( nullptr == m_spill ) {
+          std::memcpy(m_inline, other.m_inline, m_size + 1);
+        } else {
+          m_inline[0] = '\0';
+        }
+
+        other.clear();
+      }
+
+      /// Advances the write position after n characters were written behind the content
+      inline bool advance(std::size_t n) noexcept 
+      {
+        const std::size_t space = capacity() - m_size;
+        const bool complete = n <= space;
+
+        m_size += complete ? n : space;
+        buffer()[m_size] = '\0';
+        m_truncated = m_truncated || !complete;
+
+        return complete;
+      }
+
+      /// The arena spilled content lives in
+      MonotonicArena* m_arena = nullptr;
+      /// The spilled content, nullptr while the content is kept inline
+      char* m_spill = nullptr;
+      /// The size of the spilled allocation including the terminator
+      std::size_t m_capacity = 0;
+      /// The length of the content
+      std::size_t m_size = 0;
+      /// Set if content was cut off since the last clear or assignment
+      bool m_truncated = false;
+      /// The inline buffer
+      char m_inline[TInlineSize];
+  };
+}
@@ -3,13 +3,26 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include <gobeyond/utility/escape.hpp>
+#include <gobeyond/utility/format.hpp>
+#include <gobeyond/utility/hash.hpp>
+#include <gobeyond/utility/instrumentation.hpp>
+#include <gobeyond/utility/numeric.hpp>
+#include <gobeyond/utility/simd_string.hpp>
+#include <gobeyond/utility/utf8.hpp>
 
 namespace gobeyond::utility 
 {
   /**
    * @brief StringBuffer
    * 
-   * A simple string buffer that can be used to store messages.
+   * A simple string buffer that can be used to store messages. The
+   * buffer keeps track of the length of its content, so copies and
+   * moves only touch the bytes in use.
    * 
    * @tparam TBufferSize The size of the buffer
    * 
@@ -20,10 +33,20 @@ namespace gobeyond::utility
   template <std::size_t TBufferSize>
   class StringBuffer 
   {
+    static_assert(TBufferSize > 0, "StringBuffer needs room for the terminator");
+
     public:
       /// The buffer size
       static constexpr std::size_t buffer_size = TBufferSize;
 
+      /// Returned by the find functions if nothing was found
+      static constexpr std::size_t npos = std::string_view::npos;
+
+      /// The smallest unsigned type that can hold the length of the content
+      using size_type = std::conditional_t<(TBufferSize <= UINT8_MAX), std::uint8_t,
+        std::conditional_t<(TBufferSize <= UINT16_MAX), std::uint16_t,
+        std::conditional_t<(TBufferSize <= UINT32_MAX), std::uint32_t, std::size_t>>>;
+
       /**
        * @brief Constructor
        * 
@@ -33,12 +56,15 @@ namespace gobeyond::utility
        * 
        * @author t.schwarzinger@dina.de
        */
-      StringBuffer() = default;
+      inline StringBuffer() noexcept 
+      {
+        m_buffer[0] = '\0';
+      }
 
       /**
        * @brief Copy constructor
        * 
-       * Constructs a message by copying the buffer of another message.
+       * Constructs a message by copying the content of another message.
        * 
        * @param other The other message
        * 
@@ -46,15 +72,19 @@ namespace gobeyond::utility
        * 
        * @author t.schwarzinger@dina.de
        */
-      inline StringBuffer(const StringBuffer& other) noexcept 
+      inline StringBuffer(const StringBuffer& other) noexcept
+        : m_size(other.m_size),
+          m_truncated(other.m_truncated) 
       {
-        std::memcpy(m_buffer, other.m_buffer, buffer_size);
+        std::memcpy(m_buffer, other.m_buffer, static_cast<std::size_t>(m_size) + 1);
+        instrument_count(Counter::CopyBytes, static_cast<std::size_t>(m_size) + 1);
       }
 
       /**
        * @brief Move constructor
        * 
-       * Constructs a message by moving the buffer of another message.
+       * Constructs a message by moving the content of another message.
+       * The other message is empty afterwards.
        * 
        * @param other The other message
        * 
@@ -62,10 +92,13 @@ namespace gobeyond::utility
        * 
        * @author t.schwarzinger@dina.de
        */
-      inline StringBuffer(StringBuffer&& other) noexcept 
+      inline StringBuffer(StringBuffer&& other) noexcept
+        : m_size(other.m_size),
+          m_truncated(other.m_truncated) 
       {
-        std::memcpy(m_buffer, other.m_buffer, buffer_size);
-        std::memset(other.m_buffer, 0, buffer_size);
+        std::memcpy(m_buffer, other.m_buffer, static_cast<std::size_t>(m_size) + 1);
+        instrument_count(Counter::MoveBytes, static_cast<std::size_t>(m_size) + 1);
+        other.clear();
       }
 
       /**
@@ -79,20 +112,36 @@ namespace gobeyond::utility
        * 
        * @author t.schwarzinger@dina.de
        */
-      explicit inline StringBuffer(const char* s) 
+      explicit inline StringBuffer(const char* s) noexcept 
       {
         if ( nullptr == s ) {
-          std::snprintf(m_buffer, buffer_size, "");
+          m_buffer[0] = '\0';
           return;
         }
-        
-        std::snprintf(m_buffer, buffer_size, "%s", s);
+
+        assign(std::string_view(s, std::strlen(s)));
+      }
+
+      /**
+       * @brief Constructor
+       * 
+       * Constructs a message with the given string.
+       * 
+       * @param s The string to store
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit inline StringBuffer(std::string_view s) noexcept 
+      {
+        assign(s);
       }
 
       /**
        * @brief Copy assignment
        * 
-       * Assigns the buffer of another message to this message.
+       * Assigns the content of another message to this message.
        * 
        * @param other The other message
        * 
@@ -102,9 +151,14 @@ namespace gobeyond::utility
        * 
        * @author t.schwarzinger@dina.de
        */
-      StringBuffer& operator=(const StringBuffer& other) 
+      StringBuffer& operator=(const StringBuffer& other) noexcept 
       {
-        std::memcpy(m_buffer, other.m_buffer, buffer_size);
+        if ( this != &other ) {
+          m_size = other.m_size;
+          m_truncated = other.m_truncated;
+          std::memcpy(m_buffer, other.m_buffer, static_cast<std::size_t>(m_size) + 1);
+          instrument_count(Counter::CopyBytes, static_cast<std::size_t>(m_size) + 1);
+        }
 
         return *this;
       }
@@ -112,7 +166,8 @@ namespace gobeyond::utility
       /**
        * @brief Move assignment
        * 
-       * Assigns the buffer of another message to this message.
+       * Assigns the content of another message to this message. The other
+       * message is empty afterwards.
        * 
        * @param other The other message
        * 
@@ -124,8 +179,13 @@ namespace gobeyond::utility
        */
       StringBuffer& operator=(StringBuffer&& other) noexcept 
       {
-        std::memcpy(m_buffer, other.m_buffer, buffer_size);
-        std::memset(other.m_buffer, 0, buffer_size);
+        if ( this != &other ) {
+          m_size = other.m_size;
+          m_truncated = other.m_truncated;
+          std::memcpy(m_buffer, other.m_buffer, static_cast<std::size_t>(m_size) + 1);
+          instrument_count(Counter::MoveBytes, static_cast<std::size_t>(m_size) + 1);
+          other.clear();
+        }
 
         return *this;
       }
@@ -137,8 +197,8 @@ namespace gobeyond::utility
        * 
        * @return The message as a const char*
        * 
-       * @todo Was on purpose implicit operator, but SonarLint did not 
-       * allowed it. How to make sure that SonarLint, knows this is an 
+       * @todo Was on purpose implicit operator, but SonarLint did not
+       * allowed it. How to make sure that SonarLint, knows this is an
        * explicitly wanted exception of its rule?
        * 
        * @since 0.1
@@ -150,6 +210,768 @@ namespace gobeyond::utility
         return m_buffer;
       }
 
+      /**
+       * @brief C string
+       * 
+       * @return The null terminated content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const char* c_str() const noexcept 
+      {
+        return m_buffer;
+      }
+
+      /**
+       * @brief Data
+       * 
+       * @return The null terminated content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const char* data() const noexcept 
+      {
+        return m_buffer;
+      }
+
+      /**
+       * @brief View
+       * 
+       * Returns the content as a string view in constant time.
+       * 
+       * @return The content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::string_view view() const noexcept 
+      {
+        return std::string_view(m_buffer, m_size);
+      }
+
+      /**
+       * @brief Find
+       * 
+       * Searches the content with the vectorized str_find().
+       * 
+       * @param needle The string to search for
+       * @param pos The position to start at
+       * 
+       * @return The position of the first occurrence, npos if there is none
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t find(std::string_view needle, std::size_t pos = 0) const noexcept 
+      {
+        return str_find(view(), needle, pos);
+      }
+
+      /**
+       * @brief Find any of
+       * 
+       * Searches the content with the vectorized str_find_any_of().
+       * 
+       * @param set The characters to search for
+       * @param pos The position to start at
+       * 
+       * @return The position of the first character contained in set, npos 
+       * if there is none
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t find_any_of(std::string_view set, std::size_t pos = 0) const noexcept 
+      {
+        return str_find_any_of(view(), set, pos);
+      }
+
+      /**
+       * @brief Contains
+       * 
+       * @param needle The string to search for
+       * 
+       * @return true if the content contains needle, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool contains(std::string_view needle) const noexcept 
+      {
+        return npos != find(needle);
+      }
+
+      /**
+       * @brief Starts with
+       * 
+       * @param prefix The prefix
+       * 
+       * @return true if the content starts with prefix, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool starts_with(std::string_view prefix) const noexcept 
+      {
+        return str_starts_with(view(), prefix);
+      }
+
+      /**
+       * @brief Ends with
+       * 
+       * @param suffix The suffix
+       * 
+       * @return true if the content ends with suffix, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool ends_with(std::string_view suffix) const noexcept 
+      {
+        return str_ends_with(view(), suffix);
+      }
+
+      /**
+       * @brief Compare
+       * 
+       * Compares the content byte-wise with the vectorized str_compare().
+       * 
+       * @param other The string to compare with
+       * 
+       * @return A negative value if the content orders before other, 0 if 
+       * they are equal, a positive value otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline int compare(std::string_view other) const noexcept 
+      {
+        return str_compare(view(), other);
+      }
+
+      /**
+       * @brief Compare ignore case
+       * 
+       * Like compare(), but ASCII letters compare equal to their lower 
+       * case form.
+       * 
+       * @param other The string to compare with
+       * 
+       * @return A negative value if the content orders before other, 0 if 
+       * they are equal, a positive value otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline int compare_ignore_case(std::string_view other) const noexcept 
+      {
+        return str_compare_ignore_case(view(), other);
+      }
+
+      /**
+       * @brief Equals ignore case
+       * 
+       * @param other The string to compare with
+       * 
+       * @return true if the content equals other apart from the case of 
+       * ASCII letters, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool equals_ignore_case(std::string_view other) const noexcept 
+      {
+        return str_equals_ignore_case(view(), other);
+      }
+
+      /**
+       * @brief Equals
+       * 
+       * Compares the lengths first, the characters only if they match.
+       * 
+       * @param other The string to compare with
+       * 
+       * @return true if the content equals other, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool equals(std::string_view other) const noexcept 
+      {
+        return str_equals(view(), other);
+      }
+
+      /**
+       * @brief Hash
+       * 
+       * @param seed The seed
+       * 
+       * @return The hash_string() value of the content
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::uint64_t hash(std::uint64_t seed = 0) const noexcept 
+      {
+        return hash_string(view(), seed);
+      }
+
+      template <std::size_t TOtherSize>
+      [[nodiscard]] inline bool operator==(const StringBuffer<TOtherSize>& other) const noexcept 
+      {
+        return equals(other.view());
+      }
+
+      template <std::size_t TOtherSize>
+      [[nodiscard]] inline bool operator!=(const StringBuffer<TOtherSize>& other) const noexcept 
+      {
+        return !equals(other.view());
+      }
+
+      [[nodiscard]] inline bool operator==(std::string_view other) const noexcept 
+      {
+        return equals(other);
+      }
+
+      [[nodiscard]] inline bool operator!=(std::string_view other) const noexcept 
+      {
+        return !equals(other);
+      }
+
+      /**
+       * @brief Size
+       * 
+       * Returns the length of the content in constant time.
+       * 
+       * @return The length of the content without the terminator
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t size() const noexcept 
+      {
+        return m_size;
+      }
+
+      /**
+       * @brief Empty
+       * 
+       * @return true if the message has no content, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool empty() const noexcept 
+      {
+        return 0 == m_size;
+      }
+
+      /**
+       * @brief Capacity
+       * 
+       * @return The maximum length of the content (buffer_size - 1)
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] static constexpr std::size_t capacity() noexcept 
+      {
+        return buffer_size - 1;
+      }
+
+      /**
+       * @brief Clear
+       * 
+       * Removes the content of the message.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void clear() noexcept 
+      {
+        m_size = 0;
+        m_truncated = false;
+        m_buffer[0] = '\0';
+      }
+
+      /**
+       * @brief Assign
+       * 
+       * Replaces the content with the given string. Content that does
+       * not fit is cut off.
+       * 
+       * @param s The string to store
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void assign(std::string_view s) noexcept 
+      {
+        const std::size_t length = s.size() < capacity() ? s.size() : capacity();
+
+        if ( length > 0 ) {
+          std::memcpy(m_buffer, s.data(), length);
+        }
+
+        m_buffer[length] = '\0';
+        m_size = static_cast<size_type>(length);
+        m_truncated = length < s.size();
+      }
+
+      /**
+       * @brief Truncated
+       * 
+       * Reports whether content was cut off because it did not fit into 
+       * the buffer since the last clear, assignment or format.
+       * 
+       * @return true if content was lost, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool truncated() const noexcept 
+      {
+        return m_truncated;
+      }
+
+      /**
+       * @brief Tail
+       * 
+       * The free space behind the content, returned by reserve_tail().
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      struct Tail 
+      {
+        /// The first free character
+        char* data;
+        /// The number of characters that can be written (without terminator)
+        std::size_t size;
+      };
+
+      /**
+       * @brief Reserve tail
+       * 
+       * Gives direct access to the free space behind the content. Write 
+       * into it and call commit() with the number of characters written.
+       * 
+       * @return The free space
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline Tail reserve_tail() noexcept 
+      {
+        return Tail{m_buffer + m_size, capacity() - m_size};
+      }
+
+      /**
+       * @brief Commit
+       * 
+       * Appends n characters that were written into the tail returned by 
+       * reserve_tail(). A count beyond the tail is rejected, the content
+       * stays unchanged and the buffer is marked as truncated.
+       * 
+       * @param n The number of characters written
+       * 
+       * @return true if the characters were appended, false if n exceeded the tail
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool commit(std::size_t n) noexcept 
+      {
+        if ( n > capacity() - m_size ) {
+          // The characters behind what the caller wrote were never initialized,
+          // the caller may have overwritten the terminator though
+          m_buffer[m_size] = '\0';
+          m_truncated = true;
+          return false;
+        }
+
+        return advance(n);
+      }
+
+      /**
+       * @brief Commit truncated
+       * 
+       * Appends a text of n characters whose beginning was written into
+       * the tail returned by reserve_tail(), e.g. by snprintf. What fits
+       * is kept and the buffer is marked as truncated if n exceeded the
+       * tail.
+       * 
+       * @param n The length of the complete text
+       * 
+       * @return true if the text fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool commit_truncated(std::size_t n) noexcept 
+      {
+        return advance(n);
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a string at the current write position.
+       * 
+       * @param s The string to append
+       * 
+       * @return true if the string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(std::string_view s) noexcept 
+      {
+        const std::size_t space = capacity() - m_size;
+        const std::size_t length = s.size() < space ? s.size() : space;
+
+        if ( length > 0 ) {
+          std::memcpy(m_buffer + m_size, s.data(), length);
+        }
+
+        advance(length);
+
+        if ( length < s.size() ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a null terminated string. nullptr appends nothing.
+       * 
+       * @param s The string to append
+       * 
+       * @return true if the string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(const char* s) noexcept 
+      {
+        return nullptr == s || append(std::string_view(s, std::strlen(s)));
+      }
+
+      /**
+       * @brief Append UTF-8
+       * 
+       * Appends a string as valid UTF-8. Invalid sequences are replaced
+       * with U+FFFD. A string that does not fit is cut off on a code point
+       * boundary and followed by marker, for example "..." or "\u2026".
+       * The vectorized validator makes the check cheap enough for every
+       * message, the copy is a single memcpy for valid input.
+       * 
+       * @param s The string to append
+       * @param marker Appended if s was cut off, omitted if the buffer is smaller than the marker
+       * 
+       * @return true if the string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append_utf8(std::string_view s, std::string_view marker = std::string_view()) noexcept 
+      {
+        const std::size_t space = capacity() - m_size;
+        std::size_t consumed = 0;
+        std::size_t written = utf8_sanitize_to(m_buffer + m_size, space, s, consumed);
+
+        if ( consumed < s.size() && !marker.empty() && marker.size() <= space ) {
+          // Cut further, so the marker fits behind the last complete code point
+          written = utf8_sanitize_to(m_buffer + m_size, space - marker.size(), s, consumed);
+          std::memcpy(m_buffer + m_size + written, marker.data(), marker.size());
+          written += marker.size();
+        }
+
+        advance(written);
+
+        if ( consumed < s.size() ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Repair UTF-8
+       * 
+       * The UTF-8 mode of the formatting functions. format() and
+       * append_format() cut the output wherever the buffer ends, which may
+       * split a multi-byte sequence. Called afterwards, this removes an
+       * incomplete code point at the end, replaces invalid sequences with
+       * U+FFFD and, if the content was cut off, appends marker.
+       * 
+       * @param marker Appended if the content was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline void repair_utf8(std::string_view marker = std::string_view()) noexcept 
+      {
+        const bool truncated = m_truncated;
+
+        if ( truncated ) {
+          m_size = static_cast<size_type>(utf8_complete(view()));
+          m_buffer[m_size] = '\0';
+        }
+
+        std::size_t consumed = 0;
+        const std::size_t size = utf8_sanitize_in_place(m_buffer, m_size, capacity(), consumed);
+
+        m_truncated = m_truncated || consumed < m_size;
+        m_size = static_cast<size_type>(size);
+        m_buffer[m_size] = '\0';
+
+        if ( truncated && !marker.empty() && marker.size() <= capacity() ) {
+          if ( capacity() - m_size < marker.size() ) {
+            m_size = static_cast<size_type>(utf8_boundary(view(), capacity() - marker.size()));
+          }
+
+          m_buffer[m_size] = '\0';
+          append(marker);
+        }
+
+        m_truncated = m_truncated || truncated;
+      }
+
+      /**
+       * @brief Append escaped
+       * 
+       * Escapes a string straight into the buffer with escape_to(), clean
+       * runs are copied in bulk. If the buffer is too small, the content
+       * ends before the first escape sequence that does not fit
+       * completely.
+       * 
+       * @param s The string to escape
+       * @param mode The encoding
+       * 
+       * @return true if the escaped string fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append_escaped(std::string_view s, Escape mode = Escape::Json) noexcept 
+      {
+        const EscapeResult result = escape_to(m_buffer + m_size, capacity() - m_size, s, mode);
+
+        advance(result.written);
+
+        if ( result.consumed < s.size() ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the content of another message.
+       * 
+       * @param other The message to append
+       * 
+       * @return true if the content fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <std::size_t TOtherSize>
+      inline bool append(const StringBuffer<TOtherSize>& other) noexcept 
+      {
+        return append(other.view());
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends a single character.
+       * 
+       * @param c The character to append
+       * 
+       * @return true if the character fit, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(char c) noexcept 
+      {
+        if ( m_size == capacity() ) {
+          m_truncated = true;
+          return false;
+        }
+
+        m_buffer[m_size] = c;
+        return advance(1);
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends "true" or "false".
+       * 
+       * @param value The value to append
+       * 
+       * @return true if the text fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      inline bool append(bool value) noexcept 
+      {
+        return append(value ? std::string_view("true") : std::string_view("false"));
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the decimal representation of an integer. The number is 
+       * either appended completely or not at all.
+       * 
+       * @tparam T The integer type
+       * 
+       * @param value The value to append
+       * 
+       * @return true if the number fit, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+      inline bool append(T value) noexcept 
+      {
+        if ( decimal_length(value) > capacity() - m_size ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return advance(static_cast<std::size_t>(write_decimal(m_buffer + m_size, value) - (m_buffer + m_size)));
+      }
+
+      /**
+       * @brief Append
+       * 
+       * Appends the shortest representation of a floating point value that 
+       * reads back to the same value. The number is either appended 
+       * completely or not at all.
+       * 
+       * @tparam T The floating point type
+       * 
+       * @param value The value to append
+       * 
+       * @return true if the number fit, false otherwise
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>, typename = void>
+      inline bool append(T value) noexcept 
+      {
+        char* last = write_shortest(m_buffer + m_size, m_buffer + capacity(), value);
+
+        if ( nullptr == last ) {
+          m_truncated = true;
+          return false;
+        }
+
+        return advance(static_cast<std::size_t>(last - (m_buffer + m_size)));
+      }
+
+      /**
+       * @brief Append format
+       * 
+       * Formats the arguments with a compile-time format string and 
+       * appends the result at the current write position.
+       * 
+       * @tparam TFormat The format string type (see GBE_FMT)
+       * @tparam TArgs The argument types
+       * 
+       * @param fmt The format string
+       * @param args The arguments
+       * 
+       * @return true if the output fit completely, false if it was cut off
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+      inline bool append_format(TFormat fmt, const TArgs&... args) noexcept 
+      {
+        InstrumentationTimer timer(Histogram::FormatLatency);
+        const std::size_t length = format_to(m_buffer + m_size, buffer_size - m_size, fmt, args...);
+
+        instrumentFormat(length, capacity() - m_size);
+        return advance(length);
+      }
+
+      /**
+       * @brief Stream operator
+       * 
+       * Appends anything accepted by append(). Check truncated() to find 
+       * out whether content was cut off.
+       * 
+       * @tparam T The value type
+       * 
+       * @param value The value to append
+       * 
+       * @return This message
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename T>
+      inline StringBuffer& operator<<(const T& value) noexcept 
+      {
+        append(value);
+        return *this;
+      }
+
       /**
        * @brief Format
        * 
@@ -165,10 +987,7 @@ namespace gobeyond::utility
        */
       [[nodiscard]] static StringBuffer format(const char* fmt) 
       {
-        StringBuffer buffer;
-        std::snprintf(buffer.m_buffer, buffer_size, "%s", fmt);
-
-        return buffer;
+        return StringBuffer(fmt);
       }
 
       /**
@@ -190,14 +1009,117 @@ namespace gobeyond::utility
       template <typename... TArgs>
       [[nodiscard]] static StringBuffer format(const char* fmt, TArgs... args) 
       {
+        InstrumentationTimer timer(Histogram::FormatLatency);
         StringBuffer buffer;
-        std::snprintf(buffer.m_buffer, buffer_size, fmt, args...);
+        const int length = std::snprintf(buffer.m_buffer, buffer_size, fmt, args...);
+
+        buffer.setSize(length);
+        instrumentFormat(length < 0 ? 0 : static_cast<std::size_t>(length), capacity());
+
+        return buffer;
+      }
+
+      /**
+       * @brief Format
+       * 
+       * Formats a message with a compile-time format string. The format
+       * string is parsed and checked against the argument types at
+       * compile time and the arguments are written straight into the
+       * buffer without going through snprintf.
+       * 
+       * @tparam TFormat The format string type (see GBE_FMT)
+       * @tparam TArgs The argument types
+       * 
+       * @param fmt The format string, e.g. GBE_FMT("%s=%d")
+       * @param args The arguments
+       * 
+       * @return The formatted message
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      template <typename TFormat, typename... TArgs, typename = std::enable_if_t<is_format_string_v<TFormat>>>
+      [[nodiscard]] static StringBuffer format(TFormat fmt, const TArgs&... args) noexcept 
+      {
+        InstrumentationTimer timer(Histogram::FormatLatency);
+        StringBuffer buffer;
+        const std::size_t length = format_to(buffer.m_buffer, buffer_size, fmt, args...);
+
+        buffer.setSize(length);
+        instrumentFormat(length, capacity());
 
         return buffer;
       }
 
     private:
+      /// Feeds a format call that produced length characters for the given space into the instrumentation
+      static inline void instrumentFormat([[maybe_unused]] std::size_t length, [[maybe_unused]] std::size_t space) noexcept 
+      {
+        if constexpr ( instrumentation_enabled ) {
+          instrument_count(Counter::FormatCalls);
+          instrument_count(Counter::FormatBytes, length < space ? length : space);
+          instrument_record(Histogram::FormatLength, length);
+
+          if ( length > space ) {
+            instrument_count(Counter::FormatTruncations);
+          }
+        }
+      }
+
+      /// Stores the length reported by a snprintf-like call, limited to the capacity
+      template <typename TLength>
+      inline void setSize(TLength length) noexcept 
+      {
+        if ( length < 0 ) {
+          clear();
+          return;
+        }
+
+        const std::size_t written = static_cast<std::size_t>(length);
+        m_size = static_cast<size_type>(written < capacity() ? written : capacity());
+        m_truncated = written > capacity();
+      }
+
+      /// Advances the write position after n characters were written into the tail
+      inline bool advance(std::size_t n) noexcept 
+      {
+        const std::size_t space = capacity() - m_size;
+        const bool complete = n <= space;
+
+        m_size = static_cast<size_type>(m_size + (complete ? n : space));
+        m_buffer[m_size] = '\0';
+        m_truncated = m_truncated || !complete;
+
+        return complete;
+      }
+
+      /// The length of the content
+      size_type m_size = 0;
+      /// Set if content was cut off since the last clear or assignment
+      bool m_truncated = false;
       /// The buffer
-      char m_buffer[TBufferSize] = {0};
+      char m_buffer[TBufferSize];
+  };
+}
+
+namespace std 
+{
+  /**
+   * @brief std::hash specialization
+   * 
+   * Lets StringBuffer be used as key of the standard unordered containers.
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TBufferSize>
+  struct hash<gobeyond::utility::StringBuffer<TBufferSize>> 
+  {
+    [[nodiscard]] inline std::size_t operator()(const gobeyond::utility::StringBuffer<TBufferSize>& buffer) const noexcept 
+    {
+      return static_cast<std::size_t>(buffer.hash());
+    }
   };
-}
\ No newline at end of file
+}
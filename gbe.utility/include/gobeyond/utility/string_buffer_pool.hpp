@@ -0,0 +1,413 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <gobeyond/utility/instrumentation.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+#include <gobeyond/utility/thread_slots.hpp>
+
+namespace gobeyond::utility 
+{
+  /**
+   * @brief StringBufferPool
+   * 
+   * A fixed set of pre-allocated, cache line aligned string buffers.
+   * Each thread keeps a small cache of free buffers, the caches are
+   * refilled from and drained into a lock-free shared free list. At
+   * steady state acquiring and releasing a buffer touches neither the
+   * heap nor a cache line shared with other threads.
+   * 
+   * Buffers parked in the cache of one thread are not visible to other
+   * threads, so the capacity should leave room for
+   * thread_cache_size buffers per thread.
+   * 
+   * @tparam TBufferSize The size of the buffers
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <std::size_t TBufferSize>
+  class StringBufferPool 
+  {
+    public:
+      /// The buffer type
+      using buffer_type = StringBuffer<TBufferSize>;
+
+      /// The maximum number of free buffers cached per thread
+      static constexpr std::size_t thread_cache_size = 16;
+
+      /**
+       * @brief Statistics
+       * 
+       * A snapshot of the pool counters.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      struct Statistics 
+      {
+        /// The number of buffers in the pool
+        std::size_t capacity = 0;
+        /// The number of buffers currently handed out
+        std::size_t in_use = 0;
+        /// The maximum number of buffers drawn from the shared free list at the same time (in use or cached by threads)
+        std::size_t high_water_mark = 0;
+        /// The number of successful acquisitions
+        std::uint64_t acquired = 0;
+        /// The number of acquisitions that failed because the pool was empty
+        std::uint64_t exhausted = 0;
+        /// The number of buffers released by another thread than the one that acquired them
+        std::uint64_t cross_thread_frees = 0;
+      };
+
+      /**
+       * @brief Handle
+       * 
+       * Owns a buffer of the pool and returns it on destruction.
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      class Handle 
+      {
+        public:
+          /// Constructs an empty handle
+          Handle() noexcept = default;
+
+          Handle(const Handle&) = delete;
+          Handle& operator=(const Handle&) = delete;
+
+          inline Handle(Handle&& other) noexcept
+            : m_pool(other.m_pool),
+              m_index(other.m_index) 
+          {
+            other.m_pool = nullptr;
+          }
+
+          inline Handle& operator=(Handle&& other) noexcept 
+          {
+            if ( this != &other ) {
+              reset();
+              m_pool = other.m_pool;
+              m_index = other.m_index;
+              other.m_pool = nullptr;
+            }
+
+            return *this;
+          }
+
+          inline ~Handle() 
+          {
+            reset();
+          }
+
+          /**
+           * @brief Reset
+           * 
+           * Returns the buffer to the pool. The handle is empty afterwards.
+           * 
+           * @since 0.2
+           * 
+           * @author t.schwarzinger@dina.de
+           */
+          inline void reset() noexcept 
+          {
+            if ( nullptr != m_pool ) {
+              m_pool->release(m_index);
+              m_pool = nullptr;
+            }
+          }
+
+          /// The buffer, nullptr if the handle is empty
+          [[nodiscard]] inline buffer_type* get() const noexcept 
+          {
+            return nullptr == m_pool ? nullptr : &m_pool->m_slots[m_index].buffer;
+          }
+
+          [[nodiscard]] inline buffer_type& operator*() const noexcept 
+          {
+            return m_pool->m_slots[m_index].buffer;
+          }
+
+          [[nodiscard]] inline buffer_type* operator->() const noexcept 
+          {
+            return &m_pool->m_slots[m_index].buffer;
+          }
+
+          /// true if the handle owns a buffer
+          [[nodiscard]] explicit inline operator bool() const noexcept 
+          {
+            return nullptr != m_pool;
+          }
+
+        private:
+          friend class StringBufferPool;
+
+          inline Handle(StringBufferPool* pool, std::uint32_t index) noexcept
+            : m_pool(pool),
+              m_index(index)
+          {}
+
+          StringBufferPool* m_pool = nullptr;
+          std::uint32_t m_index = 0;
+      };
+
+      /**
+       * @brief Constructor
+       * 
+       * Allocates all buffers up front.
+       * 
+       * @param capacity The number of buffers
+       * @param max_threads The maximum number of threads with their own cache, further threads use the shared free list directly
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit StringBufferPool(std::size_t capacity, std::size_t max_threads = 64)
+        : m_slots(new Slot[capacity]),
+          m_capacity(capacity),
+          m_caches(max_threads, [this](Cache& cache) { flush(cache); }) 
+      {
+        for ( std::size_t i = capacity; i > 0; --i ) {
+          push(static_cast<std::uint32_t>(i - 1));
+        }
+
+        m_outstanding.store(0, std::memory_order_relaxed);
+        m_high_water_mark.store(0, std::memory_order_relaxed);
+      }
+
+      StringBufferPool(const StringBufferPool&) = delete;
+      StringBufferPool& operator=(const StringBufferPool&) = delete;
+
+      /**
+       * @brief Acquire
+       * 
+       * Takes a cleared buffer out of the pool.
+       * 
+       * @return The buffer, an empty handle if the pool is exhausted
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] Handle acquire() noexcept 
+      {
+        Cache* cache = m_caches.local();
+        std::uint32_t index = nil;
+
+        if ( nullptr == cache ) {
+          index = pop();
+        } else {
+          if ( 0 == cache->count ) {
+            refill(*cache);
+          }
+
+          if ( cache->count > 0 ) {
+            index = cache->items[--cache->count];
+            increment(cache->acquired);
+          }
+        }
+
+        if ( nil == index ) {
+          m_exhausted.fetch_add(1, std::memory_order_relaxed);
+          instrument_count(Counter::PoolExhausted);
+          return Handle();
+        }
+
+        instrument_count(Counter::PoolAcquires);
+
+        if ( nullptr == cache ) {
+          m_unowned_acquired.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Slot& slot = m_slots[index];
+        slot.owner = cache;
+        slot.buffer.clear();
+
+        return Handle(this, index);
+      }
+
+      /**
+       * @brief Statistics
+       * 
+       * Collects the counters of all threads without stopping them. The
+       * values of a running pool are a consistent-enough approximation.
+       * 
+       * @return The statistics
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] Statistics statistics() const noexcept 
+      {
+        Statistics stats;
+        std::uint64_t released = m_unowned_released.load(std::memory_order_relaxed);
+
+        stats.capacity = m_capacity;
+        stats.acquired = m_unowned_acquired.load(std::memory_order_relaxed);
+        stats.exhausted = m_exhausted.load(std::memory_order_relaxed);
+        stats.high_water_mark = m_high_water_mark.load(std::memory_order_relaxed);
+
+        for ( std::size_t i = 0; i < m_caches.count(); ++i ) {
+          const Cache& cache = m_caches[i];
+
+          stats.acquired += cache.acquired.load(std::memory_order_relaxed);
+          stats.cross_thread_frees += cache.cross_thread_frees.load(std::memory_order_relaxed);
+          released += cache.released.load(std::memory_order_relaxed);
+        }
+
+        stats.cross_thread_frees += m_unowned_cross_thread_frees.load(std::memory_order_relaxed);
+        stats.in_use = stats.acquired > released ? static_cast<std::size_t>(stats.acquired - released) : 0;
+
+        return stats;
+      }
+
+    private:
+      static constexpr std::uint32_t nil = UINT32_MAX;
+
+      struct Cache 
+      {
+        std::uint32_t count = 0;
+        std::uint32_t items[thread_cache_size] = {};
+        /// Written by the owning thread only, atomic so statistics() can read them
+        std::atomic<std::uint64_t> acquired{0};
+        std::atomic<std::uint64_t> released{0};
+        std::atomic<std::uint64_t> cross_thread_frees{0};
+      };
+
+      struct alignas(cache_line_size) Slot 
+      {
+        /// The buffer, first so it starts on a cache line
+        buffer_type buffer;
+        /// The next free slot while the slot is in the shared free list
+        std::atomic<std::uint32_t> next{nil};
+        /// The cache of the acquiring thread, nullptr for threads without a cache
+        const Cache* owner = nullptr;
+      };
+
+      static inline void increment(std::atomic<std::uint64_t>& counter) noexcept 
+      {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      }
+
+      static inline std::uint64_t pack(std::uint64_t tag, std::uint32_t index) noexcept 
+      {
+        return (tag << 32) | index;
+      }
+
+      void release(std::uint32_t index) noexcept 
+      {
+        Cache* cache = m_caches.local();
+        const bool foreign = m_slots[index].owner != cache;
+
+        if ( nullptr == cache ) {
+          m_unowned_released.fetch_add(1, std::memory_order_relaxed);
+
+          if ( foreign ) {
+            m_unowned_cross_thread_frees.fetch_add(1, std::memory_order_relaxed);
+          }
+
+          push(index);
+          return;
+        }
+
+        increment(cache->released);
+
+        if ( foreign ) {
+          increment(cache->cross_thread_frees);
+        }
+
+        if ( thread_cache_size == cache->count ) {
+          // Give half of the cache back, so other threads can use it
+          while ( cache->count > thread_cache_size / 2 ) {
+            push(cache->items[--cache->count]);
+          }
+        }
+
+        cache->items[cache->count++] = index;
+      }
+
+      void refill(Cache& cache) noexcept 
+      {
+        while ( cache.count < thread_cache_size / 2 ) {
+          const std::uint32_t index = pop();
+
+          if ( nil == index ) {
+            break;
+          }
+
+          cache.items[cache.count++] = index;
+        }
+      }
+
+      void flush(Cache& cache) noexcept 
+      {
+        while ( cache.count > 0 ) {
+          push(cache.items[--cache.count]);
+        }
+      }
+
+      /// Pops from the shared free list, the tag in the upper half of the head prevents ABA
+      std::uint32_t pop() noexcept 
+      {
+        std::uint64_t head = m_head.load(std::memory_order_acquire);
+
+        for ( ;; ) {
+          const std::uint32_t index = static_cast<std::uint32_t>(head);
+
+          if ( nil == index ) {
+            return nil;
+          }
+
+          const std::uint32_t next = m_slots[index].next.load(std::memory_order_relaxed);
+
+          if ( m_head.compare_exchange_weak(head, pack((head >> 32) + 1, next), std::memory_order_acquire, std::memory_order_acquire) ) {
+            const std::size_t outstanding = m_outstanding.fetch_add(1, std::memory_order_relaxed) + 1;
+            std::size_t high = m_high_water_mark.load(std::memory_order_relaxed);
+
+            while ( outstanding > high && !m_high_water_mark.compare_exchange_weak(high, outstanding, std::memory_order_relaxed) ) {
+            }
+
+            return index;
+          }
+        }
+      }
+
+      void push(std::uint32_t index) noexcept 
+      {
+        std::uint64_t head = m_head.load(std::memory_order_relaxed);
+
+        m_outstanding.fetch_sub(1, std::memory_order_relaxed);
+
+        do {
+          m_slots[index].next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        } while ( !m_head.compare_exchange_weak(head, pack((head >> 32) + 1, index), std::memory_order_release, std::memory_order_relaxed) );
+      }
+
+      /// The buffers
+      std::unique_ptr<Slot[]> m_slots;
+      /// The number of buffers
+      std::size_t m_capacity;
+      /// The head of the shared free list (tag << 32 | index)
+      alignas(cache_line_size) std::atomic<std::uint64_t> m_head{pack(0, nil)};
+      /// The number of buffers outside the shared free list
+      alignas(cache_line_size) std::atomic<std::size_t> m_outstanding{0};
+      /// The maximum of m_outstanding
+      std::atomic<std::size_t> m_high_water_mark{0};
+      /// Counters of threads without a cache and of failed acquisitions
+      alignas(cache_line_size) std::atomic<std::uint64_t> m_exhausted{0};
+      std::atomic<std::uint64_t> m_unowned_acquired{0};
+      std::atomic<std::uint64_t> m_unowned_released{0};
+      std::atomic<std::uint64_t> m_unowned_cross_thread_frees{0};
+      /// The per-thread caches, declared last so exiting threads stop flushing before the rest is destroyed
+      ThreadSlots<Cache> m_caches;
+  };
+}
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace gobeyond::utility 
+{
+  /// The assumed size of a cache line
+  inline constexpr std::size_t cache_line_size = 64;
+
+  namespace thread_slots_detail 
+  {
+    class Owner 
+    {
+      public:
+        virtual void releaseSlot(std::size_t index) noexcept = 0;
+
+      protected:
+        ~Owner() = default;
+    };
+
+    /// Keeps track of the living owners, so exiting threads never touch a destroyed one
+    struct Registry 
+    {
+      std::mutex mutex;
+      std::unordered_set<std::uint64_t> live;
+      std::atomic<std::uint64_t> next_id{1};
+    };
+
+    inline Registry& registry() 
+    {
+      static Registry instance;
+      return instance;
+    }
+
+    struct Entry 
+    {
+      std::uint64_t id;
+      Owner* owner;
+      std::size_t index;
+      void* slot;
+    };
+
+    /// The slots claimed by the current thread, released when the thread exits
+    struct LocalTable 
+    {
+      std::uint64_t last_id = 0;
+      void* last_slot = nullptr;
+      std::size_t last_index = 0;
+      std::vector<Entry> entries;
+
+      ~LocalTable() 
+      {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        for ( const Entry& entry : entries ) {
+          if ( reg.live.count(entry.id) > 0 ) {
+            entry.owner->releaseSlot(entry.index);
+          }
+        }
+      }
+    };
+
+    inline LocalTable& localTable() 
+    {
+      thread_local LocalTable table;
+      return table;
+    }
+  }
+
+  /**
+   * @brief ThreadSlots
+   * 
+   * A fixed number of cache line aligned slots, each owned by at most
+   * one thread. A thread claims a slot on its first call to local() and
+   * gives it back when it exits, so per-thread state can live inside an
+   * object instead of in a thread_local variable.
+   * 
+   * @tparam TSlot The slot type
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TSlot>
+  class ThreadSlots final : private thread_slots_detail::Owner 
+  {
+    public:
+      /// Called with a slot whose thread exited, before the slot can be claimed again
+      using release_function = std::function<void(TSlot&)>;
+
+      /**
+       * @brief Constructor
+       * 
+       * @param count The maximum number of threads holding a slot at the same time
+       * @param on_release Called with the slot of an exiting thread (optional)
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      explicit ThreadSlots(std::size_t count, release_function on_release = {})
+        : m_holders(new Holder[count]),
+          m_count(count),
+          m_on_release(std::move(on_release)),
+          m_id(thread_slots_detail::registry().next_id.fetch_add(1, std::memory_order_relaxed)) 
+      {
+        thread_slots_detail::Registry& reg = thread_slots_detail::registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.live.insert(m_id);
+      }
+
+      ThreadSlots(const ThreadSlots&) = delete;
+      ThreadSlots& operator=(const ThreadSlots&) = delete;
+
+      ~ThreadSlots() 
+      {
+        thread_slots_detail::Registry& reg = thread_slots_detail::registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.live.erase(m_id);
+      }
+
+      /**
+       * @brief Local
+       * 
+       * Returns the slot of the calling thread and claims one on the
+       * first call.
+       * 
+       * @return The slot of the calling thread, nullptr if all slots
+       * are owned by other threads
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline TSlot* local() noexcept 
+      {
+        thread_slots_detail::LocalTable& table = thread_slots_detail::localTable();
+
+        if ( table.last_id == m_id ) {
+          return static_cast<TSlot*>(table.last_slot);
+        }
+
+        return lookup(table);
+      }
+
+      /**
+       * @brief Local index
+       * 
+       * @return The index of the slot of the calling thread, count() if
+       * the thread has no slot
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t local_index() noexcept 
+      {
+        TSlot* slot = local();
+        return nullptr == slot ? m_count : thread_slots_detail::localTable().last_index;
+      }
+
+      /**
+       * @brief Count
+       * 
+       * @return The number of slots
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t count() const noexcept 
+      {
+        return m_count;
+      }
+
+      /**
+       * @brief Slot access
+       * 
+       * Gives access to any slot, e.g. to merge statistics. The caller
+       * is responsible for synchronizing with the owning thread.
+       * 
+       * @param index The slot index
+       * 
+       * @return The slot
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline TSlot& operator[](std::size_t index) noexcept 
+      {
+        return m_holders[index].slot;
+      }
+
+      /// @copydoc operator[]
+      [[nodiscard]] inline const TSlot& operator[](std::size_t index) const noexcept 
+      {
+        return m_holders[index].slot;
+      }
+
+    private:
+      struct alignas(cache_line_size) Holder 
+      {
+        std::atomic<bool> claimed{false};
+        TSlot slot{};
+      };
+
+      TSlot* lookup(thread_slots_detail::LocalTable& table) noexcept 
+      {
+        for ( const thread_slots_detail::Entry& entry : table.entries ) {
+          if ( entry.id == m_id ) {
+            table.last_id = m_id;
+            table.last_slot = entry.slot;
+            table.last_index = entry.index;
+            return static_cast<TSlot*>(entry.slot);
+          }
+        }
+
+        for ( std::size_t i = 0; i < m_count; ++i ) {
+          bool expected = false;
+
+          if ( !m_holders[i].claimed.load(std::memory_order_relaxed)
+            && m_holders[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire) ) {
+            TSlot* slot = &m_holders[i].slot;
+
+            try {
+              pruneDeadEntries(table);
+              table.entries.push_back({m_id, this, i, slot});
+            } catch ( ... ) {
+              m_holders[i].claimed.store(false, std::memory_order_release);
+              return nullptr;
+            }
+
+            table.last_id = m_id;
+            table.last_slot = slot;
+            table.last_index = i;
+
+            return slot;
+          }
+        }
+
+        return nullptr;
+      }
+
+      /// Drops the entries of destroyed instances, so threads using many short-lived ones do not pile them up
+      static void pruneDeadEntries(thread_slots_detail::LocalTable& table) 
+      {
+        thread_slots_detail::Registry& reg = thread_slots_detail::registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        table.entries.erase(std::remove_if(table.entries.begin(), table.entries.end(), [&reg](const thread_slots_detail::Entry& entry) {
+          return 0 == reg.live.count(entry.id);
+        }), table.entries.end());
+      }
+
+      void releaseSlot(std::size_t index) noexcept override 
+      {
+        if ( m_on_release ) {
+          m_on_release(m_holders[index].slot);
+        }
+
+        m_holders[index].claimed.store(false, std::memory_order_release);
+      }
+
+      /// The slots
+      std::unique_ptr<Holder[]> m_holders;
+      /// The number of slots
+      std::size_t m_count;
+      /// Called when a thread gives its slot back
+      release_function m_on_release;
+      /// Identifies this instance in the thread local tables
+      std::uint64_t m_id;
+  };
+}
@@ -0,0 +1,589 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <gobeyond/utility/simd_string.hpp>
+
+namespace gobeyond::utility 
+{
+  namespace utf8_detail 
+  {
+    /// The kernels of one instruction set
+    struct Kernels 
+    {
+      bool (*valid)(const char* s, std::size_t size) noexcept;
+    };
+
+    inline bool isContinuation(unsigned char c) noexcept 
+    {
+      return 0x80 == (c & 0xC0);
+    }
+
+    /**
+     * Checks the sequence at the start of s. Returns its length if it is
+     * valid, otherwise 0 and sets invalid to the length of its maximal
+     * valid prefix (at least 1), the part replaced by a single U+FFFD.
+     */
+    inline std::size_t decode(const unsigned char* s, std::size_t size, std::size_t& invalid) noexcept 
+    {
+      const unsigned char lead = s[0];
+      std::size_t length = 0;
+      unsigned char low = 0x80;
+      unsigned char high = 0xBF;
+
+      if ( lead < 0x80 ) {
+        return 1;
+      }
+
+      if ( lead >= 0xC2 && lead <= 0xDF ) {
+        length = 2;
+      } else if ( lead >= 0xE0 && lead <= 0xEF ) {
+        length = 3;
+        // No overlong forms and no UTF-16 surrogates
+        low = 0xE0 == lead ? 0xA0 : 0x80;
+        high = 0xED == lead ? 0x9F : 0xBF;
+      } else if ( lead >= 0xF0 && lead <= 0xF4 ) {
+        length = 4;
+        // No overlong forms and nothing above U+10FFFF
+        low = 0xF0 == lead ? 0x90 : 0x80;
+        high = 0xF4 == lead ? 0x8F : 0xBF;
+      } else {
+        invalid = 1;
+        return 0;
+      }
+
+      for ( std::size_t i = 1; i < length; ++i ) {
+        if ( i >= size || s[i] < low || s[i] > high ) {
+          invalid = i;
+          return 0;
+        }
+
+        low = 0x80;
+        high = 0xBF;
+      }
+
+      return length;
+    }
+
+    /// The position of the first invalid sequence, size if there is none
+    inline std::size_t scalarValidPrefix(const char* s, std::size_t size) noexcept 
+    {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+      std::size_t i = 0;
+
+      while ( i < size ) {
+        if ( i + 8 <= size ) {
+          std::uint64_t word;
+          std::memcpy(&word, p + i, sizeof(word));
+
+          if ( 0 == (word & 0x8080808080808080ull) ) {
+            i += 8;
+            continue;
+          }
+        }
+
+        std::size_t invalid = 0;
+        const std::size_t length = decode(p + i, size - i, invalid);
+
+        if ( 0 == length ) {
+          return i;
+        }
+
+        i += length;
+      }
+
+      return size;
+    }
+
+    /**
+     * The number of bytes to scan for a valid run copied into space bytes.
+     * A sequence cut off by the limit starts behind space, so it is never
+     * mistaken for an invalid one in front of it.
+     */
+    inline std::size_t scanLimit(std::size_t size, std::size_t space) noexcept 
+    {
+      return space < size && size - space > 4 ? space + 4 : size;
+    }
+
+    inline bool scalarValid(const char* s, std::size_t size) noexcept 
+    {
+      return size == scalarValidPrefix(s, size);
+    }
+
+    inline constexpr Kernels scalar_kernels = {scalarValid};
+
+#if defined(GBE_UTILITY_SIMD_X86)
+    /// Skips ASCII 16 bytes at a time, sequences are checked one by one
+    inline bool sse2Valid(const char* s, std::size_t size) noexcept 
+    {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+      std::size_t i = 0;
+
+      while ( i < size ) {
+        if ( i + 16 <= size && 0 == simd_detail::sse2Mask(simd_detail::sse2Load(s + i)) ) {
+          i += 16;
+          continue;
+        }
+
+        std::size_t invalid = 0;
+        const std::size_t length = decode(p + i, size - i, invalid);
+
+        if ( 0 == length ) {
+          return false;
+        }
+
+        i += length;
+      }
+
+      return true;
+    }
+
+    inline constexpr Kernels sse2_kernels = {sse2Valid};
+
+    // The error classes of the lookup algorithm by Keiser and Lemire
+    // ("Validating UTF-8 In Less Than One Instruction Per Byte"). Every
+    // pair of consecutive bytes is classified by three table lookups on
+    // the high and low nibble of the first and the high nibble of the
+    // second byte, a pair is invalid if all three share an error bit.
+    inline constexpr std::uint8_t too_short = 1 << 0;
+    inline constexpr std::uint8_t too_long = 1 << 1;
+    inline constexpr std::uint8_t overlong_3 = 1 << 2;
+    inline constexpr std::uint8_t too_large = 1 << 3;
+    inline constexpr std::uint8_t surrogate = 1 << 4;
+    inline constexpr std::uint8_t overlong_2 = 1 << 5;
+    inline constexpr std::uint8_t too_large_1000 = 1 << 6;
+    inline constexpr std::uint8_t overlong_4 = 1 << 6;
+    inline constexpr std::uint8_t two_continuations = 1 << 7;
+    inline constexpr std::uint8_t carry = too_short | too_long | two_continuations;
+
+    /// Broadcasts a 16 entry table to both lanes, _mm256_shuffle_epi8 looks up per lane
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Table(std::uint8_t e0, std::uint8_t e1, std::uint8_t e2, std::uint8_t e3, std::uint8_t e4, std::uint8_t e5, std::uint8_t e6, std::uint8_t e7,
+                                                     std::uint8_t e8, std::uint8_t e9, std::uint8_t e10, std::uint8_t e11, std::uint8_t e12, std::uint8_t e13, std::uint8_t e14, std::uint8_t e15) noexcept 
+    {
+      const __m128i table = _mm_setr_epi8(static_cast<char>(e0), static_cast<char>(e1), static_cast<char>(e2), static_cast<char>(e3),
+                                          static_cast<char>(e4), static_cast<char>(e5), static_cast<char>(e6), static_cast<char>(e7),
+                                          static_cast<char>(e8), static_cast<char>(e9), static_cast<char>(e10), static_cast<char>(e11),
+                                          static_cast<char>(e12), static_cast<char>(e13), static_cast<char>(e14), static_cast<char>(e15));
+      return _mm256_broadcastsi128_si256(table);
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2HighNibble(__m256i v) noexcept 
+    {
+      return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    /// The input shifted by N bytes, the missing bytes taken from the end of the previous block
+    template <int N>
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Previous(__m256i input, __m256i previous) noexcept 
+    {
+      return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+    }
+
+    struct Avx2Tables 
+    {
+      __m256i byte_1_high;
+      __m256i byte_1_low;
+      __m256i byte_2_high;
+      __m256i incomplete_limit;
+    };
+
+    GBE_UTILITY_TARGET_AVX2 inline Avx2Tables avx2Tables() noexcept 
+    {
+      Avx2Tables tables;
+
+      tables.byte_1_high = avx2Table(
+        // 0_______ (ASCII)
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        // 10______ (continuation)
+        two_continuations, two_continuations, two_continuations, two_continuations,
+        // 1100____, 1101____, 1110____, 1111____ (lead bytes)
+        too_short | overlong_2, too_short, too_short | overlong_3 | surrogate, too_short | too_large | too_large_1000 | overlong_4);
+      tables.byte_1_low = avx2Table(
+        // ____0000, ____0001, ____001_
+        carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+        // ____0100, ____0101, ____011_
+        carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        // ____1___, ____1101 marks ED (surrogates)
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000 | surrogate, carry | too_large | too_large_1000, carry | too_large | too_large_1000);
+      tables.byte_2_high = avx2Table(
+        // ________ 0_______ (ASCII)
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        // ________ 1000____, 1001____, 101_____
+        too_long | overlong_2 | two_continuations | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_continuations | overlong_3 | too_large,
+        too_long | overlong_2 | two_continuations | surrogate | too_large,
+        too_long | overlong_2 | two_continuations | surrogate | too_large,
+        // ________ 11______
+        too_short, too_short, too_short, too_short);
+      // Bytes at the end of a block that start a sequence which continues in the next block
+      tables.incomplete_limit = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                 -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                 static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+
+      return tables;
+    }
+
+    /// Returns the error bits of a block, given the previous one
+    GBE_UTILITY_TARGET_AVX2 inline __m256i avx2Errors(const Avx2Tables& tables, __m256i input, __m256i previous) noexcept 
+    {
+      const __m256i previous1 = avx2Previous<1>(input, previous);
+      const __m256i byte_1_high = _mm256_shuffle_epi8(tables.byte_1_high, avx2HighNibble(previous1));
+      const __m256i byte_1_low = _mm256_shuffle_epi8(tables.byte_1_low, _mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)));
+      const __m256i byte_2_high = _mm256_shuffle_epi8(tables.byte_2_high, avx2HighNibble(input));
+      const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+      // The third and fourth byte of a sequence have to be continuations, the lookup only sees pairs
+      const __m256i third = _mm256_subs_epu8(avx2Previous<2>(input, previous), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+      const __m256i fourth = _mm256_subs_epu8(avx2Previous<3>(input, previous), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+      const __m256i must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+      return _mm256_xor_si256(must_continue, special);
+    }
+
+    GBE_UTILITY_TARGET_AVX2 inline bool avx2Valid(const char* s, std::size_t size) noexcept 
+    {
+      const Avx2Tables tables = avx2Tables();
+      __m256i previous = _mm256_setzero_si256();
+      __m256i incomplete = _mm256_setzero_si256();
+      __m256i errors = _mm256_setzero_si256();
+      std::size_t i = 0;
+
+      for ( ; i < size; i += 32 ) {
+        __m256i input;
+
+        if ( i + 32 <= size ) {
+          input = simd_detail::avx2Load(s + i);
+        } else {
+          // The last block is padded with ASCII, which also reports sequences cut off at the end
+          char tail[32] = {};
+          std::memcpy(tail, s + i, size - i);
+          input = simd_detail::avx2Load(tail);
+        }
+
+        if ( 0 == simd_detail::avx2Mask(input) ) {
+          // An ASCII block only has to check that the previous one did not end in the middle of a sequence
+          errors = _mm256_or_si256(errors, incomplete);
+          incomplete = _mm256_setzero_si256();
+        } else {
+          errors = _mm256_or_si256(errors, avx2Errors(tables, input, previous));
+          incomplete = _mm256_subs_epu8(input, tables.incomplete_limit);
+        }
+
+        previous = input;
+
+        // Bail out early on invalid input, checked every 4 blocks to keep the loop tight
+        if ( 0x60 == (i & 0x60) && !_mm256_testz_si256(errors, errors) ) {
+          return false;
+        }
+      }
+
+      errors = _mm256_or_si256(errors, incomplete);
+
+      return _mm256_testz_si256(errors, errors);
+    }
+
+    inline constexpr Kernels avx2_kernels = {avx2Valid};
+#endif
+
+#if defined(GBE_UTILITY_SIMD_NEON)
+    /// Skips ASCII 16 bytes at a time, sequences are checked one by one
+    inline bool neonValid(const char* s, std::size_t size) noexcept 
+    {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+      std::size_t i = 0;
+
+      while ( i < size ) {
+        if ( i + 16 <= size && vmaxvq_u8(simd_detail::neonLoad(s + i)) < 0x80 ) {
+          i += 16;
+          continue;
+        }
+
+        std::size_t invalid = 0;
+        const std::size_t length = decode(p + i, size - i, invalid);
+
+        if ( 0 == length ) {
+          return false;
+        }
+
+        i += length;
+      }
+
+      return true;
+    }
+
+    inline constexpr Kernels neon_kernels = {neonValid};
+#endif
+
+    /// The kernels of the given level, the scalar kernels if the level is not supported
+    inline const Kernels& kernelsFor(SimdLevel level) noexcept 
+    {
+      switch ( level ) {
+#if defined(GBE_UTILITY_SIMD_X86)
+        case SimdLevel::SSE2:
+          return sse2_kernels;
+        case SimdLevel::AVX2:
+          return SimdLevel::AVX2 == simd_level() ? avx2_kernels : sse2_kernels;
+#endif
+#if defined(GBE_UTILITY_SIMD_NEON)
+        case SimdLevel::NEON:
+          return neon_kernels;
+#endif
+        default:
+          return scalar_kernels;
+      }
+    }
+
+    /// The kernels selected once for the running CPU
+    inline const Kernels& kernels() noexcept 
+    {
+      static const Kernels& selected = kernelsFor(simd_level());
+      return selected;
+    }
+  }
+
+  /// The replacement character U+FFFD, substituted for invalid sequences
+  inline constexpr std::string_view utf8_replacement = "\xEF\xBF\xBD";
+
+  /**
+   * @brief UTF-8 valid
+   * 
+   * Validates text with the vectorized validator. Overlong forms,
+   * surrogates and code points above U+10FFFF are invalid, as well as a
+   * sequence cut off at the end.
+   * 
+   * @param text The text
+   * 
+   * @return true if text is valid UTF-8, false otherwise
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline bool utf8_valid(std::string_view text) noexcept 
+  {
+    return utf8_detail::kernels().valid(text.data(), text.size());
+  }
+
+  /**
+   * @brief UTF-8 validate
+   * 
+   * @param text The text
+   * 
+   * @return The position of the first invalid sequence, text.size() if
+   * text is valid UTF-8
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t utf8_validate(std::string_view text) noexcept 
+  {
+    // Invalid input is rare, only then the position is searched without vectors
+    return utf8_valid(text) ? text.size() : utf8_detail::scalarValidPrefix(text.data(), text.size());
+  }
+
+  /**
+   * @brief UTF-8 boundary
+   * 
+   * @param text Valid UTF-8
+   * @param limit The maximum position
+   * 
+   * @return The largest position up to limit that does not split a code
+   * point
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t utf8_boundary(std::string_view text, std::size_t limit) noexcept 
+  {
+    if ( limit >= text.size() ) {
+      return text.size();
+    }
+
+    // A code point has at most 3 continuation bytes
+    for ( std::size_t i = 0; i < 3 && limit > 0 && utf8_detail::isContinuation(static_cast<unsigned char>(text[limit])); ++i ) {
+      --limit;
+    }
+
+    return limit;
+  }
+
+  /**
+   * @brief UTF-8 complete
+   * 
+   * @param text Valid UTF-8, possibly cut off in the middle of the last
+   * code point
+   * 
+   * @return The length of text without an incomplete code point at the
+   * end
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  [[nodiscard]] inline std::size_t utf8_complete(std::string_view text) noexcept 
+  {
+    const std::size_t size = text.size();
+    std::size_t lead = size;
+
+    while ( lead > 0 && size - lead < 4 ) {
+      const unsigned char c = static_cast<unsigned char>(text[--lead]);
+
+      if ( !utf8_detail::isContinuation(c) ) {
+        const std::size_t length = c < 0xC0 ? 1 : (c < 0xE0 ? 2 : (c < 0xF0 ? 3 : 4));
+        return size - lead < length ? lead : size;
+      }
+    }
+
+    return size;
+  }
+
+  /**
+   * @brief UTF-8 sanitize to
+   * 
+   * Copies text into a raw output range, e.g. the free tail of a buffer,
+   * and replaces every invalid sequence with U+FFFD. The output is always
+   * valid UTF-8, it ends on a code point boundary if it is too small.
+   * 
+   * @param out The output, not null terminated
+   * @param space The size of the output
+   * @param text The text
+   * @param consumed Set to the number of input characters processed
+   * 
+   * @return The number of characters written
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline std::size_t utf8_sanitize_to(char* out, std::size_t space, std::string_view text, std::size_t& consumed) noexcept 
+  {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    // Only the part that fits is validated, long input is not read beyond it
+    const std::size_t limit = utf8_boundary(text, space);
+    const bool valid = utf8_valid(text.substr(0, limit));
+    std::size_t written = 0;
+
+    consumed = 0;
+
+    // Backing off over continuation bytes only finds a boundary in valid text, otherwise the loop below decides
+    if ( valid && (limit == text.size() || (limit == space && !utf8_detail::isContinuation(static_cast<unsigned char>(text[limit])))) ) {
+      std::memcpy(out, text.data(), limit);
+      consumed = limit;
+      return limit;
+    }
+
+    while ( consumed < text.size() ) {
+      // The valid run before the next invalid sequence is copied in bulk, it is only scanned as far as it can fit
+      const std::size_t run = utf8_detail::scalarValidPrefix(text.data() + consumed, utf8_detail::scanLimit(text.size() - consumed, space - written));
+      const std::size_t copied = utf8_boundary(text.substr(consumed, run), space - written);
+
+      if ( copied > 0 ) {
+        std::memcpy(out + written, text.data() + consumed, copied);
+      }
+
+      written += copied;
+      consumed += copied;
+
+      if ( copied < run || consumed == text.size() || space - written < utf8_replacement.size() ) {
+        break;
+      }
+
+      std::size_t invalid = 1;
+      (void)utf8_detail::decode(p + consumed, text.size() - consumed, invalid);
+
+      std::memcpy(out + written, utf8_replacement.data(), utf8_replacement.size());
+      written += utf8_replacement.size();
+      consumed += invalid;
+    }
+
+    return written;
+  }
+
+  /**
+   * @brief UTF-8 sanitize in place
+   * 
+   * Replaces every invalid sequence of the text with U+FFFD without a
+   * copy of the text. A replacement is never shorter than the sequence it
+   * replaces, so the valid prefix is skipped, the end of the output is
+   * found in a first pass and the output is written from the back. It
+   * ends on a code point boundary if the capacity is too small.
+   * 
+   * @param s The text, not null terminated
+   * @param size The length of the text
+   * @param capacity The size of the storage at s, at least size
+   * @param consumed Set to the number of input characters kept
+   * 
+   * @return The length of the sanitized text
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  inline std::size_t utf8_sanitize_in_place(char* s, std::size_t size, std::size_t capacity, std::size_t& consumed) noexcept 
+  {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+    const std::size_t start = utf8_validate(std::string_view(s, size));
+    std::size_t written = start;
+
+    consumed = start;
+
+    // Same steps as utf8_sanitize_to, only counting
+    while ( consumed < size ) {
+      const std::size_t run = utf8_detail::scalarValidPrefix(s + consumed, utf8_detail::scanLimit(size - consumed, capacity - written));
+      const std::size_t copied = utf8_boundary(std::string_view(s + consumed, run), capacity - written);
+
+      written += copied;
+      consumed += copied;
+
+      if ( copied < run || consumed == size || capacity - written < utf8_replacement.size() ) {
+        break;
+      }
+
+      std::size_t invalid = 1;
+      (void)utf8_detail::decode(p + consumed, size - consumed, invalid);
+
+      written += utf8_replacement.size();
+      consumed += invalid;
+    }
+
+    // Every non-continuation byte starts a sequence, so the input is split into sequences from the back
+    char* out = s + written;
+    std::size_t end = consumed;
+
+    while ( end > start ) {
+      std::size_t lead = end - 1;
+
+      while ( lead > start && utf8_detail::isContinuation(p[lead]) ) {
+        --lead;
+      }
+
+      std::size_t invalid = 1;
+      const std::size_t length = utf8_detail::isContinuation(p[lead]) ? 0 : utf8_detail::decode(p + lead, end - lead, invalid);
+      const std::size_t first = 0 == length ? invalid : length;
+
+      // The continuation bytes behind the first sequence are invalid one by one
+      for ( std::size_t i = lead + first; i < end; ++i ) {
+        out -= utf8_replacement.size();
+        std::memcpy(out, utf8_replacement.data(), utf8_replacement.size());
+      }
+
+      if ( 0 == length ) {
+        out -= utf8_replacement.size();
+        std::memcpy(out, utf8_replacement.data(), utf8_replacement.size());
+      } else {
+        out -= length;
+        std::memmove(out, s + lead, length);
+      }
+
+      end = lead;
+    }
+
+    return written;
+  }
+}
@@ -0,0 +1,514 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include <gobeyond/utility/bits.hpp>
+#include <gobeyond/utility/simd_string.hpp>
+
+namespace gobeyond::utility 
+{
+  namespace wide_bitmask_detail 
+  {
+    using word_type = std::uint64_t;
+
+    inline constexpr std::size_t word_bits = 64;
+
+    /// The bitwise operations applied word by word
+    enum class Op 
+    {
+      And,
+      Or,
+      Xor,
+      AndNot
+    };
+
+    template <Op TOp>
+    constexpr word_type scalarApply(word_type lhs, word_type rhs) noexcept 
+    {
+      if constexpr ( Op::And == TOp ) {
+        return lhs & rhs;
+      } else if constexpr ( Op::Or == TOp ) {
+        return lhs | rhs;
+      } else if constexpr ( Op::Xor == TOp ) {
+        return lhs ^ rhs;
+      } else {
+        return lhs & ~rhs;
+      }
+    }
+
+#if defined(GBE_UTILITY_SIMD_X86)
+    template <Op TOp>
+    inline __m128i sse2Apply(__m128i lhs, __m128i rhs) noexcept 
+    {
+      if constexpr ( Op::And == TOp ) {
+        return _mm_and_si128(lhs, rhs);
+      } else if constexpr ( Op::Or == TOp ) {
+        return _mm_or_si128(lhs, rhs);
+      } else if constexpr ( Op::Xor == TOp ) {
+        return _mm_xor_si128(lhs, rhs);
+      } else {
+        return _mm_andnot_si128(rhs, lhs);
+      }
+    }
+
+    inline __m128i sse2Words(const word_type* words) noexcept 
+    {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(words));
+    }
+
+    /// Counts the bits of each 64 bit lane, the SWAR popcount on two words at once
+    inline __m128i sse2Popcount(__m128i v) noexcept 
+    {
+      const __m128i m1 = _mm_set1_epi8(0x55);
+      const __m128i m2 = _mm_set1_epi8(0x33);
+      const __m128i m4 = _mm_set1_epi8(0x0F);
+
+      v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+      v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+      v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+
+      return _mm_sad_epu8(v, _mm_setzero_si128());
+    }
+#elif defined(GBE_UTILITY_SIMD_NEON)
+    template <Op TOp>
+    inline uint64x2_t neonApply(uint64x2_t lhs, uint64x2_t rhs) noexcept 
+    {
+      if constexpr ( Op::And == TOp ) {
+        return vandq_u64(lhs, rhs);
+      } else if constexpr ( Op::Or == TOp ) {
+        return vorrq_u64(lhs, rhs);
+      } else if constexpr ( Op::Xor == TOp ) {
+        return veorq_u64(lhs, rhs);
+      } else {
+        return vbicq_u64(lhs, rhs);
+      }
+    }
+#endif
+
+    /// The words of a mask with the first TBits bits set
+    template <std::size_t TBits, std::size_t N>
+    struct Full 
+    {
+      word_type values[N];
+
+      constexpr Full() noexcept
+        : values() 
+      {
+        for ( std::size_t i = 0; i < N; ++i ) {
+          const std::size_t used = TBits - i * word_bits;
+          values[i] = used >= word_bits ? ~word_type{0} : (word_type{1} << used) - 1;
+        }
+      }
+    };
+
+    template <std::size_t TBits, std::size_t N>
+    inline constexpr Full<TBits, N> full{};
+
+    /// dst = lhs op rhs, two words per vector
+    template <Op TOp, std::size_t N>
+    inline void apply(word_type* dst, const word_type* lhs, const word_type* rhs) noexcept 
+    {
+      std::size_t i = 0;
+
+#if defined(GBE_UTILITY_SIMD_X86)
+      for ( ; i + 2 <= N; i += 2 ) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), sse2Apply<TOp>(sse2Words(lhs + i), sse2Words(rhs + i)));
+      }
+#elif defined(GBE_UTILITY_SIMD_NEON)
+      for ( ; i + 2 <= N; i += 2 ) {
+        vst1q_u64(dst + i, neonApply<TOp>(vld1q_u64(lhs + i), vld1q_u64(rhs + i)));
+      }
+#endif
+
+      for ( ; i < N; ++i ) {
+        dst[i] = scalarApply<TOp>(lhs[i], rhs[i]);
+      }
+    }
+
+    /// true if lhs op rhs has no bit set, without storing the result
+    template <Op TOp, std::size_t N>
+    inline bool none(const word_type* lhs, const word_type* rhs) noexcept 
+    {
+      std::size_t i = 0;
+      word_type rest = 0;
+
+#if defined(GBE_UTILITY_SIMD_X86)
+      __m128i combined = _mm_setzero_si128();
+
+      for ( ; i + 2 <= N; i += 2 ) {
+        combined = _mm_or_si128(combined, sse2Apply<TOp>(sse2Words(lhs + i), sse2Words(rhs + i)));
+      }
+
+      if ( 0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(combined, _mm_setzero_si128())) ) {
+        return false;
+      }
+#elif defined(GBE_UTILITY_SIMD_NEON)
+      uint64x2_t combined = vdupq_n_u64(0);
+
+      for ( ; i + 2 <= N; i += 2 ) {
+        combined = vorrq_u64(combined, neonApply<TOp>(vld1q_u64(lhs + i), vld1q_u64(rhs + i)));
+      }
+
+      if ( 0 != vmaxvq_u32(vreinterpretq_u32_u64(combined)) ) {
+        return false;
+      }
+#endif
+
+      for ( ; i < N; ++i ) {
+        rest |= scalarApply<TOp>(lhs[i], rhs[i]);
+      }
+
+      return 0 == rest;
+    }
+
+    /// The number of set bits
+    template <std::size_t N>
+    inline std::size_t popcount(const word_type* words) noexcept 
+    {
+      std::size_t i = 0;
+      std::size_t count = 0;
+
+#if defined(GBE_UTILITY_SIMD_X86)
+      __m128i counts = _mm_setzero_si128();
+
+      for ( ; i + 2 <= N; i += 2 ) {
+        counts = _mm_add_epi64(counts, sse2Popcount(sse2Words(words + i)));
+      }
+
+      word_type lanes[2];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+      count = static_cast<std::size_t>(lanes[0] + lanes[1]);
+#elif defined(GBE_UTILITY_SIMD_NEON)
+      for ( ; i + 2 <= N; i += 2 ) {
+        count += vaddvq_u8(vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + i))));
+      }
+#endif
+
+      for ( ; i < N; ++i ) {
+        count += static_cast<std::size_t>(utility::popcount(words[i]));
+      }
+
+      return count;
+    }
+  }
+
+  /**
+   * @brief WideBitMask
+   * 
+   * A BitMask for enums with more flags than the underlying type has
+   * bits. The enumerators are bit positions (0, 1, 2, ...), not bit
+   * values, and have to be smaller than TBits; larger positions are
+   * ignored, debug builds assert on them. The bits are kept in an
+   * array of 64 bit words, the bitwise operations and the tests process
+   * two words per SSE2 or NEON vector.
+   * 
+   * @tparam TEnum The flags, each enumerator is a bit position
+   * @tparam TBits The number of flags
+   * 
+   * @since 0.2
+   * 
+   * @author t.schwarzinger@dina.de
+   */
+  template <typename TEnum, std::size_t TBits>
+  class WideBitMask 
+  {
+    public:
+      static_assert(std::is_enum_v<TEnum>, "WideBitMask needs an enum");
+      static_assert(TBits > 0, "WideBitMask needs at least one flag");
+
+      using enum_type = TEnum;
+      using word_type = wide_bitmask_detail::word_type;
+
+      /// The number of flags
+      static constexpr std::size_t bits = TBits;
+      /// The number of words the flags are kept in
+      static constexpr std::size_t word_count = (TBits + wide_bitmask_detail::word_bits - 1) / wide_bitmask_detail::word_bits;
+
+      struct Enable 
+      {
+        enum_type value;
+
+        explicit inline Enable(const enum_type& value)
+          : value(value)
+        {}
+      };
+
+      struct Disable 
+      {
+        enum_type value;
+
+        explicit inline Disable(const enum_type& value)
+          : value(value)
+        {}
+      };
+
+      struct Enabled 
+      {
+        enum_type value;
+
+        explicit inline Enabled(const enum_type& value)
+          : value(value)
+        {}
+      };
+
+      struct Disabled 
+      {
+        enum_type value;
+
+        explicit inline Disabled(const enum_type& value)
+          : value(value)
+        {}
+      };
+
+      inline WideBitMask() noexcept = default;
+
+      explicit inline WideBitMask(const enum_type& value) noexcept 
+      {
+        enable(value);
+      }
+
+      inline WideBitMask(std::initializer_list<enum_type> values) noexcept 
+      {
+        for ( const enum_type& value : values ) {
+          enable(value);
+        }
+      }
+
+      inline void enable(const enum_type& value) noexcept 
+      {
+        if ( valid(value) ) {
+          m_words[word(value)] |= bit(value);
+        }
+      }
+
+      inline void disable(const enum_type& value) noexcept 
+      {
+        if ( valid(value) ) {
+          m_words[word(value)] &= ~bit(value);
+        }
+      }
+
+      [[nodiscard]] inline bool isEnabled(const enum_type& value) const noexcept 
+      {
+        return valid(value) && 0 != (m_words[word(value)] & bit(value));
+      }
+
+      [[nodiscard]] inline bool isDisabled(const enum_type& value) const noexcept 
+      {
+        return !isEnabled(value);
+      }
+
+      /**
+       * @brief Count
+       * 
+       * @return The number of enabled flags
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline std::size_t count() const noexcept 
+      {
+        return wide_bitmask_detail::popcount<word_count>(m_words);
+      }
+
+      /// true if at least one flag is enabled
+      [[nodiscard]] inline bool any() const noexcept 
+      {
+        return !none();
+      }
+
+      /// true if no flag is enabled
+      [[nodiscard]] inline bool none() const noexcept 
+      {
+        return wide_bitmask_detail::none<wide_bitmask_detail::Op::Or, word_count>(m_words, m_words);
+      }
+
+      /// true if every flag is enabled
+      [[nodiscard]] inline bool all() const noexcept 
+      {
+        return wide_bitmask_detail::none<wide_bitmask_detail::Op::AndNot, word_count>(wide_bitmask_detail::full<TBits, word_count>.values, m_words);
+      }
+
+      /**
+       * @brief Is subset of
+       * 
+       * @param other The other mask
+       * 
+       * @return true if every flag enabled here is enabled in other
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool isSubsetOf(const WideBitMask& other) const noexcept 
+      {
+        return wide_bitmask_detail::none<wide_bitmask_detail::Op::AndNot, word_count>(m_words, other.m_words);
+      }
+
+      /**
+       * @brief Intersects
+       * 
+       * @param other The other mask
+       * 
+       * @return true if at least one flag is enabled in both masks
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline bool intersects(const WideBitMask& other) const noexcept 
+      {
+        return !wide_bitmask_detail::none<wide_bitmask_detail::Op::And, word_count>(m_words, other.m_words);
+      }
+
+      /**
+       * @brief And not
+       * 
+       * @param other The flags to remove
+       * 
+       * @return The flags enabled here but not in other
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline WideBitMask andNot(const WideBitMask& other) const noexcept 
+      {
+        return combine<wide_bitmask_detail::Op::AndNot>(*this, other);
+      }
+
+      /**
+       * @brief Words
+       * 
+       * @return The words the flags are kept in, flag i is bit i % 64 of word i / 64
+       * 
+       * @since 0.2
+       * 
+       * @author t.schwarzinger@dina.de
+       */
+      [[nodiscard]] inline const word_type* words() const noexcept 
+      {
+        return m_words;
+      }
+
+      inline WideBitMask& operator=(const enum_type& value) noexcept 
+      {
+        *this = WideBitMask(value);
+        return *this;
+      }
+
+      inline WideBitMask& operator=(const Enable& flag) noexcept 
+      {
+        enable(flag.value);
+        return *this;
+      }
+
+      inline WideBitMask& operator=(const Disable& flag) noexcept 
+      {
+        disable(flag.value);
+        return *this;
+      }
+
+      inline WideBitMask& operator|=(const WideBitMask& other) noexcept 
+      {
+        wide_bitmask_detail::apply<wide_bitmask_detail::Op::Or, word_count>(m_words, m_words, other.m_words);
+        return *this;
+      }
+
+      inline WideBitMask& operator&=(const WideBitMask& other) noexcept 
+      {
+        wide_bitmask_detail::apply<wide_bitmask_detail::Op::And, word_count>(m_words, m_words, other.m_words);
+        return *this;
+      }
+
+      inline WideBitMask& operator^=(const WideBitMask& other) noexcept 
+      {
+        wide_bitmask_detail::apply<wide_bitmask_detail::Op::Xor, word_count>(m_words, m_words, other.m_words);
+        return *this;
+      }
+
+      /// The complement, limited to the TBits valid flags
+      [[nodiscard]] inline WideBitMask operator~() const noexcept 
+      {
+        WideBitMask result;
+        wide_bitmask_detail::apply<wide_bitmask_detail::Op::AndNot, word_count>(result.m_words, wide_bitmask_detail::full<TBits, word_count>.values, m_words);
+        return result;
+      }
+
+      friend inline bool operator==(const WideBitMask& lhs, const WideBitMask& rhs) noexcept 
+      {
+        return wide_bitmask_detail::none<wide_bitmask_detail::Op::Xor, word_count>(lhs.m_words, rhs.m_words);
+      }
+
+      friend inline bool operator==(const WideBitMask& lhs, const Enabled& rhs) noexcept 
+      {
+        return lhs.isEnabled(rhs.value);
+      }
+
+      friend inline bool operator==(const WideBitMask& lhs, const Disabled& rhs) noexcept 
+      {
+        return lhs.isDisabled(rhs.value);
+      }
+
+      friend inline bool operator!=(const WideBitMask& lhs, const WideBitMask& rhs) noexcept 
+      {
+        return !(lhs == rhs);
+      }
+
+      friend inline WideBitMask operator|(const WideBitMask& lhs, const WideBitMask& rhs) noexcept 
+      {
+        return combine<wide_bitmask_detail::Op::Or>(lhs, rhs);
+      }
+
+      friend inline WideBitMask operator|(const WideBitMask& lhs, const enum_type& rhs) noexcept 
+      {
+        WideBitMask result(lhs);
+        result.enable(rhs);
+        return result;
+      }
+
+      friend inline WideBitMask operator&(const WideBitMask& lhs, const WideBitMask& rhs) noexcept 
+      {
+        return combine<wide_bitmask_detail::Op::And>(lhs, rhs);
+      }
+
+      friend inline WideBitMask operator^(const WideBitMask& lhs, const WideBitMask& rhs) noexcept 
+      {
+        return combine<wide_bitmask_detail::Op::Xor>(lhs, rhs);
+      }
+
+    private:
+      /// Positions beyond TBits would write past the words or into the bits that have to stay 0
+      static inline bool valid(const enum_type& value) noexcept 
+      {
+        assert(static_cast<std::size_t>(value) < TBits);
+        return static_cast<std::size_t>(value) < TBits;
+      }
+
+      static inline std::size_t word(const enum_type& value) noexcept 
+      {
+        return static_cast<std::size_t>(value) / wide_bitmask_detail::word_bits;
+      }
+
+      static inline word_type bit(const enum_type& value) noexcept 
+      {
+        return word_type{1} << (static_cast<std::size_t>(value) % wide_bitmask_detail::word_bits);
+      }
+
+      template <wide_bitmask_detail::Op TOp>
+      static inline WideBitMask combine(const WideBitMask& lhs, const WideBitMask& rhs) noexcept 
+      {
+        WideBitMask result;
+        wide_bitmask_detail::apply<TOp, word_count>(result.m_words, lhs.m_words, rhs.m_words);
+        return result;
+      }
+
+      /// The flags, bits beyond TBits stay 0
+      alignas(16) word_type m_words[word_count] = {};
+  };
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <gobeyond/utility/arena.hpp>
+#include <gobeyond/utility/format.hpp>
+
+TEST(MonotonicArenaTest, Allocate) {
+  alignas(16) unsigned char buffer[64];
+  gobeyond::utility::MonotonicArena arena{buffer};
+
+  EXPECT_EQ(arena.capacity(), 64u);
+
+  void* a = arena.allocate(10, 1);
+  void* b = arena.allocate(8, 8);
+
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(a, buffer);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 8, 0u);
+  EXPECT_EQ(arena.used(), 24u);
+  EXPECT_TRUE(arena.owns(a));
+  EXPECT_FALSE(arena.owns(buffer + 64));
+}
+
+TEST(MonotonicArenaTest, Exhausted) {
+  unsigned char buffer[32];
+  gobeyond::utility::MonotonicArena arena{buffer};
+
+  EXPECT_NE(arena.allocate(30, 1), nullptr);
+  EXPECT_EQ(arena.allocate(3, 1), nullptr);
+  EXPECT_NE(arena.allocate(2, 1), nullptr);
+  EXPECT_EQ(arena.remaining(), 0u);
+}
+
+TEST(MonotonicArenaTest, Extend) {
+  unsigned char buffer[32];
+  gobeyond::utility::MonotonicArena arena{buffer};
+
+  void* a = arena.allocate(4, 1);
+  EXPECT_TRUE(arena.extend(a, 16));
+  EXPECT_EQ(arena.used(), 16u);
+  EXPECT_FALSE(arena.extend(a, 33));
+
+  void* b = arena.allocate(4, 1);
+  EXPECT_FALSE(arena.extend(a, 20));
+  EXPECT_TRUE(arena.extend(b, 8));
+  EXPECT_EQ(arena.used(), 24u);
+}
+
+TEST(MonotonicArenaTest, Reset) {
+  unsigned char buffer[32];
+  gobeyond::utility::MonotonicArena arena{buffer};
+
+  void* a = arena.allocate(32, 1);
+  arena.reset();
+
+  EXPECT_EQ(arena.used(), 0u);
+  EXPECT_EQ(arena.allocate(32, 1), a);
+}
+
+TEST(MonotonicArenaTest, Chained) {
+  gobeyond::utility::MonotonicArena arena{64};
+
+  EXPECT_EQ(arena.capacity(), 0u);
+
+  void* a = arena.allocate(48, 8);
+  void* b = arena.allocate(48, 8);
+  void* c = arena.allocate(200, 8);
+
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  ASSERT_NE(c, nullptr);
+  EXPECT_TRUE(arena.owns(a));
+  EXPECT_TRUE(arena.owns(b));
+  EXPECT_TRUE(arena.owns(c));
+  EXPECT_GE(arena.capacity(), 64u + 64u + 200u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 8, 0u);
+}
+
+TEST(MonotonicArenaTest, ChainedAfterBuffer) {
+  unsigned char buffer[32];
+  gobeyond::utility::MonotonicArena arena{buffer, sizeof(buffer), 128};
+
+  EXPECT_EQ(arena.allocate(24, 1), buffer);
+
+  void* b = arena.allocate(24, 1);
+  ASSERT_NE(b, nullptr);
+  EXPECT_FALSE(b >= static_cast<void*>(buffer) && b < static_cast<void*>(buffer + sizeof(buffer)));
+  EXPECT_EQ(arena.used(), 32u + 24u);
+}
+
+TEST(MonotonicArenaTest, RewindReusesBlocks) {
+  gobeyond::utility::MonotonicArena arena{64};
+  const auto marker = arena.mark();
+
+  for ( int i = 0; i < 10; ++i ) {
+    ASSERT_NE(arena.allocate(40, 1), nullptr);
+  }
+
+  const std::size_t capacity = arena.capacity();
+  arena.rewind(marker);
+  EXPECT_EQ(arena.used(), 0u);
+
+  for ( int i = 0; i < 10; ++i ) {
+    ASSERT_NE(arena.allocate(40, 1), nullptr);
+  }
+
+  EXPECT_EQ(arena.capacity(), capacity);
+
+  arena.release();
+  EXPECT_EQ(arena.capacity(), 0u);
+}
+
+TEST(MonotonicArenaTest, FrameScope) {
+  gobeyond::utility::MonotonicArena arena{256};
+  void* outer = arena.allocate(16, 1);
+  const std::size_t used = arena.used();
+
+  {
+    gobeyond::utility::FrameScope frame{arena};
+    EXPECT_NE(frame.arena().allocate(100, 1), nullptr);
+
+    {
+      gobeyond::utility::FrameScope inner{arena};
+      EXPECT_NE(inner.arena().allocate(1000, 1), nullptr);
+    }
+
+    EXPECT_EQ(arena.used(), used + 100);
+  }
+
+  EXPECT_EQ(arena.used(), used);
+  EXPECT_TRUE(arena.owns(outer));
+}
+
+TEST(MonotonicArenaTest, ThreadArena) {
+  gobeyond::utility::MonotonicArena& arena = gobeyond::utility::thread_arena();
+  const std::size_t used = arena.used();
+
+  {
+    gobeyond::utility::FrameScope frame;
+    EXPECT_EQ(&frame.arena(), &arena);
+    EXPECT_NE(arena.allocate(100), nullptr);
+  }
+
+  EXPECT_EQ(arena.used(), used);
+  EXPECT_EQ(arena.block_size(), gobeyond::utility::MonotonicArena::default_block_size);
+}
+
+TEST(MonotonicArenaTest, Resource) {
+  gobeyond::utility::MonotonicArena arena{1024};
+  gobeyond::utility::ArenaResource resource{arena};
+
+  std::pmr::vector<std::pmr::string> strings{&resource};
+
+  for ( int i = 0; i < 100; ++i ) {
+    strings.emplace_back("a string that does not fit the small string buffer");
+  }
+
+  EXPECT_EQ(strings.size(), 100u);
+  EXPECT_TRUE(arena.owns(strings.data()));
+  EXPECT_TRUE(arena.owns(strings.back().data()));
+}
+
+TEST(MonotonicArenaTest, ResourceUpstream) {
+  unsigned char buffer[64];
+  gobeyond::utility::MonotonicArena arena{buffer};
+  gobeyond::utility::ArenaResource fallback{arena, std::pmr::new_delete_resource()};
+  gobeyond::utility::ArenaResource strict{arena};
+
+  void* p = fallback.allocate(128, 8);
+  EXPECT_FALSE(arena.owns(p));
+  fallback.deallocate(p, 128, 8);
+
+  EXPECT_THROW(static_cast<void>(strict.allocate(128, 8)), std::bad_alloc);
+}
+
+TEST(MonotonicArenaTest, FormatTo) {
+  gobeyond::utility::MonotonicArena arena{64};
+
+  const std::string_view a = gobeyond::utility::format_to(arena, GBE_FMT("%s=%d"), "answer", 42);
+  const std::string_view b = gobeyond::utility::format_to(arena, GBE_FMT("%s"), std::string(100, 'x').c_str());
+
+  EXPECT_EQ(a, "answer=42");
+  EXPECT_EQ(a.data()[a.size()], '\0');
+  EXPECT_EQ(b.size(), 100u);
+  EXPECT_TRUE(arena.owns(a.data()));
+  EXPECT_TRUE(arena.owns(b.data()));
+  EXPECT_EQ(a, "answer=42");
+}
+
+TEST(MonotonicArenaTest, FormatToExhausted) {
+  unsigned char buffer[8];
+  gobeyond::utility::MonotonicArena arena{buffer};
+
+  EXPECT_EQ(gobeyond::utility::format_to(arena, GBE_FMT("%d"), 123456789), "1234567");
+  EXPECT_EQ(arena.remaining(), 0u);
+}
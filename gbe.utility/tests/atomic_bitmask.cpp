@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gobeyond/utility/atomic_bitmask.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using atomic_type = gobeyond::utility::AtomicBitMask<LogLocation>;
+  using mask_type = atomic_type::mask_type;
+}
+
+TEST(AtomicBitMaskTest, Layout) {
+  EXPECT_EQ(alignof(atomic_type), gobeyond::utility::cache_line_size);
+  EXPECT_EQ(sizeof(atomic_type), gobeyond::utility::cache_line_size);
+}
+
+TEST(AtomicBitMaskTest, EnableDisable) {
+  atomic_type mask;
+  EXPECT_EQ(mask.snapshot(), LogLocation::NONE);
+
+  EXPECT_EQ(mask.enable(LogLocation::DEBUG), LogLocation::NONE);
+  EXPECT_EQ(mask.enable(LogLocation::MQTT), LogLocation::DEBUG);
+  EXPECT_TRUE(mask.isEnabled(LogLocation::DEBUG));
+  EXPECT_TRUE(mask.isEnabled(LogLocation::MQTT));
+  EXPECT_FALSE(mask.isEnabled(LogLocation::LOGFILE));
+  EXPECT_TRUE(mask.isDisabled(LogLocation::LOGFILE));
+
+  EXPECT_EQ(mask.disable(LogLocation::DEBUG), LogLocation::DEBUG | LogLocation::MQTT);
+  EXPECT_EQ(mask.snapshot(), LogLocation::MQTT);
+}
+
+TEST(AtomicBitMaskTest, Tags) {
+  atomic_type mask{LogLocation::LOGFILE};
+
+  mask = mask_type::Enable(LogLocation::BROWSER);
+  mask = mask_type::Disable(LogLocation::LOGFILE);
+
+  EXPECT_TRUE(mask == mask_type::Enabled(LogLocation::BROWSER));
+  EXPECT_TRUE(mask == mask_type::Disabled(LogLocation::LOGFILE));
+}
+
+TEST(AtomicBitMaskTest, StoreExchange) {
+  atomic_type mask;
+
+  mask.store(LogLocation::DEBUG | LogLocation::LOGFILE);
+  EXPECT_EQ(mask.exchange(mask_type{LogLocation::MQTT}), LogLocation::DEBUG | LogLocation::LOGFILE);
+  EXPECT_EQ(mask.snapshot(std::memory_order_relaxed), LogLocation::MQTT);
+}
+
+TEST(AtomicBitMaskTest, CompareExchange) {
+  atomic_type mask{LogLocation::DEBUG};
+  mask_type expected{LogLocation::LOGFILE};
+
+  EXPECT_FALSE(mask.compare_exchange(expected, mask_type{LogLocation::ALL}));
+  EXPECT_EQ(expected, LogLocation::DEBUG);
+
+  EXPECT_TRUE(mask.compare_exchange(expected, mask_type{LogLocation::ALL}));
+  EXPECT_EQ(mask.snapshot(), LogLocation::ALL);
+}
+
+TEST(AtomicBitMaskTest, ConcurrentFlags) {
+  static constexpr LogLocation flags[] = {LogLocation::DEBUG, LogLocation::LOGFILE, LogLocation::MQTT, LogLocation::BROWSER};
+  atomic_type mask{LogLocation::PUSHNOTIFICATION};
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+
+  // Every writer toggles its own flag, the flag of the others must never get lost
+  for ( LogLocation flag : flags ) {
+    threads.emplace_back([&mask, flag] {
+      for ( int i = 0; i < 10000; ++i ) {
+        mask.enable(flag);
+        EXPECT_TRUE(mask.isEnabled(flag));
+        mask.disable(flag);
+        EXPECT_TRUE(mask.isDisabled(flag));
+      }
+    });
+  }
+
+  std::thread reader([&] {
+    while ( !stop.load() ) {
+      EXPECT_TRUE(mask.isEnabled(LogLocation::PUSHNOTIFICATION));
+    }
+  });
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  stop.store(true);
+  reader.join();
+
+  EXPECT_EQ(mask.snapshot(), LogLocation::PUSHNOTIFICATION);
+}
@@ -0,0 +1,314 @@
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gobeyond/utility/binary_log.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using gobeyond::utility::BinaryLogReader;
+  using gobeyond::utility::BinaryLogWriter;
+  using gobeyond::utility::DeferredRecord;
+  using route_type = gobeyond::utility::BitMask<LogLocation>;
+
+  class BinaryLogTest : public ::testing::Test {
+    protected:
+      void SetUp() override {
+        m_directory = std::filesystem::temp_directory_path() / ("gbe_binary_log_" + std::to_string(::getpid()) + "_"
+          + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+      }
+
+      void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+      }
+
+      std::string base() const {
+        return (m_directory / "log").string();
+      }
+
+      std::vector<std::string> readAll(std::uint32_t segment) const {
+        BinaryLogReader reader;
+        std::vector<std::string> texts;
+
+        EXPECT_TRUE(reader.open(BinaryLogWriter::segment_path(base(), segment)));
+
+        BinaryLogReader::Entry entry;
+
+        while ( reader.next(entry) ) {
+          texts.emplace_back(entry.text);
+        }
+
+        EXPECT_FALSE(reader.corrupt());
+        return texts;
+      }
+
+      std::filesystem::path m_directory;
+  };
+}
+
+TEST_F(BinaryLogTest, RoundTrip) {
+  {
+    BinaryLogWriter writer{base()};
+    ASSERT_TRUE(writer.is_open());
+
+    DeferredRecord<128> record;
+    record.capture(GBE_FMT("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%-6s|"), "sensor.temperature", -4711, 0.73125, 0xC0FFEEu, 17u, "MQTT");
+
+    EXPECT_TRUE(writer.append(route_type{LogLocation::LOGFILE | LogLocation::MQTT}, record, 1000));
+    EXPECT_TRUE(writer.append(route_type{LogLocation::LOGFILE}, "plain text", 2500));
+    EXPECT_TRUE(writer.append(route_type{LogLocation::LOGFILE}, record, 2000));
+    EXPECT_EQ(writer.statistics().records, 3u);
+  }
+
+  BinaryLogReader reader;
+  ASSERT_TRUE(reader.open(BinaryLogWriter::segment_path(base(), 0)));
+  EXPECT_EQ(reader.version(), gobeyond::utility::binary_log_version);
+  EXPECT_EQ(reader.header().segment, 0u);
+
+  BinaryLogReader::Entry entry;
+
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ(entry.kind, gobeyond::utility::BinaryLogRecordKind::Deferred);
+  EXPECT_EQ(entry.timestamp, 1000u);
+  EXPECT_EQ(entry.route, 6u);
+  EXPECT_EQ(entry.text, "[sensor.temperature] value=-4711 ratio=0.731 id=00c0ffee count=17 tag=MQTT  |");
+
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ(entry.kind, gobeyond::utility::BinaryLogRecordKind::Text);
+  EXPECT_EQ(entry.timestamp, 2500u);
+  EXPECT_EQ(entry.route, 2u);
+  EXPECT_EQ(entry.text, "plain text");
+
+  // Timestamps are deltas and may go backwards
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ(entry.timestamp, 2000u);
+
+  EXPECT_FALSE(reader.next(entry));
+  EXPECT_FALSE(reader.corrupt());
+}
+
+TEST_F(BinaryLogTest, AllTypes) {
+  {
+    BinaryLogWriter writer{base()};
+    DeferredRecord<128> record;
+    int value = 0;
+
+    record.capture(GBE_FMT("%c %hhd %hd %lld %llu %5.1f %e %Lg %s %p %p %o %#x %+d %%"), 'x', static_cast<signed char>(-5), static_cast<short>(-300),
+      -1234567890123ll, 18446744073709551615ull, 2.5f, 1e-7, 3.25L, "text", static_cast<const void*>(nullptr), &value, 8u, 255u, 7);
+
+    char expected[256];
+    record.render_to(expected, sizeof(expected));
+
+    writer.append(route_type{LogLocation::DEBUG}, record);
+    writer.close();
+
+    EXPECT_EQ(readAll(0), std::vector<std::string>{expected});
+  }
+}
+
+TEST_F(BinaryLogTest, UnclosedSegment) {
+  BinaryLogWriter writer{base(), 64 * 1024};
+  DeferredRecord<32> record;
+
+  record.capture(GBE_FMT("value=%d"), 42);
+  writer.append(route_type{LogLocation::LOGFILE}, record);
+
+  // The writer still holds the pre-allocated mapping, the reader stops at the unused rest
+  EXPECT_EQ(std::filesystem::file_size(BinaryLogWriter::segment_path(base(), 0)), 64u * 1024u);
+  EXPECT_EQ(readAll(0), std::vector<std::string>{"value=42"});
+
+  writer.close();
+  EXPECT_LT(std::filesystem::file_size(BinaryLogWriter::segment_path(base(), 0)), 64u);
+}
+
+TEST_F(BinaryLogTest, Rotation) {
+  {
+    BinaryLogWriter writer{base(), 4096, 3};
+
+    for ( int i = 0; i < 1000; ++i ) {
+      DeferredRecord<64> record;
+      record.capture(GBE_FMT("message %d of %s"), i, "a reasonably long producer name");
+      ASSERT_TRUE(writer.append(route_type{LogLocation::LOGFILE}, record));
+    }
+
+    EXPECT_GT(writer.statistics().rotations, 3u);
+    EXPECT_EQ(writer.segment(), writer.statistics().rotations);
+  }
+
+  std::vector<std::uint32_t> segments;
+
+  for ( const auto& file : std::filesystem::directory_iterator(m_directory) ) {
+    segments.push_back(static_cast<std::uint32_t>(std::stoul(file.path().stem().extension().string().substr(1))));
+  }
+
+  // Only the newest three segments are kept, each decodes on its own
+  ASSERT_EQ(segments.size(), 3u);
+  std::sort(segments.begin(), segments.end());
+
+  std::vector<std::string> texts;
+
+  for ( std::uint32_t segment : segments ) {
+    const std::vector<std::string> part = readAll(segment);
+    EXPECT_FALSE(part.empty());
+    texts.insert(texts.end(), part.begin(), part.end());
+  }
+
+  ASSERT_FALSE(texts.empty());
+  EXPECT_EQ(texts.back(), "message 999 of a reasonably long producer name");
+
+  const int first = std::stoi(texts.front().substr(8));
+
+  for ( std::size_t i = 0; i < texts.size(); ++i ) {
+    EXPECT_EQ(texts[i], "message " + std::to_string(first + static_cast<int>(i)) + " of a reasonably long producer name");
+  }
+}
+
+TEST_F(BinaryLogTest, ContinuesAfterExistingSegments) {
+  {
+    BinaryLogWriter writer{base()};
+    writer.append(route_type{LogLocation::LOGFILE}, "first run");
+  }
+
+  {
+    BinaryLogWriter writer{base()};
+    EXPECT_EQ(writer.segment(), 1u);
+    writer.append(route_type{LogLocation::LOGFILE}, "second run");
+  }
+
+  EXPECT_EQ(readAll(0), std::vector<std::string>{"first run"});
+  EXPECT_EQ(readAll(1), std::vector<std::string>{"second run"});
+}
+
+TEST_F(BinaryLogTest, FailedOpen) {
+  BinaryLogWriter writer{(m_directory / "missing" / "log").string()};
+
+  EXPECT_FALSE(writer.ok());
+  EXPECT_FALSE(writer.is_open());
+  EXPECT_FALSE(writer.append(route_type{LogLocation::LOGFILE}, "lost"));
+
+  DeferredRecord<64> record;
+  ASSERT_TRUE(record.capture(GBE_FMT("value=%d"), 42));
+  EXPECT_FALSE(writer.append(route_type{LogLocation::LOGFILE}, record));
+
+  EXPECT_EQ(writer.statistics().rotations, 0u);
+  EXPECT_EQ(writer.statistics().dropped, 2u);
+  EXPECT_EQ(writer.segment(), 0u);
+}
+
+TEST_F(BinaryLogTest, RejectsOtherVersions) {
+  {
+    BinaryLogWriter writer{base()};
+    writer.append(route_type{LogLocation::LOGFILE}, "text");
+  }
+
+  const std::string path = BinaryLogWriter::segment_path(base(), 0);
+  std::FILE* file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+
+  // The major version follows the 8 byte magic
+  std::fseek(file, 8, SEEK_SET);
+  std::fputc(gobeyond::utility::binary_log_version.major + 1, file);
+  std::fclose(file);
+
+  BinaryLogReader reader;
+  EXPECT_FALSE(reader.open(path));
+  EXPECT_FALSE(reader.open((m_directory / "missing").string()));
+}
+
+TEST_F(BinaryLogTest, RejectsOtherLongDoubleSize) {
+  {
+    BinaryLogWriter writer{base()};
+    DeferredRecord<32> record;
+
+    record.capture(GBE_FMT("%Lf"), 1.5L);
+    writer.append(route_type{LogLocation::LOGFILE}, record);
+  }
+
+  const std::string path = BinaryLogWriter::segment_path(base(), 0);
+  BinaryLogReader reader;
+
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.header().long_double_size, sizeof(long double));
+
+  // The size of long double follows the segment index
+  const auto patch = [&path](int size) {
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, offsetof(gobeyond::utility::BinaryLogHeader, long_double_size), SEEK_SET);
+    std::fputc(size, file);
+    std::fclose(file);
+  };
+
+  patch(sizeof(long double) == 16 ? 8 : 16);
+  EXPECT_FALSE(reader.open(path));
+
+  // Segments of writers before the field existed are read as native
+  patch(0);
+  EXPECT_TRUE(reader.open(path));
+}
+
+TEST_F(BinaryLogTest, SmallerThanText) {
+  std::size_t text_bytes = 0;
+
+  {
+    BinaryLogWriter writer{base(), 1024 * 1024};
+
+    for ( int i = 0; i < 1000; ++i ) {
+      DeferredRecord<64> record;
+      record.capture(GBE_FMT("Connection to broker %s established after %d retries, session %u resumed"), "mqtt.local", i % 5, 40000u + static_cast<unsigned>(i));
+      writer.append(route_type{LogLocation::LOGFILE}, record);
+
+      char text[256];
+      // A text line carries a formatted timestamp and the route as well
+      text_bytes += static_cast<std::size_t>(std::snprintf(text, sizeof(text), "2026-10-16 12:00:00.000000 [LOGFILE] ")) + record.render_to(text, sizeof(text)) + 1;
+    }
+  }
+
+  const std::size_t binary_bytes = static_cast<std::size_t>(std::filesystem::file_size(BinaryLogWriter::segment_path(base(), 0)));
+  EXPECT_LT(binary_bytes * 4, text_bytes);
+}
+
+TEST_F(BinaryLogTest, Corrupt) {
+  {
+    BinaryLogWriter writer{base()};
+    DeferredRecord<32> record;
+    record.capture(GBE_FMT("value=%d"), 42);
+    writer.append(route_type{LogLocation::LOGFILE}, record);
+  }
+
+  const std::string path = BinaryLogWriter::segment_path(base(), 0);
+  const auto size = std::filesystem::file_size(path);
+
+  // Cut the last record in half
+  std::filesystem::resize_file(path, size - 2);
+
+  BinaryLogReader reader;
+  ASSERT_TRUE(reader.open(path));
+
+  BinaryLogReader::Entry entry;
+  EXPECT_FALSE(reader.next(entry));
+  EXPECT_TRUE(reader.corrupt());
+}
+
+#endif
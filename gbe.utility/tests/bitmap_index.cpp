@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gobeyond/utility/bitmap_index.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using index_type = gobeyond::utility::BitmapIndex<LogLocation>;
+  using mask_type = index_type::mask_type;
+  using gobeyond::utility::RoaringBitmap;
+
+  /// Ids of all densities: sparse, dense and runs, across several containers
+  std::set<std::uint32_t> randomIds(std::mt19937& random) {
+    std::set<std::uint32_t> ids;
+    const std::uint32_t base = (random() % 4) << 16;
+
+    for ( int i = 0; i < 3000; ++i ) {
+      ids.insert(base + random() % 200000);
+    }
+
+    const std::uint32_t start = random() % 300000;
+
+    for ( std::uint32_t id = start; id < start + 10000; ++id ) {
+      ids.insert(id);
+    }
+
+    for ( std::uint32_t id = 0; id < 65536; id += 1 + random() % 4 ) {
+      ids.insert((5u << 16) + id);
+    }
+
+    return ids;
+  }
+
+  RoaringBitmap toBitmap(const std::set<std::uint32_t>& ids, bool optimize) {
+    RoaringBitmap bitmap;
+
+    for ( std::uint32_t id : ids ) {
+      bitmap.add(id);
+    }
+
+    if ( optimize ) {
+      bitmap.optimize();
+    }
+
+    return bitmap;
+  }
+
+  template <typename TOperation>
+  std::vector<std::uint32_t> reference(const std::set<std::uint32_t>& a, const std::set<std::uint32_t>& b, TOperation operation) {
+    std::vector<std::uint32_t> result;
+    operation(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+  }
+}
+
+TEST(RoaringBitmapTest, AddContains) {
+  RoaringBitmap bitmap;
+
+  bitmap.add(70000);
+  bitmap.add(3);
+  bitmap.add(1);
+  bitmap.add(3);
+
+  EXPECT_EQ(bitmap.cardinality(), 3u);
+  EXPECT_TRUE(bitmap.contains(1));
+  EXPECT_TRUE(bitmap.contains(70000));
+  EXPECT_FALSE(bitmap.contains(2));
+  EXPECT_FALSE(bitmap.contains(1 << 20));
+  EXPECT_EQ(bitmap.to_vector(), (std::vector<std::uint32_t>{1, 3, 70000}));
+}
+
+TEST(RoaringBitmapTest, Range) {
+  const RoaringBitmap bitmap = RoaringBitmap::range(65530, 131080);
+
+  EXPECT_EQ(bitmap.cardinality(), 131080u - 65530u);
+  EXPECT_TRUE(bitmap.contains(65530));
+  EXPECT_TRUE(bitmap.contains(131079));
+  EXPECT_FALSE(bitmap.contains(131080));
+  EXPECT_FALSE(bitmap.contains(65529));
+}
+
+TEST(RoaringBitmapTest, MatchesSet) {
+  std::mt19937 random{24};
+
+  for ( int round = 0; round < 8; ++round ) {
+    const std::set<std::uint32_t> a = randomIds(random);
+    const std::set<std::uint32_t> b = randomIds(random);
+    const RoaringBitmap x = toBitmap(a, 0 != round % 2);
+    const RoaringBitmap y = toBitmap(b, 0 != round % 4);
+
+    ASSERT_EQ(x.to_vector(), std::vector<std::uint32_t>(a.begin(), a.end()));
+    ASSERT_EQ((x & y).to_vector(), reference(a, b, [](auto... args) { return std::set_intersection(args...); }));
+    ASSERT_EQ((x | y).to_vector(), reference(a, b, [](auto... args) { return std::set_union(args...); }));
+    ASSERT_EQ((x ^ y).to_vector(), reference(a, b, [](auto... args) { return std::set_symmetric_difference(args...); }));
+    ASSERT_EQ(x.andNot(y).to_vector(), reference(a, b, [](auto... args) { return std::set_difference(args...); }));
+    ASSERT_EQ((x & y).cardinality(), (x & y).to_vector().size());
+    ASSERT_TRUE(x == toBitmap(a, false));
+  }
+}
+
+TEST(RoaringBitmapTest, RunsAreSmall) {
+  RoaringBitmap bitmap;
+
+  for ( std::uint32_t id = 0; id < 1000000; ++id ) {
+    bitmap.add(id);
+  }
+
+  bitmap.optimize();
+
+  EXPECT_EQ(bitmap.cardinality(), 1000000u);
+  EXPECT_LT(bitmap.memory_usage(), 2048u);
+}
+
+TEST(RoaringBitmapTest, AddToRuns) {
+  RoaringBitmap bitmap = RoaringBitmap::range(10, 20);
+  const std::size_t memory = bitmap.memory_usage();
+
+  // Appending extends or follows the last run without a bitmap
+  bitmap.add(20);
+  bitmap.add(30);
+  bitmap.add(15);
+  EXPECT_LT(bitmap.memory_usage(), memory + 64);
+
+  // A value in a gap turns the runs into an array
+  bitmap.add(25);
+  EXPECT_LT(bitmap.memory_usage(), memory + 64);
+
+  std::vector<std::uint32_t> expected;
+
+  for ( std::uint32_t id = 10; id <= 20; ++id ) {
+    expected.push_back(id);
+  }
+
+  expected.push_back(25);
+  expected.push_back(30);
+
+  EXPECT_EQ(bitmap.to_vector(), expected);
+  EXPECT_EQ(bitmap.cardinality(), expected.size());
+}
+
+TEST(BitmapIndexTest, AppendAfterOptimize) {
+  index_type index;
+
+  for ( int i = 0; i < 100000; ++i ) {
+    index.append(mask_type{LogLocation::DEBUG | LogLocation::LOGFILE});
+  }
+
+  index.optimize();
+  const std::size_t memory = index.memory_usage();
+
+  index.append(mask_type{LogLocation::DEBUG});
+  index.append(mask_type{LogLocation::LOGFILE});
+
+  EXPECT_LT(index.memory_usage(), memory + 256);
+  EXPECT_EQ(index.bitmap(LogLocation::DEBUG).cardinality(), 100001u);
+  EXPECT_EQ(index.bitmap(LogLocation::LOGFILE).cardinality(), 100001u);
+  EXPECT_FALSE(index.bitmap(LogLocation::LOGFILE).contains(100000));
+  EXPECT_TRUE(index.bitmap(LogLocation::LOGFILE).contains(100001));
+}
+
+TEST(BitmapIndexTest, Query) {
+  std::mt19937 random{50};
+  index_type index;
+  std::vector<mask_type> records;
+
+  for ( int i = 0; i < 200000; ++i ) {
+    // MQTT is rare, LOGFILE common and DEBUG comes in long stretches
+    mask_type mask;
+
+    if ( 0 == random() % 50 ) {
+      mask.enable(LogLocation::MQTT);
+    }
+
+    if ( 0 != random() % 4 ) {
+      mask.enable(LogLocation::LOGFILE);
+    }
+
+    if ( 0 == (i / 10000) % 2 ) {
+      mask.enable(LogLocation::DEBUG);
+    }
+
+    EXPECT_EQ(index.append(mask), static_cast<std::uint32_t>(i));
+    records.push_back(mask);
+  }
+
+  index.optimize();
+
+  const auto scan = [&records](auto predicate) {
+    std::vector<std::uint32_t> result;
+
+    for ( std::size_t i = 0; i < records.size(); ++i ) {
+      if ( predicate(records[i]) ) {
+        result.push_back(static_cast<std::uint32_t>(i));
+      }
+    }
+
+    return result;
+  };
+
+  EXPECT_EQ(index.size(), 200000u);
+  EXPECT_EQ(index.bitmap(LogLocation::MQTT).andNot(index.bitmap(LogLocation::LOGFILE)).to_vector(),
+            scan([](const mask_type& mask) { return mask.isEnabled(LogLocation::MQTT) && mask.isDisabled(LogLocation::LOGFILE); }));
+  EXPECT_EQ(index.query(mask_type::Enabled{LogLocation::MQTT | LogLocation::DEBUG}).to_vector(),
+            scan([](const mask_type& mask) { return mask == mask_type::Enabled{LogLocation::MQTT | LogLocation::DEBUG}; }));
+  EXPECT_EQ(index.query(mask_type::Disabled{LogLocation::LOGFILE | LogLocation::DEBUG}).to_vector(),
+            scan([](const mask_type& mask) { return mask == mask_type::Disabled{LogLocation::LOGFILE | LogLocation::DEBUG}; }));
+  EXPECT_EQ(index.query(mask_type::Enabled{LogLocation::DEBUG | LogLocation::LOGFILE | LogLocation::MQTT}).to_vector(),
+            scan([](const mask_type& mask) { return mask == mask_type::Enabled{LogLocation::DEBUG | LogLocation::LOGFILE | LogLocation::MQTT}; }));
+  EXPECT_EQ(index.query(mask_type::Enabled{LogLocation::NONE}).cardinality(), 200000u);
+
+  // A fraction of one 4 byte mask per record
+  EXPECT_LT(index.memory_usage(), records.size() * sizeof(mask_type) / 2);
+}
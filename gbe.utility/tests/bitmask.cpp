@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <cstdint>
+#include <vector>
 
 #include <gobeyond/utility/bitmask.hpp>
 
@@ -225,3 +226,112 @@ TEST(BitMaskTest, DisabledAssign) {
   EXPECT_TRUE(mask2 == bitmask_type::Disabled{LogLocation::DEBUG});
 }
 
+
+TEST(BitMaskTest, Count) {
+  using bitmask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  EXPECT_EQ(bitmask_type{}.count(), 0u);
+  EXPECT_EQ(bitmask_type{LogLocation::DEBUG | LogLocation::MQTT}.count(), 2u);
+  EXPECT_EQ(bitmask_type{LogLocation::ALL}.count(), 5u);
+}
+
+TEST(BitMaskTest, ForEachEnabled) {
+  using bitmask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  bitmask_type mask{LogLocation::DEBUG | LogLocation::MQTT | LogLocation::PUSHNOTIFICATION};
+  std::vector<LogLocation> visited;
+
+  mask.for_each_enabled([&](LogLocation flag) { visited.push_back(flag); });
+
+  EXPECT_EQ(visited, (std::vector<LogLocation>{LogLocation::DEBUG, LogLocation::MQTT, LogLocation::PUSHNOTIFICATION}));
+}
+
+TEST(BitMaskTest, Flags) {
+  using bitmask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  bitmask_type mask{LogLocation::LOGFILE | LogLocation::BROWSER};
+  std::vector<LogLocation> visited;
+
+  for ( LogLocation flag : mask.flags() ) {
+    visited.push_back(flag);
+  }
+
+  EXPECT_EQ(visited, (std::vector<LogLocation>{LogLocation::LOGFILE, LogLocation::BROWSER}));
+  EXPECT_EQ(bitmask_type{}.flags().begin(), bitmask_type{}.flags().end());
+}
+
+TEST(BitMaskTest, LowestHighest) {
+  using bitmask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  bitmask_type mask{LogLocation::LOGFILE | LogLocation::MQTT | LogLocation::BROWSER};
+
+  EXPECT_EQ(mask.lowest(), LogLocation::LOGFILE);
+  EXPECT_EQ(mask.highest(), LogLocation::BROWSER);
+  EXPECT_EQ(bitmask_type{}.lowest(), LogLocation::NONE);
+  EXPECT_EQ(bitmask_type{}.highest(), LogLocation::NONE);
+}
+
+namespace {
+  using constexpr_mask = gobeyond::utility::BitMask<LogLocation>;
+
+  constexpr constexpr_mask buildRoute() {
+    constexpr_mask mask{LogLocation::DEBUG};
+    mask.enable(LogLocation::MQTT);
+    mask = constexpr_mask::Enable{LogLocation::BROWSER};
+    mask = constexpr_mask::Disable{LogLocation::DEBUG};
+    return mask;
+  }
+
+  /// A route table in read-only memory
+  constexpr constexpr_mask g_routes[] = {
+    LogLocation::DEBUG | LogLocation::LOGFILE,
+    buildRoute(),
+    ~constexpr_mask{LogLocation::DEBUG}
+  };
+
+  static_assert(g_routes[0].isEnabled(LogLocation::LOGFILE));
+  static_assert(g_routes[1] == (LogLocation::MQTT | LogLocation::BROWSER));
+  static_assert(g_routes[1].count() == 2);
+  static_assert(g_routes[1].lowest() == LogLocation::MQTT);
+  static_assert(g_routes[1].highest() == LogLocation::BROWSER);
+  static_assert(g_routes[2] == (LogLocation::LOGFILE | LogLocation::MQTT | LogLocation::BROWSER | LogLocation::PUSHNOTIFICATION));
+  static_assert((LogLocation::ALL & LogLocation::MQTT) == LogLocation::MQTT);
+  static_assert((LogLocation::DEBUG ^ LogLocation::ALL) == ~constexpr_mask{LogLocation::DEBUG});
+  static_assert(constexpr_mask{LogLocation::ALL} == constexpr_mask::Enabled{LogLocation::MQTT});
+
+  enum class Wide : std::uint8_t {
+    A = 1,
+    B = 2
+  };
+
+  // Without ALL the complement covers every bit of the underlying type
+  static_assert(static_cast<std::uint8_t>(~gobeyond::utility::BitMask<Wide>{Wide::A}) == 0xFE);
+
+  template <LogLocation TRoute>
+  int specialized() {
+    constexpr constexpr_mask route{TRoute};
+
+    if constexpr ( route.isEnabled(LogLocation::MQTT) ) {
+      return 1;
+    } else {
+      return 0;
+    }
+  }
+}
+
+TEST(BitMaskTest, Constexpr) {
+  EXPECT_EQ(specialized<LogLocation::MQTT>(), 1);
+  EXPECT_EQ(specialized<LogLocation::LOGFILE>(), 0);
+  EXPECT_EQ(g_routes[1], LogLocation::MQTT | LogLocation::BROWSER);
+}
+
+TEST(BitMaskTest, Xor) {
+  using bitmask_type = gobeyond::utility::BitMask<LogLocation>;
+
+  bitmask_type mask{LogLocation::DEBUG | LogLocation::MQTT};
+  mask ^= bitmask_type{LogLocation::MQTT | LogLocation::BROWSER};
+
+  EXPECT_EQ(mask, LogLocation::DEBUG | LogLocation::BROWSER);
+  EXPECT_EQ(mask ^ LogLocation::DEBUG, LogLocation::BROWSER);
+  EXPECT_EQ(~mask, LogLocation::LOGFILE | LogLocation::MQTT | LogLocation::PUSHNOTIFICATION);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gobeyond/utility/bitmask_array.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using array_type = gobeyond::utility::BitMaskArray<LogLocation>;
+  using mask_type = array_type::mask_type;
+
+  /// Random records, kept as an array of masks as well
+  array_type randomArray(std::mt19937& random, std::size_t size, std::vector<mask_type>& reference) {
+    array_type array;
+    reference.clear();
+
+    for ( std::size_t i = 0; i < size; ++i ) {
+      const mask_type mask{static_cast<LogLocation>(random() % 32)};
+      array.push_back(mask);
+      reference.push_back(mask);
+    }
+
+    return array;
+  }
+
+  template <typename TFlag>
+  std::vector<std::size_t> referenceSelect(const std::vector<mask_type>& reference, const TFlag& flag) {
+    std::vector<std::size_t> result;
+
+    for ( std::size_t i = 0; i < reference.size(); ++i ) {
+      if ( reference[i] == flag ) {
+        result.push_back(i);
+      }
+    }
+
+    return result;
+  }
+}
+
+TEST(BitMaskArrayTest, GetSet) {
+  array_type array(100);
+
+  EXPECT_EQ(array.size(), 100u);
+  EXPECT_EQ(array.get(42), LogLocation::NONE);
+
+  array.set(42, LogLocation::DEBUG | LogLocation::MQTT);
+  array.push_back(mask_type{LogLocation::BROWSER});
+
+  EXPECT_EQ(array.get(42), LogLocation::DEBUG | LogLocation::MQTT);
+  EXPECT_EQ(array.get(100), LogLocation::BROWSER);
+  EXPECT_EQ(array.size(), 101u);
+}
+
+TEST(BitMaskArrayTest, MatchesScalar) {
+  std::mt19937 random{23};
+  std::vector<mask_type> reference;
+
+  for ( std::size_t size : {0u, 1u, 63u, 64u, 65u, 130u, 1000u} ) {
+    const array_type array = randomArray(random, size, reference);
+
+    for ( mask_type flags : {mask_type{LogLocation::NONE}, mask_type{LogLocation::MQTT}, LogLocation::DEBUG | LogLocation::BROWSER, mask_type{LogLocation::ALL}} ) {
+      const mask_type::Enabled enabled{flags};
+      const mask_type::Disabled disabled{flags};
+
+      ASSERT_EQ(array.select(enabled), referenceSelect(reference, enabled)) << size;
+      ASSERT_EQ(array.select(disabled), referenceSelect(reference, disabled)) << size;
+      ASSERT_EQ(array.count(enabled), referenceSelect(reference, enabled).size()) << size;
+      ASSERT_EQ(array.count(disabled), referenceSelect(reference, disabled).size()) << size;
+    }
+  }
+}
+
+TEST(BitMaskArrayTest, Parallel) {
+  std::mt19937 random{24};
+  std::vector<mask_type> reference;
+
+  // Large enough to be split across threads
+  const array_type array = randomArray(random, 3000000 + 17, reference);
+  const mask_type::Enabled enabled{LogLocation::LOGFILE | LogLocation::MQTT};
+  const mask_type::Disabled disabled{LogLocation::PUSHNOTIFICATION};
+
+  EXPECT_EQ(array.parallel_select(enabled, 4), array.select(enabled));
+  EXPECT_EQ(array.parallel_select(disabled, 4), referenceSelect(reference, disabled));
+  EXPECT_EQ(array.parallel_count(enabled, 4), array.count(enabled));
+  EXPECT_EQ(array.parallel_count(disabled, 3), referenceSelect(reference, disabled).size());
+}
+
+TEST(BitMaskArrayTest, ApplyRange) {
+  array_type array(300);
+
+  array.apply(mask_type::Enable{LogLocation::DEBUG | LogLocation::MQTT}, 10, 250);
+  array.apply(mask_type::Disable{LogLocation::MQTT}, 60, 70);
+
+  EXPECT_EQ(array.get(9), LogLocation::NONE);
+  EXPECT_EQ(array.get(10), LogLocation::DEBUG | LogLocation::MQTT);
+  EXPECT_EQ(array.get(65), LogLocation::DEBUG);
+  EXPECT_EQ(array.get(249), LogLocation::DEBUG | LogLocation::MQTT);
+  EXPECT_EQ(array.get(250), LogLocation::NONE);
+  EXPECT_EQ(array.count(mask_type::Enabled{LogLocation::MQTT}), 230u);
+
+  array.apply(mask_type::Enable{LogLocation::BROWSER}, 3, 5);
+  EXPECT_EQ(array.select(mask_type::Enabled{LogLocation::BROWSER}), (std::vector<std::size_t>{3, 4}));
+}
+
+TEST(BitMaskArrayTest, ApplyIndices) {
+  array_type array(200);
+  const std::vector<std::size_t> indices{1, 64, 199};
+
+  array.apply(mask_type::Enable{LogLocation::LOGFILE}, indices);
+  EXPECT_EQ(array.select(mask_type::Enabled{LogLocation::LOGFILE}), indices);
+
+  array.apply(mask_type::Disable{LogLocation::LOGFILE}, std::vector<std::size_t>{64});
+  EXPECT_EQ(array.count(mask_type::Enabled{LogLocation::LOGFILE}), 2u);
+}
+
+TEST(BitMaskArrayTest, Shrink) {
+  array_type array(100);
+
+  array.apply(mask_type::Enable{LogLocation::DEBUG}, 0, 100);
+  array.resize(50);
+
+  EXPECT_EQ(array.count(mask_type::Enabled{LogLocation::DEBUG}), 50u);
+
+  array.resize(100);
+  EXPECT_EQ(array.count(mask_type::Enabled{LogLocation::DEBUG}), 50u);
+  EXPECT_EQ(array.count(mask_type::Disabled{LogLocation::DEBUG}), 50u);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gobeyond/utility/bitmask_config.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using config_type = gobeyond::utility::BitMaskConfig<LogLocation>;
+  using mask_type = config_type::mask_type;
+
+  constexpr std::size_t g_modules = 300;
+
+  /// All modules get the same mask, so a mixed view is easy to spot
+  std::vector<mask_type> uniform(std::uint64_t version) {
+    return std::vector<mask_type>(g_modules, mask_type{static_cast<LogLocation>(version % 32)});
+  }
+}
+
+TEST(BitMaskConfigTest, PublishRead) {
+  config_type config{{mask_type{LogLocation::DEBUG}, mask_type{LogLocation::MQTT}}};
+
+  EXPECT_EQ(config.version(), 0u);
+  EXPECT_EQ(config.get(0), LogLocation::DEBUG);
+  EXPECT_EQ(config.get(1), LogLocation::MQTT);
+  EXPECT_EQ(config.get(2), LogLocation::NONE);
+
+  EXPECT_EQ(config.publish({mask_type{LogLocation::LOGFILE}}), 1u);
+  EXPECT_EQ(config.version(), 1u);
+  EXPECT_EQ(config.get(0), LogLocation::LOGFILE);
+  EXPECT_EQ(config.read()->size(), 1u);
+}
+
+TEST(BitMaskConfigTest, Update) {
+  config_type config{uniform(0)};
+
+  EXPECT_EQ(config.update([](std::vector<mask_type>& masks) { masks[7].enable(LogLocation::BROWSER); }), 1u);
+  EXPECT_EQ(config.get(7), LogLocation::BROWSER);
+  EXPECT_EQ(config.get(6), LogLocation::NONE);
+}
+
+TEST(BitMaskConfigTest, ViewKeepsSnapshot) {
+  config_type config{uniform(1)};
+
+  {
+    const config_type::View view = config.read();
+
+    config.publish(uniform(2));
+    EXPECT_EQ(view->version(), 0u);
+    EXPECT_EQ((*view)[0], LogLocation::DEBUG);
+    EXPECT_EQ(config.reclaim(), 1u);
+
+    // Nested views on the same thread keep the outer one pinned
+    {
+      const config_type::View inner = config.read();
+      EXPECT_EQ(inner->version(), 1u);
+    }
+
+    EXPECT_EQ(config.reclaim(), 1u);
+  }
+
+  EXPECT_EQ(config.reclaim(), 0u);
+}
+
+TEST(BitMaskConfigTest, Overflow) {
+  // No slot for the test thread, views use the shared counter
+  config_type config{uniform(1), 0};
+
+  {
+    const config_type::View view = config.read();
+    config.publish(uniform(2));
+    EXPECT_EQ(view->version(), 0u);
+    EXPECT_EQ(config.reclaim(), 1u);
+  }
+
+  EXPECT_EQ(config.reclaim(), 0u);
+}
+
+TEST(BitMaskConfigTest, ConcurrentReaders) {
+  config_type config{uniform(0), 8};
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> mixed{0};
+  std::vector<std::thread> readers;
+
+  for ( int t = 0; t < 4; ++t ) {
+    readers.emplace_back([&config, &done, &mixed]() {
+      std::uint64_t last = 0;
+
+      while ( !done.load(std::memory_order_relaxed) ) {
+        const config_type::View view = config.read();
+        const mask_type expected{static_cast<LogLocation>(view->version() % 32)};
+
+        for ( const mask_type& mask : view->masks() ) {
+          if ( mask != expected ) {
+            mixed.fetch_add(1);
+          }
+        }
+
+        // Versions never go back
+        if ( view->version() < last ) {
+          mixed.fetch_add(1);
+        }
+
+        last = view->version();
+      }
+    });
+  }
+
+  for ( std::uint64_t version = 1; version <= 2000; ++version ) {
+    config.publish(uniform(version));
+  }
+
+  done = true;
+
+  for ( std::thread& reader : readers ) {
+    reader.join();
+  }
+
+  config.synchronize();
+  EXPECT_EQ(mixed.load(), 0u);
+  EXPECT_EQ(config.version(), 2000u);
+  EXPECT_EQ(config.reclaim(), 0u);
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <gobeyond/utility/bits.hpp>
+
+TEST(BitsTest, CountLeadingZeros) {
+  EXPECT_EQ(gobeyond::utility::countl_zero(0), 64);
+  EXPECT_EQ(gobeyond::utility::countl_zero(1), 63);
+  EXPECT_EQ(gobeyond::utility::countl_zero(UINT64_MAX), 0);
+  EXPECT_EQ(gobeyond::utility::countl_zero(0x00f0000000000000ull), 8);
+}
+
+TEST(BitsTest, CountTrailingZeros) {
+  EXPECT_EQ(gobeyond::utility::countr_zero(0), 64);
+  EXPECT_EQ(gobeyond::utility::countr_zero(1), 0);
+  EXPECT_EQ(gobeyond::utility::countr_zero(0x8000000000000000ull), 63);
+  EXPECT_EQ(gobeyond::utility::countr_zero(0x10), 4);
+}
+
+TEST(BitsTest, Popcount) {
+  EXPECT_EQ(gobeyond::utility::popcount(0), 0);
+  EXPECT_EQ(gobeyond::utility::popcount(UINT64_MAX), 64);
+  EXPECT_EQ(gobeyond::utility::popcount(0x5555), 8);
+}
+
+TEST(BitsTest, Constexpr) {
+  static_assert(gobeyond::utility::countl_zero(1) == 63);
+  static_assert(gobeyond::utility::countr_zero(8) == 3);
+  static_assert(gobeyond::utility::popcount(7) == 3);
+}
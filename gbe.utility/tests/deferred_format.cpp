@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gobeyond/utility/deferred_format.hpp>
+
+using gobeyond::utility::DeferredFormatRegistry;
+using gobeyond::utility::DeferredRecord;
+using gobeyond::utility::DeferredType;
+using gobeyond::utility::StringBuffer;
+
+namespace {
+  enum class Level : std::uint8_t {
+    Info = 3
+  };
+}
+
+TEST(DeferredFormatTest, TriviallyCopyable) {
+  EXPECT_TRUE(std::is_trivially_copyable_v<DeferredRecord<64>>);
+}
+
+TEST(DeferredFormatTest, RenderMatchesFormat) {
+  DeferredRecord<128> record;
+  const char* name = "sensor.temperature";
+  const double ratio = 0.73125;
+
+  ASSERT_TRUE(record.capture(GBE_FMT("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%s"), name, -4711, ratio, 0xC0FFEEu, 17u, "MQTT"));
+
+  StringBuffer<256> rendered;
+  EXPECT_TRUE(record.render(rendered));
+
+  const auto expected = StringBuffer<256>::format(GBE_FMT("[%s] value=%d ratio=%.3f id=%08x count=%u tag=%s"), name, -4711, ratio, 0xC0FFEEu, 17u, "MQTT");
+  EXPECT_EQ(rendered.view(), expected.view());
+}
+
+TEST(DeferredFormatTest, Types) {
+  DeferredRecord<128> record;
+  const std::string text = "std::string";
+  const StringBuffer<16> buffer("buffer");
+  int value = 0;
+
+  ASSERT_TRUE(record.capture(GBE_FMT("%c %hhd %lld %llu %5.1f %g %s %s %s %d %s %p %p %%"),
+    'x', static_cast<signed char>(-5), -1234567890123ll, 18446744073709551615ull, 2.5f, 1e-7, text, std::string_view("view"), buffer,
+    Level::Info, true ? "yes" : "no", static_cast<const void*>(nullptr), &value));
+
+  std::string expected = "x -5 -1234567890123 18446744073709551615   2.5 1e-07 std::string view buffer 3 yes (nil) ";
+  char pointer[32];
+  std::snprintf(pointer, sizeof(pointer), "%p", static_cast<void*>(&value));
+  expected += pointer;
+  expected += " %";
+
+  char out[256];
+  EXPECT_EQ(record.render_to(out, sizeof(out)), expected.size());
+  EXPECT_EQ(std::string(out), expected);
+
+  const auto* format = DeferredFormatRegistry::instance().find(record.id());
+  ASSERT_NE(format, nullptr);
+  ASSERT_EQ(format->arguments, 13u);
+  EXPECT_EQ(format->types[0], DeferredType::Int8);
+  EXPECT_EQ(format->types[2], DeferredType::Int64);
+  EXPECT_EQ(format->types[3], DeferredType::UInt64);
+  EXPECT_EQ(format->types[4], DeferredType::Float);
+  EXPECT_EQ(format->types[5], DeferredType::Double);
+  EXPECT_EQ(format->types[6], DeferredType::String);
+  EXPECT_EQ(format->types[9], DeferredType::UInt8);
+  EXPECT_EQ(format->types[11], DeferredType::Pointer);
+}
+
+TEST(DeferredFormatTest, StringsAreCopied) {
+  DeferredRecord<64> record;
+
+  {
+    std::string temporary = "temporary";
+    record.capture(GBE_FMT("%s!"), temporary);
+    temporary.assign("overwritten");
+  }
+
+  StringBuffer<32> rendered;
+  record.render(rendered);
+  EXPECT_EQ(rendered.view(), "temporary!");
+}
+
+TEST(DeferredFormatTest, StringCut) {
+  DeferredRecord<16> record;
+
+  // 4 bytes for the int, 2 for the string length leave 10 characters
+  EXPECT_FALSE(record.capture(GBE_FMT("%s=%d"), "a rather long string", 42));
+  EXPECT_TRUE(record.truncated());
+  EXPECT_EQ(record.size(), 16u);
+
+  StringBuffer<64> rendered;
+  record.render(rendered);
+  EXPECT_EQ(rendered.view(), "a rather l=42");
+}
+
+TEST(DeferredFormatTest, RenderTruncates) {
+  DeferredRecord<64> record;
+  record.capture(GBE_FMT("value=%d"), 123456);
+
+  StringBuffer<8> rendered;
+  EXPECT_FALSE(record.render(rendered));
+  EXPECT_EQ(rendered.view(), "value=1");
+  EXPECT_TRUE(rendered.truncated());
+
+  char out[4];
+  EXPECT_EQ(record.render_to(out, sizeof(out)), 12u);
+  EXPECT_STREQ(out, "val");
+}
+
+TEST(DeferredFormatTest, EmptyRecord) {
+  DeferredRecord<16> record;
+  StringBuffer<16> rendered("old");
+
+  EXPECT_EQ(record.id(), DeferredFormatRegistry::invalid_id);
+  EXPECT_FALSE(record.render(rendered));
+  EXPECT_TRUE(rendered.empty());
+}
+
+TEST(DeferredFormatTest, IdPerCallSite) {
+  DeferredRecord<16> first;
+  DeferredRecord<16> second;
+  DeferredRecord<16> again;
+
+  for ( int i = 0; i < 2; ++i ) {
+    DeferredRecord<16>& record = 0 == i ? first : again;
+    record.capture(GBE_FMT("%d"), i);
+  }
+
+  second.capture(GBE_FMT("%d"), 1);
+
+  EXPECT_EQ(first.id(), again.id());
+  EXPECT_NE(first.id(), second.id());
+  EXPECT_EQ(DeferredFormatRegistry::instance().find(first.id())->text, "%d");
+}
+
+TEST(DeferredFormatTest, CaptureOnProducersRenderOnConsumer) {
+  std::vector<DeferredRecord<32>> records(4 * 1000);
+  std::vector<std::thread> threads;
+
+  for ( int p = 0; p < 4; ++p ) {
+    threads.emplace_back([&records, p]() {
+      for ( int i = 0; i < 1000; ++i ) {
+        records[static_cast<std::size_t>(p * 1000 + i)].capture(GBE_FMT("producer %d message %d"), p, i);
+      }
+    });
+  }
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  StringBuffer<64> rendered;
+
+  for ( int p = 0; p < 4; ++p ) {
+    for ( int i = 0; i < 1000; ++i ) {
+      records[static_cast<std::size_t>(p * 1000 + i)].render(rendered);
+      EXPECT_EQ(rendered.view(), "producer " + std::to_string(p) + " message " + std::to_string(i));
+    }
+  }
+}
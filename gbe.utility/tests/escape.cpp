@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <gobeyond/utility/escape.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace {
+  using gobeyond::utility::Escape;
+  using gobeyond::utility::SimdLevel;
+
+  constexpr SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+  constexpr Escape modes[] = {Escape::Json, Escape::Url, Escape::Html};
+
+  std::string escape(std::string_view text, Escape mode) {
+    std::string result(gobeyond::utility::escaped_size(text, mode), '\0');
+    const gobeyond::utility::EscapeResult progress = gobeyond::utility::escape_to(result.data(), result.size(), text, mode);
+
+    EXPECT_EQ(progress.written, result.size());
+    EXPECT_EQ(progress.consumed, text.size());
+
+    return result;
+  }
+}
+
+TEST(EscapeTest, Json) {
+  EXPECT_EQ(escape("plain text", Escape::Json), "plain text");
+  EXPECT_EQ(escape("say \"hi\"\\", Escape::Json), "say \\\"hi\\\"\\\\");
+  EXPECT_EQ(escape("a\nb\tc\rd\be\ff", Escape::Json), "a\\nb\\tc\\rd\\be\\ff");
+  EXPECT_EQ(escape(std::string_view("\0\x01\x1f", 3), Escape::Json), "\\u0000\\u0001\\u001F");
+  EXPECT_EQ(escape("gr\xC3\xBC\xC3\x9F \x7f", Escape::Json), "gr\xC3\xBC\xC3\x9F \x7f");
+}
+
+TEST(EscapeTest, Url) {
+  EXPECT_EQ(escape("AZaz09-._~", Escape::Url), "AZaz09-._~");
+  EXPECT_EQ(escape("a b/c?d=e&f", Escape::Url), "a%20b%2Fc%3Fd%3De%26f");
+  EXPECT_EQ(escape("@[`{\xC3\xBC", Escape::Url), "%40%5B%60%7B%C3%BC");
+}
+
+TEST(EscapeTest, Html) {
+  EXPECT_EQ(escape("<b>\"Tom\" & 'Jerry'</b>", Escape::Html), "&lt;b&gt;&quot;Tom&quot; &amp; &#39;Jerry&#39;&lt;/b&gt;");
+  EXPECT_EQ(escape("no markup", Escape::Html), "no markup");
+}
+
+TEST(EscapeTest, ScanMatchesScalar) {
+  std::mt19937 random{7};
+  const auto& scalar = gobeyond::utility::escape_detail::kernelsFor(SimdLevel::Scalar);
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::escape_detail::kernelsFor(level);
+
+    for ( int round = 0; round < 2000; ++round ) {
+      // Mostly clean text with a rare special character at a random position
+      std::string text(random() % 100, 'a');
+      const std::size_t special_count = random() % 3;
+
+      for ( std::size_t k = 0; k < special_count && !text.empty(); ++k ) {
+        text[random() % text.size()] = static_cast<char>(random() % 256);
+      }
+
+      for ( int mode = 0; mode < 3; ++mode ) {
+        ASSERT_EQ(kernels.scan[mode](text.data(), text.size()), scalar.scan[mode](text.data(), text.size())) << "level " << static_cast<int>(level) << " mode " << mode << " text " << text;
+      }
+    }
+
+    // Every byte value at every position of a vector
+    for ( int c = 0; c < 256; ++c ) {
+      for ( std::size_t position = 0; position < 40; ++position ) {
+        std::string text(48, 'x');
+        text[position] = static_cast<char>(c);
+
+        for ( int mode = 0; mode < 3; ++mode ) {
+          ASSERT_EQ(kernels.scan[mode](text.data(), text.size()), scalar.scan[mode](text.data(), text.size())) << "level " << static_cast<int>(level) << " mode " << mode << " byte " << c;
+        }
+      }
+    }
+  }
+}
+
+TEST(EscapeTest, TruncatesAtSequenceBoundaries) {
+  const std::string text = "line \"1\"\n<tag> & more";
+
+  for ( Escape mode : modes ) {
+    const std::string complete = escape(text, mode);
+
+    for ( std::size_t space = 0; space <= complete.size(); ++space ) {
+      std::string out(space, '\0');
+      const gobeyond::utility::EscapeResult result = gobeyond::utility::escape_to(out.data(), space, text, mode);
+
+      // The output is always the escaped form of the consumed input
+      ASSERT_LE(result.written, space);
+      EXPECT_EQ(out.substr(0, result.written), escape(text.substr(0, result.consumed), mode)) << "space " << space;
+      EXPECT_EQ(result.consumed == text.size(), space == complete.size()) << "space " << space;
+    }
+  }
+}
+
+TEST(EscapeTest, TruncatesAtCodePointBoundaries) {
+  // 2, 3 and 4 byte code points in clean runs
+  const std::string text = "gr\xC3\xBC\xC3\x9F \xE2\x82\xAC \"\xF0\x9F\x98\x80\xF0\x9F\x98\x80\" \xE2\x82\xAC\xE2\x82\xAC";
+
+  // Url encodes every byte of a code point on its own, so it may stop between them
+  for ( Escape mode : {Escape::Json, Escape::Html} ) {
+    const std::string complete = escape(text, mode);
+
+    for ( std::size_t space = 0; space <= complete.size(); ++space ) {
+      std::string out(space, '\0');
+      const gobeyond::utility::EscapeResult result = gobeyond::utility::escape_to(out.data(), space, text, mode);
+
+      // Resuming at a continuation byte would mean a split code point
+      ASSERT_TRUE(result.consumed == text.size() || 0x80 != (static_cast<unsigned char>(text[result.consumed]) & 0xC0)) << "space " << space;
+      EXPECT_EQ(out.substr(0, result.written), escape(text.substr(0, result.consumed), mode)) << "space " << space;
+    }
+  }
+}
+
+TEST(EscapeTest, Resume) {
+  const std::string text = "{\"a\": \"b\\c\"}\n";
+  std::string out;
+  std::size_t consumed = 0;
+
+  while ( consumed < text.size() ) {
+    char chunk[7];
+    const gobeyond::utility::EscapeResult result = gobeyond::utility::escape_to(chunk, sizeof(chunk), std::string_view(text).substr(consumed));
+
+    ASSERT_GT(result.consumed, 0u);
+    out.append(chunk, result.written);
+    consumed += result.consumed;
+  }
+
+  EXPECT_EQ(out, escape(text, Escape::Json));
+}
+
+TEST(EscapeTest, StringBuffer) {
+  gobeyond::utility::StringBuffer<16> buffer{"{\"msg\":\""};
+
+  // The closing quote needs two characters, only one is left
+  EXPECT_EQ(buffer.capacity(), 15u);
+  EXPECT_FALSE(buffer.append_escaped("a\"b\n\""));
+  EXPECT_EQ(buffer.view(), "{\"msg\":\"a\\\"b\\n");
+  EXPECT_TRUE(buffer.truncated());
+
+  buffer.assign("");
+  EXPECT_TRUE(buffer.append_escaped("<x>", Escape::Html));
+  EXPECT_EQ(buffer.view(), "&lt;x&gt;");
+  EXPECT_FALSE(buffer.truncated());
+}
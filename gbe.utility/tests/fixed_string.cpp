@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+
+#include <gobeyond/utility/fixed_string.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+using gobeyond::utility::FixedString;
+using gobeyond::utility::to_fixed_string;
+
+namespace {
+  constexpr FixedString g_prefix = "sensors/";
+  constexpr auto g_topic = g_prefix + "hall-" + to_fixed_string<3>() + "/temperature";
+
+  /// Takes the topic as template parameter the C++17 way, by reference to a constexpr object
+  template <const auto& TTopic>
+  struct Publisher 
+  {
+    static constexpr std::string_view topic() noexcept 
+    {
+      return TTopic.view();
+    }
+  };
+
+  constexpr FixedString<32> header() noexcept 
+  {
+    FixedString<32> result{"[node "};
+
+    result.append(-42).append(']').append(' ').append(true);
+
+    return result;
+  }
+}
+
+static_assert(g_prefix.size() == 8);
+static_assert(g_prefix.capacity() == 8);
+static_assert(g_topic == std::string_view("sensors/hall-3/temperature"));
+static_assert(decltype(g_topic)::capacity() == g_topic.size());
+static_assert(header() == std::string_view("[node -42] true"));
+static_assert(to_fixed_string<INT64_MIN>() == std::string_view("-9223372036854775808"));
+static_assert(to_fixed_string<UINT64_MAX>() == std::string_view("18446744073709551615"));
+static_assert(to_fixed_string<0>().size() == 1);
+static_assert(Publisher<g_topic>::topic() == "sensors/hall-3/temperature");
+static_assert(FixedString<32>::format("%shall-%d/%s", g_prefix.view(), 3, "temperature") == g_topic);
+static_assert(FixedString<16>::format("%d%% %c %s", 100, 'x', false) == std::string_view("100% x false"));
+static_assert(FixedString<16>::format("%d %d", 1) == std::string_view("1 %d"));
+static_assert(FixedString<8>::format("%s", "cut off here") == std::string_view("cut off "));
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+namespace {
+  template <FixedString TTopic>
+  struct LiteralPublisher 
+  {
+    static constexpr std::string_view topic() noexcept 
+    {
+      return TTopic.view();
+    }
+  };
+}
+
+static_assert(LiteralPublisher<"sensors/hall-3">::topic() == "sensors/hall-3");
+#elif defined(GBE_UTILITY_TEST_CXX20)
+#error "the C++20 test executable has to compile the literal template arguments"
+#endif
+
+TEST(FixedStringTest, Construct) {
+  constexpr FixedString empty = FixedString<4>();
+  constexpr FixedString<4> cut{std::string_view("abcdef")};
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.view(), "");
+  EXPECT_EQ(cut.view(), "abcd");
+  EXPECT_EQ(cut.c_str()[4], '\0');
+}
+
+TEST(FixedStringTest, Append) {
+  FixedString<8> text;
+
+  text.append("abc").append(std::string_view("de")).append(12345);
+
+  EXPECT_EQ(text.view(), "abcde123");
+  EXPECT_EQ(text.size(), 8u);
+
+  text.clear();
+  text.append(false);
+  EXPECT_EQ(text.view(), "false");
+}
+
+TEST(FixedStringTest, Format) {
+  FixedString<24> text{"id="};
+
+  text.append_format("%u, %s%%", 7u, std::string_view("done")).append_format(" 50%");
+
+  EXPECT_EQ(text.view(), "id=7, done% 50%");
+  EXPECT_EQ(FixedString<8>::format("%s", "abc", "ignored").view(), "abc");
+}
+
+TEST(FixedStringTest, Concatenate) {
+  constexpr auto joined = "[" + FixedString("tag") + "]";
+
+  EXPECT_EQ(joined.view(), "[tag]");
+  EXPECT_TRUE(joined == FixedString("[tag]"));
+  EXPECT_TRUE(joined != FixedString("[tag"));
+}
+
+TEST(FixedStringTest, ReadOnlyData) {
+  // The object is a constant initialized global, no code runs at startup
+  EXPECT_STREQ(g_topic.c_str(), "sensors/hall-3/temperature");
+  EXPECT_EQ(Publisher<g_topic>::topic().data(), g_topic.data());
+}
+
+TEST(FixedStringTest, StringBuffer) {
+  gobeyond::utility::StringBuffer<64> buffer{g_topic.view()};
+
+  buffer.append(": 21.5");
+  EXPECT_EQ(buffer.view(), "sensors/hall-3/temperature: 21.5");
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <gobeyond/utility/flag_dispatch.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  void toLogfile(std::string& out) {
+    out += "logfile;";
+  }
+
+  void toMqtt(std::string& out) {
+    out += "mqtt;";
+  }
+
+  void toBrowser(std::string& out) {
+    out += "browser;";
+  }
+
+  using table_type = gobeyond::utility::FlagDispatchTable<LogLocation, std::string&>;
+
+  constexpr table_type g_table{
+    {LogLocation::BROWSER, &toBrowser},
+    {LogLocation::LOGFILE, &toLogfile},
+    {LogLocation::MQTT, &toMqtt},
+    {LogLocation::ALL, &toMqtt}
+  };
+
+  static_assert(g_table.handles(LogLocation::MQTT));
+  static_assert(!g_table.handles(LogLocation::DEBUG));
+}
+
+TEST(FlagDispatchTableTest, Dispatch) {
+  std::string out;
+
+  EXPECT_EQ(g_table.dispatch(LogLocation::DEBUG | LogLocation::MQTT | LogLocation::BROWSER, out), 2u);
+  EXPECT_EQ(out, "mqtt;browser;");
+
+  out.clear();
+  EXPECT_EQ(g_table.dispatch(gobeyond::utility::BitMask<LogLocation>{LogLocation::ALL}, out), 3u);
+  EXPECT_EQ(out, "logfile;mqtt;browser;");
+
+  out.clear();
+  EXPECT_EQ(g_table.dispatch(gobeyond::utility::BitMask<LogLocation>{LogLocation::PUSHNOTIFICATION}, out), 0u);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(FlagDispatchTableTest, Handled) {
+  EXPECT_EQ(g_table.handled(), LogLocation::LOGFILE | LogLocation::MQTT | LogLocation::BROWSER);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include <gobeyond/utility/format.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace {
+  template <typename TFormat, typename... TArgs>
+  std::string compiled(TFormat fmt, const TArgs&... args) {
+    char buffer[256];
+    gobeyond::utility::format_to(buffer, sizeof(buffer), fmt, args...);
+    return buffer;
+  }
+
+  template <typename... TArgs>
+  std::string reference(const char* fmt, TArgs... args) {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), fmt, args...);
+    return buffer;
+  }
+}
+
+#define EXPECT_FORMAT(literal, ...) \
+  EXPECT_EQ(compiled(GBE_FMT(literal), __VA_ARGS__), reference(literal, __VA_ARGS__))
+
+TEST(FormatTest, Literal) {
+  EXPECT_EQ(compiled(GBE_FMT("hello world")), "hello world");
+  EXPECT_EQ(compiled(GBE_FMT("100%% sure")), "100% sure");
+  EXPECT_EQ(compiled(GBE_FMT("")), "");
+}
+
+TEST(FormatTest, Integers) {
+  EXPECT_FORMAT("%d", 42);
+  EXPECT_FORMAT("%d", -42);
+  EXPECT_FORMAT("%i|%5d|%-5d|%05d", 7, -7, 7, -7);
+  EXPECT_FORMAT("%+d % d %.3d", 5, 5, 5);
+  EXPECT_FORMAT("%u", 4294967295u);
+  EXPECT_FORMAT("%lld", static_cast<long long>(INT64_MIN));
+  EXPECT_FORMAT("%llu", static_cast<unsigned long long>(UINT64_MAX));
+  EXPECT_FORMAT("%x %X %#x %#X %08x", 0xbeefu, 0xbeefu, 0xbeefu, 0xbeefu, 0xbeefu);
+  EXPECT_FORMAT("%o %#o", 8u, 8u);
+  EXPECT_FORMAT("%x", -1);
+  EXPECT_FORMAT("%.0d|%.0x", 0, 0u);
+}
+
+TEST(FormatTest, Floats) {
+  EXPECT_FORMAT("%f", 3.14159);
+  EXPECT_FORMAT("%.3f", -2.5);
+  EXPECT_FORMAT("%10.2f|%-10.2f|%010.2f", 1.005, 1.005, -1.005);
+  EXPECT_FORMAT("%e %E", 12345.678, 0.00012);
+  EXPECT_FORMAT("%g %G %g", 0.0001, 1e20, 100.0);
+  EXPECT_FORMAT("%+.1f", 2.0f);
+  EXPECT_FORMAT("%f %f", 1.0 / 0.0, -1.0 / 0.0);
+}
+
+TEST(FormatTest, LongFloats) {
+  // More digits than the stack buffer of the formatter holds
+  char buffer[2048];
+  char expected[2048];
+
+  gobeyond::utility::format_to(buffer, sizeof(buffer), GBE_FMT("%.300f|%-700.300f|%+0700.300f"), 1e300, 1e300, -1e300);
+  std::snprintf(expected, sizeof(expected), "%.300f|%-700.300f|%+0700.300f", 1e300, 1e300, -1e300);
+  EXPECT_EQ(std::string(buffer), std::string(expected));
+
+  gobeyond::utility::format_to(buffer, sizeof(buffer), GBE_FMT("%.600e"), 1.5);
+  std::snprintf(expected, sizeof(expected), "%.600e", 1.5);
+  EXPECT_EQ(std::string(buffer), std::string(expected));
+
+  // Truncated, but still the digits of the value
+  const auto truncated = gobeyond::utility::StringBuffer<64>::format(GBE_FMT("[%.300f]"), 1e300);
+  std::snprintf(expected, sizeof(expected), "[%.300f]", 1e300);
+  EXPECT_EQ(truncated.view(), std::string_view(expected).substr(0, truncated.size()));
+  EXPECT_EQ(truncated.view().find("inf"), std::string_view::npos);
+}
+
+TEST(FormatTest, Strings) {
+  std::string str = "std::string";
+  std::string_view view = "view";
+
+  EXPECT_FORMAT("%s", "abc");
+  EXPECT_FORMAT("[%10s][%-10s][%.2s]", "abc", "abc", "abc");
+  EXPECT_FORMAT("%c%c%c", 'a', 'b', 'c');
+  EXPECT_EQ(compiled(GBE_FMT("%s/%s"), str, view), "std::string/view");
+  EXPECT_EQ(compiled(GBE_FMT("%s"), static_cast<const char*>(nullptr)), "(null)");
+}
+
+TEST(FormatTest, StringPrecisionBoundsTheRead) {
+  // Like printf, a precision allows a pointer to characters without a terminator
+  const char unterminated[4] = {'a', 'b', 'c', 'd'};
+  const char* text = unterminated;
+
+  EXPECT_EQ(compiled(GBE_FMT("[%.4s]"), text), "[abcd]");
+  EXPECT_EQ(compiled(GBE_FMT("[%6.3s]"), text), "[   abc]");
+  EXPECT_EQ(compiled(GBE_FMT("[%.0s]"), text), "[]");
+  EXPECT_FORMAT("[%.8s][%-6.8s]", "ab", "ab");
+}
+
+TEST(FormatTest, Pointer) {
+  int value = 0;
+  EXPECT_FORMAT("%p", static_cast<void*>(&value));
+  EXPECT_EQ(compiled(GBE_FMT("%p"), nullptr), "(nil)");
+}
+
+TEST(FormatTest, Binary) {
+  EXPECT_EQ(compiled(GBE_FMT("%b"), 5u), "101");
+  EXPECT_EQ(compiled(GBE_FMT("%#010b"), 5u), "0b00000101");
+}
+
+TEST(FormatTest, EnumAndBool) {
+  enum class Level : std::uint8_t { Info = 3 };
+
+  EXPECT_EQ(compiled(GBE_FMT("%d %d"), Level::Info, true), "3 1");
+}
+
+TEST(FormatTest, Truncation) {
+  char buffer[8];
+  std::size_t length = gobeyond::utility::format_to(buffer, sizeof(buffer), GBE_FMT("%s-%d"), "abcdef", 12345);
+
+  EXPECT_EQ(length, 12u);
+  EXPECT_STREQ(buffer, "abcdef-");
+}
+
+TEST(FormatTest, StringBufferFormat) {
+  using buffer_type = gobeyond::utility::StringBuffer<32>;
+
+  buffer_type buffer = buffer_type::format(GBE_FMT("%s: %d, %.2f"), "value", 17, 0.5);
+  EXPECT_STREQ(static_cast<const char*>(buffer), "value: 17, 0.50");
+
+  buffer_type truncated = buffer_type::format(GBE_FMT("%s"), "0123456789012345678901234567890123456789");
+  EXPECT_STREQ(static_cast<const char*>(truncated), "0123456789012345678901234567890");
+}
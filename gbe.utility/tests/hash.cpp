@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <gobeyond/utility/hash.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+using gobeyond::utility::hash_bytes;
+using gobeyond::utility::hash_string;
+using gobeyond::utility::str_equals;
+
+TEST(HashTest, Deterministic) {
+  const std::string text = "sensor 17 temperature above threshold";
+
+  EXPECT_EQ(hash_string(text), hash_string(std::string(text)));
+  EXPECT_EQ(hash_string(text, 42), hash_bytes(text.data(), text.size(), 42));
+  EXPECT_NE(hash_string(text), hash_string(text, 42));
+}
+
+TEST(HashTest, AllLengthsDistinct) {
+  // Prefixes of every length cover all code paths, including the three lane loop
+  const std::string text(300, 'a');
+  std::unordered_set<std::uint64_t> values;
+
+  for ( std::size_t size = 0; size <= text.size(); ++size ) {
+    values.insert(hash_bytes(text.data(), size));
+  }
+
+  EXPECT_EQ(values.size(), text.size() + 1);
+}
+
+TEST(HashTest, EveryBitChangesTheHash) {
+  for ( std::size_t size : {1u, 3u, 4u, 7u, 8u, 16u, 17u, 48u, 49u, 100u} ) {
+    std::string text(size, 'x');
+    const std::uint64_t original = hash_string(text);
+
+    for ( std::size_t i = 0; i < size * 8; ++i ) {
+      text[i / 8] = static_cast<char>(text[i / 8] ^ (1 << (i % 8)));
+      const std::uint64_t flipped = hash_string(text);
+      text[i / 8] = static_cast<char>(text[i / 8] ^ (1 << (i % 8)));
+
+      ASSERT_NE(flipped, original) << "size " << size << " bit " << i;
+
+      // About half of the output bits should change
+      const int changed = __builtin_popcountll(flipped ^ original);
+      EXPECT_GT(changed, 12) << "size " << size << " bit " << i;
+      EXPECT_LT(changed, 52) << "size " << size << " bit " << i;
+    }
+  }
+}
+
+TEST(HashTest, StringEquals) {
+  const std::string text = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+  for ( std::size_t size = 0; size <= text.size(); ++size ) {
+    std::string a = text.substr(0, size);
+    std::string b = a;
+
+    EXPECT_TRUE(str_equals(a, b));
+    EXPECT_FALSE(str_equals(a, text.substr(0, size) + "#"));
+
+    for ( std::size_t i = 0; i < size; ++i ) {
+      b[i] = '#';
+      EXPECT_FALSE(str_equals(a, b)) << "size " << size << " position " << i;
+      b[i] = a[i];
+    }
+  }
+}
+
+TEST(HashTest, StringBufferHash) {
+  gobeyond::utility::StringBuffer<64> a{"alarm"};
+  gobeyond::utility::StringBuffer<128> b{"alarm"};
+
+  EXPECT_EQ(a.hash(), hash_string("alarm"));
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_EQ(std::hash<gobeyond::utility::StringBuffer<64>>()(a), static_cast<std::size_t>(hash_string("alarm")));
+
+  std::unordered_set<gobeyond::utility::StringBuffer<64>> set;
+  set.insert(a);
+  set.insert(gobeyond::utility::StringBuffer<64>{"alarm"});
+  set.insert(gobeyond::utility::StringBuffer<64>{"warning"});
+
+  EXPECT_EQ(set.size(), 2u);
+}
+
+TEST(HashTest, StringBufferEquality) {
+  gobeyond::utility::StringBuffer<64> a{"alarm"};
+  gobeyond::utility::StringBuffer<128> b{"alarm"};
+  gobeyond::utility::StringBuffer<64> c{"alarms"};
+
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a != b);
+  EXPECT_TRUE(a != c);
+  EXPECT_TRUE(a == "alarm");
+  EXPECT_TRUE(a != "alarm!");
+  EXPECT_TRUE(a.equals("alarm"));
+}
+
+TEST(HashTest, TransparentFunctionObjects) {
+  gobeyond::utility::StringHash hash;
+  gobeyond::utility::StringEqual equal;
+  gobeyond::utility::StringBuffer<64> buffer{"key"};
+
+  EXPECT_EQ(hash(buffer), hash("key"));
+  EXPECT_EQ(hash(std::string("key")), hash("key"));
+  EXPECT_TRUE(equal(buffer, "key"));
+  EXPECT_TRUE(equal(std::string("key"), buffer));
+  EXPECT_FALSE(equal(buffer, "keys"));
+
+  std::unordered_map<std::string, int, gobeyond::utility::StringHash, gobeyond::utility::StringEqual> map;
+  map["a"] = 1;
+  map["b"] = 2;
+
+  EXPECT_EQ(map.at("b"), 2);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <gobeyond/utility/instrumentation.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace detail = gobeyond::utility::instrumentation_detail;
+
+TEST(InstrumentationTest, DisabledByDefault) {
+  static_assert(!gobeyond::utility::instrumentation_enabled);
+
+  auto buffer = gobeyond::utility::StringBuffer<8>::format(GBE_FMT("%s"), "truncated text");
+  gobeyond::utility::instrument_count(gobeyond::utility::Counter::QueuePushes, 5);
+  gobeyond::utility::instrument_record(gobeyond::utility::Histogram::FormatLatency, 100);
+
+  const auto snapshot = gobeyond::utility::instrumentation_snapshot();
+
+  EXPECT_TRUE(buffer.truncated());
+  EXPECT_EQ(snapshot.counter(gobeyond::utility::Counter::FormatCalls), 0u);
+  EXPECT_EQ(snapshot.counter(gobeyond::utility::Counter::QueuePushes), 0u);
+  EXPECT_EQ(snapshot.histogram(gobeyond::utility::Histogram::FormatLatency).count, 0u);
+}
+
+TEST(InstrumentationTest, Buckets) {
+  for ( std::uint64_t value = 0; value < 16; ++value ) {
+    EXPECT_EQ(detail::bucketOf(value), value);
+  }
+
+  EXPECT_EQ(detail::bucketOf(16), 16u);
+  EXPECT_EQ(detail::bucketOf(31), 31u);
+  EXPECT_EQ(detail::bucketOf(32), 32u);
+  EXPECT_EQ(detail::bucketOf(33), 32u);
+  EXPECT_EQ(detail::bucketOf(UINT64_MAX), detail::bucket_count - 1);
+
+  for ( std::size_t bucket = 0; bucket + 1 < detail::bucket_count; ++bucket ) {
+    const std::uint64_t lower = detail::bucketLowerBound(bucket);
+    const std::uint64_t upper = detail::bucketLowerBound(bucket + 1) - 1;
+
+    ASSERT_EQ(detail::bucketOf(lower), bucket);
+    ASSERT_EQ(detail::bucketOf(upper), bucket);
+    // The width of a bucket stays within 1/16 of its values
+    ASSERT_LE((upper - lower) * 16, lower);
+  }
+}
+
+TEST(InstrumentationTest, Quantile) {
+  gobeyond::utility::HistogramSnapshot histogram;
+
+  EXPECT_EQ(histogram.quantile(0.5), 0u);
+  EXPECT_EQ(histogram.mean(), 0.0);
+
+  for ( std::uint64_t value = 1; value <= 1000; ++value ) {
+    ++histogram.buckets[detail::bucketOf(value)];
+    ++histogram.count;
+    histogram.sum += value;
+    histogram.max = value;
+  }
+
+  EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+  EXPECT_EQ(histogram.quantile(0.0), 1u);
+  EXPECT_EQ(histogram.quantile(1.0), 1000u);
+  EXPECT_GE(histogram.quantile(0.5), 500u);
+  EXPECT_LE(histogram.quantile(0.5), 500u + 500u / 16);
+  EXPECT_GE(histogram.quantile(0.99), 990u);
+  EXPECT_LE(histogram.quantile(0.99), 1000u);
+}
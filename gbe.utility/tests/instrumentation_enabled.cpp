@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gobeyond/utility/instrumentation.hpp>
+#include <gobeyond/utility/message_queue.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+#include <gobeyond/utility/string_buffer_pool.hpp>
+
+static_assert(gobeyond::utility::instrumentation_enabled, "built without GBE_UTILITY_INSTRUMENTATION");
+
+namespace {
+  enum class LogLocation : unsigned {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+    ALL = 31
+  };
+
+  using gobeyond::utility::Counter;
+  using gobeyond::utility::Histogram;
+
+  std::uint64_t delta(const gobeyond::utility::InstrumentationSnapshot& before, Counter counter) {
+    return gobeyond::utility::instrumentation_snapshot().counter(counter) - before.counter(counter);
+  }
+}
+
+TEST(InstrumentationEnabledTest, Format) {
+  const auto before = gobeyond::utility::instrumentation_snapshot();
+
+  auto fits = gobeyond::utility::StringBuffer<16>::format(GBE_FMT("%d"), 12345);
+  auto cut = gobeyond::utility::StringBuffer<8>::format(GBE_FMT("%s"), "0123456789");
+  auto printf = gobeyond::utility::StringBuffer<16>::format("%s", "abc");
+  fits.append_format(GBE_FMT("!"));
+
+  const auto after = gobeyond::utility::instrumentation_snapshot();
+
+  EXPECT_EQ(after.counter(Counter::FormatCalls) - before.counter(Counter::FormatCalls), 4u);
+  EXPECT_EQ(after.counter(Counter::FormatBytes) - before.counter(Counter::FormatBytes), 5u + 7u + 3u + 1u);
+  EXPECT_EQ(after.counter(Counter::FormatTruncations) - before.counter(Counter::FormatTruncations), 1u);
+  EXPECT_EQ(after.histogram(Histogram::FormatLatency).count - before.histogram(Histogram::FormatLatency).count, 4u);
+  EXPECT_EQ(after.histogram(Histogram::FormatLength).count - before.histogram(Histogram::FormatLength).count, 4u);
+  EXPECT_GE(after.histogram(Histogram::FormatLength).max, 10u);
+  EXPECT_TRUE(cut.truncated());
+  EXPECT_EQ(printf.view(), "abc");
+}
+
+TEST(InstrumentationEnabledTest, CopyAndMove) {
+  const auto before = gobeyond::utility::instrumentation_snapshot();
+
+  gobeyond::utility::StringBuffer<32> a{"hello"};
+  gobeyond::utility::StringBuffer<32> b{a};
+  gobeyond::utility::StringBuffer<32> c{std::move(a)};
+  b = c;
+
+  EXPECT_EQ(delta(before, Counter::CopyBytes), 12u);
+  EXPECT_EQ(delta(before, Counter::MoveBytes), 6u);
+}
+
+TEST(InstrumentationEnabledTest, Queue) {
+  const auto before = gobeyond::utility::instrumentation_snapshot();
+  gobeyond::utility::MessageQueue<LogLocation, 32> queue{2};
+  const gobeyond::utility::BitMask<LogLocation> route{LogLocation::DEBUG};
+
+  EXPECT_TRUE(queue.push(route, "a"));
+  EXPECT_TRUE(queue.push(route, "b"));
+  EXPECT_FALSE(queue.push(route, "c"));
+  EXPECT_EQ(queue.consume([](const auto&) {}), 2u);
+
+  const auto after = gobeyond::utility::instrumentation_snapshot();
+
+  EXPECT_EQ(after.counter(Counter::QueuePushes) - before.counter(Counter::QueuePushes), 2u);
+  EXPECT_EQ(after.counter(Counter::QueueDrops) - before.counter(Counter::QueueDrops), 1u);
+  EXPECT_EQ(after.counter(Counter::QueueConsumed) - before.counter(Counter::QueueConsumed), 2u);
+  EXPECT_EQ(after.histogram(Histogram::QueuePushLatency).count - before.histogram(Histogram::QueuePushLatency).count, 3u);
+}
+
+TEST(InstrumentationEnabledTest, Pool) {
+  const auto before = gobeyond::utility::instrumentation_snapshot();
+  gobeyond::utility::StringBufferPool<64> pool{1};
+
+  {
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+
+    EXPECT_TRUE(first);
+    EXPECT_FALSE(second);
+  }
+
+  EXPECT_EQ(delta(before, Counter::PoolAcquires), 1u);
+  EXPECT_EQ(delta(before, Counter::PoolExhausted), 1u);
+}
+
+TEST(InstrumentationEnabledTest, ShardsMergeWhileWriting) {
+  constexpr int thread_count = 4;
+  constexpr int per_thread = 10000;
+  const auto before = gobeyond::utility::instrumentation_snapshot();
+  std::vector<std::thread> threads;
+
+  for ( int t = 0; t < thread_count; ++t ) {
+    threads.emplace_back([]() {
+      for ( int i = 0; i < per_thread; ++i ) {
+        gobeyond::utility::instrument_count(Counter::QueueOverwrites);
+        gobeyond::utility::instrument_record(Histogram::QueuePushLatency, static_cast<std::uint64_t>(i));
+      }
+    });
+  }
+
+  // Snapshots while the writers run never go backwards
+  std::uint64_t last = 0;
+
+  for ( int i = 0; i < 100; ++i ) {
+    const std::uint64_t current = delta(before, Counter::QueueOverwrites);
+    EXPECT_GE(current, last);
+    last = current;
+  }
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  const auto after = gobeyond::utility::instrumentation_snapshot();
+
+  EXPECT_EQ(after.counter(Counter::QueueOverwrites) - before.counter(Counter::QueueOverwrites), static_cast<std::uint64_t>(thread_count * per_thread));
+  EXPECT_EQ(after.histogram(Histogram::QueuePushLatency).count - before.histogram(Histogram::QueuePushLatency).count, static_cast<std::uint64_t>(thread_count * per_thread));
+  EXPECT_GE(after.histogram(Histogram::QueuePushLatency).max, static_cast<std::uint64_t>(per_thread - 1));
+}
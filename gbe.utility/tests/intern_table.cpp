@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gobeyond/utility/intern_table.hpp>
+
+using gobeyond::utility::InternTable;
+
+TEST(InternTableTest, Intern) {
+  InternTable table{16, 256};
+
+  const std::uint32_t alarm = table.intern("alarm");
+  const std::uint32_t warning = table.intern("warning");
+
+  EXPECT_EQ(alarm, 0u);
+  EXPECT_EQ(warning, 1u);
+  EXPECT_EQ(table.intern("alarm"), alarm);
+  EXPECT_EQ(table.intern(std::string("warning")), warning);
+  EXPECT_EQ(table.view(alarm), "alarm");
+  EXPECT_EQ(table.view(warning), "warning");
+  EXPECT_EQ(table.size(), 2u);
+  EXPECT_EQ(table.text_size(), 12u);
+}
+
+TEST(InternTableTest, Find) {
+  InternTable table{16, 256};
+
+  EXPECT_EQ(table.find("alarm"), InternTable::invalid_id);
+
+  const std::uint32_t id = table.intern("alarm");
+
+  EXPECT_EQ(table.find("alarm"), id);
+  EXPECT_EQ(table.find("alar"), InternTable::invalid_id);
+  EXPECT_EQ(table.view(InternTable::invalid_id), "");
+}
+
+TEST(InternTableTest, EmptyString) {
+  InternTable table{4, 16};
+
+  const std::uint32_t id = table.intern("");
+
+  EXPECT_NE(id, InternTable::invalid_id);
+  EXPECT_EQ(table.intern(""), id);
+  EXPECT_EQ(table.view(id), "");
+}
+
+TEST(InternTableTest, Full) {
+  InternTable table{2, 256};
+
+  EXPECT_EQ(table.intern("a"), 0u);
+  EXPECT_EQ(table.intern("b"), 1u);
+  EXPECT_EQ(table.intern("c"), InternTable::invalid_id);
+  EXPECT_EQ(table.intern("a"), 0u);
+  EXPECT_EQ(table.find("c"), InternTable::invalid_id);
+  EXPECT_EQ(table.text_size(), 2u);
+}
+
+TEST(InternTableTest, RejectedKeepSlotsFree) {
+  InternTable table{16, 8};
+
+  EXPECT_EQ(table.intern("12345"), 0u);
+
+  // Far more rejected strings than slots, none of them may occupy a slot
+  for ( int i = 0; i < 1000; ++i ) {
+    EXPECT_EQ(table.intern("too long " + std::to_string(i)), InternTable::invalid_id);
+  }
+
+  EXPECT_EQ(table.find("too long 0"), InternTable::invalid_id);
+  EXPECT_EQ(table.text_size(), 5u);
+
+  // Lookups and inserts still end at a free slot
+  EXPECT_EQ(table.intern("678"), 1u);
+  EXPECT_EQ(table.find("678"), 1u);
+}
+
+TEST(InternTableTest, TextFull) {
+  InternTable table{16, 8};
+
+  EXPECT_EQ(table.intern("12345"), 0u);
+  EXPECT_EQ(table.intern("123456"), InternTable::invalid_id);
+  EXPECT_EQ(table.intern("678"), 1u);
+  EXPECT_EQ(table.text_size(), 8u);
+}
+
+TEST(InternTableTest, Many) {
+  InternTable table{1000, 16000};
+
+  for ( int i = 0; i < 1000; ++i ) {
+    EXPECT_EQ(table.intern("message " + std::to_string(i)), static_cast<std::uint32_t>(i));
+  }
+
+  for ( int i = 0; i < 1000; ++i ) {
+    EXPECT_EQ(table.find("message " + std::to_string(i)), static_cast<std::uint32_t>(i));
+    EXPECT_EQ(table.view(static_cast<std::uint32_t>(i)), "message " + std::to_string(i));
+  }
+}
+
+TEST(InternTableTest, Concurrent) {
+  constexpr int thread_count = 4;
+  constexpr int string_count = 500;
+
+  InternTable table{string_count, string_count * 16};
+  std::vector<std::vector<std::uint32_t>> ids(thread_count, std::vector<std::uint32_t>(string_count));
+  std::vector<std::thread> threads;
+
+  for ( int t = 0; t < thread_count; ++t ) {
+    threads.emplace_back([&, t] {
+      // Every thread interns all strings, starting at a different position
+      for ( int i = 0; i < string_count; ++i ) {
+        const int n = (i + t * string_count / thread_count) % string_count;
+        ids[t][n] = table.intern("message " + std::to_string(n));
+      }
+    });
+  }
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  EXPECT_EQ(table.size(), static_cast<std::size_t>(string_count));
+
+  for ( int i = 0; i < string_count; ++i ) {
+    ASSERT_NE(ids[0][i], InternTable::invalid_id);
+    EXPECT_EQ(table.view(ids[0][i]), "message " + std::to_string(i));
+
+    for ( int t = 1; t < thread_count; ++t ) {
+      EXPECT_EQ(ids[t][i], ids[0][i]);
+    }
+  }
+}
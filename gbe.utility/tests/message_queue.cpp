@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gobeyond/utility/message_queue.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using gobeyond::utility::BackPressure;
+  using route_type = gobeyond::utility::BitMask<LogLocation>;
+
+  template <BackPressure TPolicy>
+  using queue_type = gobeyond::utility::MessageQueue<LogLocation, 64, TPolicy>;
+
+  /// Produces "<producer> <sequence>" messages from several threads and checks the per-producer order on the consumer side
+  template <BackPressure TPolicy>
+  void runProducers(std::size_t capacity, int producers, int messages) {
+    queue_type<TPolicy> queue{capacity};
+    std::atomic<int> running{producers};
+    std::vector<std::thread> threads;
+
+    for ( int p = 0; p < producers; ++p ) {
+      threads.emplace_back([&queue, &running, p, messages]() {
+        for ( int i = 0; i < messages; ++i ) {
+          EXPECT_TRUE(queue.emplace(route_type{LogLocation::LOGFILE}, [p, i](auto& buffer) { buffer << p << ' ' << i; }));
+        }
+
+        running.fetch_sub(1);
+      });
+    }
+
+    std::vector<int> next(static_cast<std::size_t>(producers), 0);
+    int received = 0;
+
+    while ( running.load() > 0 || !queue.empty() ) {
+      received += static_cast<int>(queue.consume([&next](const auto& message) {
+        int producer = 0;
+        int sequence = 0;
+
+        ASSERT_EQ(std::sscanf(message.text.c_str(), "%d %d", &producer, &sequence), 2);
+        EXPECT_EQ(message.route, LogLocation::LOGFILE);
+        EXPECT_EQ(next[static_cast<std::size_t>(producer)], sequence);
+        next[static_cast<std::size_t>(producer)] = sequence + 1;
+      }));
+    }
+
+    for ( std::thread& thread : threads ) {
+      thread.join();
+    }
+
+    received += static_cast<int>(queue.consume([](const auto&) {}));
+    EXPECT_EQ(received, producers * messages);
+  }
+}
+
+TEST(MessageQueueTest, PushConsume) {
+  queue_type<BackPressure::Drop> queue{4};
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.push(route_type{LogLocation::DEBUG | LogLocation::MQTT}, "first"));
+  EXPECT_TRUE(queue.push(route_type{LogLocation::BROWSER}, "second"));
+  EXPECT_FALSE(queue.empty());
+
+  std::vector<std::string> texts;
+  std::vector<route_type> routes;
+
+  EXPECT_EQ(queue.consume([&](const auto& message) {
+    texts.emplace_back(message.text.view());
+    routes.push_back(message.route);
+  }), 2u);
+
+  ASSERT_EQ(texts.size(), 2u);
+  EXPECT_EQ(texts[0], "first");
+  EXPECT_EQ(texts[1], "second");
+  EXPECT_EQ(routes[0], LogLocation::DEBUG | LogLocation::MQTT);
+  EXPECT_EQ(routes[1], LogLocation::BROWSER);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MessageQueueTest, CapacityRoundsUp) {
+  EXPECT_EQ(queue_type<BackPressure::Drop>{5}.capacity(), 8u);
+  EXPECT_EQ(queue_type<BackPressure::Drop>{8}.capacity(), 8u);
+  EXPECT_EQ(queue_type<BackPressure::Drop>{0}.capacity(), 2u);
+}
+
+TEST(MessageQueueTest, Truncates) {
+  queue_type<BackPressure::Drop> queue{2};
+
+  queue.push(route_type{LogLocation::DEBUG}, std::string(100, 'x'));
+  queue.consume([](const auto& message) {
+    EXPECT_EQ(message.text.size(), 63u);
+    EXPECT_TRUE(message.text.truncated());
+  });
+}
+
+TEST(MessageQueueTest, Drop) {
+  queue_type<BackPressure::Drop> queue{4};
+
+  for ( int i = 0; i < 4; ++i ) {
+    EXPECT_TRUE(queue.emplace(route_type{LogLocation::DEBUG}, [i](auto& buffer) { buffer << i; }));
+  }
+
+  EXPECT_FALSE(queue.push(route_type{LogLocation::DEBUG}, "dropped"));
+  EXPECT_EQ(queue.statistics().dropped, 1u);
+  EXPECT_EQ(queue.statistics().size, 4u);
+
+  std::string received;
+  queue.consume([&received](const auto& message) { received += message.text.view(); });
+  EXPECT_EQ(received, "0123");
+
+  EXPECT_TRUE(queue.push(route_type{LogLocation::DEBUG}, "again"));
+}
+
+TEST(MessageQueueTest, OverwriteOldest) {
+  queue_type<BackPressure::OverwriteOldest> queue{4};
+
+  for ( int i = 0; i < 6; ++i ) {
+    EXPECT_TRUE(queue.emplace(route_type{LogLocation::DEBUG}, [i](auto& buffer) { buffer << i; }));
+  }
+
+  EXPECT_EQ(queue.statistics().overwritten, 2u);
+
+  std::string received;
+  queue.consume([&received](const auto& message) { received += message.text.view(); });
+  EXPECT_EQ(received, "2345");
+}
+
+TEST(MessageQueueTest, OverwriteWaitsForHeldBatch) {
+  queue_type<BackPressure::OverwriteOldest> queue{8};
+
+  for ( int i = 0; i < 8; ++i ) {
+    EXPECT_TRUE(queue.emplace(route_type{LogLocation::DEBUG}, [i](auto& buffer) { buffer << i; }));
+  }
+
+  std::string received;
+  std::thread producer;
+
+  // The producer has to wait for the held slots instead of discarding the published messages behind them
+  EXPECT_EQ(queue.consume_batch([&](const auto* const* messages, std::size_t count) {
+    producer = std::thread([&queue]() { EXPECT_TRUE(queue.push(route_type{LogLocation::DEBUG}, "8")); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(queue.statistics().overwritten, 0u);
+
+    for ( std::size_t i = 0; i < count; ++i ) {
+      received += messages[i]->text.view();
+    }
+  }, 2), 2u);
+
+  producer.join();
+  queue.consume([&received](const auto& message) { received += message.text.view(); });
+
+  EXPECT_EQ(queue.statistics().overwritten, 0u);
+  EXPECT_EQ(received, "012345678");
+}
+
+TEST(MessageQueueTest, ThrowingWriterSkipsItsSlot) {
+  queue_type<BackPressure::Drop> queue{4};
+
+  EXPECT_TRUE(queue.push(route_type{LogLocation::DEBUG}, "0"));
+  EXPECT_THROW(queue.emplace(route_type{LogLocation::DEBUG}, [](auto& buffer) {
+    buffer << "partial";
+    throw std::runtime_error("writer failed");
+  }), std::runtime_error);
+  EXPECT_TRUE(queue.push(route_type{LogLocation::DEBUG}, "1"));
+
+  std::string received;
+  EXPECT_EQ(queue.consume([&received](const auto& message) { received += message.text.view(); }), 2u);
+  EXPECT_EQ(received, "01");
+  EXPECT_TRUE(queue.empty());
+
+  // The skipped slot is reused once the ring wrapped around
+  for ( int i = 0; i < 4; ++i ) {
+    EXPECT_TRUE(queue.emplace(route_type{LogLocation::DEBUG}, [i](auto& buffer) { buffer << i; }));
+  }
+
+  received.clear();
+  EXPECT_EQ(queue.consume([&received](const auto& message) { received += message.text.view(); }), 4u);
+  EXPECT_EQ(received, "0123");
+}
+
+TEST(MessageQueueTest, ConsumeBatch) {
+  queue_type<BackPressure::Drop> queue{256};
+
+  for ( int i = 0; i < 100; ++i ) {
+    queue.emplace(route_type{LogLocation::DEBUG}, [i](auto& buffer) { buffer << i; });
+  }
+
+  std::vector<std::size_t> batches;
+  int expected = 0;
+
+  EXPECT_EQ(queue.consume_batch([&](const auto* const* messages, std::size_t count) {
+    batches.push_back(count);
+
+    for ( std::size_t i = 0; i < count; ++i ) {
+      EXPECT_EQ(messages[i]->text.view(), std::to_string(expected++));
+    }
+  }), 100u);
+
+  ASSERT_EQ(batches.size(), 2u);
+  EXPECT_EQ(batches[0], 64u);
+  EXPECT_EQ(batches[1], 36u);
+}
+
+TEST(MessageQueueTest, ConsumeMax) {
+  queue_type<BackPressure::Drop> queue{8};
+
+  for ( int i = 0; i < 5; ++i ) {
+    queue.push(route_type{LogLocation::DEBUG}, "x");
+  }
+
+  EXPECT_EQ(queue.consume([](const auto&) {}, 3), 3u);
+  EXPECT_EQ(queue.consume([](const auto&) {}), 2u);
+}
+
+TEST(MessageQueueTest, WrapAround) {
+  queue_type<BackPressure::Drop> queue{4};
+
+  for ( int round = 0; round < 10; ++round ) {
+    for ( int i = 0; i < 3; ++i ) {
+      EXPECT_TRUE(queue.emplace(route_type{LogLocation::DEBUG}, [round, i](auto& buffer) { buffer << round * 3 + i; }));
+    }
+
+    int expected = round * 3;
+    queue.consume([&expected](const auto& message) { EXPECT_EQ(message.text.view(), std::to_string(expected++)); });
+  }
+}
+
+TEST(MessageQueueTest, SlotsArePadded) {
+  queue_type<BackPressure::Drop> queue{4};
+
+  queue.push(route_type{LogLocation::DEBUG}, "a");
+  queue.push(route_type{LogLocation::DEBUG}, "b");
+
+  std::vector<std::uintptr_t> addresses;
+  queue.consume([&addresses](const auto& message) { addresses.push_back(reinterpret_cast<std::uintptr_t>(&message)); });
+
+  ASSERT_EQ(addresses.size(), 2u);
+  EXPECT_GE(addresses[1] - addresses[0], gobeyond::utility::cache_line_size);
+}
+
+TEST(MessageQueueTest, MultipleProducersSpin) {
+  runProducers<BackPressure::Spin>(64, 4, 2000);
+}
+
+TEST(MessageQueueTest, MultipleProducersBlock) {
+  runProducers<BackPressure::Block>(16, 4, 5000);
+}
+
+TEST(MessageQueueTest, MultipleProducersOverwrite) {
+  queue_type<BackPressure::OverwriteOldest> queue{8};
+  std::atomic<bool> running{true};
+  std::vector<std::thread> threads;
+
+  for ( int p = 0; p < 4; ++p ) {
+    threads.emplace_back([&queue, p]() {
+      for ( int i = 0; i < 5000; ++i ) {
+        EXPECT_TRUE(queue.emplace(route_type{LogLocation::MQTT}, [p, i](auto& buffer) { buffer << p << ' ' << i; }));
+      }
+    });
+  }
+
+  std::vector<int> last(4, -1);
+  std::uint64_t received = 0;
+
+  std::thread consumer([&]() {
+    while ( running.load() || !queue.empty() ) {
+      received += queue.consume([&last](const auto& message) {
+        int producer = 0;
+        int sequence = 0;
+
+        ASSERT_EQ(std::sscanf(message.text.c_str(), "%d %d", &producer, &sequence), 2);
+        EXPECT_GT(sequence, last[static_cast<std::size_t>(producer)]);
+        last[static_cast<std::size_t>(producer)] = sequence;
+      });
+    }
+  });
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  running.store(false);
+  consumer.join();
+
+  EXPECT_EQ(received + queue.statistics().overwritten, 20000u);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <charconv>
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <gobeyond/utility/numeric.hpp>
+
+namespace {
+  template <typename T>
+  std::string decimal(T value) {
+    char buffer[32];
+    return std::string(buffer, gobeyond::utility::write_decimal(buffer, value));
+  }
+
+  template <typename T>
+  std::string reference(T value) {
+    char buffer[32];
+    return std::string(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+  }
+
+  std::string fixed(double value, int precision) {
+    char buffer[512];
+    char* last = gobeyond::utility::write_fixed(buffer, buffer + sizeof(buffer), value, precision);
+    return last == nullptr ? std::string("<null>") : std::string(buffer, last);
+  }
+
+  std::string printfFixed(double value, int precision) {
+    char buffer[512];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    return buffer;
+  }
+}
+
+TEST(NumericTest, DecimalDigits) {
+  EXPECT_EQ(gobeyond::utility::decimal_digits(0), 1);
+  EXPECT_EQ(gobeyond::utility::decimal_digits(9), 1);
+  EXPECT_EQ(gobeyond::utility::decimal_digits(10), 2);
+  EXPECT_EQ(gobeyond::utility::decimal_digits(UINT64_MAX), 20);
+
+  std::uint64_t power = 1;
+  for ( int digits = 1; digits < 20; ++digits ) {
+    EXPECT_EQ(gobeyond::utility::decimal_digits(power), digits);
+    EXPECT_EQ(gobeyond::utility::decimal_digits(power * 10 - 1), digits);
+    power *= 10;
+  }
+}
+
+TEST(NumericTest, Decimal) {
+  EXPECT_EQ(decimal(0), "0");
+  EXPECT_EQ(decimal(-1), "-1");
+  EXPECT_EQ(decimal(std::numeric_limits<std::int32_t>::min()), reference(std::numeric_limits<std::int32_t>::min()));
+  EXPECT_EQ(decimal(std::numeric_limits<std::int64_t>::min()), reference(std::numeric_limits<std::int64_t>::min()));
+  EXPECT_EQ(decimal(std::numeric_limits<std::uint64_t>::max()), reference(std::numeric_limits<std::uint64_t>::max()));
+  EXPECT_EQ(decimal(static_cast<std::int8_t>(-128)), "-128");
+
+  std::mt19937_64 random(4711);
+  for ( int i = 0; i < 10000; ++i ) {
+    const std::uint64_t value = random() >> (random() % 64);
+    EXPECT_EQ(decimal(value), reference(value));
+    EXPECT_EQ(decimal(static_cast<std::int64_t>(value)), reference(static_cast<std::int64_t>(value)));
+    EXPECT_EQ(decimal(static_cast<std::uint32_t>(value)), reference(static_cast<std::uint32_t>(value)));
+    EXPECT_EQ(gobeyond::utility::decimal_length(static_cast<std::int64_t>(value)), reference(static_cast<std::int64_t>(value)).size());
+  }
+}
+
+TEST(NumericTest, PowerOfTwoBases) {
+  char buffer[80];
+
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_hex(buffer, 0)), "0");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_hex(buffer, 0xdeadbeef)), "deadbeef");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_hex(buffer, 0xdeadbeef, true)), "DEADBEEF");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_hex(buffer, 0xab, false, 8)), "000000ab");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_hex(buffer, UINT64_MAX)), "ffffffffffffffff");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_octal(buffer, 8)), "10");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_octal(buffer, UINT64_MAX)), "1777777777777777777777");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_binary(buffer, 5)), "101");
+  EXPECT_EQ(std::string(buffer, gobeyond::utility::write_binary(buffer, 5, 8)), "00000101");
+}
+
+TEST(NumericTest, Fixed) {
+  EXPECT_EQ(fixed(0.0, 2), "0.00");
+  EXPECT_EQ(fixed(-0.0, 2), "-0.00");
+  EXPECT_EQ(fixed(-0.001, 2), "-0.00");
+  EXPECT_EQ(fixed(1.005, 2), printfFixed(1.005, 2));
+  EXPECT_EQ(fixed(0.125, 2), printfFixed(0.125, 2));
+  EXPECT_EQ(fixed(2.5, 0), printfFixed(2.5, 0));
+  EXPECT_EQ(fixed(3.5, 0), printfFixed(3.5, 0));
+  EXPECT_EQ(fixed(1e300, 3), printfFixed(1e300, 3));
+  EXPECT_EQ(fixed(123.456, 12), printfFixed(123.456, 12));
+
+  std::mt19937_64 random(815);
+  std::uniform_real_distribution<double> small(-1000.0, 1000.0);
+  std::uniform_int_distribution<int> precision(0, 9);
+
+  for ( int i = 0; i < 100000; ++i ) {
+    const double value = small(random);
+    const int p = precision(random);
+    ASSERT_EQ(fixed(value, p), printfFixed(value, p)) << value << " " << p;
+  }
+
+  for ( int i = 0; i < 10000; ++i ) {
+    // Values on or next to ties
+    const double value = static_cast<double>(random() % 100000) / 8.0;
+    const int p = precision(random) % 3;
+    ASSERT_EQ(fixed(value, p), printfFixed(value, p)) << value << " " << p;
+    ASSERT_EQ(fixed(std::nextafter(value, 0.0), p), printfFixed(std::nextafter(value, 0.0), p));
+  }
+}
+
+TEST(NumericTest, FixedTooSmall) {
+  char buffer[4];
+  EXPECT_EQ(gobeyond::utility::write_fixed(buffer, buffer + sizeof(buffer), 123.25, 2), nullptr);
+}
+
+TEST(NumericTest, Shortest) {
+  char buffer[64];
+  char* last = gobeyond::utility::write_shortest(buffer, buffer + sizeof(buffer), 0.1);
+  EXPECT_EQ(std::string(buffer, last), "0.1");
+
+  std::mt19937_64 random(42);
+  for ( int i = 0; i < 1000; ++i ) {
+    const std::uint64_t bits = random();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+
+    if ( !std::isfinite(value) ) {
+      continue;
+    }
+
+    last = gobeyond::utility::write_shortest(buffer, buffer + sizeof(buffer), value);
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(std::strtod(std::string(buffer, last).c_str(), nullptr), value);
+  }
+}
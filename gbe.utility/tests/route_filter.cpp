@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <gobeyond/utility/route_filter.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using filter_type = gobeyond::utility::RouteFilter<LogLocation>;
+  using route_type = filter_type::route_type;
+}
+
+TEST(RouteFilterTest, Accepts) {
+  filter_type filter{LogLocation::LOGFILE | LogLocation::MQTT};
+
+  EXPECT_TRUE(filter.accepts(LogLocation::MQTT));
+  EXPECT_TRUE(filter.accepts(LogLocation::DEBUG | LogLocation::LOGFILE));
+  EXPECT_FALSE(filter.accepts(LogLocation::DEBUG));
+  EXPECT_FALSE(filter.accepts(LogLocation::NONE));
+
+  filter.set(route_type{LogLocation::DEBUG});
+  EXPECT_TRUE(filter.accepts(LogLocation::DEBUG));
+  EXPECT_FALSE(filter.accepts(LogLocation::MQTT));
+  EXPECT_EQ(filter.active(), LogLocation::DEBUG);
+}
+
+TEST(RouteFilterTest, When) {
+  filter_type filter{LogLocation::LOGFILE | LogLocation::MQTT};
+  route_type seen;
+  int calls = 0;
+
+  EXPECT_TRUE(filter.when(LogLocation::DEBUG | LogLocation::MQTT, [&](const route_type& enabled) {
+    seen = enabled;
+    ++calls;
+  }));
+  EXPECT_EQ(seen, LogLocation::MQTT);
+
+  EXPECT_FALSE(filter.when(route_type{LogLocation::BROWSER}, [&](const route_type&) { ++calls; }));
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(RouteFilterTest, FormatIf) {
+  filter_type filter{route_type{LogLocation::LOGFILE}};
+  gobeyond::utility::StringBuffer<64> buffer;
+  int evaluated = 0;
+
+  EXPECT_TRUE(GBE_FORMAT_IF(filter, LogLocation::LOGFILE, buffer, GBE_FMT("%s=%d"), "value", ++evaluated));
+  EXPECT_EQ(buffer.view(), "value=1");
+
+  // A filtered message neither formats nor evaluates its arguments
+  EXPECT_FALSE(GBE_FORMAT_IF(filter, LogLocation::MQTT, buffer, GBE_FMT("%s=%d"), "value", ++evaluated));
+  EXPECT_EQ(evaluated, 1);
+  EXPECT_EQ(buffer.view(), "value=1");
+
+  EXPECT_TRUE(GBE_FORMAT_IF(filter, LogLocation::ALL, buffer, "%d apples", 3));
+  EXPECT_EQ(buffer.view(), "3 apples");
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <gobeyond/utility/simd_string.hpp>
+#include <gobeyond/utility/string_buffer.hpp>
+
+namespace {
+  using gobeyond::utility::SimdLevel;
+
+  constexpr SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+
+  int sign(int value) {
+    return (value > 0) - (value < 0);
+  }
+
+  std::string lower(std::string_view s) {
+    std::string result(s);
+
+    for ( char& c : result ) {
+      if ( c >= 'A' && c <= 'Z' ) {
+        c = static_cast<char>(c - 'A' + 'a');
+      }
+    }
+
+    return result;
+  }
+
+  /// Random text over a small alphabet, so matches and near matches are frequent
+  std::string randomText(std::mt19937& random, std::size_t size, std::string_view alphabet) {
+    std::string text(size, ' ');
+
+    for ( char& c : text ) {
+      c = alphabet[random() % alphabet.size()];
+    }
+
+    return text;
+  }
+}
+
+TEST(SimdStringTest, LevelIsSupported) {
+  const SimdLevel level = gobeyond::utility::simd_level();
+
+#if defined(__x86_64__)
+  EXPECT_TRUE(SimdLevel::SSE2 == level || SimdLevel::AVX2 == level);
+#elif defined(__aarch64__)
+  EXPECT_EQ(level, SimdLevel::NEON);
+#else
+  EXPECT_EQ(level, SimdLevel::Scalar);
+#endif
+}
+
+TEST(SimdStringTest, FindMatchesScalar) {
+  std::mt19937 random{42};
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::simd_detail::kernelsFor(level);
+
+    for ( int round = 0; round < 2000; ++round ) {
+      const std::string text = randomText(random, random() % 150, "abc\xff");
+      const std::string needle = randomText(random, random() % 6, "abc\xff");
+      const std::size_t offset = text.empty() ? 0 : random() % text.size();
+      const std::string_view haystack = std::string_view(text).substr(offset);
+
+      const std::size_t expected = haystack.find(needle);
+      ASSERT_EQ(kernels.find(haystack.data(), haystack.size(), needle.data(), needle.size()), expected) << static_cast<int>(level) << " " << haystack << " / " << needle;
+      ASSERT_EQ(gobeyond::utility::simd_detail::scalar_kernels.find(haystack.data(), haystack.size(), needle.data(), needle.size()), expected);
+    }
+  }
+}
+
+TEST(SimdStringTest, FindLongNeedle) {
+  const std::string text = std::string(300, 'a') + "needle in a haystack" + std::string(40, 'a');
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::simd_detail::kernelsFor(level);
+
+    EXPECT_EQ(kernels.find(text.data(), text.size(), "needle in a haystack", 20), 300u);
+    EXPECT_EQ(kernels.find(text.data(), text.size(), "needle in a haystacc", 20), std::string_view::npos);
+    EXPECT_EQ(kernels.find(text.data(), text.size(), text.data(), text.size()), 0u);
+  }
+}
+
+TEST(SimdStringTest, FindAnyOfMatchesScalar) {
+  std::mt19937 random{7};
+  const std::string all = [] {
+    std::string s;
+
+    for ( int c = 1; c < 256; ++c ) {
+      s += static_cast<char>(c);
+    }
+
+    return s;
+  }();
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::simd_detail::kernelsFor(level);
+
+    for ( int round = 0; round < 2000; ++round ) {
+      const std::string text = randomText(random, random() % 150, "abcdefghijklmnopqrstuvwxyz");
+      // Sets up to 40 characters cover the vector path and the table fallback
+      const std::string set = randomText(random, random() % 40, all);
+
+      const std::size_t expected = std::string_view(text).find_first_of(set);
+      ASSERT_EQ(kernels.findAnyOf(text.data(), text.size(), set.data(), set.size()), expected) << static_cast<int>(level);
+    }
+  }
+}
+
+TEST(SimdStringTest, CompareMatchesScalar) {
+  std::mt19937 random{11};
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::simd_detail::kernelsFor(level);
+
+    for ( int round = 0; round < 2000; ++round ) {
+      const std::string a = randomText(random, random() % 100, "aA\x80");
+      std::string b = a.substr(0, random() % (a.size() + 1)) + randomText(random, random() % 3, "aA\x80");
+
+      const int expected = sign(std::string_view(a).compare(b));
+      ASSERT_EQ(sign(kernels.compare(a.data(), a.size(), b.data(), b.size())), expected) << static_cast<int>(level);
+      ASSERT_EQ(sign(kernels.compare(b.data(), b.size(), a.data(), a.size())), -expected);
+    }
+  }
+}
+
+TEST(SimdStringTest, CompareIgnoreCaseMatchesScalar) {
+  std::mt19937 random{13};
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::simd_detail::kernelsFor(level);
+
+    for ( int round = 0; round < 2000; ++round ) {
+      // Characters around the letter ranges catch off by one errors of the folding
+      const std::string a = randomText(random, random() % 100, "@AZ[`az{\xc1\xe1");
+      std::string b = a;
+
+      for ( char& c : b ) {
+        if ( random() % 2 ) {
+          c = static_cast<char>(c >= 'a' && c <= 'z' ? c - 32 : (c >= 'A' && c <= 'Z' ? c + 32 : c));
+        }
+      }
+
+      if ( !b.empty() && random() % 2 ) {
+        b[random() % b.size()] = "@AZ[`az{\xc1\xe1"[random() % 10];
+      }
+
+      const int expected = sign(lower(a).compare(lower(b)));
+      ASSERT_EQ(sign(kernels.compareIgnoreCase(a.data(), a.size(), b.data(), b.size())), expected) << static_cast<int>(level) << " " << a << " / " << b;
+    }
+  }
+}
+
+TEST(SimdStringTest, LengthMatchesStrlen) {
+  alignas(64) char buffer[256];
+
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::simd_detail::kernelsFor(level);
+
+    for ( std::size_t offset = 0; offset < 64; ++offset ) {
+      for ( std::size_t length = 0; length < 128; length += 7 ) {
+        std::memset(buffer, 'x', sizeof(buffer));
+        buffer[offset + length] = '\0';
+
+        ASSERT_EQ(kernels.length(buffer + offset), length) << static_cast<int>(level);
+      }
+    }
+  }
+}
+
+TEST(SimdStringTest, FreeFunctions) {
+  EXPECT_EQ(gobeyond::utility::str_find("sensors/hall-3/temperature", "hall"), 8u);
+  EXPECT_EQ(gobeyond::utility::str_find("sensors/hall-3/temperature", "/", 8), 14u);
+  EXPECT_EQ(gobeyond::utility::str_find("abc", "", 3), 3u);
+  EXPECT_EQ(gobeyond::utility::str_find("abc", "", 4), std::string_view::npos);
+  EXPECT_EQ(gobeyond::utility::str_find_any_of("key=value;other", "=;", 4), 9u);
+  EXPECT_EQ(gobeyond::utility::str_find_any_of("abc", "xyz"), std::string_view::npos);
+  EXPECT_LT(gobeyond::utility::str_compare("abc", "abd"), 0);
+  EXPECT_GT(gobeyond::utility::str_compare("abcd", "abc"), 0);
+  EXPECT_EQ(gobeyond::utility::str_compare_ignore_case("MQTT/Alarm", "mqtt/alarm"), 0);
+  EXPECT_TRUE(gobeyond::utility::str_equals_ignore_case("Error", "ERROR"));
+  EXPECT_FALSE(gobeyond::utility::str_equals_ignore_case("Error", "ERRORS"));
+  EXPECT_TRUE(gobeyond::utility::str_starts_with("mqtt/alarm", "mqtt/"));
+  EXPECT_FALSE(gobeyond::utility::str_starts_with("mq", "mqtt/"));
+  EXPECT_TRUE(gobeyond::utility::str_ends_with("mqtt/alarm", "/alarm"));
+  EXPECT_EQ(gobeyond::utility::str_length("hello"), 5u);
+}
+
+TEST(SimdStringTest, StringBufferMembers) {
+  const gobeyond::utility::StringBuffer<64> buffer{"MQTT: connection lost, retrying"};
+
+  EXPECT_EQ(buffer.find("lost"), 17u);
+  EXPECT_EQ(buffer.find("found"), buffer.npos);
+  EXPECT_EQ(buffer.find_any_of(",:"), 4u);
+  EXPECT_TRUE(buffer.contains("connection"));
+  EXPECT_TRUE(buffer.starts_with("MQTT:"));
+  EXPECT_TRUE(buffer.ends_with("retrying"));
+  EXPECT_EQ(buffer.compare("MQTT: connection lost, retrying"), 0);
+  EXPECT_LT(buffer.compare("MQTT: connection lost, retryinh"), 0);
+  EXPECT_EQ(buffer.compare_ignore_case("mqtt: CONNECTION lost, retrying"), 0);
+  EXPECT_TRUE(buffer.equals_ignore_case("mqtt: connection LOST, retrying"));
+}
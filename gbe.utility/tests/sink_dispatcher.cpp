@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gobeyond/utility/sink_dispatcher.hpp>
+
+namespace {
+  enum class LogLocation : std::uint32_t {
+    NONE = 0,
+    DEBUG = 1,
+    LOGFILE = 2,
+    MQTT = 4,
+    BROWSER = 8,
+    PUSHNOTIFICATION = 16,
+
+    ALL = 31
+  };
+
+  using dispatcher_type = gobeyond::utility::SinkDispatcher<LogLocation, 128>;
+  using sink_type = dispatcher_type::sink_type;
+  using route_type = dispatcher_type::route_type;
+
+  /// Collects the messages and the batch sizes it was given
+  class CollectingSink : public sink_type {
+    public:
+      explicit CollectingSink(std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+        : m_delay(delay)
+      {}
+
+      void write(const message_type* const* messages, std::size_t count) override {
+        if ( m_delay.count() > 0 ) {
+          std::this_thread::sleep_for(m_delay);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        batches.push_back(count);
+
+        for ( std::size_t i = 0; i < count; ++i ) {
+          texts.emplace_back(messages[i]->text.view());
+        }
+
+        received.fetch_add(count);
+      }
+
+      void flush() override {
+        flushes.fetch_add(1);
+      }
+
+      std::vector<std::string> snapshot() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return texts;
+      }
+
+      std::atomic<std::size_t> received{0};
+      std::atomic<std::size_t> flushes{0};
+      std::vector<std::size_t> batches;
+      std::vector<std::string> texts;
+
+    private:
+      std::chrono::milliseconds m_delay;
+      std::mutex m_mutex;
+  };
+
+  template <typename TPredicate>
+  bool waitFor(TPredicate predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while ( !predicate() ) {
+      if ( std::chrono::steady_clock::now() > deadline ) {
+        return false;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+  }
+}
+
+TEST(SinkDispatcherTest, AddSink) {
+  dispatcher_type dispatcher;
+  auto sink = std::make_shared<CollectingSink>();
+
+  EXPECT_TRUE(dispatcher.add_sink(LogLocation::DEBUG, sink));
+  EXPECT_FALSE(dispatcher.add_sink(LogLocation::DEBUG, sink));
+  EXPECT_FALSE(dispatcher.add_sink(LogLocation::ALL, sink));
+  EXPECT_FALSE(dispatcher.add_sink(LogLocation::NONE, sink));
+  EXPECT_FALSE(dispatcher.add_sink(LogLocation::MQTT, nullptr));
+
+  dispatcher.start();
+  EXPECT_FALSE(dispatcher.add_sink(LogLocation::MQTT, sink));
+}
+
+TEST(SinkDispatcherTest, Route) {
+  dispatcher_type dispatcher;
+  auto debug = std::make_shared<CollectingSink>();
+  auto logfile = std::make_shared<CollectingSink>();
+  auto mqtt = std::make_shared<CollectingSink>();
+
+  dispatcher.add_sink(LogLocation::DEBUG, debug);
+  dispatcher.add_sink(LogLocation::LOGFILE, logfile);
+  dispatcher.add_sink(LogLocation::MQTT, mqtt);
+  dispatcher.start();
+
+  EXPECT_EQ(dispatcher.dispatch(route_type{LogLocation::DEBUG | LogLocation::LOGFILE}, "both"), 2u);
+  EXPECT_EQ(dispatcher.dispatch(route_type{LogLocation::MQTT}, gobeyond::utility::StringBuffer<16>("mqtt")), 1u);
+  EXPECT_EQ(dispatcher.dispatch(route_type{LogLocation::BROWSER}, "nobody"), 0u);
+
+  dispatcher.stop();
+
+  EXPECT_EQ(debug->texts, std::vector<std::string>{"both"});
+  EXPECT_EQ(logfile->texts, std::vector<std::string>{"both"});
+  EXPECT_EQ(mqtt->texts, std::vector<std::string>{"mqtt"});
+  EXPECT_GE(debug->flushes.load(), 1u);
+}
+
+TEST(SinkDispatcherTest, StopDrains) {
+  dispatcher_type dispatcher{4096};
+  auto sink = std::make_shared<CollectingSink>();
+
+  dispatcher.add_sink(LogLocation::LOGFILE, sink);
+  dispatcher.start();
+
+  for ( int i = 0; i < 1000; ++i ) {
+    dispatcher.dispatch(route_type{LogLocation::LOGFILE}, std::to_string(i));
+  }
+
+  dispatcher.stop();
+
+  ASSERT_EQ(sink->texts.size(), 1000u);
+
+  for ( int i = 0; i < 1000; ++i ) {
+    EXPECT_EQ(sink->texts[static_cast<std::size_t>(i)], std::to_string(i));
+  }
+}
+
+TEST(SinkDispatcherTest, Batches) {
+  dispatcher_type dispatcher{4096};
+  auto sink = std::make_shared<CollectingSink>();
+
+  dispatcher.add_sink(LogLocation::LOGFILE, sink);
+
+  // Queued before the worker runs, so it sees full batches
+  for ( int i = 0; i < 200; ++i ) {
+    dispatcher.dispatch(route_type{LogLocation::LOGFILE}, "x");
+  }
+
+  dispatcher.start();
+  dispatcher.stop();
+
+  ASSERT_FALSE(sink->batches.empty());
+  EXPECT_EQ(sink->batches[0], dispatcher_type::queue_type::max_batch_size);
+  EXPECT_EQ(sink->received.load(), 200u);
+}
+
+TEST(SinkDispatcherTest, SlowSinkDoesNotStallOthers) {
+  dispatcher_type dispatcher{16};
+  auto slow = std::make_shared<CollectingSink>(std::chrono::milliseconds(200));
+  auto fast = std::make_shared<CollectingSink>();
+
+  dispatcher.add_sink(LogLocation::MQTT, slow);
+  dispatcher.add_sink(LogLocation::DEBUG, fast);
+  dispatcher.start();
+
+  for ( int i = 0; i < 100; ++i ) {
+    dispatcher.dispatch(route_type{LogLocation::MQTT | LogLocation::DEBUG}, std::to_string(i));
+
+    if ( i % 8 == 7 ) {
+      ASSERT_TRUE(waitFor([&fast, i]() { return fast->received.load() == static_cast<std::size_t>(i + 1); }));
+    }
+  }
+
+  EXPECT_LT(slow->received.load(), 100u);
+  EXPECT_GT(dispatcher.statistics(LogLocation::MQTT).dropped, 0u);
+  EXPECT_EQ(dispatcher.statistics(LogLocation::DEBUG).dropped, 0u);
+}
+
+TEST(SinkDispatcherTest, WakesSleepingWorker) {
+  dispatcher_type dispatcher{16, std::chrono::milliseconds(60000)};
+  auto sink = std::make_shared<CollectingSink>();
+
+  dispatcher.add_sink(LogLocation::DEBUG, sink);
+  dispatcher.start();
+
+  for ( int i = 0; i < 20; ++i ) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    dispatcher.dispatch(route_type{LogLocation::DEBUG}, "ping");
+    ASSERT_TRUE(waitFor([&sink, i]() { return sink->received.load() == static_cast<std::size_t>(i + 1); }));
+  }
+}
+
+TEST(SinkDispatcherTest, MultipleProducers) {
+  gobeyond::utility::SinkDispatcher<LogLocation, 128, gobeyond::utility::BackPressure::Block> dispatcher{64};
+  auto sink = std::make_shared<CollectingSink>();
+  std::vector<std::thread> threads;
+
+  dispatcher.add_sink(LogLocation::LOGFILE, sink);
+  dispatcher.start();
+
+  for ( int p = 0; p < 4; ++p ) {
+    threads.emplace_back([&dispatcher]() {
+      for ( int i = 0; i < 2000; ++i ) {
+        dispatcher.dispatch(route_type{LogLocation::LOGFILE}, "message");
+      }
+    });
+  }
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  dispatcher.stop();
+  EXPECT_EQ(sink->received.load(), 8000u);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(SinkDispatcherTest, FileDescriptorSink) {
+  std::FILE* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+
+  {
+    dispatcher_type dispatcher{1024};
+
+    dispatcher.add_sink(LogLocation::LOGFILE, std::make_shared<gobeyond::utility::FileDescriptorSink<LogLocation, 128>>(fileno(file)));
+
+    for ( int i = 0; i < 300; ++i ) {
+      dispatcher.dispatch(route_type{LogLocation::LOGFILE}, "line " + std::to_string(i));
+    }
+
+    dispatcher.start();
+  }
+
+  std::string expected;
+
+  for ( int i = 0; i < 300; ++i ) {
+    expected += "line " + std::to_string(i) + "\n";
+  }
+
+  std::string content(expected.size() + 16, '\0');
+  std::rewind(file);
+  content.resize(std::fread(content.data(), 1, content.size(), file));
+  std::fclose(file);
+
+  EXPECT_EQ(content, expected);
+}
+#endif
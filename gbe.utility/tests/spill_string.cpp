@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gobeyond/utility/spill_string.hpp>
+
+TEST(SpillStringTest, Inline) {
+  unsigned char memory[256];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<16> string{arena, "hello"};
+
+  EXPECT_EQ(string.view(), "hello");
+  EXPECT_FALSE(string.spilled());
+  EXPECT_FALSE(string.truncated());
+  EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(SpillStringTest, SpillsInsteadOfTruncating) {
+  unsigned char memory[256];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<8> string{arena};
+
+  string << "0123456" << 789 << '-' << 1.5 << true;
+
+  EXPECT_EQ(string.view(), "0123456789-1.5true");
+  EXPECT_STREQ(string.c_str(), "0123456789-1.5true");
+  EXPECT_TRUE(string.spilled());
+  EXPECT_FALSE(string.truncated());
+  EXPECT_TRUE(arena.owns(string.data()));
+}
+
+TEST(SpillStringTest, GrowsInPlace) {
+  unsigned char memory[1024];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<8> string{arena};
+
+  for ( int i = 0; i < 100; ++i ) {
+    string.append("0123456789");
+  }
+
+  EXPECT_EQ(string.size(), 1000u);
+  EXPECT_FALSE(string.truncated());
+  EXPECT_LE(arena.used(), 1024u);
+}
+
+TEST(SpillStringTest, TruncatesWithoutArena) {
+  gobeyond::utility::SpillString<8> string;
+
+  EXPECT_FALSE(string.append("0123456789"));
+  EXPECT_EQ(string.view(), "0123456");
+  EXPECT_FALSE(string.spilled());
+  EXPECT_TRUE(string.truncated());
+}
+
+TEST(SpillStringTest, TruncatesWhenArenaIsExhausted) {
+  unsigned char memory[12];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<4> string{arena};
+
+  EXPECT_FALSE(string.append("0123456789abcdef"));
+  EXPECT_EQ(string.view(), "0123456789a");
+  EXPECT_TRUE(string.spilled());
+  EXPECT_TRUE(string.truncated());
+}
+
+TEST(SpillStringTest, NumbersDoNotOverrunTheArena) {
+  unsigned char memory[16] = {};
+  gobeyond::utility::MonotonicArena arena{memory, 8};
+  gobeyond::utility::SpillString<4> string{arena};
+
+  EXPECT_FALSE(string.append(1234567890));
+  EXPECT_FALSE(string.append(0.123456789));
+  EXPECT_EQ(string.view(), "");
+  EXPECT_TRUE(string.truncated());
+
+  for ( std::size_t i = 8; i < sizeof(memory); ++i ) {
+    EXPECT_EQ(memory[i], 0u) << i;
+  }
+
+  EXPECT_TRUE(string.append(12345));
+  EXPECT_EQ(string.view(), "12345");
+}
+
+TEST(SpillStringTest, FormatsIntoAPartialSpill) {
+  unsigned char memory[12];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<4> string{arena};
+
+  EXPECT_FALSE(string.append_format(GBE_FMT("%s"), "0123456789abcdef"));
+  EXPECT_EQ(string.view(), "0123456789a");
+  EXPECT_TRUE(string.truncated());
+}
+
+TEST(SpillStringTest, AppendFormat) {
+  unsigned char memory[256];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<16> string{arena, "id="};
+
+  EXPECT_TRUE(string.append_format(GBE_FMT("%d name=%s value=%.2f"), 42, "temperature", 21.125));
+  EXPECT_EQ(string.view(), "id=42 name=temperature value=21.12");
+  EXPECT_TRUE(string.spilled());
+
+  EXPECT_TRUE(string.append_format(GBE_FMT("!")));
+  EXPECT_EQ(string.view(), "id=42 name=temperature value=21.12!");
+}
+
+TEST(SpillStringTest, Format) {
+  unsigned char memory[256];
+  gobeyond::utility::MonotonicArena arena{memory};
+
+  const auto short_string = gobeyond::utility::SpillString<16>::format(arena, GBE_FMT("%d"), 7);
+  const auto long_string = gobeyond::utility::SpillString<16>::format(arena, GBE_FMT("%s/%s"), "a long path", "with more");
+  // Read at runtime, the compiler must not see the inline attempt of the snprintf overload fail
+  const char* volatile label = "zero padded";
+  volatile int number = 42;
+  const auto printf_string = gobeyond::utility::SpillString<16>::format(arena, "%s %05d", label, number);
+
+  EXPECT_EQ(short_string.view(), "7");
+  EXPECT_FALSE(short_string.spilled());
+  EXPECT_EQ(long_string.view(), "a long path/with more");
+  EXPECT_TRUE(long_string.spilled());
+  EXPECT_EQ(printf_string.view(), "zero padded 00042");
+  EXPECT_TRUE(printf_string.spilled());
+}
+
+TEST(SpillStringTest, CopyAndMove) {
+  unsigned char memory[256];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<8> string{arena, "a string that spills"};
+
+  gobeyond::utility::SpillString<8> copy{string};
+  EXPECT_EQ(copy.view(), string.view());
+  EXPECT_NE(copy.data(), string.data());
+
+  const char* data = string.data();
+  gobeyond::utility::SpillString<8> moved{std::move(string)};
+  EXPECT_EQ(moved.data(), data);
+  EXPECT_TRUE(string.empty());
+  EXPECT_FALSE(string.spilled());
+
+  gobeyond::utility::SpillString<8> small{arena, "abc"};
+  moved = std::move(small);
+  EXPECT_EQ(moved.view(), "abc");
+  EXPECT_FALSE(moved.spilled());
+}
+
+TEST(SpillStringTest, Clear) {
+  unsigned char memory[256];
+  gobeyond::utility::MonotonicArena arena{memory};
+  gobeyond::utility::SpillString<8> string{arena, "a string that spills"};
+
+  string.clear();
+
+  EXPECT_TRUE(string.empty());
+  EXPECT_FALSE(string.spilled());
+  EXPECT_EQ(string.capacity(), 7u);
+}
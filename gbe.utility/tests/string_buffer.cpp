@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <gobeyond/utility/string_buffer.hpp>
+
+TEST(StringBufferTest, Default) {
+  gobeyond::utility::StringBuffer<16> buffer;
+
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.size(), 0u);
+  EXPECT_STREQ(buffer.c_str(), "");
+}
+
+TEST(StringBufferTest, Construct) {
+  gobeyond::utility::StringBuffer<16> buffer{"hello"};
+
+  EXPECT_EQ(buffer.size(), 5u);
+  EXPECT_EQ(buffer.view(), "hello");
+  EXPECT_STREQ(static_cast<const char*>(buffer), "hello");
+}
+
+TEST(StringBufferTest, ConstructNull) {
+  gobeyond::utility::StringBuffer<16> buffer{static_cast<const char*>(nullptr)};
+
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_STREQ(buffer.c_str(), "");
+}
+
+TEST(StringBufferTest, ConstructTruncates) {
+  gobeyond::utility::StringBuffer<8> buffer{"0123456789"};
+
+  EXPECT_EQ(buffer.size(), 7u);
+  EXPECT_EQ(buffer.view(), "0123456");
+}
+
+TEST(StringBufferTest, Copy) {
+  gobeyond::utility::StringBuffer<1024> buffer1{"message"};
+  gobeyond::utility::StringBuffer<1024> buffer2{buffer1};
+
+  EXPECT_EQ(buffer2.view(), "message");
+  EXPECT_EQ(buffer1.view(), "message");
+}
+
+TEST(StringBufferTest, Move) {
+  gobeyond::utility::StringBuffer<1024> buffer1{"message"};
+  gobeyond::utility::StringBuffer<1024> buffer2{std::move(buffer1)};
+
+  EXPECT_EQ(buffer2.view(), "message");
+  EXPECT_TRUE(buffer1.empty());
+  EXPECT_STREQ(buffer1.c_str(), "");
+}
+
+TEST(StringBufferTest, CopyAssign) {
+  gobeyond::utility::StringBuffer<32> buffer1{"a longer message"};
+  gobeyond::utility::StringBuffer<32> buffer2{"short"};
+
+  buffer1 = buffer2;
+  EXPECT_EQ(buffer1.view(), "short");
+  EXPECT_STREQ(buffer1.c_str(), "short");
+
+  buffer1 = buffer1;
+  EXPECT_EQ(buffer1.view(), "short");
+}
+
+TEST(StringBufferTest, MoveAssign) {
+  gobeyond::utility::StringBuffer<32> buffer1;
+  gobeyond::utility::StringBuffer<32> buffer2{"moved"};
+
+  buffer1 = std::move(buffer2);
+  EXPECT_EQ(buffer1.view(), "moved");
+  EXPECT_TRUE(buffer2.empty());
+}
+
+TEST(StringBufferTest, FormatSize) {
+  using buffer_type = gobeyond::utility::StringBuffer<8>;
+
+  buffer_type buffer1 = buffer_type::format("%d", 1234);
+  EXPECT_EQ(buffer1.size(), 4u);
+
+  // Read at runtime, the compiler must not see the truncation of the snprintf overload coming
+  volatile int large = 123456789;
+  buffer_type buffer2 = buffer_type::format("%d", large);
+  EXPECT_EQ(buffer2.size(), 7u);
+  EXPECT_EQ(buffer2.view(), "1234567");
+
+  buffer_type buffer3 = buffer_type::format(GBE_FMT("%d"), 123456789);
+  EXPECT_EQ(buffer3.size(), 7u);
+  EXPECT_EQ(buffer3.view(), "1234567");
+}
+
+TEST(StringBufferTest, SizeType) {
+  EXPECT_TRUE((std::is_same_v<gobeyond::utility::StringBuffer<255>::size_type, std::uint8_t>));
+  EXPECT_TRUE((std::is_same_v<gobeyond::utility::StringBuffer<1024>::size_type, std::uint16_t>));
+  EXPECT_TRUE((std::is_same_v<gobeyond::utility::StringBuffer<100000>::size_type, std::uint32_t>));
+}
+
+TEST(StringBufferTest, Append) {
+  gobeyond::utility::StringBuffer<32> buffer{"prefix"};
+
+  EXPECT_TRUE(buffer.append(std::string_view(": ")));
+  EXPECT_TRUE(buffer.append("text"));
+  EXPECT_TRUE(buffer.append(' '));
+  EXPECT_TRUE(buffer.append(42));
+  EXPECT_TRUE(buffer.append(' '));
+  EXPECT_TRUE(buffer.append(true));
+
+  EXPECT_EQ(buffer.view(), "prefix: text 42 true");
+  EXPECT_FALSE(buffer.truncated());
+}
+
+TEST(StringBufferTest, AppendNumbers) {
+  gobeyond::utility::StringBuffer<64> buffer;
+
+  buffer.append(-17);
+  buffer.append(',');
+  buffer.append(18446744073709551615ull);
+  buffer.append(',');
+  buffer.append(0.1);
+  buffer.append(',');
+  buffer.append(2.5f);
+
+  EXPECT_EQ(buffer.view(), "-17,18446744073709551615,0.1,2.5");
+}
+
+TEST(StringBufferTest, AppendTruncates) {
+  gobeyond::utility::StringBuffer<8> buffer{"abc"};
+
+  EXPECT_FALSE(buffer.append("defghij"));
+  EXPECT_EQ(buffer.view(), "abcdefg");
+  EXPECT_TRUE(buffer.truncated());
+  EXPECT_FALSE(buffer.append('x'));
+
+  buffer.clear();
+  EXPECT_FALSE(buffer.truncated());
+}
+
+TEST(StringBufferTest, AppendNumberIsAtomic) {
+  gobeyond::utility::StringBuffer<8> buffer{"abcde"};
+
+  EXPECT_FALSE(buffer.append(12345));
+  EXPECT_EQ(buffer.view(), "abcde");
+  EXPECT_TRUE(buffer.truncated());
+}
+
+TEST(StringBufferTest, StreamOperator) {
+  gobeyond::utility::StringBuffer<64> buffer;
+  std::string_view name = "sensor";
+  gobeyond::utility::StringBuffer<16> unit{"C"};
+
+  buffer << "[" << name << "] " << 21 << ' ' << unit;
+
+  EXPECT_EQ(buffer.view(), "[sensor] 21 C");
+}
+
+TEST(StringBufferTest, AppendFormat) {
+  gobeyond::utility::StringBuffer<32> buffer{"id="};
+
+  EXPECT_TRUE(buffer.append_format(GBE_FMT("%04x, value=%d"), 0xabu, 7));
+  EXPECT_EQ(buffer.view(), "id=00ab, value=7");
+
+  EXPECT_FALSE(buffer.append_format(GBE_FMT(" %s"), "too long for the rest"));
+  EXPECT_EQ(buffer.size(), 31u);
+  EXPECT_TRUE(buffer.truncated());
+}
+
+TEST(StringBufferTest, ReserveCommit) {
+  gobeyond::utility::StringBuffer<16> buffer{"abc"};
+
+  auto tail = buffer.reserve_tail();
+  ASSERT_EQ(tail.size, 12u);
+  std::memcpy(tail.data, "def", 3);
+
+  EXPECT_TRUE(buffer.commit(3));
+  EXPECT_EQ(buffer.view(), "abcdef");
+  EXPECT_STREQ(buffer.c_str(), "abcdef");
+
+  // Nothing beyond the tail was written, so an oversize commit is rejected
+  EXPECT_FALSE(buffer.commit(100));
+  EXPECT_EQ(buffer.view(), "abcdef");
+  EXPECT_STREQ(buffer.c_str(), "abcdef");
+  EXPECT_TRUE(buffer.truncated());
+
+  EXPECT_TRUE(buffer.commit(0));
+  EXPECT_EQ(buffer.size(), 6u);
+}
+
+TEST(StringBufferTest, CommitTruncated) {
+  gobeyond::utility::StringBuffer<8> buffer{"ab"};
+
+  auto tail = buffer.reserve_tail();
+  ASSERT_EQ(tail.size, 5u);
+  // What snprintf leaves of an 8 character text
+  std::memcpy(tail.data, "cdefg", 6);
+
+  EXPECT_FALSE(buffer.commit_truncated(8));
+  EXPECT_EQ(buffer.view(), "abcdefg");
+  EXPECT_STREQ(buffer.c_str(), "abcdefg");
+  EXPECT_TRUE(buffer.truncated());
+
+  buffer.clear();
+  tail = buffer.reserve_tail();
+  std::memcpy(tail.data, "xyz", 3);
+
+  EXPECT_TRUE(buffer.commit_truncated(3));
+  EXPECT_EQ(buffer.view(), "xyz");
+  EXPECT_FALSE(buffer.truncated());
+}
+
+TEST(StringBufferTest, CopyKeepsTruncation) {
+  gobeyond::utility::StringBuffer<4> buffer1{"abcdef"};
+  gobeyond::utility::StringBuffer<4> buffer2{buffer1};
+
+  EXPECT_TRUE(buffer2.truncated());
+}
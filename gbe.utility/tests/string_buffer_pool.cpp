@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gobeyond/utility/string_buffer_pool.hpp>
+
+using pool_type = gobeyond::utility::StringBufferPool<512>;
+
+TEST(StringBufferPoolTest, Acquire) {
+  pool_type pool{4};
+
+  pool_type::Handle handle = pool.acquire();
+  ASSERT_TRUE(handle);
+
+  handle->append("message");
+  EXPECT_EQ((*handle).view(), "message");
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(handle.get()) % gobeyond::utility::cache_line_size, 0u);
+}
+
+TEST(StringBufferPoolTest, Exhausted) {
+  pool_type pool{2};
+
+  pool_type::Handle handle1 = pool.acquire();
+  pool_type::Handle handle2 = pool.acquire();
+  pool_type::Handle handle3 = pool.acquire();
+
+  EXPECT_TRUE(handle1);
+  EXPECT_TRUE(handle2);
+  EXPECT_FALSE(handle3);
+  EXPECT_NE(handle1.get(), handle2.get());
+  EXPECT_EQ(pool.statistics().exhausted, 1u);
+
+  handle1.reset();
+  EXPECT_TRUE(pool.acquire());
+}
+
+TEST(StringBufferPoolTest, AcquiredBufferIsCleared) {
+  pool_type pool{1};
+
+  {
+    pool_type::Handle handle = pool.acquire();
+    handle->append("old content");
+  }
+
+  pool_type::Handle handle = pool.acquire();
+  ASSERT_TRUE(handle);
+  EXPECT_TRUE(handle->empty());
+}
+
+TEST(StringBufferPoolTest, MoveHandle) {
+  pool_type pool{1};
+
+  pool_type::Handle handle1 = pool.acquire();
+  pool_type::Handle handle2{std::move(handle1)};
+
+  EXPECT_FALSE(handle1);
+  EXPECT_TRUE(handle2);
+
+  handle1 = std::move(handle2);
+  EXPECT_TRUE(handle1);
+  EXPECT_EQ(pool.statistics().in_use, 1u);
+}
+
+TEST(StringBufferPoolTest, Statistics) {
+  pool_type pool{64};
+
+  {
+    std::vector<pool_type::Handle> handles;
+    for ( int i = 0; i < 20; ++i ) {
+      handles.push_back(pool.acquire());
+    }
+
+    pool_type::Statistics stats = pool.statistics();
+    EXPECT_EQ(stats.capacity, 64u);
+    EXPECT_EQ(stats.in_use, 20u);
+    EXPECT_EQ(stats.acquired, 20u);
+    EXPECT_GE(stats.high_water_mark, 20u);
+  }
+
+  EXPECT_EQ(pool.statistics().in_use, 0u);
+}
+
+TEST(StringBufferPoolTest, CrossThreadFree) {
+  pool_type pool{64};
+  pool_type::Handle handle = pool.acquire();
+
+  std::thread consumer([&handle]() { handle.reset(); });
+  consumer.join();
+
+  EXPECT_EQ(pool.statistics().cross_thread_frees, 1u);
+  EXPECT_EQ(pool.statistics().in_use, 0u);
+}
+
+TEST(StringBufferPoolTest, ThreadExitReturnsCache) {
+  pool_type pool{8};
+
+  std::thread worker([&pool]() {
+    pool_type::Handle handle = pool.acquire();
+    ASSERT_TRUE(handle);
+  });
+  worker.join();
+
+  // The worker cached buffers when it refilled, they must be back after it exited
+  std::vector<pool_type::Handle> handles;
+  for ( int i = 0; i < 8; ++i ) {
+    handles.push_back(pool.acquire());
+    EXPECT_TRUE(handles.back());
+  }
+}
+
+TEST(StringBufferPoolTest, Concurrent) {
+  pool_type pool{256};
+  std::atomic<int> failures{0};
+  std::vector<std::thread> threads;
+
+  for ( int t = 0; t < 4; ++t ) {
+    threads.emplace_back([&pool, &failures, t]() {
+      std::vector<pool_type::Handle> handles;
+
+      for ( int i = 0; i < 20000; ++i ) {
+        pool_type::Handle handle = pool.acquire();
+
+        if ( !handle ) {
+          failures.fetch_add(1);
+          continue;
+        }
+
+        handle->append(t);
+
+        if ( handle->view() != std::to_string(t) ) {
+          failures.fetch_add(1);
+        }
+
+        handles.push_back(std::move(handle));
+
+        if ( handles.size() > 8 ) {
+          handles.clear();
+        }
+      }
+    });
+  }
+
+  for ( std::thread& thread : threads ) {
+    thread.join();
+  }
+
+  EXPECT_EQ(failures.load(), 0);
+  EXPECT_EQ(pool.statistics().in_use, 0u);
+}
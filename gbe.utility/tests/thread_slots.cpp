@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <gobeyond/utility/thread_slots.hpp>
+
+TEST(ThreadSlotsTest, SameSlotPerThread) {
+  gobeyond::utility::ThreadSlots<int> slots{4};
+
+  int* slot = slots.local();
+  ASSERT_NE(slot, nullptr);
+  EXPECT_EQ(slots.local(), slot);
+  EXPECT_EQ(&slots[slots.local_index()], slot);
+}
+
+TEST(ThreadSlotsTest, DifferentSlotsPerThread) {
+  gobeyond::utility::ThreadSlots<int> slots{4};
+  int* main_slot = slots.local();
+  int* other_slot = nullptr;
+
+  std::thread other([&]() { other_slot = slots.local(); });
+  other.join();
+
+  EXPECT_NE(other_slot, nullptr);
+  EXPECT_NE(other_slot, main_slot);
+}
+
+TEST(ThreadSlotsTest, ReleasedOnThreadExit) {
+  std::atomic<int> released{0};
+  gobeyond::utility::ThreadSlots<int> slots{1, [&released](int&) { released.fetch_add(1); }};
+
+  std::thread first([&]() { EXPECT_NE(slots.local(), nullptr); });
+  first.join();
+  EXPECT_EQ(released.load(), 1);
+
+  std::thread second([&]() { EXPECT_NE(slots.local(), nullptr); });
+  second.join();
+  EXPECT_EQ(released.load(), 2);
+}
+
+TEST(ThreadSlotsTest, Exhausted) {
+  gobeyond::utility::ThreadSlots<int> slots{1};
+  ASSERT_NE(slots.local(), nullptr);
+
+  std::thread other([&]() {
+    EXPECT_EQ(slots.local(), nullptr);
+    EXPECT_EQ(slots.local_index(), slots.count());
+  });
+  other.join();
+}
+
+TEST(ThreadSlotsTest, OwnerDestroyedBeforeThreadExit) {
+  std::atomic<bool> claimed{false};
+  std::atomic<bool> destroyed{false};
+
+  auto* slots = new gobeyond::utility::ThreadSlots<int>{1};
+
+  std::thread worker([&]() {
+    EXPECT_NE(slots->local(), nullptr);
+    claimed = true;
+
+    while ( !destroyed ) {
+      std::this_thread::yield();
+    }
+  });
+
+  while ( !claimed ) {
+    std::this_thread::yield();
+  }
+
+  delete slots;
+  destroyed = true;
+  worker.join();
+}
+
+TEST(ThreadSlotsTest, DestroyedInstancesArePruned) {
+  std::thread worker([]() {
+    // A long-lived thread using many short-lived instances
+    for ( int i = 0; i < 1000; ++i ) {
+      gobeyond::utility::ThreadSlots<int> slots{2};
+      EXPECT_NE(slots.local(), nullptr);
+    }
+
+    gobeyond::utility::ThreadSlots<int> slots{2};
+    EXPECT_NE(slots.local(), nullptr);
+    EXPECT_LE(gobeyond::utility::thread_slots_detail::localTable().entries.size(), 2u);
+  });
+
+  worker.join();
+}
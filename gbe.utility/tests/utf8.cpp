@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <gobeyond/utility/string_buffer.hpp>
+#include <gobeyond/utility/utf8.hpp>
+
+namespace {
+  using gobeyond::utility::SimdLevel;
+
+  constexpr SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+
+  /// Reference validator, decodes the code points and checks their ranges
+  bool referenceValid(std::string_view text) {
+    std::size_t i = 0;
+
+    while ( i < text.size() ) {
+      const unsigned char lead = static_cast<unsigned char>(text[i]);
+      std::size_t length = 0;
+      std::uint32_t code_point = 0;
+
+      if ( lead < 0x80 ) {
+        ++i;
+        continue;
+      } else if ( (lead & 0xE0) == 0xC0 ) {
+        length = 2;
+        code_point = lead & 0x1F;
+      } else if ( (lead & 0xF0) == 0xE0 ) {
+        length = 3;
+        code_point = lead & 0x0F;
+      } else if ( (lead & 0xF8) == 0xF0 ) {
+        length = 4;
+        code_point = lead & 0x07;
+      } else {
+        return false;
+      }
+
+      if ( i + length > text.size() ) {
+        return false;
+      }
+
+      for ( std::size_t k = 1; k < length; ++k ) {
+        const unsigned char c = static_cast<unsigned char>(text[i + k]);
+
+        if ( (c & 0xC0) != 0x80 ) {
+          return false;
+        }
+
+        code_point = (code_point << 6) | (c & 0x3F);
+      }
+
+      const std::uint32_t minimum = 2 == length ? 0x80 : (3 == length ? 0x800 : 0x10000);
+
+      if ( code_point < minimum || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF) ) {
+        return false;
+      }
+
+      i += length;
+    }
+
+    return true;
+  }
+
+  std::string encode(std::uint32_t code_point) {
+    std::string result;
+
+    if ( code_point < 0x80 ) {
+      result += static_cast<char>(code_point);
+    } else if ( code_point < 0x800 ) {
+      result += static_cast<char>(0xC0 | (code_point >> 6));
+      result += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if ( code_point < 0x10000 ) {
+      result += static_cast<char>(0xE0 | (code_point >> 12));
+      result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+      result += static_cast<char>(0xF0 | (code_point >> 18));
+      result += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+
+    return result;
+  }
+
+  /// Valid text with code points of all lengths, mostly ASCII like real messages
+  std::string randomText(std::mt19937& random, std::size_t code_points) {
+    std::string text;
+
+    for ( std::size_t i = 0; i < code_points; ++i ) {
+      switch ( random() % 8 ) {
+        case 0:
+          text += encode(0x80 + random() % (0x800 - 0x80));
+          break;
+        case 1:
+          text += encode(0x800 + random() % (0xD800 - 0x800));
+          break;
+        case 2:
+          text += encode(0x10000 + random() % (0x110000 - 0x10000));
+          break;
+        default:
+          text += static_cast<char>(0x20 + random() % 0x5F);
+          break;
+      }
+    }
+
+    return text;
+  }
+
+  /// Reference sanitizer, copies sequence by sequence and stops at the first one that does not fit
+  std::string referenceSanitize(std::string_view text, std::size_t space, std::size_t& consumed) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    std::string result;
+
+    consumed = 0;
+
+    while ( consumed < text.size() ) {
+      std::size_t invalid = 0;
+      const std::size_t length = gobeyond::utility::utf8_detail::decode(p + consumed, text.size() - consumed, invalid);
+      const std::string_view output = 0 == length ? gobeyond::utility::utf8_replacement : text.substr(consumed, length);
+
+      if ( result.size() + output.size() > space ) {
+        break;
+      }
+
+      result += output;
+      consumed += 0 == length ? invalid : length;
+    }
+
+    return result;
+  }
+}
+
+TEST(Utf8Test, Valid) {
+  EXPECT_TRUE(gobeyond::utility::utf8_valid(""));
+  EXPECT_TRUE(gobeyond::utility::utf8_valid("plain ascii"));
+  EXPECT_TRUE(gobeyond::utility::utf8_valid("gr\xC3\xBC\xC3\x9F \xE2\x82\xAC \xF0\x9F\x98\x80"));
+  EXPECT_FALSE(gobeyond::utility::utf8_valid("\xC3"));
+  EXPECT_FALSE(gobeyond::utility::utf8_valid("\xC0\xAF"));
+  EXPECT_FALSE(gobeyond::utility::utf8_valid("\xED\xA0\x80"));
+  EXPECT_FALSE(gobeyond::utility::utf8_valid("\xF4\x90\x80\x80"));
+  EXPECT_FALSE(gobeyond::utility::utf8_valid("\x80"));
+  EXPECT_FALSE(gobeyond::utility::utf8_valid("\xFF"));
+  EXPECT_EQ(gobeyond::utility::utf8_validate("ab\xC3\xBC\xFF"), 4u);
+}
+
+TEST(Utf8Test, Fuzz) {
+  std::mt19937 random{2026};
+
+  for ( int round = 0; round < 20000; ++round ) {
+    std::string text = randomText(random, random() % 80);
+
+    // Corrupt some of the texts at a few random positions
+    if ( !text.empty() && 0 != round % 3 ) {
+      for ( std::uint32_t k = random() % 3; k > 0; --k ) {
+        text[random() % text.size()] = static_cast<char>(random() % 256);
+      }
+    }
+
+    // Cut some of the texts, possibly in the middle of a sequence
+    if ( 0 == round % 5 && !text.empty() ) {
+      text.resize(random() % text.size());
+    }
+
+    const bool expected = referenceValid(text);
+
+    for ( SimdLevel level : levels ) {
+      ASSERT_EQ(gobeyond::utility::utf8_detail::kernelsFor(level).valid(text.data(), text.size()), expected) << "level " << static_cast<int>(level) << " round " << round;
+    }
+
+    ASSERT_EQ(gobeyond::utility::utf8_detail::scalarValidPrefix(text.data(), text.size()) == text.size(), expected);
+
+    // Sanitized output is valid and fits, whatever the input and space
+    char out[128];
+    std::size_t consumed = 0;
+    const std::size_t space = random() % sizeof(out);
+    const std::size_t written = gobeyond::utility::utf8_sanitize_to(out, space, text, consumed);
+
+    ASSERT_LE(written, space);
+    ASSERT_LE(consumed, text.size());
+    ASSERT_TRUE(referenceValid(std::string_view(out, written))) << "round " << round;
+
+    if ( expected ) {
+      ASSERT_EQ(std::string_view(out, written), std::string_view(text).substr(0, consumed));
+    }
+  }
+}
+
+TEST(Utf8Test, SanitizeMatchesReference) {
+  std::mt19937 random{2027};
+
+  for ( int round = 0; round < 20000; ++round ) {
+    std::string text = randomText(random, random() % 80);
+
+    // Some texts are noise, the others have a few corrupt bytes
+    if ( 0 == round % 4 ) {
+      for ( char& c : text ) {
+        c = static_cast<char>(random() % 256);
+      }
+    } else if ( !text.empty() ) {
+      for ( std::uint32_t k = random() % 4; k > 0; --k ) {
+        text[random() % text.size()] = static_cast<char>(0x80 + random() % 128);
+      }
+    }
+
+    const std::size_t space = random() % (text.size() * 3 + 4);
+    std::size_t expected_consumed = 0;
+    const std::string expected = referenceSanitize(text, space, expected_consumed);
+
+    char out[512];
+    std::size_t consumed = 0;
+    const std::size_t written = gobeyond::utility::utf8_sanitize_to(out, space, text, consumed);
+
+    ASSERT_EQ(std::string_view(out, written), expected) << "round " << round;
+    ASSERT_EQ(consumed, expected_consumed) << "round " << round;
+
+    // In place the capacity holds at least the text
+    const std::size_t capacity = text.size() + random() % (text.size() * 2 + 4);
+    const std::string expected_in_place = referenceSanitize(text, capacity, expected_consumed);
+    std::string storage = text;
+
+    storage.resize(capacity, '#');
+
+    const std::size_t size = gobeyond::utility::utf8_sanitize_in_place(storage.data(), text.size(), capacity, consumed);
+
+    ASSERT_EQ(storage.substr(0, size), expected_in_place) << "round " << round;
+    ASSERT_EQ(consumed, expected_consumed) << "round " << round;
+  }
+}
+
+TEST(Utf8Test, EveryTwoByteCombination) {
+  // Every pair of bytes at every position relative to a vector boundary
+  for ( SimdLevel level : levels ) {
+    const auto& kernels = gobeyond::utility::utf8_detail::kernelsFor(level);
+
+    for ( int first = 0x80; first < 0x100; first += 3 ) {
+      for ( int second = 0; second < 0x100; ++second ) {
+        for ( std::size_t position : {0u, 15u, 30u, 31u, 62u} ) {
+          std::string text(64, 'x');
+          text[position] = static_cast<char>(first);
+          text[position + 1] = static_cast<char>(second);
+
+          // Completes three and four byte sequences, so only the pair decides
+          if ( position + 3 < text.size() ) {
+            text[position + 2] = '\x80' + (position % 2);
+            text[position + 3] = '\x80';
+          }
+
+          ASSERT_EQ(kernels.valid(text.data(), text.size()), referenceValid(text)) << "level " << static_cast<int>(level) << " bytes " << first << " " << second << " at " << position;
+        }
+      }
+    }
+  }
+}
+
+TEST(Utf8Test, Boundary) {
+  const std::string text = "a\xC3\xBC\xE2\x82\xAC\xF0\x9F\x98\x80";
+
+  EXPECT_EQ(gobeyond::utility::utf8_boundary(text, 0), 0u);
+  EXPECT_EQ(gobeyond::utility::utf8_boundary(text, 2), 1u);
+  EXPECT_EQ(gobeyond::utility::utf8_boundary(text, 3), 3u);
+  EXPECT_EQ(gobeyond::utility::utf8_boundary(text, 5), 3u);
+  EXPECT_EQ(gobeyond::utility::utf8_boundary(text, 9), 6u);
+  EXPECT_EQ(gobeyond::utility::utf8_boundary(text, 100), text.size());
+
+  EXPECT_EQ(gobeyond::utility::utf8_complete(text), text.size());
+  EXPECT_EQ(gobeyond::utility::utf8_complete(text.substr(0, 9)), 6u);
+  EXPECT_EQ(gobeyond::utility::utf8_complete(text.substr(0, 2)), 1u);
+  EXPECT_EQ(gobeyond::utility::utf8_complete(""), 0u);
+}
+
+TEST(Utf8Test, Sanitize) {
+  char out[32];
+  std::size_t consumed = 0;
+
+  // One replacement per maximal invalid subpart
+  const std::string_view text = "a\xE2\x82" "b\xFF" "c";
+  const std::size_t written = gobeyond::utility::utf8_sanitize_to(out, sizeof(out), text, consumed);
+
+  EXPECT_EQ(std::string_view(out, written), "a\xEF\xBF\xBD" "b\xEF\xBF\xBD" "c");
+  EXPECT_EQ(consumed, text.size());
+}
+
+TEST(Utf8Test, StringBufferAppend) {
+  gobeyond::utility::StringBuffer<8> buffer;
+
+  // 7 characters of capacity, the euro sign would be split
+  EXPECT_FALSE(buffer.append_utf8("abcde\xE2\x82\xAC"));
+  EXPECT_EQ(buffer.view(), "abcde");
+  EXPECT_TRUE(buffer.truncated());
+
+  buffer.clear();
+  EXPECT_FALSE(buffer.append_utf8("\xC3\xBC\xC3\xBC\xC3\xBC\xC3\xBC", "..."));
+  EXPECT_EQ(buffer.view(), "\xC3\xBC\xC3\xBC...");
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.append_utf8("a\xFF"));
+  EXPECT_EQ(buffer.view(), "a\xEF\xBF\xBD");
+  EXPECT_TRUE(gobeyond::utility::utf8_valid(buffer.view()));
+}
+
+TEST(Utf8Test, StringBufferRepair) {
+  gobeyond::utility::StringBuffer<8> buffer;
+
+  // snprintf cuts the third umlaut in half, the text is read at runtime so the compiler does not warn about it
+  const char* volatile umlauts = "\xC3\xBC\xC3\xBC\xC3\xBC\xC3\xBC";
+  buffer = gobeyond::utility::StringBuffer<8>::format("%s", umlauts);
+  EXPECT_FALSE(gobeyond::utility::utf8_valid(buffer.view()));
+
+  buffer.repair_utf8();
+  EXPECT_EQ(buffer.view(), "\xC3\xBC\xC3\xBC\xC3\xBC");
+  EXPECT_TRUE(buffer.truncated());
+
+  buffer = gobeyond::utility::StringBuffer<8>::format("%s", umlauts);
+  buffer.repair_utf8("\xE2\x80\xA6");
+  EXPECT_EQ(buffer.view(), "\xC3\xBC\xC3\xBC\xE2\x80\xA6");
+
+  buffer = gobeyond::utility::StringBuffer<8>::format("%s", "ok\xFF");
+  buffer.repair_utf8("...");
+  EXPECT_EQ(buffer.view(), "ok\xEF\xBF\xBD");
+  EXPECT_FALSE(buffer.truncated());
+
+  // Every invalid byte grows by two, the repaired text is cut where the buffer ends
+  buffer = gobeyond::utility::StringBuffer<8>::format("%s", "a\xFF\xFE\xFD");
+  buffer.repair_utf8();
+  EXPECT_EQ(buffer.view(), "a\xEF\xBF\xBD\xEF\xBF\xBD");
+  EXPECT_TRUE(buffer.truncated());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <bitset>
+#include <cstdint>
+#include <random>
+
+#include <gobeyond/utility/wide_bitmask.hpp>
+
+namespace {
+  enum class Permission : std::uint16_t {
+    READ = 0,
+    WRITE = 1,
+    DELETE = 63,
+    SHARE = 64,
+    AUDIT = 130,
+    ADMIN = 159
+  };
+
+  using mask_type = gobeyond::utility::WideBitMask<Permission, 160>;
+
+  mask_type randomMask(std::mt19937& random, std::bitset<160>& reference) {
+    mask_type mask;
+    reference.reset();
+
+    for ( std::size_t i = 0; i < 160; ++i ) {
+      if ( 0 == random() % 3 ) {
+        mask.enable(static_cast<Permission>(i));
+        reference.set(i);
+      }
+    }
+
+    return mask;
+  }
+
+  std::bitset<160> toBitset(const mask_type& mask) {
+    std::bitset<160> result;
+
+    for ( std::size_t i = 0; i < 160; ++i ) {
+      result[i] = mask.isEnabled(static_cast<Permission>(i));
+    }
+
+    return result;
+  }
+}
+
+TEST(WideBitMaskTest, EnableDisable) {
+  mask_type mask{Permission::READ, Permission::AUDIT};
+
+  EXPECT_EQ(mask_type::word_count, 3u);
+  EXPECT_TRUE(mask.isEnabled(Permission::READ));
+  EXPECT_TRUE(mask.isEnabled(Permission::AUDIT));
+  EXPECT_TRUE(mask.isDisabled(Permission::SHARE));
+
+  mask.enable(Permission::SHARE);
+  mask.disable(Permission::READ);
+  EXPECT_TRUE(mask.isEnabled(Permission::SHARE));
+  EXPECT_TRUE(mask.isDisabled(Permission::READ));
+  EXPECT_EQ(mask.count(), 2u);
+}
+
+TEST(WideBitMaskTest, LastBit) {
+  mask_type mask{Permission::ADMIN};
+
+  EXPECT_TRUE(mask.isEnabled(Permission::ADMIN));
+  EXPECT_EQ(mask.words()[2], std::uint64_t{1} << 31);
+  EXPECT_EQ(mask.count(), 1u);
+  EXPECT_EQ((~mask).count(), 159u);
+
+  mask.disable(Permission::ADMIN);
+  EXPECT_TRUE(mask.none());
+
+  // The bits behind the last flag share its word but are not flags
+  EXPECT_DEBUG_DEATH(mask.enable(static_cast<Permission>(160)), "");
+  EXPECT_DEBUG_DEATH(mask.enable(static_cast<Permission>(192)), "");
+  EXPECT_TRUE(mask.none());
+  EXPECT_EQ(mask.words()[2], 0u);
+}
+
+TEST(WideBitMaskTest, Tags) {
+  mask_type mask{Permission::DELETE};
+
+  mask = mask_type::Enable(Permission::ADMIN);
+  mask = mask_type::Disable(Permission::DELETE);
+
+  EXPECT_TRUE(mask == mask_type::Enabled(Permission::ADMIN));
+  EXPECT_TRUE(mask == mask_type::Disabled(Permission::DELETE));
+
+  mask = Permission::WRITE;
+  EXPECT_EQ(mask, mask_type{Permission::WRITE});
+}
+
+TEST(WideBitMaskTest, Tests) {
+  mask_type empty;
+  mask_type all = ~empty;
+
+  EXPECT_TRUE(empty.none());
+  EXPECT_FALSE(empty.any());
+  EXPECT_TRUE(all.all());
+  EXPECT_EQ(all.count(), 160u);
+  EXPECT_EQ(~all, empty);
+
+  all.disable(Permission::ADMIN);
+  EXPECT_FALSE(all.all());
+
+  const mask_type some{Permission::WRITE, Permission::SHARE};
+  EXPECT_TRUE(some.isSubsetOf(some | Permission::AUDIT));
+  EXPECT_FALSE((some | Permission::AUDIT).isSubsetOf(some));
+  EXPECT_TRUE(some.intersects(mask_type{Permission::SHARE}));
+  EXPECT_FALSE(some.intersects(mask_type{Permission::ADMIN}));
+}
+
+TEST(WideBitMaskTest, MatchesBitset) {
+  std::mt19937 random{160};
+
+  for ( int round = 0; round < 500; ++round ) {
+    std::bitset<160> a_reference;
+    std::bitset<160> b_reference;
+    const mask_type a = randomMask(random, a_reference);
+    const mask_type b = randomMask(random, b_reference);
+
+    ASSERT_EQ(toBitset(a & b), a_reference & b_reference);
+    ASSERT_EQ(toBitset(a | b), a_reference | b_reference);
+    ASSERT_EQ(toBitset(a ^ b), a_reference ^ b_reference);
+    ASSERT_EQ(toBitset(a.andNot(b)), a_reference & ~b_reference);
+    ASSERT_EQ(toBitset(~a), ~a_reference);
+    ASSERT_EQ(a.count(), a_reference.count());
+    ASSERT_EQ(a.isSubsetOf(b), (a_reference & ~b_reference).none());
+    ASSERT_EQ(a.intersects(b), (a_reference & b_reference).any());
+    ASSERT_EQ(a == b, a_reference == b_reference);
+
+    mask_type c = a;
+    c ^= b;
+    c &= a;
+    c |= b;
+    ASSERT_EQ(toBitset(c), ((a_reference ^ b_reference) & a_reference) | b_reference);
+  }
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#include <gobeyond/utility/binary_log.hpp>
+
+namespace {
+  void printUsage(const char* program) {
+    std::fprintf(stderr, "usage: %s [-n] <segment>...\n", program);
+    std::fprintf(stderr, "  -n  print timestamps as nanoseconds since the epoch\n");
+  }
+
+  void printTimestamp(std::uint64_t timestamp, bool raw) {
+    if ( raw ) {
+      std::printf("%llu", static_cast<unsigned long long>(timestamp));
+      return;
+    }
+
+    const std::time_t seconds = static_cast<std::time_t>(timestamp / 1000000000ull);
+    std::tm utc{};
+    char text[32];
+
+#if defined(_WIN32)
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+
+    std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &utc);
+    std::printf("%s.%06u", text, static_cast<unsigned>((timestamp % 1000000000ull) / 1000u));
+  }
+}
+
+int main(int argc, char** argv) {
+  bool raw = false;
+  int first = 1;
+
+  if ( first < argc && 0 == std::strcmp(argv[first], "-n") ) {
+    raw = true;
+    ++first;
+  }
+
+  if ( first >= argc ) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  int result = 0;
+
+  for ( int i = first; i < argc; ++i ) {
+    gobeyond::utility::BinaryLogReader reader;
+
+    if ( !reader.open(argv[i]) ) {
+      std::fprintf(stderr, "%s: not a binary log of version %u.x\n", argv[i], static_cast<unsigned>(gobeyond::utility::binary_log_version.major));
+      result = 1;
+      continue;
+    }
+
+    gobeyond::utility::BinaryLogReader::Entry entry;
+
+    while ( reader.next(entry) ) {
+      printTimestamp(entry.timestamp, raw);
+      std::printf(" [0x%llx] %.*s\n", static_cast<unsigned long long>(entry.route), static_cast<int>(entry.text.size()), entry.text.data());
+    }
+
+    if ( reader.corrupt() ) {
+      std::fprintf(stderr, "%s: corrupt record, the rest of the segment is skipped\n", argv[i]);
+      result = 1;
+    }
+  }
+
+  return result;
+}